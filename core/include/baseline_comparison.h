@@ -0,0 +1,169 @@
+/**
+ * baseline_comparison.h - Statistical regression detection against saved results
+ *
+ * Compares the sample sets of two JSON result documents written by
+ * ResultWriter and flags metrics whose change is both statistically
+ * significant and larger than a practical threshold.
+ */
+
+#ifndef BASELINE_COMPARISON_H
+#define BASELINE_COMPARISON_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "json_value.h"
+
+class ResultWriter;
+
+/**
+ * Baseline Comparison
+ *
+ * Sample sets are taken from:
+ *   - runner repetitions ("<benchmark>:<metric>", direction from the metric)
+ *   - memory latency samples ("memory:latency_ns")
+ *   - network round-trip samples ("network.<mode>:round_trip_ms", sweep
+ *     points, transport-comparison rows and latency-under-load phases)
+ *
+ * A metric regresses when the Mann-Whitney U test rejects equality at the
+ * configured alpha AND the median moved in the worse direction by more
+ * than threshold_percent. Welch's t-test is reported alongside. Metrics
+ * with fewer than min_samples values on either side are listed but not
+ * judged - run the runner with --repetitions to get enough samples.
+ *
+ * Samples taken within a single run (per-cycle memory latency, RTT
+ * samples) are autocorrelated: two runs of the same build routinely
+ * differ "significantly". Such changes are reported as Shifted and only
+ * gate when gate_within_run_samples is set.
+ *
+ * Example usage:
+ *   BaselineComparison comparison;
+ *   auto results = comparison.compare(baseline_document, current_document);
+ *   BaselineComparison::print_results(results);
+ *   return results.regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+ */
+class BaselineComparison {
+public:
+    /**
+     * Decision thresholds.
+     */
+    struct Config {
+        double alpha = 0.05;                // Significance level (confidence = 1 - alpha)
+        double threshold_percent = 5.0;     // Smallest median change that counts
+        std::size_t min_samples = 5;        // Per side, to attempt a verdict
+        bool gate_within_run_samples = false;   // Judge raw samples like repetitions
+    };
+
+    /**
+     * Outcome for one metric.
+     */
+    enum class Verdict {
+        Unchanged,
+        Improved,
+        Regressed,
+        Shifted,                // Significant change in within-run samples (not gated)
+        InsufficientSamples
+    };
+
+    /**
+     * Values of one metric in one document.
+     */
+    struct SampleSet {
+        std::string key;
+        std::string unit;
+        bool higher_is_better;
+        std::vector<double> values;
+        std::string parameters;         // Settings that produced the values, "name=value ..."
+        bool within_run;                // Raw samples of one run rather than one value per run
+    };
+
+    /**
+     * Comparison of one metric present in both documents.
+     */
+    struct MetricComparison {
+        std::string key;
+        std::string unit;
+        bool higher_is_better;
+        std::size_t baseline_count;
+        std::size_t current_count;
+        double baseline_median;
+        double current_median;
+        double change_percent;          // Median change, signed (current vs baseline)
+        double mann_whitney_p;
+        double welch_p;
+        double cliffs_delta;            // Current vs baseline; sign follows the values
+        std::string baseline_parameters;
+        std::string current_parameters; // Differs from the baseline when settings changed
+        bool within_run;
+        Verdict verdict;
+    };
+
+    /**
+     * Comparison results.
+     */
+    struct Results {
+        Config config;
+        std::vector<MetricComparison> metrics;
+        std::vector<std::string> missing_in_current;   // Baseline keys with no current data
+        std::size_t regressions;
+        std::size_t improvements;
+        std::string error_message;
+        bool comparison_successful;
+    };
+
+    /**
+     * Constructs a comparison with the default thresholds.
+     */
+    BaselineComparison() noexcept;
+
+    /**
+     * Constructs a comparison with the given thresholds.
+     *
+     * @param config Decision thresholds
+     */
+    explicit BaselineComparison(const Config& config) noexcept;
+
+    /**
+     * Compares every sample set present in both documents.
+     *
+     * @param baseline Parsed baseline document
+     * @param current Parsed current document
+     * @return Results (comparison_successful is false if nothing overlaps)
+     */
+    Results compare(const JsonValue& baseline, const JsonValue& current) const;
+
+    /**
+     * Extracts every comparable sample set from a result document.
+     *
+     * @param document Parsed result document
+     * @return Sample sets in document order
+     */
+    static std::vector<SampleSet> extract_sample_sets(const JsonValue& document);
+
+    /**
+     * Returns a short label for a verdict.
+     */
+    static const char* verdict_to_string(Verdict verdict) noexcept;
+
+    /**
+     * Prints the per-metric comparison table and the overall verdict.
+     *
+     * @param results The comparison results to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes the thresholds, every metric comparison and the totals as one object.
+     *
+     * @param results The comparison results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "baseline_comparison");
+
+private:
+    Config config_;
+};
+
+#endif // BASELINE_COMPARISON_H
@@ -0,0 +1,228 @@
+/**
+ * benchmark_registry.h - Common benchmark interface and registry
+ *
+ * Lets each module declare its parameters and report a common result type
+ * so a generic runner can select, repeat and report benchmarks by name
+ * instead of every module being wired into main() by hand.
+ */
+
+#ifndef BENCHMARK_REGISTRY_H
+#define BENCHMARK_REGISTRY_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Resolved parameter values, keyed by parameter name.
+ */
+using BenchmarkParameters = std::map<std::string, std::string>;
+
+/**
+ * A parameter declared by a benchmark.
+ */
+struct BenchmarkParameter {
+    std::string name;
+    std::string default_value;
+    std::string description;
+};
+
+/**
+ * A single named measurement.
+ */
+struct BenchmarkMetric {
+    std::string name;
+    double value;
+    std::string unit;
+    bool higher_is_better;
+};
+
+/**
+ * Result of one benchmark execution in module-independent form.
+ */
+struct BenchmarkResult {
+    std::string benchmark_name;
+    BenchmarkParameters parameters;     // Values the run actually used
+    std::vector<BenchmarkMetric> metrics;
+    std::string primary_metric;         // Metric that best summarizes the run
+    std::vector<double> latency_samples_seconds;    // Per-operation latencies (empty if not sampled)
+    std::string error_message;
+    bool benchmark_successful;
+};
+
+/**
+ * Benchmark Interface
+ *
+ * Implementations wrap an existing module (MemoryBenchmark, CpuBenchmark,
+ * ...). One instance is reused for warmup and every repetition, so
+ * expensive setup can be done once on the first run().
+ *
+ * Example usage:
+ *   class MyBenchmark : public Benchmark { ... };
+ *   registry.add([]() { return std::make_unique<MyBenchmark>(); });
+ */
+class Benchmark {
+public:
+    virtual ~Benchmark() = default;
+
+    /**
+     * Returns the unique benchmark name (e.g., "memory", "network.rtt").
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * Returns a one-line description.
+     */
+    virtual std::string description() const = 0;
+
+    /**
+     * Returns the parameters the benchmark accepts, with defaults.
+     */
+    virtual std::vector<BenchmarkParameter> parameters() const = 0;
+
+    /**
+     * Executes the benchmark once.
+     *
+     * @param parameters Every declared parameter, resolved to a value
+     * @return Common result structure
+     */
+    virtual BenchmarkResult run(const BenchmarkParameters& parameters) = 0;
+
+    /**
+     * Prints the module's detailed report for the most recent run().
+     */
+    virtual void print_details() const {}
+
+protected:
+    /**
+     * Parses a positive integer parameter.
+     *
+     * @param parameters Resolved parameters
+     * @param name Parameter name
+     * @param value Output value
+     * @param error_message Set when the value is missing or invalid
+     * @return true on success
+     */
+    static bool get_size(const BenchmarkParameters& parameters, const std::string& name,
+                         std::size_t& value, std::string& error_message);
+
+    /**
+     * Parses a non-negative floating-point parameter.
+     *
+     * @param parameters Resolved parameters
+     * @param name Parameter name
+     * @param value Output value
+     * @param error_message Set when the value is missing or invalid
+     * @return true on success
+     */
+    static bool get_double(const BenchmarkParameters& parameters, const std::string& name,
+                           double& value, std::string& error_message);
+
+    /**
+     * Parses a boolean parameter: 1, true, 0 or false.
+     *
+     * @param parameters Resolved parameters
+     * @param name Parameter name
+     * @param value Output value
+     * @param error_message Set when the value is missing or invalid
+     * @return true on success
+     */
+    static bool get_bool(const BenchmarkParameters& parameters, const std::string& name,
+                         bool& value, std::string& error_message);
+
+    /**
+     * Starts a result for this benchmark with the parameters recorded.
+     */
+    BenchmarkResult make_result(const BenchmarkParameters& parameters) const;
+};
+
+/**
+ * Benchmark Registry
+ *
+ * Holds a factory per benchmark name. Modules register through explicit
+ * functions (register_core_benchmarks(), ...) rather than static
+ * initializers, which a static library would silently drop at link time.
+ *
+ * Example usage:
+ *   BenchmarkRegistry registry;
+ *   register_core_benchmarks(registry);
+ *   auto names = registry.match("memory*,cpu");
+ */
+class BenchmarkRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<Benchmark>()>;
+
+    /**
+     * Registration entry describing one benchmark.
+     */
+    struct Entry {
+        std::string name;
+        std::string description;
+        std::vector<BenchmarkParameter> parameters;
+        Factory factory;
+    };
+
+    /**
+     * Registers a benchmark.
+     *
+     * @param factory Creates a fresh benchmark instance
+     * @return false if the name is already registered
+     */
+    bool add(Factory factory);
+
+    /**
+     * Returns all entries sorted by name.
+     */
+    const std::vector<Entry>& entries() const noexcept;
+
+    /**
+     * Looks up an entry by exact name.
+     *
+     * @return Entry pointer, or nullptr if not registered
+     */
+    const Entry* find(const std::string& name) const noexcept;
+
+    /**
+     * Selects benchmarks by a comma-separated list of names or globs
+     * ('*' and '?'). Order follows the registry; duplicates are removed.
+     *
+     * @param patterns Selection such as "memory,network.*"
+     * @param unmatched Output: patterns that matched nothing
+     * @return Matching benchmark names
+     */
+    std::vector<std::string> match(const std::string& patterns,
+                                   std::vector<std::string>& unmatched) const;
+
+    /**
+     * Creates an instance of a registered benchmark.
+     *
+     * @return New instance, or nullptr if not registered
+     */
+    std::unique_ptr<Benchmark> create(const std::string& name) const;
+
+    /**
+     * Matches text against a glob pattern supporting '*' and '?'.
+     */
+    static bool glob_match(const std::string& pattern, const std::string& text) noexcept;
+
+    /**
+     * Prints every registered benchmark with its parameters.
+     */
+    void print_list() const;
+
+private:
+    std::vector<Entry> entries_;
+};
+
+/**
+ * Registers the portable benchmarks provided by BenchmarkCore
+ * ("memory", "memory.continuous", "cpu").
+ *
+ * @param registry Registry to add to
+ */
+void register_core_benchmarks(BenchmarkRegistry& registry);
+
+#endif // BENCHMARK_REGISTRY_H
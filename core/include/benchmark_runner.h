@@ -0,0 +1,170 @@
+/**
+ * benchmark_runner.h - Generic runner for registered benchmarks
+ *
+ * Resolves parameters, runs warmup and measured repetitions for every
+ * selected benchmark and summarizes each metric across repetitions.
+ */
+
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "benchmark_registry.h"
+#include "statistics.h"
+#include "suite_config.h"
+
+class ResultWriter;
+
+/**
+ * Benchmark Runner
+ *
+ * Parameter overrides are "name=value" (applies to every selected
+ * benchmark that declares the parameter) or "benchmark.name=value"
+ * (applies to one benchmark only, e.g. "memory.buffer_size=4096").
+ *
+ * Example usage:
+ *   BenchmarkRunner::Config config;
+ *   config.selection = "memory,cpu";
+ *   config.repetitions = 5;
+ *   std::string error;
+ *   auto runs = BenchmarkRunner().run(registry, config, error);
+ *   BenchmarkRunner::print_summary(runs);
+ *
+ * Suites (see suite_config.h) run named instances instead of a selection;
+ * CPU pinning is delegated to the caller since it is platform-specific.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * Runner configuration.
+     */
+    struct Config {
+        std::string selection;                  // Comma-separated names or globs
+        std::size_t repetitions = 1;            // Measured runs per benchmark
+        std::size_t warmup = 0;                 // Discarded runs per benchmark
+        BenchmarkParameters overrides;          // Keyed "name" or "benchmark.name"
+        bool print_details = false;             // Module report after the last repetition
+    };
+
+    /**
+     * Summary of one metric across repetitions.
+     */
+    struct MetricSummary {
+        std::string name;
+        std::string unit;
+        bool higher_is_better;
+        std::size_t count;
+        double mean;
+        double min;
+        double max;
+        double std_deviation;
+        Statistics::BootstrapSummary ci;    // Across repetitions
+    };
+
+    /**
+     * All repetitions of one benchmark.
+     */
+    struct Run {
+        std::string benchmark_name;
+        std::string instance_name;          // Suite instance (empty outside suites)
+        int cpu;                            // Pinned CPU, -1 = not pinned
+        BenchmarkParameters parameters;
+        std::string primary_metric;
+        std::vector<BenchmarkResult> repetitions;
+        std::vector<MetricSummary> summaries;
+        std::size_t failed_repetitions;
+        std::string error_message;
+        bool benchmark_successful;
+    };
+
+    /**
+     * Pins the calling thread to a CPU, or restores the original affinity
+     * when cpu is -1.
+     *
+     * @param cpu CPU number or -1
+     * @param error_message Set on failure
+     * @return true on success
+     */
+    using CpuPinner = std::function<bool(int cpu, std::string& error_message)>;
+
+    /**
+     * Constructs a runner.
+     */
+    BenchmarkRunner() noexcept;
+
+    /**
+     * Runs every selected benchmark.
+     *
+     * @param registry Registry to select from
+     * @param config Selection, repetitions and overrides
+     * @param error_message Set when the selection or an override is invalid
+     * @return One Run per selected benchmark (empty on configuration error)
+     */
+    std::vector<Run> run(const BenchmarkRegistry& registry, const Config& config,
+                         std::string& error_message);
+
+    /**
+     * Runs every suite instance in order. An instance whose CPU cannot be
+     * pinned is reported as failed and skipped.
+     *
+     * @param registry Registry the suite was validated against
+     * @param suite Parsed suite
+     * @param print_details Module report after each instance's last repetition
+     * @param pin_cpu CPU pinning callback (empty = ignore cpu keys)
+     * @param error_message Set when the suite does not validate
+     * @return One Run per instance (empty on configuration error)
+     */
+    std::vector<Run> run_suite(const BenchmarkRegistry& registry, const SuiteConfig& suite,
+                               bool print_details, const CpuPinner& pin_cpu,
+                               std::string& error_message);
+
+    /**
+     * Resolves declared defaults and overrides for one benchmark.
+     *
+     * @param entry Registry entry
+     * @param overrides Overrides keyed "name" or "benchmark.name"
+     * @return Value for every declared parameter
+     */
+    static BenchmarkParameters resolve_parameters(const BenchmarkRegistry::Entry& entry,
+                                                  const BenchmarkParameters& overrides);
+
+    /**
+     * Prints one summary table per benchmark.
+     *
+     * @param runs Runs returned by run()
+     */
+    static void print_summary(const std::vector<Run>& runs);
+
+    /**
+     * Writes every run with its parameters, per-repetition metrics and
+     * summaries as an array.
+     *
+     * @param runs Runs returned by run()
+     * @param writer Destination JSON/CSV writer
+     * @param name Array name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const std::vector<Run>& runs, ResultWriter& writer,
+                              const std::string& name = "runs");
+
+private:
+    /**
+     * Runs warmup and measured repetitions of one benchmark.
+     */
+    static Run execute(const BenchmarkRegistry::Entry& entry,
+                       const BenchmarkParameters& parameters,
+                       std::size_t warmup,
+                       std::size_t repetitions,
+                       bool print_details,
+                       const std::string& instance_name = "",
+                       int cpu = -1);
+
+    /**
+     * Fills the per-metric summaries from the successful repetitions.
+     */
+    static void summarize(Run& run);
+};
+
+#endif // BENCHMARK_RUNNER_H
@@ -11,6 +11,9 @@
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include <vector>
+
+class ResultWriter;
 
 /**
  * CPU Benchmarking Module
@@ -33,6 +36,19 @@ public:
         double time_per_operation_ns;
     };
 
+    /**
+     * Timing and nominal work of one workload. Operation and byte counts
+     * are per-iteration estimates from the loop bodies (one libm call counts
+     * as one operation); bytes are loads and stores that leave registers.
+     */
+    struct WorkloadStats {
+        std::string name;               // "integer", "float" or "memory"
+        double seconds;
+        double operations;
+        double bytes;
+        std::size_t working_set_bytes;
+    };
+
     /**
      * Results structure containing CPU benchmark metrics.
      */
@@ -41,6 +57,7 @@ public:
         TimingStats timing;
         std::string benchmark_type;
         bool benchmark_successful;
+        std::vector<WorkloadStats> workloads;
     };
 
     /**
@@ -63,6 +80,16 @@ public:
      */
     static void print_results(const Results& results);
 
+    /**
+     * Writes every result field as one object.
+     *
+     * @param results The benchmark results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "cpu");
+
 private:
     /**
      * Performs CPU-intensive computation (integer operations).
@@ -0,0 +1,204 @@
+/**
+ * cpu_topology.h - In-memory model of caches, cores, SMT siblings and nodes
+ *
+ * Lets benchmarks size buffers relative to the cache hierarchy ("2xL2")
+ * and spread threads over cores instead of relying on fixed defaults.
+ */
+
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class ResultWriter;
+
+/**
+ * CPU Topology
+ *
+ * Built by a platform-specific discoverer (the CLI reads sysfs) through
+ * add_cpu() and add_cache(); an empty topology means nothing is known and
+ * callers fall back to their fixed defaults. The process-wide instance
+ * set with set_current() is what benchmarks consult.
+ *
+ * Size expressions accepted by parse_size():
+ *   4194304      bytes
+ *   L2           one L2 cache (data or unified)
+ *   2xL2         a multiple of it (also 2*L2, 0.5xL1)
+ *   L3/2         a fraction of it
+ *
+ * Example usage:
+ *   CpuTopology topology;
+ *   topology.add_cpu(0, 0, 0, 0);
+ *   topology.add_cache({2, "Unified", 1048576, 64, {0}});
+ *   CpuTopology::set_current(topology);
+ *   std::size_t bytes = 0;
+ *   std::string error;
+ *   CpuTopology::current().parse_size("2xL2", bytes, error);
+ */
+class CpuTopology {
+public:
+    /**
+     * One cache instance and the CPUs sharing it.
+     */
+    struct Cache {
+        int level;
+        std::string type;               // Data, Instruction or Unified
+        std::size_t size_bytes;
+        std::size_t line_bytes;         // 0 if unknown
+        std::vector<int> cpus;          // Sharing set, ascending
+    };
+
+    /**
+     * One physical core and its hardware threads.
+     */
+    struct Core {
+        int package;
+        int id;                         // Core id within the package
+        int node;                       // NUMA node (0 if unknown)
+        std::vector<int> cpus;          // SMT siblings, ascending
+    };
+
+    /**
+     * One NUMA node.
+     */
+    struct Node {
+        int id;
+        std::vector<int> cpus;
+    };
+
+    /**
+     * Constructs an empty topology.
+     */
+    CpuTopology() noexcept;
+
+    /**
+     * Adds a logical CPU; CPUs with the same package and core id are SMT
+     * siblings.
+     *
+     * @param cpu Logical CPU number
+     * @param package Physical package (socket) id
+     * @param core_id Core id within the package
+     * @param node NUMA node
+     */
+    void add_cpu(int cpu, int package, int core_id, int node);
+
+    /**
+     * Adds a cache instance unless one with the same level, type and
+     * sharing set exists.
+     *
+     * @param cache Cache to add (cpus need not be sorted)
+     */
+    void add_cache(const Cache& cache);
+
+    /**
+     * Returns true if no CPU has been added.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * Returns the logical CPUs, ascending.
+     */
+    std::vector<int> cpus() const;
+
+    /**
+     * Returns the cores ordered by package and core id.
+     */
+    const std::vector<Core>& cores() const noexcept;
+
+    /**
+     * Returns the distinct cache instances ordered by level.
+     */
+    const std::vector<Cache>& caches() const noexcept;
+
+    /**
+     * Returns the NUMA nodes, ascending.
+     */
+    std::vector<Node> nodes() const;
+
+    /**
+     * Returns the number of physical packages.
+     */
+    std::size_t package_count() const;
+
+    /**
+     * Returns the size of one data or unified cache of a level.
+     *
+     * @param level Cache level (1, 2, 3, ...)
+     * @return Size in bytes, or 0 if the level is unknown
+     */
+    std::size_t cache_size(int level) const noexcept;
+
+    /**
+     * Returns the highest known data or unified cache level (0 if none).
+     */
+    int last_level() const noexcept;
+
+    /**
+     * Returns the other hardware threads of a CPU's core.
+     *
+     * @param cpu Logical CPU number
+     * @return Siblings, empty without SMT or if the CPU is unknown
+     */
+    std::vector<int> smt_siblings(int cpu) const;
+
+    /**
+     * Chooses CPUs for worker threads: the first thread of every core,
+     * alternating between nodes, before any SMT sibling is used.
+     *
+     * @param count Number of CPUs wanted
+     * @return Up to count CPUs (fewer if the topology has fewer)
+     */
+    std::vector<int> spread_cpus(std::size_t count) const;
+
+    /**
+     * Parses a byte count or cache-relative size expression.
+     *
+     * @param text Expression (see class comment)
+     * @param bytes Output parameter for the size (at least 1)
+     * @param error_message Set when the expression is invalid or names an
+     *        unknown cache level
+     * @return true on success
+     */
+    bool parse_size(const std::string& text, std::size_t& bytes, std::string& error_message) const;
+
+    /**
+     * Parses a kernel cpulist such as "0-3,8-11".
+     *
+     * @param text Cpulist
+     * @return CPUs ascending (empty if the list is empty or malformed)
+     */
+    static std::vector<int> parse_cpulist(const std::string& text);
+
+    /**
+     * Formats CPUs as a kernel cpulist, e.g. "0-3,8".
+     */
+    static std::string format_cpulist(const std::vector<int>& cpus);
+
+    /**
+     * Replaces the process-wide topology. Call before benchmarks start.
+     */
+    static void set_current(const CpuTopology& topology);
+
+    /**
+     * Returns the process-wide topology (empty until set_current()).
+     */
+    static const CpuTopology& current() noexcept;
+
+    /**
+     * Writes cores, nodes and caches as one object.
+     *
+     * @param topology Topology to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const CpuTopology& topology, ResultWriter& writer,
+                              const std::string& name = "topology");
+
+private:
+    std::vector<Core> cores_;
+    std::vector<Cache> caches_;
+};
+
+#endif // CPU_TOPOLOGY_H
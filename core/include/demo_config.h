@@ -9,6 +9,7 @@
 #define DEMO_CONFIG_H
 
 #include <cstddef>
+#include "cpu_topology.h"
 
 /**
  * Demo Mode Configuration
@@ -33,6 +34,26 @@ namespace DemoConfig {
     constexpr std::size_t FULL_BUFFER_SIZE = 10 * 1024 * 1024; // 10 MB
     constexpr std::size_t FULL_ITERATIONS = 1000;               // More iterations
     constexpr std::size_t FULL_CPU_ITERATIONS = 1000000;        // Full CPU test
+
+    // Topology-relative buffer sizes (fall back to the constants above)
+
+    /**
+     * Demo buffer: twice the L2, past the private caches without
+     * stressing memory, or DEMO_BUFFER_SIZE if the L2 is unknown.
+     */
+    inline std::size_t demo_buffer_size(const CpuTopology& topology = CpuTopology::current()) {
+        std::size_t l2 = topology.cache_size(2);
+        return l2 > 0 ? 2 * l2 : DEMO_BUFFER_SIZE;
+    }
+
+    /**
+     * Full buffer: twice the last-level cache so DRAM is exercised, or
+     * FULL_BUFFER_SIZE if no cache is known.
+     */
+    inline std::size_t full_buffer_size(const CpuTopology& topology = CpuTopology::current()) {
+        std::size_t llc = topology.cache_size(topology.last_level());
+        return llc > 0 ? 2 * llc : FULL_BUFFER_SIZE;
+    }
 }
 
 #endif // DEMO_CONFIG_H
@@ -0,0 +1,136 @@
+/**
+ * drift_analysis.h - Performance drift detection for long-running modes
+ *
+ * Finds the points where per-run throughput shifted during a continuous
+ * run and relates each shift to CPU frequency, temperature and thermal
+ * throttling sampled alongside the runs.
+ */
+
+#ifndef DRIFT_ANALYSIS_H
+#define DRIFT_ANALYSIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ResultWriter;
+
+/**
+ * Drift Analysis Module
+ *
+ * Change points come from Statistics::change_points() over the per-run
+ * throughput series. Long series are first averaged into at most
+ * MAX_POINTS blocks so detection stays fast on hour-long burn-ins; each
+ * change is then located to the run. Shifts below MIN_CHANGE_PERCENT are
+ * merged into their neighbours.
+ *
+ * Host conditions are supplied by the caller (the core library does not
+ * read sysfs); a sampler that returns valid == false leaves the shifts
+ * uncorrelated.
+ *
+ * Example usage:
+ *   DriftAnalysis::Results drift = DriftAnalysis::analyze(run_start_seconds,
+ *                                                         run_throughput_mbps,
+ *                                                         conditions);
+ *   DriftAnalysis::print_results(drift);
+ */
+class DriftAnalysis {
+public:
+    /**
+     * Maximum points handed to change-point detection.
+     */
+    static constexpr std::size_t MAX_POINTS = 1000;
+
+    /**
+     * Minimum points per segment between two change points.
+     */
+    static constexpr std::size_t MIN_SEGMENT = 4;
+
+    /**
+     * Shifts smaller than this (percent of throughput) are merged away.
+     */
+    static constexpr double MIN_CHANGE_PERCENT = 2.0;
+
+    /**
+     * Host state at one instant. Throttle counts are cumulative since boot.
+     */
+    struct Condition {
+        bool valid;
+        double frequency_mhz;                   // Mean current frequency over CPUs
+        double temperature_celsius;             // Hottest thermal zone (0 if unknown)
+        std::uint64_t package_throttle_count;
+        std::uint64_t core_throttle_count;
+    };
+
+    /**
+     * Returns the current host state; called between runs.
+     */
+    using ConditionSampler = std::function<Condition()>;
+
+    /**
+     * One detected shift in throughput.
+     */
+    struct ChangePoint {
+        std::size_t run_index;                  // First run of the new segment
+        double time_seconds;                    // Start of that run
+        double throughput_before_mbps;          // Segment means
+        double throughput_after_mbps;
+        double change_percent;                  // Relative throughput change
+        double frequency_before_mhz;            // Segment means (0 if not sampled)
+        double frequency_after_mhz;
+        double temperature_before_celsius;
+        double temperature_after_celsius;
+        std::uint64_t package_throttle_events;  // Around the change
+        std::uint64_t core_throttle_events;
+        std::string description;                // e.g. "performance dropped 18% at t=340 s ..."
+    };
+
+    /**
+     * Drift summary of one continuous run.
+     */
+    struct Results {
+        bool enabled;                           // Analysis ran (continuous mode)
+        std::size_t runs;
+        bool conditions_sampled;                // At least one valid condition
+        double min_frequency_mhz;
+        double max_frequency_mhz;
+        double max_temperature_celsius;
+        std::uint64_t package_throttle_events;  // Over the whole run
+        std::uint64_t core_throttle_events;
+        std::vector<ChangePoint> change_points;
+    };
+
+    /**
+     * Detects throughput shifts and correlates them with host conditions.
+     *
+     * @param run_start_seconds Start time of each run since the first
+     * @param throughput_mbps Throughput of each run
+     * @param conditions Host state before the first run and after each run
+     *        (runs + 1 entries), or empty when not sampled
+     * @return Drift summary (enabled is always true)
+     */
+    static Results analyze(const std::vector<double>& run_start_seconds,
+                           const std::vector<double>& throughput_mbps,
+                           const std::vector<Condition>& conditions);
+
+    /**
+     * Prints the host condition ranges and one line per change point.
+     *
+     * @param results Drift summary
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes the summary and every change point as one object.
+     *
+     * @param results Drift summary
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "drift");
+};
+
+#endif // DRIFT_ANALYSIS_H
@@ -0,0 +1,153 @@
+/**
+ * fleet_report.h - Fleet-level aggregates and per-node outliers
+ *
+ * Combines the runner results of many hosts that ran the same suite into
+ * one distribution per suite instance and flags the hosts that stand out.
+ */
+
+#ifndef FLEET_REPORT_H
+#define FLEET_REPORT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "json_value.h"
+
+class ResultWriter;
+
+/**
+ * Fleet Report
+ *
+ * Each node contributes the mean primary metric of every run in its
+ * document (the object an agent returns: "node", "start_offset_ms" and a
+ * "runs" array as written by BenchmarkRunner::write_results). Runs are
+ * keyed by suite instance name, so every node is compared on identical
+ * settings.
+ *
+ * A node is an outlier for an instance when its value is more than
+ * outlier_threshold robust z-scores from the fleet median (modified
+ * z-score, 0.6745 * deviation / MAD) and at least min_deviation_percent
+ * away from it. With a MAD of zero the percentage alone decides. Fewer
+ * than min_nodes values are aggregated but not screened.
+ *
+ * Example usage:
+ *   FleetReport::Results results;
+ *   results.nodes.push_back(FleetReport::parse_node("10.0.0.1:9400", document));
+ *   FleetReport::aggregate(results, FleetReport::Config());
+ *   FleetReport::print_results(results);
+ */
+class FleetReport {
+public:
+    /**
+     * Outlier screening thresholds.
+     */
+    struct Config {
+        double outlier_threshold = 3.5;         // Modified z-score
+        double min_deviation_percent = 5.0;     // Smallest distance from the median that counts
+        std::size_t min_nodes = 3;              // Values needed to screen an instance
+    };
+
+    /**
+     * Primary metric of one run on one node.
+     */
+    struct NodeMetric {
+        std::string instance;                   // Suite instance (benchmark name outside suites)
+        std::string benchmark;
+        std::string metric;
+        std::string unit;
+        bool higher_is_better;
+        double value;                           // Mean over repetitions
+    };
+
+    /**
+     * One node of the fleet.
+     */
+    struct Node {
+        std::string name;                       // Reported by the node (address if unknown)
+        std::string address;                    // host:port it was reached at
+        double start_offset_ms;                 // Actual minus requested start time
+        std::vector<NodeMetric> metrics;
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * One node far from the fleet median.
+     */
+    struct Outlier {
+        std::string node;
+        double value;
+        double deviation_percent;               // Signed, against the median
+        double robust_z;                        // 0 when the MAD is zero
+        bool worse;                             // Deviates in the metric's bad direction
+    };
+
+    /**
+     * Distribution of one instance's primary metric across nodes.
+     */
+    struct Aggregate {
+        std::string instance;
+        std::string benchmark;
+        std::string metric;
+        std::string unit;
+        bool higher_is_better;
+        std::size_t nodes;
+        double mean;
+        double median;
+        double min;
+        double max;
+        double p05;
+        double p95;
+        double mad;                             // Median absolute deviation
+        std::vector<Outlier> outliers;          // Largest deviation first
+    };
+
+    /**
+     * Per-node and fleet results.
+     */
+    struct Results {
+        std::vector<Node> nodes;
+        std::vector<Aggregate> aggregates;
+        std::size_t failed_nodes;
+        double max_start_offset_ms;             // Largest |offset|: how tight the lockstep was
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * Reads one node's result document.
+     *
+     * @param address Where the node was reached
+     * @param document Parsed document returned by the node
+     * @return Node (benchmark_successful false if a run failed or the
+     *         document has no runs)
+     */
+    static Node parse_node(const std::string& address, const JsonValue& document);
+
+    /**
+     * Builds the aggregates, outliers and totals from results.nodes.
+     *
+     * @param results Results whose nodes are filled in; updated in place
+     * @param config Outlier thresholds
+     */
+    static void aggregate(Results& results, const Config& config);
+
+    /**
+     * Prints the fleet summary, one block per instance and the failed nodes.
+     *
+     * @param results Results to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes nodes and aggregates as one object.
+     *
+     * @param results Results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "fleet");
+};
+
+#endif // FLEET_REPORT_H
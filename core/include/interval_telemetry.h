@@ -0,0 +1,119 @@
+/**
+ * interval_telemetry.h - Live per-interval metrics as JSON lines
+ *
+ * Long stability runs report one line per interval (throughput, latency
+ * percentiles, errors) so a degradation can be located in time.
+ */
+
+#ifndef INTERVAL_TELEMETRY_H
+#define INTERVAL_TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "timer.h"
+
+/**
+ * Interval Telemetry
+ *
+ * record() is O(1) and allocation-free: latencies go into a fixed
+ * log-linear histogram (16 sub-buckets per power of two, so reported
+ * percentiles are within about 3% of the exact value), and the clock is
+ * only read after roughly 1% of an interval's worth of recorded latency.
+ * Each line is flushed as it is written, so the stream can be followed
+ * with `tail -f` while the run is still going.
+ *
+ * Line format:
+ *   {"source":"memory.continuous","interval":3,"elapsed_s":4.001,
+ *    "duration_s":1.000,"cycles":1520,"throughput_mbps":4561.2,"errors":0,
+ *    "latency_ns":{"min":..,"mean":..,"p50":..,"p90":..,"p99":..,"max":..}}
+ *
+ * Example usage:
+ *   IntervalTelemetry telemetry(std::cout, "memory.continuous", 1.0);
+ *   telemetry.start();
+ *   for (...) {
+ *       telemetry.record(latency_ns, bytes, errors);
+ *   }
+ *   telemetry.finish();
+ */
+class IntervalTelemetry {
+public:
+    /**
+     * Constructs a telemetry stream.
+     *
+     * @param stream Destination for JSON lines (must outlive this object)
+     * @param source Value of the "source" field (must outlive this object)
+     * @param interval_seconds Interval length (values <= 0 mean 1 second)
+     */
+    IntervalTelemetry(std::ostream& stream, const char* source, double interval_seconds) noexcept;
+
+    /**
+     * Starts the first interval and resets all counters.
+     */
+    void start() noexcept;
+
+    /**
+     * Records one measured operation, writing a line whenever an interval
+     * has elapsed.
+     *
+     * @param latency_ns Operation latency in nanoseconds
+     * @param bytes Bytes processed by the operation
+     * @param errors Errors detected by the operation
+     */
+    void record(double latency_ns, std::size_t bytes, std::size_t errors);
+
+    /**
+     * Writes the final (partial) interval if it recorded anything.
+     */
+    void finish();
+
+    /**
+     * Returns the number of lines written since start().
+     */
+    std::size_t intervals_written() const noexcept;
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int OCTAVES = 48;                          // Up to ~2.8e14 ns
+    static constexpr int BUCKET_COUNT = OCTAVES * SUB_BUCKETS;
+
+    /**
+     * Maps a latency to its histogram bucket.
+     */
+    static int bucket_index(double latency_ns) noexcept;
+
+    /**
+     * Returns the midpoint of a histogram bucket.
+     */
+    static double bucket_midpoint(int index) noexcept;
+
+    /**
+     * Returns the latency at a percentile of the current interval.
+     */
+    double interval_percentile(double pct) const noexcept;
+
+    /**
+     * Writes the current interval and starts the next one.
+     */
+    void emit(double now_seconds);
+
+    std::ostream& stream_;
+    const char* source_;
+    double interval_seconds_;
+    Timer timer_;
+    double interval_start_seconds_;
+    double latency_since_check_ns_;
+    std::size_t intervals_written_;
+
+    // Current interval
+    std::uint64_t counts_[BUCKET_COUNT];
+    std::uint64_t cycles_;
+    std::uint64_t bytes_;
+    std::uint64_t errors_;
+    double latency_sum_ns_;
+    double min_latency_ns_;
+    double max_latency_ns_;
+};
+
+#endif // INTERVAL_TELEMETRY_H
@@ -0,0 +1,123 @@
+/**
+ * json_value.h - Minimal JSON document reader
+ *
+ * Parses the documents produced by ResultWriter (and any other RFC 8259
+ * JSON) into an immutable tree so saved results can be read back.
+ */
+
+#ifndef JSON_VALUE_H
+#define JSON_VALUE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * JSON Value
+ *
+ * Accessors never throw: asking a value for the wrong type returns an
+ * empty/zero result. find() returns nullptr for a missing member, so check
+ * it before dereferencing.
+ *
+ * Example usage:
+ *   JsonValue document;
+ *   std::string error;
+ *   if (JsonValue::parse_file("results.json", document, error)) {
+ *       const JsonValue* memory = document.find("memory");
+ *       const JsonValue* throughput = memory ? memory->find("throughput_mbps") : nullptr;
+ *   }
+ */
+class JsonValue {
+public:
+    /**
+     * Value type.
+     */
+    enum class Type {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    using Member = std::pair<std::string, JsonValue>;
+
+    /**
+     * Constructs a null value.
+     */
+    JsonValue() noexcept;
+
+    /**
+     * Parses a complete JSON document.
+     *
+     * @param text Document text
+     * @param value Output parameter for the parsed document
+     * @param error_message Set with the offset of the first error on failure
+     * @return true on success
+     */
+    static bool parse(const std::string& text, JsonValue& value, std::string& error_message);
+
+    /**
+     * Reads and parses a JSON file.
+     *
+     * @param path File path
+     * @param value Output parameter for the parsed document
+     * @param error_message Set on read or parse failure
+     * @return true on success
+     */
+    static bool parse_file(const std::string& path, JsonValue& value, std::string& error_message);
+
+    Type type() const noexcept;
+    bool is_null() const noexcept;
+    bool is_number() const noexcept;
+    bool is_string() const noexcept;
+    bool is_array() const noexcept;
+    bool is_object() const noexcept;
+
+    /**
+     * Returns the boolean value (false for other types).
+     */
+    bool as_bool() const noexcept;
+
+    /**
+     * Returns the numeric value (0.0 for other types).
+     */
+    double as_number() const noexcept;
+
+    /**
+     * Returns the string value (empty for other types).
+     */
+    const std::string& as_string() const noexcept;
+
+    /**
+     * Returns the array elements (empty for other types).
+     */
+    const std::vector<JsonValue>& items() const noexcept;
+
+    /**
+     * Returns the object members in document order (empty for other types).
+     */
+    const std::vector<Member>& members() const noexcept;
+
+    /**
+     * Finds an object member by name.
+     *
+     * @param name Member name
+     * @return Pointer to the first member with that name, or nullptr
+     */
+    const JsonValue* find(const std::string& name) const noexcept;
+
+private:
+    class Parser;
+
+    Type type_;
+    bool bool_value_;
+    double number_value_;
+    std::string string_value_;
+    std::vector<JsonValue> items_;
+    std::vector<Member> members_;
+};
+
+#endif // JSON_VALUE_H
@@ -10,7 +10,13 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <string>
 #include <vector>
+#include "statistics.h"
+#include "drift_analysis.h"
+
+class ResultWriter;
+class IntervalTelemetry;
 
 /**
  * RAM Benchmarking Module
@@ -35,6 +41,35 @@ public:
         double variance_ns;          // Variance of latency measurements
         double std_deviation_ns;      // Standard deviation of latency measurements
         std::size_t sample_count;     // Number of samples used for statistics
+        double median_latency_ns;
+        double mad_ns;                // Median absolute deviation (unscaled)
+        double trimmed_mean_ns;       // Mean of the middle 80% of samples
+        Statistics::OutlierCounts outliers;   // Tukey fences over the samples
+    };
+
+    /**
+     * Automatic iteration-count parameters for run_calibrated().
+     */
+    struct CalibrationConfig {
+        std::size_t window_iterations = 16;     // Cycles per warmup/convergence check
+        double warmup_tolerance = 0.05;         // Max relative change between window means
+        double max_warmup_seconds = 2.0;        // Warmup budget
+        double target_relative_ci = 0.01;       // 95% CI half-width as a fraction of the mean
+        std::size_t min_iterations = 32;        // Measured cycles before stopping is allowed
+        std::size_t max_iterations = 1000000;
+        double max_seconds = 10.0;              // Measurement budget (excludes warmup)
+    };
+
+    /**
+     * How a calibrated run chose its iteration count.
+     */
+    struct CalibrationStats {
+        bool enabled;                   // Results come from run_calibrated()
+        std::size_t warmup_iterations;  // Discarded cycles
+        double warmup_seconds;
+        bool warmup_stable;             // Window means settled within the warmup budget
+        double relative_ci_half_width;  // Achieved 95% CI half-width / mean
+        bool converged;                 // Target reached within the measurement budget
     };
 
     /**
@@ -45,8 +80,15 @@ public:
         std::size_t iterations;
         TimingStats timing;
         double throughput_mbps;
+        bool outliers_excluded;         // Throughput omits cycles outside the inner fences
+        std::size_t excluded_cycles;
+        double excluded_seconds;
         bool verification_passed;
         std::size_t verification_errors;
+        std::vector<double> latency_samples_ns;    // Per cycle (continuous mode: per-run averages)
+        Statistics::BootstrapSummary latency_ci;   // Over latency_samples_ns
+        CalibrationStats calibration;
+        DriftAnalysis::Results drift;              // Continuous mode only
     };
 
     /**
@@ -54,6 +96,31 @@ public:
      */
     MemoryBenchmark() noexcept;
 
+    /**
+     * Excludes cycles outside the inner Tukey fences from throughput.
+     * Latency statistics always cover every cycle; interrupts and page
+     * faults otherwise drag the throughput of short runs down.
+     * 
+     * @param exclude true to compute throughput from inlier cycles only
+     */
+    void set_exclude_outliers(bool exclude) noexcept;
+
+    /**
+     * Streams per-interval metrics of every cycle during run_continuous().
+     * 
+     * @param telemetry Telemetry sink (nullptr disables; must outlive the runs)
+     */
+    void set_telemetry(IntervalTelemetry* telemetry) noexcept;
+
+    /**
+     * Samples host conditions (frequency, temperature, throttling) before
+     * and after every run of run_continuous() for drift correlation.
+     * Sampling happens between runs, outside the timed cycles.
+     * 
+     * @param sampler Condition source (empty disables)
+     */
+    void set_condition_sampler(DriftAnalysis::ConditionSampler sampler);
+
     /**
      * Runs the memory benchmark.
      * 
@@ -66,6 +133,7 @@ public:
     /**
      * Runs the memory benchmark in continuous/stability mode.
      * Executes multiple benchmark runs and tracks consistency across runs.
+     * Shifts in per-run throughput are reported in Results::drift.
      * 
      * @param buffer_size_bytes Size of the buffer to allocate (in bytes)
      * @param iterations_per_run Number of read-write-read cycles per run
@@ -78,6 +146,19 @@ public:
                           std::size_t max_runs,
                           double max_duration_seconds);
 
+    /**
+     * Runs the memory benchmark with an automatically chosen iteration count.
+     * Warms up until the mean latency of consecutive windows agrees within
+     * warmup_tolerance (cold caches, frequency ramp-up), then measures until
+     * the 95% confidence interval of the mean is narrower than
+     * target_relative_ci or the time budget runs out.
+     * 
+     * @param buffer_size_bytes Size of the buffer to allocate (in bytes)
+     * @param config Warmup and convergence thresholds
+     * @return Results structure with benchmark metrics and calibration details
+     */
+    Results run_calibrated(std::size_t buffer_size_bytes, const CalibrationConfig& config);
+
     /**
      * Prints benchmark results in a clear table format.
      * 
@@ -85,6 +166,17 @@ public:
      */
     static void print_results(const Results& results);
 
+    /**
+     * Writes every result field plus the latency samples and their
+     * histogram as one object.
+     * 
+     * @param results The benchmark results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "memory");
+
 private:
     /**
      * Performs a single read-write-read verification cycle and measures its latency.
@@ -120,11 +212,35 @@ private:
      * @param buffer Pointer to pre-allocated buffer
      * @param buffer_size_bytes Size of the buffer in bytes
      * @param iterations Number of read-write-read cycles to perform
+     * @param telemetry Receives every cycle when not nullptr
      * @return Results structure with benchmark metrics
      */
     Results run_with_buffer(std::uint8_t* buffer, 
                            std::size_t buffer_size_bytes, 
-                           std::size_t iterations);
+                           std::size_t iterations,
+                           IntervalTelemetry* telemetry = nullptr);
+
+    /**
+     * Fills timing, throughput and verification fields from per-cycle latencies.
+     * 
+     * @param results Results to fill (buffer_size_bytes must be set)
+     * @param latencies Per-cycle latencies in nanoseconds (moved into the results)
+     * @param total_errors Verification errors across all cycles
+     * @param elapsed_seconds Wall time of the measured cycles
+     */
+    void summarize_cycles(Results& results,
+                          std::vector<double> latencies,
+                          std::size_t total_errors,
+                          double elapsed_seconds) const;
+
+    /**
+     * Fills median, MAD, trimmed mean and outlier counts.
+     * 
+     * @param sorted_samples Latencies sorted in ascending order
+     * @param timing Output timing statistics
+     */
+    static void calculate_robust_statistics(const std::vector<double>& sorted_samples,
+                                            TimingStats& timing);
 
     /**
      * Calculates variance and standard deviation from a vector of latency values.
@@ -138,6 +254,10 @@ private:
                                     double mean,
                                     double& variance,
                                     double& std_deviation) noexcept;
+
+    bool exclude_outliers_;
+    IntervalTelemetry* telemetry_;
+    DriftAnalysis::ConditionSampler condition_sampler_;
 };
 
 #endif // MEMORY_BENCHMARK_H
@@ -0,0 +1,102 @@
+/**
+ * prometheus_exporter.h - Benchmark results in Prometheus text format
+ *
+ * Keeps the latest metrics of each benchmark plus cumulative latency
+ * histograms and renders them for a /metrics scrape.
+ */
+
+#ifndef PROMETHEUS_EXPORTER_H
+#define PROMETHEUS_EXPORTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "benchmark_registry.h"
+
+/**
+ * Prometheus Exporter
+ *
+ * Renders text exposition format 0.0.4:
+ *   systembenchmark_probe_value{benchmark,metric,unit}   gauge, latest run
+ *   systembenchmark_probe_success{benchmark}             gauge, 1 = last run passed
+ *   systembenchmark_probe_runs_total{benchmark}          counter
+ *   systembenchmark_probe_failures_total{benchmark}      counter
+ *   systembenchmark_probe_last_run_timestamp_seconds{benchmark}
+ *   systembenchmark_probe_latency_seconds{benchmark}     histogram of
+ *       BenchmarkResult::latency_samples_seconds, cumulative since start
+ * plus any gauges set with set_gauge(). Not thread-safe; callers that
+ * update and render from different threads must serialize access.
+ *
+ * Example usage:
+ *   PrometheusExporter exporter;
+ *   exporter.update(benchmark->run(parameters), unix_time_seconds);
+ *   std::string body = exporter.render();
+ */
+class PrometheusExporter {
+public:
+    /**
+     * Constructs an empty exporter.
+     */
+    PrometheusExporter() noexcept;
+
+    /**
+     * Records one benchmark result.
+     *
+     * @param result Result to expose (replaces the benchmark's previous values)
+     * @param timestamp_seconds Unix time of the run
+     */
+    void update(const BenchmarkResult& result, double timestamp_seconds);
+
+    /**
+     * Sets a process-level gauge or counter, rendered as
+     * systembenchmark_<name>.
+     *
+     * @param name Metric name suffix ([a-z_] only)
+     * @param help HELP text
+     * @param type "gauge" or "counter"
+     * @param value Current value
+     */
+    void set_gauge(const std::string& name, const std::string& help,
+                   const std::string& type, double value);
+
+    /**
+     * Renders every metric in text exposition format.
+     */
+    std::string render() const;
+
+    /**
+     * Upper bounds (seconds) of the latency histogram buckets, +Inf excluded.
+     */
+    static const std::vector<double>& latency_buckets();
+
+private:
+    /**
+     * Everything exposed for one benchmark.
+     */
+    struct ProbeState {
+        std::vector<BenchmarkMetric> metrics;
+        bool successful;
+        std::uint64_t runs;
+        std::uint64_t failures;
+        double last_run_timestamp;
+        std::vector<std::uint64_t> bucket_counts;   // Per bucket, not cumulative; last = +Inf
+        std::uint64_t latency_count;
+        double latency_sum;
+    };
+
+    /**
+     * A process-level metric from set_gauge().
+     */
+    struct Gauge {
+        std::string help;
+        std::string type;
+        double value;
+    };
+
+    std::map<std::string, ProbeState> probes_;
+    std::map<std::string, Gauge> gauges_;
+};
+
+#endif // PROMETHEUS_EXPORTER_H
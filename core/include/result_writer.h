@@ -0,0 +1,199 @@
+/**
+ * result_writer.h - Machine-readable JSON and CSV result output
+ *
+ * Streams nested result records as JSON or as flattened CSV rows so the
+ * same per-module write_results() function serves both formats.
+ */
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "statistics.h"
+
+/**
+ * Result Writer
+ *
+ * JSON output is a single pretty-printed document. CSV output has the
+ * header "field,value" and one row per scalar, where field is the dotted
+ * path of the value (array elements use [index]), e.g.
+ *   memory.timing.avg_latency_ns,5123.5
+ *   network[0].round_trip_samples_ms[3],0.012
+ *
+ * Names passed for values inside an array are ignored. Scopes still open
+ * when the writer is destroyed are closed, so an early exit still leaves a
+ * well-formed document.
+ *
+ * Example usage:
+ *   ResultWriter writer(std::cout, ResultWriter::Format::Json);
+ *   writer.begin_object();
+ *   writer.begin_object("memory");
+ *   writer.field("avg_latency_ns", 5123.5);
+ *   writer.end_object();
+ *   writer.end_object();
+ */
+class ResultWriter {
+public:
+    /**
+     * Output format.
+     */
+    enum class Format {
+        Json,
+        Csv
+    };
+
+    /**
+     * Number of bins used by histogram().
+     */
+    static constexpr std::size_t DEFAULT_HISTOGRAM_BINS = 20;
+
+    /**
+     * Constructs a writer.
+     *
+     * @param out Destination stream (must outlive the writer)
+     * @param format Output format
+     */
+    ResultWriter(std::ostream& out, Format format) noexcept;
+
+    /**
+     * Closes any open scopes.
+     */
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /**
+     * Parses a format name ("json" or "csv").
+     *
+     * @param name Format name
+     * @param format Output parameter for the parsed format
+     * @return true if the name is recognized
+     */
+    static bool parse_format(const std::string& name, Format& format) noexcept;
+
+    /**
+     * Opens a nested object (name is ignored at top level and in arrays).
+     */
+    void begin_object(const std::string& name = "");
+
+    /**
+     * Closes the innermost object.
+     */
+    void end_object();
+
+    /**
+     * Opens a nested array.
+     */
+    void begin_array(const std::string& name = "");
+
+    /**
+     * Closes the innermost array.
+     */
+    void end_array();
+
+    /**
+     * Writes a string value.
+     */
+    void field(const std::string& name, const std::string& value);
+
+    /**
+     * Writes a string value.
+     */
+    void field(const std::string& name, const char* value);
+
+    /**
+     * Writes a floating-point value (NaN and infinity become null).
+     */
+    void field(const std::string& name, double value);
+
+    /**
+     * Writes a boolean value.
+     */
+    void field(const std::string& name, bool value);
+
+    /**
+     * Writes an integer value.
+     */
+    template <typename Integer,
+              typename std::enable_if<std::is_integral<Integer>::value &&
+                                      !std::is_same<Integer, bool>::value, int>::type = 0>
+    void field(const std::string& name, Integer value) {
+        if (std::is_signed<Integer>::value) {
+            write_scalar(name, std::to_string(static_cast<long long>(value)), false);
+        } else {
+            write_scalar(name, std::to_string(static_cast<unsigned long long>(value)), false);
+        }
+    }
+
+    /**
+     * Writes raw samples as an array of numbers.
+     */
+    void samples(const std::string& name, const std::vector<double>& values);
+
+    /**
+     * Writes a histogram of the samples as an array of
+     * {lower, upper, count} objects (see Statistics::histogram).
+     */
+    void histogram(const std::string& name, const std::vector<double>& values,
+                   std::size_t bin_count = DEFAULT_HISTOGRAM_BINS);
+
+    /**
+     * Writes bootstrap confidence intervals as an object with the sample
+     * count, confidence level, resample count and {estimate, lower, upper}
+     * objects for mean, median and p99 (see Statistics::bootstrap_summary).
+     */
+    void confidence_intervals(const std::string& name, const Statistics::BootstrapSummary& summary);
+
+    /**
+     * Closes every open scope and flushes the stream.
+     */
+    void finish();
+
+private:
+    /**
+     * One open object or array.
+     */
+    struct Scope {
+        bool is_array;
+        std::size_t count;          // Values written so far
+        std::string path;           // CSV field prefix
+    };
+
+    /**
+     * Writes the separator, indentation and key for the next value and
+     * returns its CSV path.
+     */
+    std::string begin_value(const std::string& name);
+
+    /**
+     * Writes one scalar, quoted as a string when is_string is true.
+     */
+    void write_scalar(const std::string& name, const std::string& text, bool is_string);
+
+    /**
+     * Writes a newline and indentation for the current depth (JSON only).
+     */
+    void write_indent();
+
+    /**
+     * Escapes a string for a JSON string literal.
+     */
+    static std::string escape_json(const std::string& text);
+
+    /**
+     * Quotes a CSV cell when it contains a separator, quote or newline.
+     */
+    static std::string escape_csv(const std::string& text);
+
+    std::ostream& out_;
+    Format format_;
+    std::vector<Scope> scopes_;
+    bool header_written_;
+};
+
+#endif // RESULT_WRITER_H
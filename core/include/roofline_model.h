@@ -0,0 +1,157 @@
+/**
+ * roofline_model.h - Per-host roofline from measured bandwidth and peak compute
+ *
+ * Measures peak floating-point throughput and the streaming read bandwidth
+ * of each memory level, then places workloads on the resulting roofline by
+ * their arithmetic intensity to show whether they are compute- or
+ * memory-bound on this host.
+ */
+
+#ifndef ROOFLINE_MODEL_H
+#define ROOFLINE_MODEL_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class ResultWriter;
+
+/**
+ * Roofline Model
+ *
+ * Attainable performance at arithmetic intensity I (operations per byte)
+ * on a level with bandwidth B is min(peak, I * B); the ridge point
+ * peak / B separates memory-bound from compute-bound intensities.
+ *
+ * The peak is measured with independent double-precision multiply-add
+ * chains and the bandwidths with a multi-accumulator read of each level's
+ * test buffer, both as compiled for this build (no explicit SIMD), so the
+ * roofs describe what portable code reaches rather than the datasheet.
+ * Workloads count operations generically (integer and libm operations
+ * included), which places them consistently but not as strict FLOPs.
+ *
+ * Example usage:
+ *   RooflineModel::Results roofline = RooflineModel::measure(RooflineModel::default_config());
+ *   RooflineModel::place(roofline, {"stream", operations, bytes, seconds, working_set});
+ *   RooflineModel::print_results(roofline);
+ */
+class RooflineModel {
+public:
+    /**
+     * One level of the memory hierarchy.
+     */
+    struct MemoryLevel {
+        std::string name;               // e.g. "L1", "L2", "L3", "DRAM"
+        std::size_t capacity_bytes;     // Working sets up to this size use the level (0 = unbounded)
+        std::size_t test_bytes;         // Buffer size used to measure its bandwidth
+    };
+
+    /**
+     * Measurement parameters.
+     */
+    struct Config {
+        std::vector<MemoryLevel> levels;    // Ascending capacity, last one unbounded
+        double min_seconds = 0.05;          // Minimum duration of each measurement
+        std::size_t repetitions = 3;        // Best of this many measurements
+    };
+
+    /**
+     * Bandwidth roof of one memory level.
+     */
+    struct Roof {
+        std::string name;
+        std::size_t capacity_bytes;
+        std::size_t test_bytes;
+        double bandwidth_gbps;          // GB/s (1e9 bytes)
+        double ridge_intensity;         // Operations per byte where the roof meets the peak
+    };
+
+    /**
+     * Work done by one workload.
+     */
+    struct Workload {
+        std::string name;
+        double operations;
+        double bytes;                   // Memory traffic (0 = register-resident)
+        double seconds;
+        std::size_t working_set_bytes;  // Selects the roof
+    };
+
+    /**
+     * A workload placed on the roofline.
+     */
+    struct Point {
+        std::string name;
+        double intensity;               // Operations per byte (0 when bytes == 0)
+        double achieved_gops;
+        std::string roof;               // Memory level the working set fits in
+        double attainable_gops;
+        bool compute_bound;             // At or right of the ridge point
+        double efficiency;              // Achieved / attainable
+    };
+
+    /**
+     * Roofline of this host plus the placed workloads.
+     */
+    struct Results {
+        double peak_gops;               // Measured peak (2 operations per multiply-add)
+        std::vector<Roof> roofs;
+        std::vector<Point> points;
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * Default levels for a typical x86-64/ARM64 core: L1 32 KiB, L2 1 MiB,
+     * L3 16 MiB and DRAM, each measured at half its capacity (256 MiB for
+     * DRAM).
+     */
+    static Config default_config();
+
+    /**
+     * Measures the peak and every level's bandwidth.
+     *
+     * @param config Levels and measurement durations
+     * @return Roofline without points (benchmark_successful is false and
+     *         error_message set when a buffer cannot be allocated)
+     */
+    static Results measure(const Config& config);
+
+    /**
+     * Places a workload on the roofline.
+     *
+     * @param results Measured roofline (receives the point)
+     * @param workload Operations, traffic and duration of the workload
+     */
+    static void place(Results& results, const Workload& workload);
+
+    /**
+     * Prints the roofs and one row per placed workload.
+     *
+     * @param results Roofline to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes the peak, roofs and placed workloads as one object.
+     *
+     * @param results Roofline to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "roofline");
+
+private:
+    /**
+     * Independent multiply-add chains; returns a value to keep them live.
+     */
+    static double peak_kernel(std::size_t iterations) noexcept;
+
+    /**
+     * Sums a buffer with several accumulators.
+     */
+    static double read_kernel(const double* data, std::size_t count) noexcept;
+};
+
+#endif // ROOFLINE_MODEL_H
@@ -0,0 +1,281 @@
+/**
+ * statistics.h - Shared statistical helpers for benchmark results
+ * 
+ * Provides percentile and summary calculations over latency samples.
+ * Used by modules that report distributions rather than a single mean.
+ * Bootstrap confidence intervals quantify how much of a difference between
+ * two reports could be noise.
+ */
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Statistics Helpers
+ * 
+ * Stateless functions operating on sample vectors. Percentiles use linear
+ * interpolation between closest ranks.
+ *
+ * Bootstrap intervals: the mean uses BCa (bias-corrected and accelerated)
+ * resampling with a seeded generator, so identical samples give identical
+ * intervals. Quantiles use the exact percentile bootstrap of the nearest
+ * order statistic, computed from the binomial distribution without
+ * resampling (jackknife acceleration is unreliable for quantiles).
+ */
+namespace Statistics {
+    /**
+     * One histogram bin covering [lower, upper).
+     */
+    struct HistogramBin {
+        double lower;
+        double upper;
+        std::size_t count;
+    };
+
+    /**
+     * Tukey-fence outlier classification. Inner fences lie 1.5 IQR and
+     * outer fences 3 IQR beyond the quartiles; samples between the fences
+     * are mild outliers, samples beyond the outer fences severe ones.
+     */
+    struct OutlierCounts {
+        double lower_inner_fence;
+        double upper_inner_fence;
+        double lower_outer_fence;
+        double upper_outer_fence;
+        std::size_t low_severe;
+        std::size_t low_mild;
+        std::size_t high_mild;
+        std::size_t high_severe;
+    };
+
+    /**
+     * Outcome of a two-sample significance test.
+     */
+    struct TestResult {
+        double statistic;       // U for Mann-Whitney, t for Welch
+        double p_value;         // Two-sided
+    };
+
+    /**
+     * Point estimate with a two-sided confidence interval.
+     */
+    struct ConfidenceInterval {
+        double estimate;
+        double lower;
+        double upper;
+    };
+
+    /**
+     * Bootstrap parameters.
+     */
+    struct BootstrapConfig {
+        double confidence = 0.95;
+        std::size_t resamples = 2000;           // Mean replicates for small samples
+        std::size_t max_draws = 20000000;       // Caps resamples * samples (min 200 resamples)
+        std::uint64_t seed = 0x5EED5EED5EED5EEDULL;
+    };
+
+    /**
+     * Confidence intervals for the usual latency summaries of one sample.
+     */
+    struct BootstrapSummary {
+        std::size_t sample_count;
+        double confidence;
+        std::size_t resamples;          // Replicates drawn for the mean
+        ConfidenceInterval mean;        // BCa
+        ConfidenceInterval median;      // Exact percentile bootstrap
+        ConfidenceInterval p99;         // Exact percentile bootstrap
+    };
+
+    /**
+     * Computes a percentile from an already sorted sample vector.
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @param percentile Percentile in the range [0, 100]
+     * @return Interpolated percentile value, or 0.0 if samples are empty
+     */
+    double percentile_sorted(const std::vector<double>& sorted_samples,
+                             double percentile) noexcept;
+
+    /**
+     * Computes a percentile from an unsorted sample vector.
+     * Sorts a copy of the samples; prefer percentile_sorted() when several
+     * percentiles are needed from the same data.
+     * 
+     * @param samples Unsorted samples
+     * @param pct Percentile in the range [0, 100]
+     * @return Interpolated percentile value, or 0.0 if samples are empty
+     */
+    double percentile(std::vector<double> samples, double pct) noexcept;
+
+    /**
+     * Computes the arithmetic mean of the samples.
+     * 
+     * @param samples Sample values
+     * @return Mean value, or 0.0 if samples are empty
+     */
+    double mean(const std::vector<double>& samples) noexcept;
+
+    /**
+     * Computes the sample standard deviation (n - 1 denominator).
+     * 
+     * @param samples Sample values
+     * @return Standard deviation, or 0.0 with fewer than two samples
+     */
+    double standard_deviation(const std::vector<double>& samples) noexcept;
+
+    /**
+     * Computes the median absolute deviation from the median (unscaled;
+     * multiply by 1.4826 for a standard-deviation estimate under normality).
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @return MAD, or 0.0 if samples are empty
+     */
+    double median_absolute_deviation_sorted(const std::vector<double>& sorted_samples);
+
+    /**
+     * Computes the mean after discarding a fraction of the samples at
+     * each end.
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @param trim_fraction Fraction removed from each end, in [0, 0.5)
+     * @return Trimmed mean, or 0.0 if samples are empty
+     */
+    double trimmed_mean_sorted(const std::vector<double>& sorted_samples,
+                               double trim_fraction) noexcept;
+
+    /**
+     * Classifies samples against Tukey's fences.
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @return Fences and per-class counts (all zero if samples are empty)
+     */
+    OutlierCounts classify_outliers_sorted(const std::vector<double>& sorted_samples) noexcept;
+
+    /**
+     * Buckets samples into a histogram. Bins are geometrically spaced
+     * between the smallest and largest sample so latency tails keep their
+     * resolution; spacing is linear when the smallest sample is not positive.
+     * The largest sample is counted in the last bin.
+     * 
+     * @param samples Sample values
+     * @param bin_count Number of bins
+     * @return Bins in ascending order, or empty if samples are empty
+     */
+    std::vector<HistogramBin> histogram(const std::vector<double>& samples,
+                                        std::size_t bin_count);
+
+    /**
+     * BCa bootstrap confidence interval of the mean. Resampling draws
+     * indices from a counter-based generator and accumulates sums in place,
+     * so only the replicate array is allocated. From 65536 samples on,
+     * Poisson(1) weights over a sequential pass replace the index draws to
+     * stay cache-friendly. The replicate count shrinks for large samples to
+     * keep the work near config.max_draws.
+     * 
+     * @param samples Sample values (fewer than 2^32)
+     * @param config Confidence level, replicate count and seed
+     * @param resamples_used Output parameter for the replicates drawn
+     * @return Mean with its interval (lower == upper == mean with fewer
+     *         than two samples or no spread)
+     */
+    ConfidenceInterval bootstrap_mean(const std::vector<double>& samples,
+                                      const BootstrapConfig& config,
+                                      std::size_t& resamples_used);
+
+    /**
+     * Exact percentile-bootstrap confidence interval of a percentile.
+     * The bootstrap distribution of the k-th order statistic is binomial,
+     * so no resampling is needed: cost is O(log n) after sorting.
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @param percentile Percentile in the range [0, 100]
+     * @param confidence Confidence level in (0, 1)
+     * @return Interpolated percentile with its interval
+     */
+    ConfidenceInterval bootstrap_percentile_sorted(const std::vector<double>& sorted_samples,
+                                                   double percentile,
+                                                   double confidence) noexcept;
+
+    /**
+     * Confidence intervals of the mean, median and p99.
+     * 
+     * @param sorted_samples Samples sorted in ascending order
+     * @param config Bootstrap parameters
+     * @return Summary (all zero if samples are empty)
+     */
+    BootstrapSummary bootstrap_summary_sorted(const std::vector<double>& sorted_samples,
+                                              const BootstrapConfig& config = BootstrapConfig());
+
+    /**
+     * Confidence intervals of the mean, median and p99.
+     * Sorts a copy of the samples; prefer bootstrap_summary_sorted() when
+     * the samples are already sorted.
+     * 
+     * @param samples Unsorted samples
+     * @param config Bootstrap parameters
+     * @return Summary (all zero if samples are empty)
+     */
+    BootstrapSummary bootstrap_summary(std::vector<double> samples,
+                                       const BootstrapConfig& config = BootstrapConfig());
+
+    /**
+     * Mann-Whitney U test (Wilcoxon rank-sum) of whether one sample tends
+     * to be larger than the other. Uses the normal approximation with tie
+     * and continuity correction, which is adequate from roughly eight
+     * samples per side; no distributional assumption is made.
+     * 
+     * @param first First sample
+     * @param second Second sample
+     * @return U of the first sample and the two-sided p-value
+     *         (p = 1 when either sample is empty)
+     */
+    TestResult mann_whitney_u(const std::vector<double>& first,
+                              const std::vector<double>& second);
+
+    /**
+     * Welch's unequal-variance t-test of a difference in means.
+     * 
+     * @param first First sample
+     * @param second Second sample
+     * @return t (first minus second) and the two-sided p-value
+     *         (p = 1 with fewer than two samples per side)
+     */
+    TestResult welch_t_test(const std::vector<double>& first,
+                            const std::vector<double>& second) noexcept;
+
+    /**
+     * Cliff's delta effect size: P(first > second) - P(first < second).
+     * Ranges from -1 to 1; |delta| below 0.147 is conventionally negligible,
+     * below 0.33 small, below 0.474 medium, and large otherwise.
+     * 
+     * @param first First sample
+     * @param second Second sample
+     * @return Effect size, or 0.0 if either sample is empty
+     */
+    double cliffs_delta(const std::vector<double>& first,
+                        const std::vector<double>& second);
+
+    /**
+     * Detects shifts in the mean of a series with PELT (pruned exact
+     * linear time) under a squared-error cost. The noise level is
+     * estimated from the MAD of first differences, so a slow drift or a
+     * step does not inflate it. Each change costs penalty * sigma^2 * ln(n);
+     * 2 corresponds to BIC, larger values tolerate autocorrelated noise.
+     * 
+     * @param series Values in time order
+     * @param min_segment Minimum samples between change points (at least 1)
+     * @param penalty Penalty multiplier per change point
+     * @return Indices where a new segment starts, ascending (empty when the
+     *         series is too short or constant)
+     */
+    std::vector<std::size_t> change_points(const std::vector<double>& series,
+                                           std::size_t min_segment,
+                                           double penalty = 3.0);
+}
+
+#endif // STATISTICS_H
@@ -0,0 +1,117 @@
+/**
+ * suite_config.h - Declarative benchmark suite files
+ *
+ * Parses an INI-style file of named benchmark instances so one process
+ * can run many parameterized configurations back to back.
+ */
+
+#ifndef SUITE_CONFIG_H
+#define SUITE_CONFIG_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "benchmark_registry.h"
+
+/**
+ * Suite Configuration
+ *
+ * Each [section] is one benchmark instance. Reserved keys:
+ *   benchmark    Registered benchmark to run (default: the section name)
+ *   repetitions  Measured runs (default: 1)
+ *   warmup       Discarded runs (default: 0)
+ *   cpu          CPU to pin the run to (default: none)
+ *   order        Lower runs first; equal orders keep file order (default: 0)
+ * Every other key is a parameter of the benchmark. A [defaults] section
+ * supplies values for keys an instance does not set; its parameters only
+ * apply to benchmarks that declare them. Lines starting with '#' or ';'
+ * are comments; values may be double-quoted.
+ *
+ * Example file:
+ *   [defaults]
+ *   repetitions = 5
+ *
+ *   [memory-1m]
+ *   benchmark = memory
+ *   buffer_size = 1048576
+ *   cpu = 2
+ *
+ *   [cpu]
+ *   iterations = 200000
+ *   order = -1
+ *
+ * Example usage:
+ *   SuiteConfig suite;
+ *   std::string error;
+ *   if (SuiteConfig::parse_file("fleet.ini", suite, error) &&
+ *       suite.validate(registry, error)) {
+ *       auto runs = BenchmarkRunner().run_suite(registry, suite, false, nullptr, error);
+ *   }
+ */
+class SuiteConfig {
+public:
+    /**
+     * One named benchmark configuration.
+     */
+    struct Instance {
+        std::string name;                   // Section name (unique)
+        std::string benchmark;              // Registered benchmark name
+        BenchmarkParameters parameters;     // Non-reserved keys set in the section
+        std::size_t repetitions;
+        std::size_t warmup;
+        int cpu;                            // -1 = not pinned
+        int order;
+        std::size_t line;                   // Section header line, for messages
+    };
+
+    /**
+     * Constructs an empty suite.
+     */
+    SuiteConfig() noexcept;
+
+    /**
+     * Parses suite text.
+     *
+     * @param text File contents
+     * @param suite Output parameter for the parsed suite
+     * @param error_message Set with the line number of the first error on failure
+     * @return true on success
+     */
+    static bool parse(const std::string& text, SuiteConfig& suite, std::string& error_message);
+
+    /**
+     * Reads and parses a suite file.
+     *
+     * @param path File path
+     * @param suite Output parameter for the parsed suite
+     * @param error_message Set on read or parse failure (prefixed with the path)
+     * @return true on success
+     */
+    static bool parse_file(const std::string& path, SuiteConfig& suite, std::string& error_message);
+
+    /**
+     * Checks every instance against the registry: the benchmark exists and
+     * declares each parameter.
+     *
+     * @param registry Registry the suite will run against
+     * @param error_message Set for the first invalid instance
+     * @return true if every instance can run
+     */
+    bool validate(const BenchmarkRegistry& registry, std::string& error_message) const;
+
+    /**
+     * Returns the instances in run order.
+     */
+    const std::vector<Instance>& instances() const noexcept;
+
+    /**
+     * Returns the [defaults] parameters; an instance's own values win.
+     */
+    const BenchmarkParameters& default_parameters() const noexcept;
+
+private:
+    std::vector<Instance> instances_;
+    BenchmarkParameters default_parameters_;
+};
+
+#endif // SUITE_CONFIG_H
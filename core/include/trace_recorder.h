@@ -0,0 +1,136 @@
+/**
+ * trace_recorder.h - Low-overhead phase tracing in Chrome trace-event format
+ *
+ * Records begin/end events per thread and writes them as a Chrome
+ * trace-event JSON file that chrome://tracing and Perfetto can open.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * Trace Recorder
+ *
+ * Disabled by default: every call is then a single relaxed atomic load.
+ * Once enabled, each thread appends to its own bounded buffer without
+ * locking (the only lock is taken once per thread, on its first
+ * event). A full buffer drops further events and counts them.
+ *
+ * Names and categories are stored as pointers, so they must outlive the
+ * recorder: pass string literals, or intern() dynamic names first.
+ * write_chrome_trace() must only be called once traced threads have
+ * finished (e.g. after they are joined).
+ *
+ * Example usage:
+ *   TraceRecorder::enable();
+ *   TraceRecorder::set_thread_name("main");
+ *   {
+ *       TraceScope scope("measure", "memory");
+ *       // ... timed work ...
+ *   }
+ *   TraceRecorder::write_chrome_trace(file);
+ */
+class TraceRecorder {
+public:
+    /**
+     * Default events per thread before events are dropped (~1.5 MB at most).
+     */
+    static constexpr std::size_t DEFAULT_EVENTS_PER_THREAD = 65536;
+
+    /**
+     * Starts recording. Timestamps are relative to the first call; later
+     * calls have no effect.
+     *
+     * @param events_per_thread Buffer capacity of each thread
+     */
+    static void enable(std::size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+
+    /**
+     * Returns true once enable() has been called.
+     */
+    static bool enabled() noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records the start of a span on the calling thread.
+     */
+    static void begin(const char* name, const char* category) noexcept;
+
+    /**
+     * Records the end of the innermost open span on the calling thread.
+     */
+    static void end(const char* name, const char* category) noexcept;
+
+    /**
+     * Names the calling thread in the trace viewer.
+     *
+     * @param name Thread name (copied)
+     */
+    static void set_thread_name(const std::string& name) noexcept;
+
+    /**
+     * Returns a pointer to a copy of text that stays valid for the rest
+     * of the process. Identical strings share one copy.
+     *
+     * @param text Dynamic name (e.g., a benchmark or instance name)
+     * @return Stable C string
+     */
+    static const char* intern(const std::string& text);
+
+    /**
+     * Writes every recorded event as a Chrome trace-event JSON object.
+     *
+     * @param out Destination stream
+     * @return false if the stream reported an error
+     */
+    static bool write_chrome_trace(std::ostream& out);
+
+    /**
+     * Returns the number of events dropped because a buffer was full.
+     */
+    static std::uint64_t dropped_events() noexcept;
+
+private:
+    /**
+     * Appends one event to the calling thread's buffer.
+     */
+    static void record(const char* name, const char* category, char phase) noexcept;
+
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * Records a span for the lifetime of the scope (nothing when disabled).
+ */
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category) noexcept
+        : name_(TraceRecorder::enabled() ? name : nullptr),
+          category_(category) {
+        if (name_ != nullptr) {
+            TraceRecorder::begin(name_, category_);
+        }
+    }
+
+    ~TraceScope() {
+        if (name_ != nullptr) {
+            TraceRecorder::end(name_, category_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+};
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,440 @@
+/**
+ * baseline_comparison.cpp - Statistical regression detection implementation
+ */
+
+#include "baseline_comparison.h"
+#include "statistics.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    /**
+     * Appends the numbers of a JSON array as a sample set (skips empty arrays).
+     */
+    void add_sample_array(std::vector<BaselineComparison::SampleSet>& sets,
+                          const std::string& key, const char* unit, bool higher_is_better,
+                          const JsonValue* array, const std::string& parameters) {
+        if (array == nullptr || array->items().empty()) {
+            return;
+        }
+        BaselineComparison::SampleSet set{key, unit, higher_is_better, {}, parameters, true};
+        for (const JsonValue& item : array->items()) {
+            if (item.is_number()) {
+                set.values.push_back(item.as_number());
+            }
+        }
+        if (!set.values.empty()) {
+            sets.push_back(std::move(set));
+        }
+    }
+
+    /**
+     * Formats selected scalar members as "name=value ..." so changed
+     * settings between baseline and current can be reported.
+     */
+    std::string describe_members(const JsonValue& object, std::initializer_list<const char*> names) {
+        std::ostringstream text;
+        for (const char* name : names) {
+            const JsonValue* member = object.find(name);
+            if (member == nullptr) {
+                continue;
+            }
+            text << (text.tellp() > 0 ? " " : "") << name << "=";
+            if (member->is_string()) {
+                text << member->as_string();
+            } else {
+                text << member->as_number();
+            }
+        }
+        return text.str();
+    }
+
+    /**
+     * Adds the round-trip samples of a NetworkBenchmark result object.
+     */
+    void add_round_trips(std::vector<BaselineComparison::SampleSet>& sets,
+                         const std::string& prefix, const JsonValue* network) {
+        if (network == nullptr) {
+            return;
+        }
+        add_sample_array(sets, prefix + ":round_trip_ms", "ms", false,
+                         network->find("round_trip_samples_ms"),
+                         describe_members(*network, {"target_host", "payload_size_bytes",
+                                                     "congestion_control"}));
+    }
+
+    /**
+     * Returns a member's string value, or fallback when absent.
+     */
+    std::string string_member(const JsonValue& object, const char* name, const char* fallback) {
+        const JsonValue* member = object.find(name);
+        if (member == nullptr || member->as_string().empty()) {
+            return fallback;
+        }
+        return member->as_string();
+    }
+
+    /**
+     * Formats a value with enough precision for both ns and ms metrics.
+     */
+    std::string format_value(double value) {
+        std::ostringstream text;
+        double magnitude = std::fabs(value);
+        int precision = magnitude >= 1000.0 ? 0 : (magnitude >= 1.0 ? 3 : 4);
+        text << std::fixed << std::setprecision(precision) << value;
+        return text.str();
+    }
+}
+
+BaselineComparison::BaselineComparison() noexcept
+    : config_() {
+}
+
+BaselineComparison::BaselineComparison(const Config& config) noexcept
+    : config_(config) {
+}
+
+std::vector<BaselineComparison::SampleSet> BaselineComparison::extract_sample_sets(
+    const JsonValue& document
+) {
+    std::vector<SampleSet> sets;
+
+    // Runner repetitions: one sample per repetition and metric
+    if (const JsonValue* runs = document.find("runs")) {
+        for (const JsonValue& run : runs->items()) {
+            // Suite instances of the same benchmark are compared by instance name
+            std::string benchmark_name = string_member(run, "instance_name", "");
+            if (benchmark_name.empty()) {
+                benchmark_name = string_member(run, "benchmark_name", "unnamed");
+            }
+            const JsonValue* summaries = run.find("summaries");
+            const JsonValue* repetitions = run.find("repetitions");
+            if (summaries == nullptr || repetitions == nullptr) {
+                continue;
+            }
+            for (const JsonValue& summary : summaries->items()) {
+                const JsonValue* metric_name = summary.find("name");
+                if (metric_name == nullptr) {
+                    continue;
+                }
+                const JsonValue* higher_is_better = summary.find("higher_is_better");
+                std::string parameters;
+                if (const JsonValue* run_parameters = run.find("parameters")) {
+                    for (const JsonValue::Member& parameter : run_parameters->members()) {
+                        parameters += (parameters.empty() ? "" : " ") + parameter.first + "=" +
+                                      parameter.second.as_string();
+                    }
+                }
+                SampleSet set{benchmark_name + ":" + metric_name->as_string(),
+                              string_member(summary, "unit", ""),
+                              higher_is_better != nullptr && higher_is_better->as_bool(),
+                              {}, parameters, false};
+                for (const JsonValue& repetition : repetitions->items()) {
+                    const JsonValue* successful = repetition.find("benchmark_successful");
+                    const JsonValue* metrics = repetition.find("metrics");
+                    if (successful == nullptr || !successful->as_bool() || metrics == nullptr) {
+                        continue;
+                    }
+                    const JsonValue* value = metrics->find(metric_name->as_string());
+                    if (value != nullptr && value->is_number()) {
+                        set.values.push_back(value->as_number());
+                    }
+                }
+                if (!set.values.empty()) {
+                    sets.push_back(std::move(set));
+                }
+            }
+        }
+    }
+
+    if (const JsonValue* memory = document.find("memory")) {
+        add_sample_array(sets, "memory:latency_ns", "ns", false,
+                         memory->find("latency_samples_ns"),
+                         describe_members(*memory, {"buffer_size_bytes", "iterations"}));
+    }
+
+    if (const JsonValue* network = document.find("network")) {
+        add_round_trips(sets, "network." + string_member(*network, "mode", "unknown"), network);
+    }
+
+    if (const JsonValue* sweep = document.find("payload_sweep")) {
+        for (const JsonValue& point : sweep->items()) {
+            const JsonValue* payload = point.find("payload_size_bytes");
+            std::string payload_text = payload != nullptr
+                ? std::to_string(static_cast<unsigned long long>(payload->as_number()))
+                : std::string("0");
+            add_round_trips(sets, "payload_sweep." + string_member(point, "mode", "unknown") +
+                            "." + payload_text, &point);
+        }
+    }
+
+    if (const JsonValue* comparison = document.find("transport_comparison")) {
+        for (const JsonValue& row : comparison->items()) {
+            const JsonValue* fast_open = row.find("fast_open");
+            std::string prefix = "transport." + string_member(row, "congestion_control", "default") +
+                                 (fast_open != nullptr && fast_open->as_bool() ? "+tfo" : "");
+            add_round_trips(sets, prefix + ".handshake", row.find("handshake"));
+            add_round_trips(sets, prefix + ".rtt", row.find("rtt"));
+        }
+    }
+
+    if (const JsonValue* loaded = document.find("latency_under_load")) {
+        add_round_trips(sets, "latency_under_load.idle", loaded->find("idle"));
+        add_round_trips(sets, "latency_under_load.loaded", loaded->find("loaded"));
+    }
+
+    return sets;
+}
+
+BaselineComparison::Results BaselineComparison::compare(
+    const JsonValue& baseline,
+    const JsonValue& current
+) const {
+    Results results{};
+    results.config = config_;
+    results.regressions = 0;
+    results.improvements = 0;
+    results.comparison_successful = false;
+
+    std::vector<SampleSet> baseline_sets = extract_sample_sets(baseline);
+    std::vector<SampleSet> current_sets = extract_sample_sets(current);
+    if (baseline_sets.empty()) {
+        results.error_message = "Baseline contains no sample sets";
+        return results;
+    }
+
+    for (const SampleSet& base : baseline_sets) {
+        auto match = std::find_if(current_sets.begin(), current_sets.end(),
+                                  [&base](const SampleSet& set) { return set.key == base.key; });
+        if (match == current_sets.end()) {
+            results.missing_in_current.push_back(base.key);
+            continue;
+        }
+
+        MetricComparison metric{};
+        metric.key = base.key;
+        metric.unit = base.unit;
+        metric.higher_is_better = base.higher_is_better;
+        metric.baseline_count = base.values.size();
+        metric.current_count = match->values.size();
+        metric.baseline_median = Statistics::percentile(base.values, 50.0);
+        metric.current_median = Statistics::percentile(match->values, 50.0);
+        if (metric.baseline_median != 0.0) {
+            metric.change_percent = (metric.current_median - metric.baseline_median) /
+                                    std::fabs(metric.baseline_median) * 100.0;
+        }
+        metric.mann_whitney_p = Statistics::mann_whitney_u(match->values, base.values).p_value;
+        metric.welch_p = Statistics::welch_t_test(match->values, base.values).p_value;
+        metric.cliffs_delta = Statistics::cliffs_delta(match->values, base.values);
+        metric.baseline_parameters = base.parameters;
+        metric.current_parameters = match->parameters;
+        metric.within_run = base.within_run;
+
+        if (metric.baseline_count < config_.min_samples || metric.current_count < config_.min_samples) {
+            metric.verdict = Verdict::InsufficientSamples;
+        } else if (metric.mann_whitney_p < config_.alpha &&
+                   std::fabs(metric.change_percent) > config_.threshold_percent) {
+            bool got_worse = metric.higher_is_better ? (metric.change_percent < 0.0)
+                                                     : (metric.change_percent > 0.0);
+            if (metric.within_run && !config_.gate_within_run_samples) {
+                metric.verdict = Verdict::Shifted;
+            } else {
+                metric.verdict = got_worse ? Verdict::Regressed : Verdict::Improved;
+            }
+        } else {
+            metric.verdict = Verdict::Unchanged;
+        }
+
+        if (metric.verdict == Verdict::Regressed) {
+            results.regressions++;
+        } else if (metric.verdict == Verdict::Improved) {
+            results.improvements++;
+        }
+        results.metrics.push_back(std::move(metric));
+    }
+
+    if (results.metrics.empty()) {
+        results.error_message = "No metric of the baseline was measured in this run";
+        return results;
+    }
+    results.comparison_successful = true;
+    return results;
+}
+
+const char* BaselineComparison::verdict_to_string(Verdict verdict) noexcept {
+    switch (verdict) {
+        case Verdict::Unchanged:
+            return "unchanged";
+        case Verdict::Improved:
+            return "improved";
+        case Verdict::Regressed:
+            return "regressed";
+        case Verdict::Shifted:
+            return "shifted";
+        case Verdict::InsufficientSamples:
+            return "insufficient_samples";
+    }
+    return "unknown";
+}
+
+void BaselineComparison::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Baseline Comparison\n";
+    std::cout << "========================================\n";
+    std::cout << "  " << std::left << std::setw(25) << "Significance Level:"
+              << std::fixed << std::setprecision(3) << results.config.alpha
+              << " (" << std::setprecision(1) << (1.0 - results.config.alpha) * 100.0
+              << "% confidence, Mann-Whitney U)\n";
+    std::cout << "  " << std::left << std::setw(25) << "Regression Threshold:"
+              << std::setprecision(1) << results.config.threshold_percent << "% median change\n";
+
+    if (!results.error_message.empty()) {
+        std::cout << "  " << std::left << std::setw(25) << "Error:"
+                  << results.error_message << "\n";
+    }
+
+    if (!results.metrics.empty()) {
+        std::size_t key_width = 6;
+        for (const MetricComparison& metric : results.metrics) {
+            key_width = std::max(key_width, metric.key.size());
+        }
+        key_width += 2;
+        std::size_t table_width = key_width + 12 + 12 + 10 + 10 + 10 + 8 + 17;
+
+        std::cout << "\n";
+        std::cout << "  " << std::string(table_width, '-') << "\n";
+        std::cout << "  " << std::left << std::setw(static_cast<int>(key_width)) << "Metric"
+                  << std::right << std::setw(12) << "Baseline"
+                  << std::right << std::setw(12) << "Current"
+                  << std::right << std::setw(10) << "Change"
+                  << std::right << std::setw(10) << "p (MWU)"
+                  << std::right << std::setw(10) << "p (Welch)"
+                  << std::right << std::setw(8) << "Delta"
+                  << "  " << std::left << "Verdict" << "\n";
+        std::cout << "  " << std::string(table_width, '-') << "\n";
+        for (const MetricComparison& metric : results.metrics) {
+            std::cout << "  " << std::left << std::setw(static_cast<int>(key_width)) << metric.key
+                      << std::right << std::setw(12) << format_value(metric.baseline_median)
+                      << std::right << std::setw(12) << format_value(metric.current_median)
+                      << std::fixed << std::setprecision(1)
+                      << std::right << std::setw(9) << std::showpos << metric.change_percent
+                      << std::noshowpos << "%"
+                      << std::setprecision(4)
+                      << std::right << std::setw(10) << metric.mann_whitney_p
+                      << std::right << std::setw(10) << metric.welch_p
+                      << std::setprecision(2)
+                      << std::right << std::setw(8) << std::showpos << metric.cliffs_delta
+                      << std::noshowpos
+                      << "  " << std::left << verdict_to_string(metric.verdict) << "\n";
+        }
+        std::cout << "  " << std::string(table_width, '-') << "\n";
+        std::cout << "  Baseline and Current are medians in each metric's unit.\n";
+
+        bool header_printed = false;
+        for (const MetricComparison& metric : results.metrics) {
+            if (metric.verdict != Verdict::InsufficientSamples) {
+                continue;
+            }
+            if (!header_printed) {
+                std::cout << "  Too few samples for a verdict (need " << results.config.min_samples
+                          << " per side; use --repetitions for runner metrics):\n";
+                header_printed = true;
+            }
+            std::cout << "    " << metric.key << ": " << metric.baseline_count
+                      << " baseline vs " << metric.current_count << " current\n";
+        }
+    }
+
+    // Identical settings are printed once per distinct change
+    std::vector<std::string> reported_changes;
+    for (const MetricComparison& metric : results.metrics) {
+        if (metric.baseline_parameters == metric.current_parameters) {
+            continue;
+        }
+        std::string change = metric.baseline_parameters + " -> " + metric.current_parameters;
+        if (std::find(reported_changes.begin(), reported_changes.end(), change) != reported_changes.end()) {
+            continue;
+        }
+        reported_changes.push_back(change);
+        std::cout << "  Warning: Settings differ for " << metric.key << "\n";
+        std::cout << "    baseline: " << metric.baseline_parameters << "\n";
+        std::cout << "    current:  " << metric.current_parameters << "\n";
+    }
+
+    for (const std::string& key : results.missing_in_current) {
+        std::cout << "  Not measured in this run: " << key << "\n";
+    }
+
+    std::cout << "\n";
+    if (results.regressions > 0) {
+        std::cout << "Result: " << results.regressions << " significant regression"
+                  << (results.regressions == 1 ? "" : "s") << " detected.\n";
+    } else if (results.comparison_successful) {
+        std::cout << "Result: No significant regressions";
+        if (results.improvements > 0) {
+            std::cout << " (" << results.improvements << " improvement"
+                      << (results.improvements == 1 ? "" : "s") << ")";
+        }
+        std::cout << ".\n";
+    }
+    bool any_shifted = std::any_of(results.metrics.begin(), results.metrics.end(),
+                                   [](const MetricComparison& metric) {
+                                       return metric.verdict == Verdict::Shifted;
+                                   });
+    if (any_shifted) {
+        std::cout << "Note: 'shifted' marks a significant change in samples from a single run.\n";
+        std::cout << "      Those samples are autocorrelated, so the change may be run-to-run noise;\n";
+        std::cout << "      gate on runner metrics instead (--run ... --repetitions 10).\n";
+    }
+    std::cout << "Note: Delta is Cliff's delta of current vs baseline values\n";
+    std::cout << "      (|delta| < 0.15 negligible, < 0.33 small, < 0.47 medium, else large).\n";
+    std::cout << "\n";
+}
+
+void BaselineComparison::write_results(const Results& results, ResultWriter& writer,
+                                       const std::string& name) {
+    writer.begin_object(name);
+    writer.field("alpha", results.config.alpha);
+    writer.field("threshold_percent", results.config.threshold_percent);
+    writer.field("min_samples", results.config.min_samples);
+
+    writer.begin_array("metrics");
+    for (const MetricComparison& metric : results.metrics) {
+        writer.begin_object();
+        writer.field("key", metric.key);
+        writer.field("unit", metric.unit);
+        writer.field("higher_is_better", metric.higher_is_better);
+        writer.field("baseline_count", metric.baseline_count);
+        writer.field("current_count", metric.current_count);
+        writer.field("baseline_median", metric.baseline_median);
+        writer.field("current_median", metric.current_median);
+        writer.field("change_percent", metric.change_percent);
+        writer.field("mann_whitney_p", metric.mann_whitney_p);
+        writer.field("welch_p", metric.welch_p);
+        writer.field("cliffs_delta", metric.cliffs_delta);
+        writer.field("within_run", metric.within_run);
+        writer.field("baseline_parameters", metric.baseline_parameters);
+        writer.field("current_parameters", metric.current_parameters);
+        writer.field("verdict", verdict_to_string(metric.verdict));
+        writer.end_object();
+    }
+    writer.end_array();
+
+    writer.begin_array("missing_in_current");
+    for (const std::string& key : results.missing_in_current) {
+        writer.field("", key);
+    }
+    writer.end_array();
+
+    writer.field("regressions", results.regressions);
+    writer.field("improvements", results.improvements);
+    writer.field("error_message", results.error_message);
+    writer.field("comparison_successful", results.comparison_successful);
+    writer.end_object();
+}
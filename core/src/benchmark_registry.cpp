@@ -0,0 +1,209 @@
+/**
+ * benchmark_registry.cpp - Benchmark interface helpers and registry implementation
+ */
+
+#include "benchmark_registry.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <sstream>
+
+bool Benchmark::get_size(
+    const BenchmarkParameters& parameters,
+    const std::string& name,
+    std::size_t& value,
+    std::string& error_message
+) {
+    auto it = parameters.find(name);
+    if (it == parameters.end() || it->second.empty()) {
+        error_message = "Missing parameter: " + name;
+        return false;
+    }
+    try {
+        std::size_t consumed = 0;
+        unsigned long long parsed = std::stoull(it->second, &consumed);
+        if (consumed != it->second.size() || parsed == 0 || it->second[0] == '-') {
+            error_message = "Parameter " + name + " must be a positive integer: " + it->second;
+            return false;
+        }
+        value = static_cast<std::size_t>(parsed);
+        return true;
+    } catch (const std::exception& e) {
+        error_message = "Invalid value for " + name + ": " + it->second;
+        return false;
+    }
+}
+
+bool Benchmark::get_double(
+    const BenchmarkParameters& parameters,
+    const std::string& name,
+    double& value,
+    std::string& error_message
+) {
+    auto it = parameters.find(name);
+    if (it == parameters.end() || it->second.empty()) {
+        error_message = "Missing parameter: " + name;
+        return false;
+    }
+    try {
+        std::size_t consumed = 0;
+        double parsed = std::stod(it->second, &consumed);
+        if (consumed != it->second.size() || parsed < 0.0) {
+            error_message = "Parameter " + name + " must be a non-negative number: " + it->second;
+            return false;
+        }
+        value = parsed;
+        return true;
+    } catch (const std::exception& e) {
+        error_message = "Invalid value for " + name + ": " + it->second;
+        return false;
+    }
+}
+
+bool Benchmark::get_bool(
+    const BenchmarkParameters& parameters,
+    const std::string& name,
+    bool& value,
+    std::string& error_message
+) {
+    auto it = parameters.find(name);
+    if (it == parameters.end() || it->second.empty()) {
+        error_message = "Missing parameter: " + name;
+        return false;
+    }
+    if (it->second == "1" || it->second == "true") {
+        value = true;
+        return true;
+    }
+    if (it->second == "0" || it->second == "false") {
+        value = false;
+        return true;
+    }
+    error_message = "Parameter " + name + " must be 0, 1, true or false: " + it->second;
+    return false;
+}
+
+BenchmarkResult Benchmark::make_result(const BenchmarkParameters& parameters) const {
+    BenchmarkResult result{};
+    result.benchmark_name = name();
+    result.parameters = parameters;
+    result.benchmark_successful = false;
+    return result;
+}
+
+bool BenchmarkRegistry::add(Factory factory) {
+    std::unique_ptr<Benchmark> prototype = factory();
+    if (!prototype || find(prototype->name()) != nullptr) {
+        return false;
+    }
+
+    Entry entry{prototype->name(), prototype->description(), prototype->parameters(),
+                std::move(factory)};
+    auto position = std::lower_bound(entries_.begin(), entries_.end(), entry.name,
+                                     [](const Entry& existing, const std::string& name) {
+                                         return existing.name < name;
+                                     });
+    entries_.insert(position, std::move(entry));
+    return true;
+}
+
+const std::vector<BenchmarkRegistry::Entry>& BenchmarkRegistry::entries() const noexcept {
+    return entries_;
+}
+
+const BenchmarkRegistry::Entry* BenchmarkRegistry::find(const std::string& name) const noexcept {
+    for (const Entry& entry : entries_) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> BenchmarkRegistry::match(
+    const std::string& patterns,
+    std::vector<std::string>& unmatched
+) const {
+    std::vector<std::string> pattern_list;
+    std::stringstream pattern_stream(patterns);
+    std::string pattern;
+    while (std::getline(pattern_stream, pattern, ',')) {
+        if (!pattern.empty()) {
+            pattern_list.push_back(pattern);
+        }
+    }
+
+    std::vector<bool> pattern_used(pattern_list.size(), false);
+    std::vector<std::string> names;
+    for (const Entry& entry : entries_) {
+        bool selected = false;
+        for (std::size_t i = 0; i < pattern_list.size(); ++i) {
+            if (glob_match(pattern_list[i], entry.name)) {
+                pattern_used[i] = true;
+                selected = true;
+            }
+        }
+        if (selected) {
+            names.push_back(entry.name);
+        }
+    }
+
+    unmatched.clear();
+    for (std::size_t i = 0; i < pattern_list.size(); ++i) {
+        if (!pattern_used[i]) {
+            unmatched.push_back(pattern_list[i]);
+        }
+    }
+    return names;
+}
+
+std::unique_ptr<Benchmark> BenchmarkRegistry::create(const std::string& name) const {
+    const Entry* entry = find(name);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    return entry->factory();
+}
+
+bool BenchmarkRegistry::glob_match(const std::string& pattern, const std::string& text) noexcept {
+    // Iterative matcher: on mismatch, backtrack to the last '*'
+    std::size_t p = 0;
+    std::size_t t = 0;
+    std::size_t star = std::string::npos;
+    std::size_t star_text = 0;
+
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_text = t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++star_text;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+void BenchmarkRegistry::print_list() const {
+    std::cout << "Available Benchmarks:\n";
+    for (const Entry& entry : entries_) {
+        std::cout << "  " << std::left << std::setw(22) << entry.name
+                  << entry.description << "\n";
+        for (const BenchmarkParameter& parameter : entry.parameters) {
+            std::string default_text = parameter.default_value.empty()
+                ? std::string("(none)") : parameter.default_value;
+            std::cout << "    " << std::left << std::setw(20) << parameter.name
+                      << std::left << std::setw(14) << default_text
+                      << parameter.description << "\n";
+        }
+    }
+    std::cout << "\n";
+}
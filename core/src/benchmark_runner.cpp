@@ -0,0 +1,373 @@
+/**
+ * benchmark_runner.cpp - Generic benchmark runner implementation
+ */
+
+#include "benchmark_runner.h"
+#include "statistics.h"
+#include "result_writer.h"
+#include "trace_recorder.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+BenchmarkRunner::BenchmarkRunner() noexcept {
+}
+
+BenchmarkParameters BenchmarkRunner::resolve_parameters(
+    const BenchmarkRegistry::Entry& entry,
+    const BenchmarkParameters& overrides
+) {
+    BenchmarkParameters resolved;
+    for (const BenchmarkParameter& parameter : entry.parameters) {
+        resolved[parameter.name] = parameter.default_value;
+
+        // A benchmark-scoped override wins over a global one
+        auto global = overrides.find(parameter.name);
+        if (global != overrides.end()) {
+            resolved[parameter.name] = global->second;
+        }
+        auto scoped = overrides.find(entry.name + "." + parameter.name);
+        if (scoped != overrides.end()) {
+            resolved[parameter.name] = scoped->second;
+        }
+    }
+    return resolved;
+}
+
+std::vector<BenchmarkRunner::Run> BenchmarkRunner::run(
+    const BenchmarkRegistry& registry,
+    const Config& config,
+    std::string& error_message
+) {
+    std::vector<Run> runs;
+    error_message.clear();
+
+    // Validate inputs
+    if (config.repetitions == 0) {
+        error_message = "Repetitions must be greater than 0";
+        return runs;
+    }
+
+    std::vector<std::string> unmatched;
+    std::vector<std::string> names = registry.match(config.selection, unmatched);
+    if (!unmatched.empty()) {
+        error_message = "No benchmark matches: " + unmatched.front();
+        return runs;
+    }
+    if (names.empty()) {
+        error_message = "No benchmarks selected";
+        return runs;
+    }
+
+    // Every override must name a parameter of at least one selected benchmark
+    for (const auto& override_value : config.overrides) {
+        bool known = false;
+        for (const std::string& name : names) {
+            for (const BenchmarkParameter& parameter : registry.find(name)->parameters) {
+                if (override_value.first == parameter.name ||
+                    override_value.first == name + "." + parameter.name) {
+                    known = true;
+                }
+            }
+        }
+        if (!known) {
+            error_message = "Unknown parameter for the selected benchmarks: " + override_value.first;
+            return runs;
+        }
+    }
+
+    for (const std::string& name : names) {
+        const BenchmarkRegistry::Entry& entry = *registry.find(name);
+        runs.push_back(execute(entry, resolve_parameters(entry, config.overrides),
+                               config.warmup, config.repetitions, config.print_details));
+    }
+
+    return runs;
+}
+
+std::vector<BenchmarkRunner::Run> BenchmarkRunner::run_suite(
+    const BenchmarkRegistry& registry,
+    const SuiteConfig& suite,
+    bool print_details,
+    const CpuPinner& pin_cpu,
+    std::string& error_message
+) {
+    std::vector<Run> runs;
+    error_message.clear();
+
+    if (!suite.validate(registry, error_message)) {
+        return runs;
+    }
+
+    bool pinned = false;
+    for (const SuiteConfig::Instance& instance : suite.instances()) {
+        const BenchmarkRegistry::Entry& entry = *registry.find(instance.benchmark);
+
+        // Defaults first so the instance's own values win
+        BenchmarkParameters overrides = suite.default_parameters();
+        for (const auto& parameter : instance.parameters) {
+            overrides[parameter.first] = parameter.second;
+        }
+
+        // Unpin when a pinned instance is followed by an unpinned one
+        if (pin_cpu && (instance.cpu >= 0 || pinned)) {
+            std::string pin_error;
+            if (!pin_cpu(instance.cpu, pin_error)) {
+                Run run{};
+                run.benchmark_name = instance.benchmark;
+                run.instance_name = instance.name;
+                run.cpu = instance.cpu;
+                run.parameters = resolve_parameters(entry, overrides);
+                run.error_message = "Cannot pin to CPU " + std::to_string(instance.cpu) + ": " + pin_error;
+                run.benchmark_successful = false;
+                runs.push_back(std::move(run));
+                continue;
+            }
+            pinned = (instance.cpu >= 0);
+        }
+
+        Run run = execute(entry, resolve_parameters(entry, overrides), instance.warmup,
+                          instance.repetitions, print_details, instance.name, instance.cpu);
+        runs.push_back(std::move(run));
+    }
+
+    if (pin_cpu && pinned) {
+        std::string pin_error;
+        pin_cpu(-1, pin_error);
+    }
+    return runs;
+}
+
+BenchmarkRunner::Run BenchmarkRunner::execute(
+    const BenchmarkRegistry::Entry& entry,
+    const BenchmarkParameters& parameters,
+    std::size_t warmup,
+    std::size_t repetitions,
+    bool print_details,
+    const std::string& instance_name,
+    int cpu
+) {
+    std::unique_ptr<Benchmark> benchmark = entry.factory();
+
+    Run run{};
+    run.benchmark_name = entry.name;
+    run.instance_name = instance_name;
+    run.cpu = cpu;
+    run.parameters = parameters;
+    run.failed_repetitions = 0;
+    run.benchmark_successful = false;
+
+    std::cout << "Running " << (instance_name.empty() ? entry.name : instance_name + " [" + entry.name + "]");
+    if (cpu >= 0) {
+        std::cout << " on CPU " << cpu;
+    }
+    if (warmup > 0) {
+        std::cout << " (" << warmup << " warmup + " << repetitions << " runs)";
+    } else if (repetitions > 1) {
+        std::cout << " (" << repetitions << " runs)";
+    }
+    std::cout << "...\n" << std::flush;
+
+    TraceScope benchmark_scope(TraceRecorder::enabled()
+                                   ? TraceRecorder::intern(instance_name.empty() ? entry.name : instance_name)
+                                   : "",
+                               "runner");
+
+    for (std::size_t i = 0; i < warmup; ++i) {
+        TraceScope warmup_scope("warmup", "runner");
+        benchmark->run(run.parameters);
+    }
+
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        TraceScope repetition_scope("repetition", "runner");
+        BenchmarkResult result = benchmark->run(run.parameters);
+        if (!result.benchmark_successful) {
+            run.failed_repetitions++;
+            run.error_message = result.error_message;
+        }
+        if (run.primary_metric.empty()) {
+            run.primary_metric = result.primary_metric;
+        }
+        run.repetitions.push_back(std::move(result));
+    }
+
+    if (print_details) {
+        benchmark->print_details();
+    }
+
+    summarize(run);
+    run.benchmark_successful = (run.failed_repetitions == 0);
+    return run;
+}
+
+void BenchmarkRunner::summarize(Run& run) {
+    for (const BenchmarkResult& result : run.repetitions) {
+        if (!result.benchmark_successful) {
+            continue;
+        }
+        for (const BenchmarkMetric& metric : result.metrics) {
+            auto existing = std::find_if(run.summaries.begin(), run.summaries.end(),
+                                         [&metric](const MetricSummary& summary) {
+                                             return summary.name == metric.name;
+                                         });
+            if (existing == run.summaries.end()) {
+                run.summaries.push_back(MetricSummary{metric.name, metric.unit,
+                                                      metric.higher_is_better,
+                                                      0, 0.0, 0.0, 0.0, 0.0, {}});
+            }
+        }
+    }
+
+    for (MetricSummary& summary : run.summaries) {
+        std::vector<double> values;
+        for (const BenchmarkResult& result : run.repetitions) {
+            if (!result.benchmark_successful) {
+                continue;
+            }
+            for (const BenchmarkMetric& metric : result.metrics) {
+                if (metric.name == summary.name) {
+                    values.push_back(metric.value);
+                }
+            }
+        }
+        if (values.empty()) {
+            continue;
+        }
+        summary.count = values.size();
+        summary.mean = Statistics::mean(values);
+        summary.min = *std::min_element(values.begin(), values.end());
+        summary.max = *std::max_element(values.begin(), values.end());
+        summary.std_deviation = Statistics::standard_deviation(values);
+        summary.ci = Statistics::bootstrap_summary(values);
+    }
+}
+
+void BenchmarkRunner::print_summary(const std::vector<Run>& runs) {
+    if (runs.empty()) {
+        return;
+    }
+
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Benchmark Runner Summary\n";
+    std::cout << "========================================\n";
+
+    for (const Run& run : runs) {
+        std::cout << "\n";
+        if (!run.instance_name.empty()) {
+            std::cout << run.instance_name << " [" << run.benchmark_name << "]";
+        } else {
+            std::cout << run.benchmark_name;
+        }
+        std::cout << " (" << run.repetitions.size() << " run"
+                  << (run.repetitions.size() == 1 ? "" : "s");
+        if (run.cpu >= 0) {
+            std::cout << ", CPU " << run.cpu;
+        }
+        if (run.failed_repetitions > 0) {
+            std::cout << ", " << run.failed_repetitions << " failed";
+        }
+        std::cout << "):\n";
+
+        if (!run.parameters.empty()) {
+            std::cout << "  Parameters:";
+            for (const auto& parameter : run.parameters) {
+                std::cout << " " << parameter.first << "=" << parameter.second;
+            }
+            std::cout << "\n";
+        }
+        if (!run.error_message.empty()) {
+            std::cout << "  " << std::left << std::setw(25) << "Error:"
+                      << run.error_message << "\n";
+        }
+        if (run.summaries.empty()) {
+            continue;
+        }
+
+        std::cout << "  " << std::string(124, '-') << "\n";
+        std::cout << "  " << std::left << std::setw(26) << "Metric"
+                  << std::left << std::setw(8) << "Unit"
+                  << std::right << std::setw(15) << "Mean"
+                  << std::right << std::setw(15) << "Min"
+                  << std::right << std::setw(15) << "Max"
+                  << std::right << std::setw(15) << "Std Dev"
+                  << std::right << std::setw(15) << "Mean CI Low"
+                  << std::right << std::setw(15) << "Mean CI High" << "\n";
+        std::cout << "  " << std::string(124, '-') << "\n";
+        for (const MetricSummary& summary : run.summaries) {
+            std::string label = summary.name;
+            if (summary.name == run.primary_metric) {
+                label += " *";
+            }
+            std::cout << "  " << std::left << std::setw(26) << label
+                      << std::left << std::setw(8) << summary.unit
+                      << std::fixed << std::setprecision(3)
+                      << std::right << std::setw(15) << summary.mean
+                      << std::right << std::setw(15) << summary.min
+                      << std::right << std::setw(15) << summary.max
+                      << std::right << std::setw(15) << summary.std_deviation
+                      << std::right << std::setw(15) << summary.ci.mean.lower
+                      << std::right << std::setw(15) << summary.ci.mean.upper << "\n";
+        }
+        std::cout << "  " << std::string(124, '-') << "\n";
+    }
+
+    std::cout << "\n";
+    std::cout << "* Primary metric; mean CI is a 95% BCa bootstrap interval across repetitions\n";
+    std::cout << "\n";
+}
+
+void BenchmarkRunner::write_results(const std::vector<Run>& runs, ResultWriter& writer,
+                                    const std::string& name) {
+    writer.begin_array(name);
+    for (const Run& run : runs) {
+        writer.begin_object();
+        writer.field("benchmark_name", run.benchmark_name);
+        if (!run.instance_name.empty()) {
+            writer.field("instance_name", run.instance_name);
+            writer.field("cpu", run.cpu);
+        }
+        writer.begin_object("parameters");
+        for (const auto& parameter : run.parameters) {
+            writer.field(parameter.first, parameter.second);
+        }
+        writer.end_object();
+        writer.field("primary_metric", run.primary_metric);
+
+        writer.begin_array("summaries");
+        for (const MetricSummary& summary : run.summaries) {
+            writer.begin_object();
+            writer.field("name", summary.name);
+            writer.field("unit", summary.unit);
+            writer.field("higher_is_better", summary.higher_is_better);
+            writer.field("count", summary.count);
+            writer.field("mean", summary.mean);
+            writer.field("min", summary.min);
+            writer.field("max", summary.max);
+            writer.field("std_deviation", summary.std_deviation);
+            writer.confidence_intervals("ci", summary.ci);
+            writer.end_object();
+        }
+        writer.end_array();
+
+        writer.begin_array("repetitions");
+        for (const BenchmarkResult& result : run.repetitions) {
+            writer.begin_object();
+            writer.begin_object("metrics");
+            for (const BenchmarkMetric& metric : result.metrics) {
+                writer.field(metric.name, metric.value);
+            }
+            writer.end_object();
+            writer.field("error_message", result.error_message);
+            writer.field("benchmark_successful", result.benchmark_successful);
+            writer.end_object();
+        }
+        writer.end_array();
+
+        writer.field("failed_repetitions", run.failed_repetitions);
+        writer.field("error_message", run.error_message);
+        writer.field("benchmark_successful", run.benchmark_successful);
+        writer.end_object();
+    }
+    writer.end_array();
+}
@@ -0,0 +1,227 @@
+/**
+ * core_benchmarks.cpp - Registry adapters for the portable benchmark modules
+ */
+
+#include "benchmark_registry.h"
+#include "memory_benchmark.h"
+#include "cpu_benchmark.h"
+#include "cpu_topology.h"
+
+namespace {
+    /**
+     * Default buffer: twice the L2 so the working set leaves the private
+     * caches on any host, or 1 MiB when the topology is unknown.
+     */
+    std::string default_buffer_size() {
+        return CpuTopology::current().cache_size(2) > 0 ? "2xL2" : "1048576";
+    }
+
+    /**
+     * Reads buffer_size as bytes or a cache expression such as "2xL2".
+     */
+    bool get_buffer_size(const BenchmarkParameters& parameters, std::size_t& value, std::string& error_message) {
+        auto it = parameters.find("buffer_size");
+        if (it == parameters.end() || it->second.empty()) {
+            error_message = "Missing parameter: buffer_size";
+            return false;
+        }
+        if (!CpuTopology::current().parse_size(it->second, value, error_message)) {
+            error_message = "Parameter buffer_size: " + error_message;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Converts MemoryBenchmark results into common metrics.
+     */
+    void add_memory_metrics(const MemoryBenchmark::Results& results, BenchmarkResult& result) {
+        result.metrics = {
+            {"avg_latency_ns", results.timing.avg_latency_ns, "ns", false},
+            {"min_latency_ns", results.timing.min_latency_ns, "ns", false},
+            {"max_latency_ns", results.timing.max_latency_ns, "ns", false},
+            {"std_deviation_ns", results.timing.std_deviation_ns, "ns", false},
+            {"median_latency_ns", results.timing.median_latency_ns, "ns", false},
+            {"mad_ns", results.timing.mad_ns, "ns", false},
+            {"trimmed_mean_ns", results.timing.trimmed_mean_ns, "ns", false},
+            {"outliers", static_cast<double>(results.timing.outliers.low_severe + results.timing.outliers.low_mild
+                                             + results.timing.outliers.high_mild + results.timing.outliers.high_severe),
+             "", false},
+            {"throughput_mbps", results.throughput_mbps, "MB/s", true},
+            {"total_time_seconds", results.timing.total_time_seconds, "s", false},
+            {"verification_errors", static_cast<double>(results.verification_errors), "", false},
+        };
+        result.primary_metric = "avg_latency_ns";
+        result.latency_samples_seconds.reserve(results.latency_samples_ns.size());
+        for (double latency_ns : results.latency_samples_ns) {
+            result.latency_samples_seconds.push_back(latency_ns / 1e9);
+        }
+        result.benchmark_successful = results.verification_passed;
+        if (!results.verification_passed) {
+            result.error_message = "Memory verification failed";
+        }
+    }
+
+    class MemoryRegistryBenchmark : public Benchmark {
+    public:
+        std::string name() const override {
+            return "memory";
+        }
+
+        std::string description() const override {
+            return "RAM read-write-read verification latency and throughput";
+        }
+
+        std::vector<BenchmarkParameter> parameters() const override {
+            return {
+                {"buffer_size", default_buffer_size(), "Bytes or cache multiple (2xL2, L3/2)"},
+                {"iterations", "1000", "Read-write-read cycles, or 'auto' to calibrate"},
+                {"target_precision", "1", "Auto iterations: 95% CI half-width in percent of the mean"},
+                {"time_budget", "10", "Auto iterations: measurement time limit in seconds"},
+                {"exclude_outliers", "0", "1 = throughput from cycles inside the Tukey inner fences"},
+            };
+        }
+
+        BenchmarkResult run(const BenchmarkParameters& parameters) override {
+            BenchmarkResult result = make_result(parameters);
+            std::size_t buffer_size = 0;
+            bool exclude_outliers = false;
+            if (!get_buffer_size(parameters, buffer_size, result.error_message) ||
+                !get_bool(parameters, "exclude_outliers", exclude_outliers, result.error_message)) {
+                return result;
+            }
+            benchmark_.set_exclude_outliers(exclude_outliers);
+
+            auto iterations_value = parameters.find("iterations");
+            if (iterations_value != parameters.end() && iterations_value->second == "auto") {
+                MemoryBenchmark::CalibrationConfig config;
+                double target_percent = 0.0;
+                if (!get_double(parameters, "target_precision", target_percent, result.error_message) ||
+                    !get_double(parameters, "time_budget", config.max_seconds, result.error_message)) {
+                    return result;
+                }
+                if (target_percent <= 0.0 || config.max_seconds <= 0.0) {
+                    result.error_message = "target_precision and time_budget must be greater than 0";
+                    return result;
+                }
+                config.target_relative_ci = target_percent / 100.0;
+                last_results_ = benchmark_.run_calibrated(buffer_size, config);
+            } else {
+                std::size_t iterations = 0;
+                if (!get_size(parameters, "iterations", iterations, result.error_message)) {
+                    return result;
+                }
+                last_results_ = benchmark_.run(buffer_size, iterations);
+            }
+            add_memory_metrics(last_results_, result);
+            return result;
+        }
+
+        void print_details() const override {
+            MemoryBenchmark::print_results(last_results_);
+        }
+
+    private:
+        MemoryBenchmark benchmark_;
+        MemoryBenchmark::Results last_results_{};
+    };
+
+    class MemoryContinuousRegistryBenchmark : public Benchmark {
+    public:
+        std::string name() const override {
+            return "memory.continuous";
+        }
+
+        std::string description() const override {
+            return "RAM benchmark repeated for stability (run-to-run variance)";
+        }
+
+        std::vector<BenchmarkParameter> parameters() const override {
+            return {
+                {"buffer_size", default_buffer_size(), "Bytes or cache multiple (2xL2, L3/2)"},
+                {"iterations", "1000", "Read-write-read cycles per run"},
+                {"runs", "10", "Number of runs"},
+                {"exclude_outliers", "0", "1 = throughput from cycles inside the Tukey inner fences"},
+            };
+        }
+
+        BenchmarkResult run(const BenchmarkParameters& parameters) override {
+            BenchmarkResult result = make_result(parameters);
+            std::size_t buffer_size = 0;
+            std::size_t iterations = 0;
+            std::size_t runs = 0;
+            bool exclude_outliers = false;
+            if (!get_buffer_size(parameters, buffer_size, result.error_message) ||
+                !get_size(parameters, "iterations", iterations, result.error_message) ||
+                !get_size(parameters, "runs", runs, result.error_message) ||
+                !get_bool(parameters, "exclude_outliers", exclude_outliers, result.error_message)) {
+                return result;
+            }
+
+            benchmark_.set_exclude_outliers(exclude_outliers);
+            last_results_ = benchmark_.run_continuous(buffer_size, iterations, runs, 0.0);
+            add_memory_metrics(last_results_, result);
+            return result;
+        }
+
+        void print_details() const override {
+            MemoryBenchmark::print_results(last_results_);
+        }
+
+    private:
+        MemoryBenchmark benchmark_;
+        MemoryBenchmark::Results last_results_{};
+    };
+
+    class CpuRegistryBenchmark : public Benchmark {
+    public:
+        std::string name() const override {
+            return "cpu";
+        }
+
+        std::string description() const override {
+            return "Mixed integer, floating-point and memory-bound CPU workload";
+        }
+
+        std::vector<BenchmarkParameter> parameters() const override {
+            return {
+                {"iterations", "100000", "Iterations per workload"},
+            };
+        }
+
+        BenchmarkResult run(const BenchmarkParameters& parameters) override {
+            BenchmarkResult result = make_result(parameters);
+            std::size_t iterations = 0;
+            if (!get_size(parameters, "iterations", iterations, result.error_message)) {
+                return result;
+            }
+
+            last_results_ = benchmark_.run(iterations);
+            result.metrics = {
+                {"time_per_operation_ns", last_results_.timing.time_per_operation_ns, "ns", false},
+                {"operations_per_second", last_results_.timing.operations_per_second, "ops/s", true},
+                {"total_time_seconds", last_results_.timing.total_time_seconds, "s", false},
+            };
+            result.primary_metric = "time_per_operation_ns";
+            result.benchmark_successful = last_results_.benchmark_successful;
+            if (!result.benchmark_successful) {
+                result.error_message = "CPU benchmark failed to complete";
+            }
+            return result;
+        }
+
+        void print_details() const override {
+            CpuBenchmark::print_results(last_results_);
+        }
+
+    private:
+        CpuBenchmark benchmark_;
+        CpuBenchmark::Results last_results_{};
+    };
+}
+
+void register_core_benchmarks(BenchmarkRegistry& registry) {
+    registry.add([]() { return std::make_unique<MemoryRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<MemoryContinuousRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<CpuRegistryBenchmark>(); });
+}
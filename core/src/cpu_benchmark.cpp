@@ -7,11 +7,18 @@
 
 #include "cpu_benchmark.h"
 #include "timer.h"
+#include "result_writer.h"
+#include "trace_recorder.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <cctype>
+
+namespace {
+    constexpr std::size_t MEMORY_WORKLOAD_ELEMENTS = 1024;
+}
 
 CpuBenchmark::CpuBenchmark() noexcept {
 }
@@ -31,10 +38,23 @@ CpuBenchmark::Results CpuBenchmark::run(std::size_t iterations) {
     Timer total_timer;
     total_timer.start();
 
-    // Run different types of CPU workloads
+    // Run different types of CPU workloads, timing each for roofline placement
+    Timer workload_timer;
+    TraceRecorder::begin("integer", "cpu");
+    workload_timer.start();
     std::uint64_t int_result = compute_integer_workload(iterations);
+    double integer_seconds = workload_timer.elapsed_seconds();
+    TraceRecorder::end("integer", "cpu");
+    TraceRecorder::begin("float", "cpu");
+    workload_timer.start();
     double float_result = compute_float_workload(iterations);
+    double float_seconds = workload_timer.elapsed_seconds();
+    TraceRecorder::end("float", "cpu");
+    TraceRecorder::begin("memory", "cpu");
+    workload_timer.start();
     std::uint64_t mem_result = compute_memory_workload(iterations);
+    double memory_seconds = workload_timer.elapsed_seconds();
+    TraceRecorder::end("memory", "cpu");
 
     double elapsed_seconds = total_timer.elapsed_seconds();
 
@@ -51,6 +71,17 @@ CpuBenchmark::Results CpuBenchmark::run(std::size_t iterations) {
     results.timing.operations_per_second = static_cast<double>(iterations * 3) / elapsed_seconds; // 3 workloads
     results.timing.time_per_operation_ns = (elapsed_seconds / static_cast<double>(iterations * 3)) * 1'000'000'000.0;
 
+    // Per iteration: integer = mul, add, mod, shl, shr, or, xor; float = sin,
+    // add, cos, mul, abs, add, sqrt, mul, exp, sub; memory = mul, mod, add,
+    // mul, mod plus one 8-byte load and store within MEMORY_WORKLOAD_ELEMENTS
+    double count = static_cast<double>(iterations);
+    results.workloads = {
+        {"integer", integer_seconds, 7.0 * count, 0.0, 0},
+        {"float", float_seconds, 10.0 * count, 0.0, 0},
+        {"memory", memory_seconds, 5.0 * count, 16.0 * count,
+         MEMORY_WORKLOAD_ELEMENTS * sizeof(std::uint64_t)},
+    };
+
     results.benchmark_successful = true;
 
     return results;
@@ -76,7 +107,7 @@ double CpuBenchmark::compute_float_workload(std::size_t iterations) noexcept {
 }
 
 std::uint64_t CpuBenchmark::compute_memory_workload(std::size_t iterations) noexcept {
-    const std::size_t array_size = 1024;
+    const std::size_t array_size = MEMORY_WORKLOAD_ELEMENTS;
     std::vector<std::uint64_t> data(array_size);
 
     // Initialize with pattern
@@ -118,6 +149,14 @@ void CpuBenchmark::print_results(const Results& results) {
         std::cout << "  " << std::left << std::setw(30) << "Time/Operation:"
                   << std::fixed << std::setprecision(2)
                   << results.timing.time_per_operation_ns << " ns\n";
+
+        for (const WorkloadStats& workload : results.workloads) {
+            std::string label = workload.name + " Workload Time:";
+            label[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(label[0])));
+            std::cout << "  " << std::left << std::setw(30) << label
+                      << std::fixed << std::setprecision(6)
+                      << workload.seconds << " seconds\n";
+        }
     } else {
         std::cout << "Benchmark failed to complete successfully.\n";
     }
@@ -126,4 +165,32 @@ void CpuBenchmark::print_results(const Results& results) {
     std::cout << "Note: CPU benchmarks measure computational throughput and may vary\n";
     std::cout << "      based on CPU frequency scaling, thermal throttling, and system load.\n";
     std::cout << "\n";
-}
\ No newline at end of file
+}
+
+void CpuBenchmark::write_results(const Results& results, ResultWriter& writer,
+                                 const std::string& name) {
+    writer.begin_object(name);
+    writer.field("benchmark_type", results.benchmark_type);
+    writer.field("iterations", results.iterations);
+
+    writer.begin_object("timing");
+    writer.field("total_time_seconds", results.timing.total_time_seconds);
+    writer.field("operations_per_second", results.timing.operations_per_second);
+    writer.field("time_per_operation_ns", results.timing.time_per_operation_ns);
+    writer.end_object();
+
+    writer.begin_array("workloads");
+    for (const WorkloadStats& workload : results.workloads) {
+        writer.begin_object();
+        writer.field("name", workload.name);
+        writer.field("seconds", workload.seconds);
+        writer.field("operations", workload.operations);
+        writer.field("bytes", workload.bytes);
+        writer.field("working_set_bytes", workload.working_set_bytes);
+        writer.end_object();
+    }
+    writer.end_array();
+
+    writer.field("benchmark_successful", results.benchmark_successful);
+    writer.end_object();
+}
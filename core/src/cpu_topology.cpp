@@ -0,0 +1,333 @@
+/**
+ * cpu_topology.cpp - CPU topology model implementation
+ */
+
+#include "cpu_topology.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+namespace {
+    CpuTopology& current_topology() {
+        static CpuTopology topology;
+        return topology;
+    }
+
+    bool is_data_cache(const CpuTopology::Cache& cache) {
+        return cache.type != "Instruction";
+    }
+}
+
+CpuTopology::CpuTopology() noexcept {
+}
+
+void CpuTopology::add_cpu(int cpu, int package, int core_id, int node) {
+    auto core = std::find_if(cores_.begin(), cores_.end(), [&](const Core& candidate) {
+        return candidate.package == package && candidate.id == core_id;
+    });
+    if (core == cores_.end()) {
+        Core new_core{package, core_id, node, {}};
+        core = cores_.insert(std::upper_bound(cores_.begin(), cores_.end(), new_core,
+                                              [](const Core& a, const Core& b) {
+                                                  return a.package != b.package ? a.package < b.package
+                                                                                : a.id < b.id;
+                                              }),
+                             new_core);
+    }
+    if (std::find(core->cpus.begin(), core->cpus.end(), cpu) == core->cpus.end()) {
+        core->cpus.insert(std::upper_bound(core->cpus.begin(), core->cpus.end(), cpu), cpu);
+    }
+}
+
+void CpuTopology::add_cache(const Cache& cache) {
+    Cache sorted = cache;
+    std::sort(sorted.cpus.begin(), sorted.cpus.end());
+    for (const Cache& existing : caches_) {
+        if (existing.level == sorted.level && existing.type == sorted.type && existing.cpus == sorted.cpus) {
+            return;
+        }
+    }
+    caches_.insert(std::upper_bound(caches_.begin(), caches_.end(), sorted,
+                                    [](const Cache& a, const Cache& b) { return a.level < b.level; }),
+                   sorted);
+}
+
+bool CpuTopology::empty() const noexcept {
+    return cores_.empty();
+}
+
+std::vector<int> CpuTopology::cpus() const {
+    std::vector<int> all;
+    for (const Core& core : cores_) {
+        all.insert(all.end(), core.cpus.begin(), core.cpus.end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+const std::vector<CpuTopology::Core>& CpuTopology::cores() const noexcept {
+    return cores_;
+}
+
+const std::vector<CpuTopology::Cache>& CpuTopology::caches() const noexcept {
+    return caches_;
+}
+
+std::vector<CpuTopology::Node> CpuTopology::nodes() const {
+    std::map<int, std::vector<int>> node_cpus;
+    for (const Core& core : cores_) {
+        std::vector<int>& cpus = node_cpus[core.node];
+        cpus.insert(cpus.end(), core.cpus.begin(), core.cpus.end());
+    }
+    std::vector<Node> result;
+    for (auto& entry : node_cpus) {
+        std::sort(entry.second.begin(), entry.second.end());
+        result.push_back(Node{entry.first, entry.second});
+    }
+    return result;
+}
+
+std::size_t CpuTopology::package_count() const {
+    std::vector<int> packages;
+    for (const Core& core : cores_) {
+        if (std::find(packages.begin(), packages.end(), core.package) == packages.end()) {
+            packages.push_back(core.package);
+        }
+    }
+    return packages.size();
+}
+
+std::size_t CpuTopology::cache_size(int level) const noexcept {
+    for (const Cache& cache : caches_) {
+        if (cache.level == level && is_data_cache(cache)) {
+            return cache.size_bytes;
+        }
+    }
+    return 0;
+}
+
+int CpuTopology::last_level() const noexcept {
+    int level = 0;
+    for (const Cache& cache : caches_) {
+        if (is_data_cache(cache)) {
+            level = std::max(level, cache.level);
+        }
+    }
+    return level;
+}
+
+std::vector<int> CpuTopology::smt_siblings(int cpu) const {
+    std::vector<int> siblings;
+    for (const Core& core : cores_) {
+        if (std::find(core.cpus.begin(), core.cpus.end(), cpu) != core.cpus.end()) {
+            for (int sibling : core.cpus) {
+                if (sibling != cpu) {
+                    siblings.push_back(sibling);
+                }
+            }
+            break;
+        }
+    }
+    return siblings;
+}
+
+std::vector<int> CpuTopology::spread_cpus(std::size_t count) const {
+    // Rounds over SMT thread index, then core; within a round, alternate
+    // nodes so memory bandwidth of every node is used
+    std::map<int, std::vector<const Core*>> cores_by_node;
+    std::size_t max_threads = 0;
+    for (const Core& core : cores_) {
+        cores_by_node[core.node].push_back(&core);
+        max_threads = std::max(max_threads, core.cpus.size());
+    }
+
+    std::vector<int> chosen;
+    for (std::size_t thread = 0; thread < max_threads && chosen.size() < count; ++thread) {
+        bool added = true;
+        for (std::size_t index = 0; added && chosen.size() < count; ++index) {
+            added = false;
+            for (const auto& node : cores_by_node) {
+                if (index < node.second.size() && thread < node.second[index]->cpus.size() &&
+                    chosen.size() < count) {
+                    chosen.push_back(node.second[index]->cpus[thread]);
+                    added = true;
+                } else if (index < node.second.size()) {
+                    added = true;   // Core without this SMT thread; keep scanning
+                }
+            }
+        }
+    }
+    return chosen;
+}
+
+bool CpuTopology::parse_size(const std::string& text, std::size_t& bytes, std::string& error_message) const {
+    std::string expression;
+    for (char c : text) {
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            expression += c;
+        }
+    }
+    if (expression.empty()) {
+        error_message = "Empty size";
+        return false;
+    }
+
+    std::string::size_type level_position = expression.find_first_of("Ll");
+    if (level_position == std::string::npos) {
+        if (expression.find_first_not_of("0123456789") != std::string::npos) {
+            error_message = "Invalid size: " + text + " (expected bytes, L2, 2xL2 or L3/2)";
+            return false;
+        }
+        try {
+            unsigned long long value = std::stoull(expression);
+            if (value == 0) {
+                error_message = "Size must be greater than 0: " + text;
+                return false;
+            }
+            bytes = static_cast<std::size_t>(value);
+            return true;
+        } catch (const std::exception& e) {
+            error_message = "Invalid size: " + text;
+            return false;
+        }
+    }
+
+    // [factor x|*] L<level> [/ divisor]
+    double factor = 1.0;
+    if (level_position > 0) {
+        char separator = expression[level_position - 1];
+        std::string factor_text = expression.substr(0, level_position - 1);
+        char* end = nullptr;
+        factor = std::strtod(factor_text.c_str(), &end);
+        if ((separator != 'x' && separator != 'X' && separator != '*') || factor_text.empty() ||
+            *end != '\0' || !(factor > 0.0)) {
+            error_message = "Invalid size: " + text + " (expected bytes, L2, 2xL2 or L3/2)";
+            return false;
+        }
+    }
+    std::string rest = expression.substr(level_position + 1);
+    std::string::size_type slash = rest.find('/');
+    std::string level_text = rest.substr(0, slash);
+    if (level_text.empty() || level_text.find_first_not_of("0123456789") != std::string::npos) {
+        error_message = "Invalid cache level in size: " + text;
+        return false;
+    }
+    if (slash != std::string::npos) {
+        std::string divisor_text = rest.substr(slash + 1);
+        char* end = nullptr;
+        double divisor = std::strtod(divisor_text.c_str(), &end);
+        if (divisor_text.empty() || *end != '\0' || !(divisor > 0.0)) {
+            error_message = "Invalid divisor in size: " + text;
+            return false;
+        }
+        factor /= divisor;
+    }
+
+    int level = std::atoi(level_text.c_str());
+    std::size_t cache_bytes = cache_size(level);
+    if (cache_bytes == 0) {
+        error_message = "L" + level_text + " cache size is unknown on this host: " + text;
+        return false;
+    }
+    bytes = static_cast<std::size_t>(std::llround(factor * static_cast<double>(cache_bytes)));
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    return true;
+}
+
+std::vector<int> CpuTopology::parse_cpulist(const std::string& text) {
+    std::vector<int> cpus;
+    std::istringstream ranges(text);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(),
+                                   [](char c) { return std::isspace(static_cast<unsigned char>(c)); }),
+                    range.end());
+        if (range.empty()) {
+            continue;
+        }
+        std::string::size_type dash = range.find('-');
+        if (range.find_first_not_of("0123456789-") != std::string::npos ||
+            dash == 0 || (dash != std::string::npos && dash + 1 >= range.size())) {
+            return {};
+        }
+        int first = std::atoi(range.c_str());
+        int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::string CpuTopology::format_cpulist(const std::vector<int>& cpus) {
+    std::vector<int> sorted(cpus);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    std::string list;
+    for (std::size_t i = 0; i < sorted.size(); ) {
+        std::size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+            ++j;
+        }
+        list += (list.empty() ? "" : ",") + std::to_string(sorted[i]);
+        if (j > i) {
+            list += "-" + std::to_string(sorted[j]);
+        }
+        i = j + 1;
+    }
+    return list;
+}
+
+void CpuTopology::set_current(const CpuTopology& topology) {
+    current_topology() = topology;
+}
+
+const CpuTopology& CpuTopology::current() noexcept {
+    return current_topology();
+}
+
+void CpuTopology::write_results(const CpuTopology& topology, ResultWriter& writer,
+                                const std::string& name) {
+    writer.begin_object(name);
+    writer.field("packages", topology.package_count());
+    writer.field("cores", topology.cores_.size());
+    writer.field("cpus", format_cpulist(topology.cpus()));
+
+    writer.begin_array("smt_cores");
+    for (const Core& core : topology.cores_) {
+        if (core.cpus.size() > 1) {
+            writer.field("", format_cpulist(core.cpus));
+        }
+    }
+    writer.end_array();
+
+    writer.begin_array("nodes");
+    for (const Node& node : topology.nodes()) {
+        writer.begin_object();
+        writer.field("id", node.id);
+        writer.field("cpus", format_cpulist(node.cpus));
+        writer.end_object();
+    }
+    writer.end_array();
+
+    writer.begin_array("caches");
+    for (const Cache& cache : topology.caches_) {
+        writer.begin_object();
+        writer.field("level", cache.level);
+        writer.field("type", cache.type);
+        writer.field("size_bytes", cache.size_bytes);
+        writer.field("line_bytes", cache.line_bytes);
+        writer.field("cpus", format_cpulist(cache.cpus));
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.end_object();
+}
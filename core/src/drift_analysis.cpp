@@ -0,0 +1,314 @@
+/**
+ * drift_analysis.cpp - Performance drift detection implementation
+ */
+
+#include "drift_analysis.h"
+#include "statistics.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    constexpr double FREQUENCY_CHANGE_THRESHOLD = 0.03;    // Relative change worth reporting
+
+    struct SegmentConditions {
+        double frequency_mhz;
+        double temperature_celsius;
+    };
+
+    /**
+     * Mean frequency and temperature sampled after runs [begin, end).
+     */
+    SegmentConditions segment_conditions(const std::vector<DriftAnalysis::Condition>& conditions,
+                                         std::size_t begin, std::size_t end) {
+        SegmentConditions segment{0.0, 0.0};
+        std::size_t frequency_count = 0;
+        std::size_t temperature_count = 0;
+        for (std::size_t run = begin; run < end; ++run) {
+            const DriftAnalysis::Condition& condition = conditions[run + 1];
+            if (!condition.valid) {
+                continue;
+            }
+            if (condition.frequency_mhz > 0.0) {
+                segment.frequency_mhz += condition.frequency_mhz;
+                frequency_count++;
+            }
+            if (condition.temperature_celsius > 0.0) {
+                segment.temperature_celsius += condition.temperature_celsius;
+                temperature_count++;
+            }
+        }
+        if (frequency_count > 0) {
+            segment.frequency_mhz /= static_cast<double>(frequency_count);
+        }
+        if (temperature_count > 0) {
+            segment.temperature_celsius /= static_cast<double>(temperature_count);
+        }
+        return segment;
+    }
+
+    /**
+     * Counter increase between two samples (0 if either is missing or the
+     * counter went backwards, e.g. after CPU hotplug).
+     */
+    std::uint64_t counter_delta(const DriftAnalysis::Condition& first,
+                                const DriftAnalysis::Condition& last,
+                                std::uint64_t DriftAnalysis::Condition::*counter) {
+        if (!first.valid || !last.valid || last.*counter < first.*counter) {
+            return 0;
+        }
+        return last.*counter - first.*counter;
+    }
+
+    double mean_range(const std::vector<double>& values, std::size_t begin, std::size_t end) {
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            sum += values[i];
+        }
+        return (end > begin) ? sum / static_cast<double>(end - begin) : 0.0;
+    }
+
+    std::string describe(const DriftAnalysis::ChangePoint& change, bool conditions_sampled) {
+        std::ostringstream text;
+        text << "performance " << (change.change_percent < 0.0 ? "dropped " : "rose ")
+             << std::fixed << std::setprecision(0) << std::fabs(change.change_percent)
+             << "% at t=" << std::setprecision(change.time_seconds < 10.0 ? 1 : 0)
+             << change.time_seconds << " s";
+        if (!conditions_sampled) {
+            return text.str();
+        }
+
+        std::vector<std::string> causes;
+        if (change.package_throttle_events > 0) {
+            causes.push_back("package throttling");
+        }
+        if (change.core_throttle_events > 0) {
+            causes.push_back("core throttling");
+        }
+        if (change.frequency_before_mhz > 0.0 && change.frequency_after_mhz > 0.0) {
+            double frequency_change = change.frequency_after_mhz / change.frequency_before_mhz - 1.0;
+            if (std::fabs(frequency_change) >= FREQUENCY_CHANGE_THRESHOLD) {
+                std::ostringstream frequency;
+                frequency << std::fixed << std::setprecision(0)
+                          << "CPU frequency " << (frequency_change < 0.0 ? "falling" : "rising")
+                          << " from " << change.frequency_before_mhz << " to "
+                          << change.frequency_after_mhz << " MHz";
+                causes.push_back(frequency.str());
+            }
+        }
+
+        if (causes.empty()) {
+            text << "; no frequency or throttling change observed";
+        } else {
+            text << " coinciding with " << causes[0];
+            for (std::size_t i = 1; i < causes.size(); ++i) {
+                text << " and " << causes[i];
+            }
+        }
+        return text.str();
+    }
+}
+
+DriftAnalysis::Results DriftAnalysis::analyze(const std::vector<double>& run_start_seconds,
+                                              const std::vector<double>& throughput_mbps,
+                                              const std::vector<Condition>& conditions) {
+    Results results{};
+    results.enabled = true;
+    std::size_t runs = std::min(run_start_seconds.size(), throughput_mbps.size());
+    results.runs = runs;
+    bool have_conditions = (conditions.size() == runs + 1);
+
+    if (have_conditions) {
+        const Condition* first_valid = nullptr;
+        const Condition* last_valid = nullptr;
+        for (const Condition& condition : conditions) {
+            if (!condition.valid) {
+                continue;
+            }
+            if (first_valid == nullptr) {
+                first_valid = &condition;
+            }
+            last_valid = &condition;
+            if (condition.frequency_mhz > 0.0) {
+                results.min_frequency_mhz = (results.min_frequency_mhz > 0.0)
+                    ? std::min(results.min_frequency_mhz, condition.frequency_mhz)
+                    : condition.frequency_mhz;
+            }
+            results.max_frequency_mhz = std::max(results.max_frequency_mhz, condition.frequency_mhz);
+            results.max_temperature_celsius = std::max(results.max_temperature_celsius,
+                                                       condition.temperature_celsius);
+        }
+        if (first_valid != nullptr) {
+            results.conditions_sampled = true;
+            results.package_throttle_events = counter_delta(*first_valid, *last_valid,
+                                                            &Condition::package_throttle_count);
+            results.core_throttle_events = counter_delta(*first_valid, *last_valid,
+                                                         &Condition::core_throttle_count);
+        }
+    }
+
+    // Average runs into blocks so detection stays near O(MAX_POINTS^2)
+    std::size_t block = std::max<std::size_t>(1, (runs + MAX_POINTS - 1) / MAX_POINTS);
+    std::vector<double> block_means;
+    for (std::size_t begin = 0; begin < runs; begin += block) {
+        block_means.push_back(mean_range(throughput_mbps, begin, std::min(runs, begin + block)));
+    }
+
+    std::vector<std::size_t> boundaries{0};
+    for (std::size_t change : Statistics::change_points(block_means, MIN_SEGMENT)) {
+        boundaries.push_back(change * block);
+    }
+    boundaries.push_back(runs);
+
+    // Merge shifts too small to matter, smallest first; a step inside a
+    // block otherwise shows up as a short intermediate segment
+    while (boundaries.size() > 2) {
+        std::size_t smallest = 0;
+        double smallest_change = MIN_CHANGE_PERCENT;
+        for (std::size_t i = 1; i + 1 < boundaries.size(); ++i) {
+            double before = mean_range(throughput_mbps, boundaries[i - 1], boundaries[i]);
+            double after = mean_range(throughput_mbps, boundaries[i], boundaries[i + 1]);
+            double change = (before > 0.0) ? std::fabs(after / before - 1.0) * 100.0 : 0.0;
+            if (change < smallest_change) {
+                smallest = i;
+                smallest_change = change;
+            }
+        }
+        if (smallest == 0) {
+            break;
+        }
+        boundaries.erase(boundaries.begin() + static_cast<std::ptrdiff_t>(smallest));
+    }
+
+    // Locate each change to the run within its block; prefix sums keep
+    // each candidate split O(1)
+    std::vector<double> sums(runs + 1, 0.0);
+    std::vector<double> squares(runs + 1, 0.0);
+    for (std::size_t run = 0; run < runs; ++run) {
+        sums[run + 1] = sums[run] + throughput_mbps[run];
+        squares[run + 1] = squares[run] + throughput_mbps[run] * throughput_mbps[run];
+    }
+    auto squared_error = [&](std::size_t begin, std::size_t end) {
+        double sum = sums[end] - sums[begin];
+        return squares[end] - squares[begin] - sum * sum / static_cast<double>(end - begin);
+    };
+    for (std::size_t i = 1; i + 1 < boundaries.size() && block > 1; ++i) {
+        std::size_t begin = boundaries[i - 1];
+        std::size_t end = boundaries[i + 1];
+        std::size_t first = std::max(begin + 1, (boundaries[i] > block) ? boundaries[i] - block : 0);
+        std::size_t last = std::min(end - 1, boundaries[i] + block);
+        double best_cost = -1.0;
+        for (std::size_t split = first; split <= last; ++split) {
+            double cost = squared_error(begin, split) + squared_error(split, end);
+            if (best_cost < 0.0 || cost < best_cost) {
+                best_cost = cost;
+                boundaries[i] = split;
+            }
+        }
+    }
+
+    std::size_t window = MIN_SEGMENT * block;
+    for (std::size_t i = 1; i + 1 < boundaries.size(); ++i) {
+        std::size_t begin = boundaries[i - 1];
+        std::size_t run = boundaries[i];
+        std::size_t end = boundaries[i + 1];
+
+        ChangePoint change{};
+        change.run_index = run;
+        change.time_seconds = run_start_seconds[run];
+        change.throughput_before_mbps = mean_range(throughput_mbps, begin, run);
+        change.throughput_after_mbps = mean_range(throughput_mbps, run, end);
+        if (change.throughput_before_mbps > 0.0) {
+            change.change_percent = (change.throughput_after_mbps / change.throughput_before_mbps - 1.0) * 100.0;
+        }
+
+        if (results.conditions_sampled) {
+            SegmentConditions before = segment_conditions(conditions, begin, run);
+            SegmentConditions after = segment_conditions(conditions, run, end);
+            change.frequency_before_mhz = before.frequency_mhz;
+            change.frequency_after_mhz = after.frequency_mhz;
+            change.temperature_before_celsius = before.temperature_celsius;
+            change.temperature_after_celsius = after.temperature_celsius;
+
+            // Throttling shortly before the shift counts as its cause too
+            const Condition& window_start = conditions[(run > window) ? run - window : 0];
+            const Condition& window_end = conditions[std::min(runs, run + window)];
+            change.package_throttle_events = counter_delta(window_start, window_end,
+                                                           &Condition::package_throttle_count);
+            change.core_throttle_events = counter_delta(window_start, window_end,
+                                                        &Condition::core_throttle_count);
+        }
+        change.description = describe(change, results.conditions_sampled);
+        results.change_points.push_back(change);
+    }
+    return results;
+}
+
+void DriftAnalysis::print_results(const Results& results) {
+    std::cout << "Drift Analysis:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Runs Analyzed:" << results.runs << "\n";
+    if (results.conditions_sampled) {
+        if (results.max_frequency_mhz > 0.0) {
+            std::cout << "  " << std::left << std::setw(25) << "CPU Frequency:"
+                      << std::fixed << std::setprecision(0)
+                      << results.min_frequency_mhz << " - " << results.max_frequency_mhz << " MHz\n";
+        }
+        if (results.max_temperature_celsius > 0.0) {
+            std::cout << "  " << std::left << std::setw(25) << "Max Temperature:"
+                      << std::fixed << std::setprecision(1)
+                      << results.max_temperature_celsius << " C\n";
+        }
+        std::cout << "  " << std::left << std::setw(25) << "Throttle Events:"
+                  << "package " << results.package_throttle_events
+                  << ", core " << results.core_throttle_events << "\n";
+    } else {
+        std::cout << "  " << std::left << std::setw(25) << "Host Conditions:"
+                  << "not sampled\n";
+    }
+
+    if (results.change_points.empty()) {
+        std::cout << "  " << std::left << std::setw(25) << "Change Points:"
+                  << "none (throughput stable)\n";
+    } else {
+        std::cout << "  " << std::left << std::setw(25) << "Change Points:"
+                  << results.change_points.size() << "\n";
+        for (const ChangePoint& change : results.change_points) {
+            std::cout << "    - " << change.description << "\n";
+        }
+    }
+    std::cout << "\n";
+}
+
+void DriftAnalysis::write_results(const Results& results, ResultWriter& writer,
+                                  const std::string& name) {
+    writer.begin_object(name);
+    writer.field("runs", results.runs);
+    writer.field("conditions_sampled", results.conditions_sampled);
+    writer.field("min_frequency_mhz", results.min_frequency_mhz);
+    writer.field("max_frequency_mhz", results.max_frequency_mhz);
+    writer.field("max_temperature_celsius", results.max_temperature_celsius);
+    writer.field("package_throttle_events", results.package_throttle_events);
+    writer.field("core_throttle_events", results.core_throttle_events);
+    writer.begin_array("change_points");
+    for (const ChangePoint& change : results.change_points) {
+        writer.begin_object();
+        writer.field("run_index", change.run_index);
+        writer.field("time_seconds", change.time_seconds);
+        writer.field("throughput_before_mbps", change.throughput_before_mbps);
+        writer.field("throughput_after_mbps", change.throughput_after_mbps);
+        writer.field("change_percent", change.change_percent);
+        writer.field("frequency_before_mhz", change.frequency_before_mhz);
+        writer.field("frequency_after_mhz", change.frequency_after_mhz);
+        writer.field("temperature_before_celsius", change.temperature_before_celsius);
+        writer.field("temperature_after_celsius", change.temperature_after_celsius);
+        writer.field("package_throttle_events", change.package_throttle_events);
+        writer.field("core_throttle_events", change.core_throttle_events);
+        writer.field("description", change.description);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.end_object();
+}
@@ -0,0 +1,276 @@
+/**
+ * fleet_report.cpp - Fleet aggregation and outlier screening implementation
+ */
+
+#include "fleet_report.h"
+#include "statistics.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    constexpr double MAD_TO_Z = 0.6745;            // Iglewicz-Hoaglin modified z-score
+    constexpr std::size_t PRINTED_OUTLIERS = 10;   // Per instance; JSON has all of them
+
+    std::string string_member(const JsonValue& object, const char* name) {
+        const JsonValue* value = object.find(name);
+        return value != nullptr ? value->as_string() : std::string();
+    }
+}
+
+FleetReport::Node FleetReport::parse_node(const std::string& address, const JsonValue& document) {
+    Node node{};
+    node.address = address;
+    node.name = string_member(document, "node");
+    if (node.name.empty()) {
+        node.name = address;
+    }
+    const JsonValue* offset = document.find("start_offset_ms");
+    node.start_offset_ms = offset != nullptr ? offset->as_number() : 0.0;
+    node.benchmark_successful = true;
+
+    const JsonValue* runs = document.find("runs");
+    if (runs == nullptr || !runs->is_array() || runs->items().empty()) {
+        node.benchmark_successful = false;
+        node.error_message = "Result document has no runs";
+        return node;
+    }
+    for (const JsonValue& run : runs->items()) {
+        NodeMetric metric{};
+        metric.benchmark = string_member(run, "benchmark_name");
+        metric.instance = string_member(run, "instance_name");
+        if (metric.instance.empty()) {
+            metric.instance = metric.benchmark;
+        }
+        const JsonValue* successful = run.find("benchmark_successful");
+        if (successful == nullptr || !successful->as_bool()) {
+            if (node.benchmark_successful) {
+                node.error_message = metric.instance + ": " + string_member(run, "error_message");
+            }
+            node.benchmark_successful = false;
+            continue;
+        }
+        metric.metric = string_member(run, "primary_metric");
+        const JsonValue* summaries = run.find("summaries");
+        if (summaries == nullptr) {
+            continue;
+        }
+        for (const JsonValue& summary : summaries->items()) {
+            if (string_member(summary, "name") == metric.metric) {
+                const JsonValue* higher_is_better = summary.find("higher_is_better");
+                const JsonValue* mean = summary.find("mean");
+                metric.unit = string_member(summary, "unit");
+                metric.higher_is_better = higher_is_better != nullptr && higher_is_better->as_bool();
+                metric.value = mean != nullptr ? mean->as_number() : 0.0;
+                node.metrics.push_back(metric);
+                break;
+            }
+        }
+    }
+    return node;
+}
+
+void FleetReport::aggregate(Results& results, const Config& config) {
+    results.aggregates.clear();
+    results.failed_nodes = 0;
+    results.max_start_offset_ms = 0.0;
+
+    // Instances in first-seen order; values in node order
+    std::vector<std::vector<std::pair<std::string, double>>> values;
+    for (const Node& node : results.nodes) {
+        if (!node.benchmark_successful) {
+            ++results.failed_nodes;
+        }
+        if (!node.metrics.empty()) {
+            results.max_start_offset_ms = std::max(results.max_start_offset_ms, std::fabs(node.start_offset_ms));
+        }
+        for (const NodeMetric& metric : node.metrics) {
+            auto aggregate = std::find_if(results.aggregates.begin(), results.aggregates.end(),
+                                          [&metric](const Aggregate& candidate) {
+                                              return candidate.instance == metric.instance &&
+                                                     candidate.metric == metric.metric;
+                                          });
+            if (aggregate == results.aggregates.end()) {
+                Aggregate new_aggregate{};
+                new_aggregate.instance = metric.instance;
+                new_aggregate.benchmark = metric.benchmark;
+                new_aggregate.metric = metric.metric;
+                new_aggregate.unit = metric.unit;
+                new_aggregate.higher_is_better = metric.higher_is_better;
+                results.aggregates.push_back(new_aggregate);
+                values.emplace_back();
+                aggregate = results.aggregates.end() - 1;
+            }
+            values[static_cast<std::size_t>(aggregate - results.aggregates.begin())]
+                .emplace_back(node.name, metric.value);
+        }
+    }
+
+    for (std::size_t i = 0; i < results.aggregates.size(); ++i) {
+        Aggregate& aggregate = results.aggregates[i];
+        std::vector<double> sorted;
+        for (const auto& value : values[i]) {
+            sorted.push_back(value.second);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        aggregate.nodes = sorted.size();
+        aggregate.mean = Statistics::mean(sorted);
+        aggregate.median = Statistics::percentile_sorted(sorted, 50.0);
+        aggregate.min = sorted.front();
+        aggregate.max = sorted.back();
+        aggregate.p05 = Statistics::percentile_sorted(sorted, 5.0);
+        aggregate.p95 = Statistics::percentile_sorted(sorted, 95.0);
+        aggregate.mad = Statistics::median_absolute_deviation_sorted(sorted);
+
+        if (aggregate.nodes < config.min_nodes || aggregate.median == 0.0) {
+            continue;
+        }
+        for (const auto& value : values[i]) {
+            double deviation = value.second - aggregate.median;
+            Outlier outlier{};
+            outlier.node = value.first;
+            outlier.value = value.second;
+            outlier.deviation_percent = deviation / std::fabs(aggregate.median) * 100.0;
+            outlier.robust_z = aggregate.mad > 0.0 ? MAD_TO_Z * deviation / aggregate.mad : 0.0;
+            outlier.worse = aggregate.higher_is_better ? deviation < 0.0 : deviation > 0.0;
+            if (std::fabs(outlier.deviation_percent) >= config.min_deviation_percent &&
+                (aggregate.mad == 0.0 || std::fabs(outlier.robust_z) > config.outlier_threshold)) {
+                aggregate.outliers.push_back(outlier);
+            }
+        }
+        std::sort(aggregate.outliers.begin(), aggregate.outliers.end(), [](const Outlier& a, const Outlier& b) {
+            return std::fabs(a.deviation_percent) > std::fabs(b.deviation_percent);
+        });
+    }
+
+    results.benchmark_successful = results.error_message.empty() && !results.nodes.empty() &&
+                                   results.failed_nodes == 0;
+    if (!results.benchmark_successful && results.error_message.empty()) {
+        results.error_message = results.nodes.empty()
+            ? "No nodes"
+            : std::to_string(results.failed_nodes) + " of " + std::to_string(results.nodes.size()) +
+              " nodes failed";
+    }
+}
+
+void FleetReport::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Fleet Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    std::cout << "  " << std::left << std::setw(25) << "Nodes:"
+              << (results.nodes.size() - results.failed_nodes) << " of " << results.nodes.size()
+              << " succeeded\n";
+    std::cout << "  " << std::left << std::setw(25) << "Start Skew (max):"
+              << std::fixed << std::setprecision(1) << results.max_start_offset_ms << " ms\n";
+    std::cout << "\n";
+
+    for (const Aggregate& aggregate : results.aggregates) {
+        std::cout << aggregate.instance << " (" << aggregate.metric << ", " << aggregate.unit << ", "
+                  << (aggregate.higher_is_better ? "higher" : "lower") << " is better) over "
+                  << aggregate.nodes << " nodes:\n";
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  " << std::left << std::setw(25) << "Median:" << aggregate.median << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "Mean:" << aggregate.mean << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "Min / Max:"
+                  << aggregate.min << " / " << aggregate.max << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "P5 / P95:"
+                  << aggregate.p05 << " / " << aggregate.p95 << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "MAD:" << aggregate.mad << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "Outliers:" << aggregate.outliers.size() << "\n";
+        for (std::size_t i = 0; i < aggregate.outliers.size() && i < PRINTED_OUTLIERS; ++i) {
+            const Outlier& outlier = aggregate.outliers[i];
+            std::cout << "    " << std::left << std::setw(23) << (outlier.node + ":")
+                      << std::setprecision(2) << outlier.value << " " << aggregate.unit << " ("
+                      << std::showpos << std::setprecision(1) << outlier.deviation_percent << std::noshowpos
+                      << "% vs median, " << (outlier.worse ? "worse" : "better") << ")\n";
+        }
+        if (aggregate.outliers.size() > PRINTED_OUTLIERS) {
+            std::cout << "    ... and " << (aggregate.outliers.size() - PRINTED_OUTLIERS) << " more\n";
+        }
+        std::cout << "\n";
+    }
+
+    if (results.failed_nodes > 0) {
+        std::cout << "Failed Nodes:\n";
+        for (const Node& node : results.nodes) {
+            if (!node.benchmark_successful) {
+                std::cout << "  " << std::left << std::setw(25) << (node.address + ":")
+                          << node.error_message << "\n";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    if (!results.benchmark_successful) {
+        std::cout << "Error: " << results.error_message << "\n\n";
+    }
+}
+
+void FleetReport::write_results(const Results& results, ResultWriter& writer, const std::string& name) {
+    writer.begin_object(name);
+    writer.field("node_count", results.nodes.size());
+    writer.field("failed_nodes", results.failed_nodes);
+    writer.field("max_start_offset_ms", results.max_start_offset_ms);
+    writer.begin_array("aggregates");
+    for (const Aggregate& aggregate : results.aggregates) {
+        writer.begin_object();
+        writer.field("instance", aggregate.instance);
+        writer.field("benchmark", aggregate.benchmark);
+        writer.field("metric", aggregate.metric);
+        writer.field("unit", aggregate.unit);
+        writer.field("higher_is_better", aggregate.higher_is_better);
+        writer.field("nodes", aggregate.nodes);
+        writer.field("mean", aggregate.mean);
+        writer.field("median", aggregate.median);
+        writer.field("min", aggregate.min);
+        writer.field("max", aggregate.max);
+        writer.field("p05", aggregate.p05);
+        writer.field("p95", aggregate.p95);
+        writer.field("mad", aggregate.mad);
+        writer.begin_array("outliers");
+        for (const Outlier& outlier : aggregate.outliers) {
+            writer.begin_object();
+            writer.field("node", outlier.node);
+            writer.field("value", outlier.value);
+            writer.field("deviation_percent", outlier.deviation_percent);
+            writer.field("robust_z", outlier.robust_z);
+            writer.field("worse", outlier.worse);
+            writer.end_object();
+        }
+        writer.end_array();
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.begin_array("nodes");
+    for (const Node& node : results.nodes) {
+        writer.begin_object();
+        writer.field("name", node.name);
+        writer.field("address", node.address);
+        writer.field("start_offset_ms", node.start_offset_ms);
+        writer.begin_array("metrics");
+        for (const NodeMetric& metric : node.metrics) {
+            writer.begin_object();
+            writer.field("instance", metric.instance);
+            writer.field("metric", metric.metric);
+            writer.field("value", metric.value);
+            writer.end_object();
+        }
+        writer.end_array();
+        writer.field("benchmark_successful", node.benchmark_successful);
+        if (!node.benchmark_successful) {
+            writer.field("error_message", node.error_message);
+        }
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.field("benchmark_successful", results.benchmark_successful);
+    if (!results.benchmark_successful) {
+        writer.field("error_message", results.error_message);
+    }
+    writer.end_object();
+}
@@ -0,0 +1,151 @@
+/**
+ * interval_telemetry.cpp - Live per-interval metrics implementation
+ */
+
+#include "interval_telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace {
+    // Re-read the clock after this fraction of an interval of recorded latency
+    constexpr double CHECK_FRACTION = 0.01;
+}
+
+IntervalTelemetry::IntervalTelemetry(std::ostream& stream, const char* source,
+                                     double interval_seconds) noexcept
+    : stream_(stream),
+      source_(source),
+      interval_seconds_(interval_seconds > 0.0 ? interval_seconds : 1.0),
+      interval_start_seconds_(0.0),
+      latency_since_check_ns_(0.0),
+      intervals_written_(0),
+      counts_{},
+      cycles_(0),
+      bytes_(0),
+      errors_(0),
+      latency_sum_ns_(0.0),
+      min_latency_ns_(0.0),
+      max_latency_ns_(0.0) {
+}
+
+void IntervalTelemetry::start() noexcept {
+    std::fill(std::begin(counts_), std::end(counts_), 0);
+    cycles_ = 0;
+    bytes_ = 0;
+    errors_ = 0;
+    latency_sum_ns_ = 0.0;
+    latency_since_check_ns_ = 0.0;
+    intervals_written_ = 0;
+    interval_start_seconds_ = 0.0;
+    timer_.start();
+}
+
+void IntervalTelemetry::record(double latency_ns, std::size_t bytes, std::size_t errors) {
+    if (cycles_ == 0) {
+        min_latency_ns_ = latency_ns;
+        max_latency_ns_ = latency_ns;
+    } else {
+        min_latency_ns_ = std::min(min_latency_ns_, latency_ns);
+        max_latency_ns_ = std::max(max_latency_ns_, latency_ns);
+    }
+    counts_[bucket_index(latency_ns)]++;
+    cycles_++;
+    bytes_ += bytes;
+    errors_ += errors;
+    latency_sum_ns_ += latency_ns;
+
+    // Recorded latency approximates wall time, so the clock is read a
+    // bounded number of times per interval whatever the operation length
+    latency_since_check_ns_ += latency_ns;
+    if (latency_since_check_ns_ < interval_seconds_ * 1e9 * CHECK_FRACTION) {
+        return;
+    }
+    latency_since_check_ns_ = 0.0;
+    double now = timer_.elapsed_seconds();
+    if (now - interval_start_seconds_ >= interval_seconds_) {
+        emit(now);
+    }
+}
+
+void IntervalTelemetry::finish() {
+    if (cycles_ > 0) {
+        emit(timer_.elapsed_seconds());
+    }
+}
+
+std::size_t IntervalTelemetry::intervals_written() const noexcept {
+    return intervals_written_;
+}
+
+int IntervalTelemetry::bucket_index(double latency_ns) noexcept {
+    if (!(latency_ns >= 1.0)) {
+        return 0;
+    }
+    int exponent = 0;
+    double mantissa = std::frexp(latency_ns, &exponent);   // latency = mantissa * 2^exponent, mantissa in [0.5, 1)
+    int octave = exponent - 1;
+    if (octave >= OCTAVES) {
+        return BUCKET_COUNT - 1;
+    }
+    int sub_bucket = static_cast<int>((mantissa * 2.0 - 1.0) * SUB_BUCKETS);
+    return octave * SUB_BUCKETS + std::min(sub_bucket, SUB_BUCKETS - 1);
+}
+
+double IntervalTelemetry::bucket_midpoint(int index) noexcept {
+    int octave = index / SUB_BUCKETS;
+    int sub_bucket = index % SUB_BUCKETS;
+    double octave_base = std::ldexp(1.0, octave);
+    double width = octave_base / SUB_BUCKETS;
+    return octave_base + width * (static_cast<double>(sub_bucket) + 0.5);
+}
+
+double IntervalTelemetry::interval_percentile(double pct) const noexcept {
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(cycles_)));
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += counts_[i];
+        if (cumulative >= rank) {
+            // The exact extremes are known; keep estimates inside them
+            return std::min(std::max(bucket_midpoint(i), min_latency_ns_), max_latency_ns_);
+        }
+    }
+    return max_latency_ns_;
+}
+
+void IntervalTelemetry::emit(double now_seconds) {
+    double duration = now_seconds - interval_start_seconds_;
+    double throughput_mbps = duration > 0.0
+        ? (static_cast<double>(bytes_) / duration) / (1024.0 * 1024.0)
+        : 0.0;
+    double mean = cycles_ > 0 ? latency_sum_ns_ / static_cast<double>(cycles_) : 0.0;
+
+    std::ios_base::fmtflags flags = stream_.flags();
+    std::streamsize precision = stream_.precision();
+    stream_ << std::fixed << std::setprecision(3)
+            << "{\"source\":\"" << source_ << "\""
+            << ",\"interval\":" << intervals_written_
+            << ",\"elapsed_s\":" << now_seconds
+            << ",\"duration_s\":" << duration
+            << ",\"cycles\":" << cycles_
+            << ",\"throughput_mbps\":" << throughput_mbps
+            << ",\"errors\":" << errors_
+            << ",\"latency_ns\":{\"min\":" << min_latency_ns_
+            << ",\"mean\":" << mean
+            << ",\"p50\":" << interval_percentile(50.0)
+            << ",\"p90\":" << interval_percentile(90.0)
+            << ",\"p99\":" << interval_percentile(99.0)
+            << ",\"max\":" << max_latency_ns_ << "}}\n"
+            << std::flush;
+    stream_.flags(flags);
+    stream_.precision(precision);
+
+    intervals_written_++;
+    interval_start_seconds_ = now_seconds;
+    std::fill(std::begin(counts_), std::end(counts_), 0);
+    cycles_ = 0;
+    bytes_ = 0;
+    errors_ = 0;
+    latency_sum_ns_ = 0.0;
+}
@@ -0,0 +1,403 @@
+/**
+ * json_value.cpp - Minimal JSON document reader implementation
+ */
+
+#include "json_value.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    constexpr std::size_t MAX_NESTING_DEPTH = 256;
+}
+
+/**
+ * Recursive-descent parser over the document text.
+ */
+class JsonValue::Parser {
+public:
+    explicit Parser(const std::string& text) noexcept
+        : text_(text),
+          position_(0) {
+    }
+
+    bool parse_document(JsonValue& value, std::string& error_message) {
+        skip_whitespace();
+        if (!parse_value(value, 0)) {
+            error_message = error_ + " at offset " + std::to_string(position_);
+            return false;
+        }
+        skip_whitespace();
+        if (position_ != text_.size()) {
+            error_message = "Unexpected trailing data at offset " + std::to_string(position_);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool parse_value(JsonValue& value, std::size_t depth) {
+        if (depth > MAX_NESTING_DEPTH) {
+            return fail("Document nested too deeply");
+        }
+        if (position_ >= text_.size()) {
+            return fail("Unexpected end of document");
+        }
+
+        char c = text_[position_];
+        if (c == '{') {
+            return parse_object(value, depth);
+        }
+        if (c == '[') {
+            return parse_array(value, depth);
+        }
+        if (c == '"') {
+            value.type_ = Type::String;
+            return parse_string(value.string_value_);
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            return parse_number(value);
+        }
+        if (consume_literal("true")) {
+            value.type_ = Type::Boolean;
+            value.bool_value_ = true;
+            return true;
+        }
+        if (consume_literal("false")) {
+            value.type_ = Type::Boolean;
+            value.bool_value_ = false;
+            return true;
+        }
+        if (consume_literal("null")) {
+            value.type_ = Type::Null;
+            return true;
+        }
+        return fail("Unexpected character");
+    }
+
+    bool parse_object(JsonValue& value, std::size_t depth) {
+        value.type_ = Type::Object;
+        ++position_;  // '{'
+        skip_whitespace();
+        if (peek() == '}') {
+            ++position_;
+            return true;
+        }
+
+        while (true) {
+            skip_whitespace();
+            if (peek() != '"') {
+                return fail("Expected member name");
+            }
+            Member member;
+            if (!parse_string(member.first)) {
+                return false;
+            }
+            skip_whitespace();
+            if (peek() != ':') {
+                return fail("Expected ':'");
+            }
+            ++position_;
+            skip_whitespace();
+            if (!parse_value(member.second, depth + 1)) {
+                return false;
+            }
+            value.members_.push_back(std::move(member));
+
+            skip_whitespace();
+            if (peek() == ',') {
+                ++position_;
+            } else if (peek() == '}') {
+                ++position_;
+                return true;
+            } else {
+                return fail("Expected ',' or '}'");
+            }
+        }
+    }
+
+    bool parse_array(JsonValue& value, std::size_t depth) {
+        value.type_ = Type::Array;
+        ++position_;  // '['
+        skip_whitespace();
+        if (peek() == ']') {
+            ++position_;
+            return true;
+        }
+
+        while (true) {
+            skip_whitespace();
+            JsonValue item;
+            if (!parse_value(item, depth + 1)) {
+                return false;
+            }
+            value.items_.push_back(std::move(item));
+
+            skip_whitespace();
+            if (peek() == ',') {
+                ++position_;
+            } else if (peek() == ']') {
+                ++position_;
+                return true;
+            } else {
+                return fail("Expected ',' or ']'");
+            }
+        }
+    }
+
+    bool parse_string(std::string& result) {
+        ++position_;  // opening quote
+        while (position_ < text_.size()) {
+            char c = text_[position_++];
+            if (c == '"') {
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return fail("Control character in string");
+            }
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+
+            if (position_ >= text_.size()) {
+                break;
+            }
+            char escape = text_[position_++];
+            switch (escape) {
+                case '"':  result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/':  result += '/'; break;
+                case 'b':  result += '\b'; break;
+                case 'f':  result += '\f'; break;
+                case 'n':  result += '\n'; break;
+                case 'r':  result += '\r'; break;
+                case 't':  result += '\t'; break;
+                case 'u':
+                    if (!parse_unicode_escape(result)) {
+                        return false;
+                    }
+                    break;
+                default:
+                    return fail("Invalid escape sequence");
+            }
+        }
+        return fail("Unterminated string");
+    }
+
+    bool parse_unicode_escape(std::string& result) {
+        unsigned int code_point = 0;
+        if (!parse_hex4(code_point)) {
+            return false;
+        }
+
+        // Combine a UTF-16 surrogate pair into one code point
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            unsigned int low = 0;
+            if (text_.compare(position_, 2, "\\u") != 0) {
+                return fail("Unpaired surrogate");
+            }
+            position_ += 2;
+            if (!parse_hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                return fail("Invalid surrogate pair");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+
+        // Encode as UTF-8
+        if (code_point < 0x80) {
+            result += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            result += static_cast<char>(0xC0 | (code_point >> 6));
+            result += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            result += static_cast<char>(0xE0 | (code_point >> 12));
+            result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            result += static_cast<char>(0xF0 | (code_point >> 18));
+            result += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        return true;
+    }
+
+    bool parse_hex4(unsigned int& value) {
+        if (position_ + 4 > text_.size()) {
+            return fail("Truncated unicode escape");
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[position_++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<unsigned int>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<unsigned int>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<unsigned int>(c - 'A' + 10);
+            } else {
+                return fail("Invalid unicode escape");
+            }
+        }
+        return true;
+    }
+
+    bool parse_number(JsonValue& value) {
+        std::size_t start = position_;
+        if (peek() == '-') {
+            ++position_;
+        }
+        if (!consume_digits()) {
+            return fail("Invalid number");
+        }
+        if (peek() == '.') {
+            ++position_;
+            if (!consume_digits()) {
+                return fail("Invalid number");
+            }
+        }
+        if (peek() == 'e' || peek() == 'E') {
+            ++position_;
+            if (peek() == '+' || peek() == '-') {
+                ++position_;
+            }
+            if (!consume_digits()) {
+                return fail("Invalid number");
+            }
+        }
+
+        // The grammar was checked above; strtod only converts
+        std::string number_text = text_.substr(start, position_ - start);
+        value.type_ = Type::Number;
+        value.number_value_ = std::strtod(number_text.c_str(), nullptr);
+        return true;
+    }
+
+    bool consume_digits() noexcept {
+        std::size_t start = position_;
+        while (position_ < text_.size() && text_[position_] >= '0' && text_[position_] <= '9') {
+            ++position_;
+        }
+        return position_ > start;
+    }
+
+    bool consume_literal(const char* literal) noexcept {
+        std::size_t length = std::char_traits<char>::length(literal);
+        if (text_.compare(position_, length, literal) == 0) {
+            position_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    void skip_whitespace() noexcept {
+        while (position_ < text_.size() &&
+               (text_[position_] == ' ' || text_[position_] == '\t' ||
+                text_[position_] == '\n' || text_[position_] == '\r')) {
+            ++position_;
+        }
+    }
+
+    char peek() const noexcept {
+        return position_ < text_.size() ? text_[position_] : '\0';
+    }
+
+    bool fail(const char* message) {
+        if (error_.empty()) {
+            error_ = message;
+        }
+        return false;
+    }
+
+    const std::string& text_;
+    std::size_t position_;
+    std::string error_;
+};
+
+JsonValue::JsonValue() noexcept
+    : type_(Type::Null),
+      bool_value_(false),
+      number_value_(0.0) {
+}
+
+bool JsonValue::parse(const std::string& text, JsonValue& value, std::string& error_message) {
+    value = JsonValue();
+    error_message.clear();
+    Parser parser(text);
+    if (!parser.parse_document(value, error_message)) {
+        value = JsonValue();
+        return false;
+    }
+    return true;
+}
+
+bool JsonValue::parse_file(const std::string& path, JsonValue& value, std::string& error_message) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error_message = "Cannot open " + path;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (!parse(contents.str(), value, error_message)) {
+        error_message = path + ": " + error_message;
+        return false;
+    }
+    return true;
+}
+
+JsonValue::Type JsonValue::type() const noexcept {
+    return type_;
+}
+
+bool JsonValue::is_null() const noexcept {
+    return type_ == Type::Null;
+}
+
+bool JsonValue::is_number() const noexcept {
+    return type_ == Type::Number;
+}
+
+bool JsonValue::is_string() const noexcept {
+    return type_ == Type::String;
+}
+
+bool JsonValue::is_array() const noexcept {
+    return type_ == Type::Array;
+}
+
+bool JsonValue::is_object() const noexcept {
+    return type_ == Type::Object;
+}
+
+bool JsonValue::as_bool() const noexcept {
+    return type_ == Type::Boolean && bool_value_;
+}
+
+double JsonValue::as_number() const noexcept {
+    return type_ == Type::Number ? number_value_ : 0.0;
+}
+
+const std::string& JsonValue::as_string() const noexcept {
+    // string_value_ is only ever set for strings
+    return string_value_;
+}
+
+const std::vector<JsonValue>& JsonValue::items() const noexcept {
+    return items_;
+}
+
+const std::vector<JsonValue::Member>& JsonValue::members() const noexcept {
+    return members_;
+}
+
+const JsonValue* JsonValue::find(const std::string& name) const noexcept {
+    for (const Member& member : members_) {
+        if (member.first == name) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
@@ -6,13 +6,37 @@
 
 #include "memory_benchmark.h"
 #include "timer.h"
+#include "result_writer.h"
+#include "interval_telemetry.h"
+#include "trace_recorder.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <string>
 #include <cmath>
+#include <utility>
+#include <algorithm>
 
-MemoryBenchmark::MemoryBenchmark() noexcept {
+namespace {
+    constexpr double TRIM_FRACTION = 0.10;
+    constexpr std::size_t TRACE_BATCH_CYCLES = 64;     // Cycles per trace span
+}
+
+MemoryBenchmark::MemoryBenchmark() noexcept
+    : exclude_outliers_(false),
+      telemetry_(nullptr) {
+}
+
+void MemoryBenchmark::set_exclude_outliers(bool exclude) noexcept {
+    exclude_outliers_ = exclude;
+}
+
+void MemoryBenchmark::set_telemetry(IntervalTelemetry* telemetry) noexcept {
+    telemetry_ = telemetry;
+}
+
+void MemoryBenchmark::set_condition_sampler(DriftAnalysis::ConditionSampler sampler) {
+    condition_sampler_ = std::move(sampler);
 }
 
 MemoryBenchmark::Results MemoryBenchmark::run(
@@ -31,17 +55,24 @@ MemoryBenchmark::Results MemoryBenchmark::run(
         return results;
     }
 
+    TraceScope run_scope("run", "memory");
+
     // Allocate buffer using vector for automatic cleanup
+    TraceRecorder::begin("allocate", "memory");
     std::vector<std::uint8_t> buffer(buffer_size_bytes);
+    TraceRecorder::end("allocate", "memory");
     
     // Use helper method with pre-allocated buffer
-    return run_with_buffer(buffer.data(), buffer_size_bytes, iterations);
+    Results results = run_with_buffer(buffer.data(), buffer_size_bytes, iterations);
+    results.latency_ci = Statistics::bootstrap_summary(results.latency_samples_ns);
+    return results;
 }
 
 MemoryBenchmark::Results MemoryBenchmark::run_with_buffer(
     std::uint8_t* buffer,
     std::size_t buffer_size_bytes,
-    std::size_t iterations
+    std::size_t iterations,
+    IntervalTelemetry* telemetry
 ) {
     Results results{};
     results.buffer_size_bytes = buffer_size_bytes;
@@ -61,62 +92,185 @@ MemoryBenchmark::Results MemoryBenchmark::run_with_buffer(
     total_timer.start();
 
     std::size_t total_errors = 0;
-    std::int64_t min_latency_ns = 0;
-    std::int64_t max_latency_ns = 0;
-    std::int64_t sum_latency_ns = 0;
-    bool first_iteration = true;
     
     // Store latencies for variance calculation
     std::vector<double> latencies;
     latencies.reserve(iterations);
 
+    bool tracing = TraceRecorder::enabled();
     for (std::size_t i = 0; i < iterations; ++i) {
-        std::int64_t cycle_latency_ns = 0;
-        std::size_t errors = verify_cycle(buffer, buffer_size_bytes, 
-                                          cycle_latency_ns);
-        total_errors += errors;
-
-        // Track min/max/average latency incrementally
-        if (first_iteration) {
-            min_latency_ns = cycle_latency_ns;
-            max_latency_ns = cycle_latency_ns;
-            first_iteration = false;
-        } else {
-            if (cycle_latency_ns < min_latency_ns) {
-                min_latency_ns = cycle_latency_ns;
-            }
-            if (cycle_latency_ns > max_latency_ns) {
-                max_latency_ns = cycle_latency_ns;
-            }
+        if (tracing && i % TRACE_BATCH_CYCLES == 0) {
+            TraceRecorder::begin("cycles", "memory");
         }
-        sum_latency_ns += cycle_latency_ns;
+        std::int64_t cycle_latency_ns = 0;
+        std::size_t cycle_errors = verify_cycle(buffer, buffer_size_bytes, cycle_latency_ns);
+        total_errors += cycle_errors;
         latencies.push_back(static_cast<double>(cycle_latency_ns));
+        if (telemetry != nullptr) {
+            telemetry->record(static_cast<double>(cycle_latency_ns), buffer_size_bytes * 3, cycle_errors);
+        }
+        if (tracing && (i % TRACE_BATCH_CYCLES == TRACE_BATCH_CYCLES - 1 || i + 1 == iterations)) {
+            TraceRecorder::end("cycles", "memory");
+        }
+    }
+
+    summarize_cycles(results, std::move(latencies), total_errors, total_timer.elapsed_seconds());
+    return results;
+}
+
+MemoryBenchmark::Results MemoryBenchmark::run_calibrated(
+    std::size_t buffer_size_bytes,
+    const CalibrationConfig& config
+) {
+    Results results{};
+    results.buffer_size_bytes = buffer_size_bytes;
+    results.calibration.enabled = true;
+
+    // Validate inputs
+    if (buffer_size_bytes == 0) {
+        std::cerr << "Error: Buffer size must be greater than 0\n";
+        return results;
+    }
+    if (config.window_iterations == 0 || config.target_relative_ci <= 0.0 || config.max_seconds <= 0.0) {
+        std::cerr << "Error: Calibration window, target and time budget must be greater than 0\n";
+        return results;
     }
 
-    double elapsed_seconds = total_timer.elapsed_seconds();
+    TraceScope run_scope("run_calibrated", "memory");
+    std::vector<std::uint8_t> buffer(buffer_size_bytes);
+    std::int64_t cycle_latency_ns = 0;
+
+    // Warmup: discard windows until two consecutive window means agree
+    TraceRecorder::begin("warmup", "memory");
+    Timer warmup_timer;
+    warmup_timer.start();
+    double previous_window_mean = 0.0;
+    while (warmup_timer.elapsed_seconds() < config.max_warmup_seconds) {
+        double window_sum = 0.0;
+        for (std::size_t i = 0; i < config.window_iterations; ++i) {
+            verify_cycle(buffer.data(), buffer_size_bytes, cycle_latency_ns);
+            window_sum += static_cast<double>(cycle_latency_ns);
+        }
+        results.calibration.warmup_iterations += config.window_iterations;
+
+        double window_mean = window_sum / static_cast<double>(config.window_iterations);
+        if (previous_window_mean > 0.0 &&
+            std::fabs(window_mean - previous_window_mean) / previous_window_mean <= config.warmup_tolerance) {
+            results.calibration.warmup_stable = true;
+            break;
+        }
+        previous_window_mean = window_mean;
+    }
+    results.calibration.warmup_seconds = warmup_timer.elapsed_seconds();
+    TraceRecorder::end("warmup", "memory");
+
+    // Measurement: Welford's running mean/variance keeps each check O(1)
+    TraceRecorder::begin("measure", "memory");
+    Timer total_timer;
+    total_timer.start();
+    std::vector<double> latencies;
+    std::size_t total_errors = 0;
+    double running_mean = 0.0;
+    double running_m2 = 0.0;
+    constexpr double Z_95 = 1.96;
+
+    while (latencies.size() < config.max_iterations) {
+        total_errors += verify_cycle(buffer.data(), buffer_size_bytes, cycle_latency_ns);
+        double latency = static_cast<double>(cycle_latency_ns);
+        latencies.push_back(latency);
+
+        double delta = latency - running_mean;
+        running_mean += delta / static_cast<double>(latencies.size());
+        running_m2 += delta * (latency - running_mean);
+
+        if (latencies.size() < config.min_iterations || latencies.size() % config.window_iterations != 0) {
+            continue;
+        }
+
+        double n = static_cast<double>(latencies.size());
+        double standard_error = std::sqrt(running_m2 / (n - 1.0)) / std::sqrt(n);
+        results.calibration.relative_ci_half_width =
+            running_mean > 0.0 ? Z_95 * standard_error / running_mean : 0.0;
+        if (results.calibration.relative_ci_half_width <= config.target_relative_ci) {
+            results.calibration.converged = true;
+            break;
+        }
+        if (total_timer.elapsed_seconds() >= config.max_seconds) {
+            break;
+        }
+    }
+
+    // Stopped by max_iterations between checks: report the final precision
+    if (!results.calibration.converged && latencies.size() > 1) {
+        double n = static_cast<double>(latencies.size());
+        double standard_error = std::sqrt(running_m2 / (n - 1.0)) / std::sqrt(n);
+        results.calibration.relative_ci_half_width =
+            running_mean > 0.0 ? Z_95 * standard_error / running_mean : 0.0;
+    }
+
+    double measure_seconds = total_timer.elapsed_seconds();
+    TraceRecorder::end("measure", "memory");
+
+    results.iterations = latencies.size();
+    summarize_cycles(results, std::move(latencies), total_errors, measure_seconds);
+    results.latency_ci = Statistics::bootstrap_summary(results.latency_samples_ns);
+    return results;
+}
+
+void MemoryBenchmark::summarize_cycles(
+    Results& results,
+    std::vector<double> latencies,
+    std::size_t total_errors,
+    double elapsed_seconds
+) const {
+    results.verification_errors = total_errors;
+    results.verification_passed = (total_errors == 0);
+    if (latencies.empty()) {
+        return;
+    }
+    TraceScope summarize_scope("summarize", "memory");
 
     // Calculate timing statistics
+    double sum_latency_ns = 0.0;
+    results.timing.min_latency_ns = latencies.front();
+    results.timing.max_latency_ns = latencies.front();
+    for (double latency : latencies) {
+        results.timing.min_latency_ns = std::min(results.timing.min_latency_ns, latency);
+        results.timing.max_latency_ns = std::max(results.timing.max_latency_ns, latency);
+        sum_latency_ns += latency;
+    }
     results.timing.total_time_seconds = elapsed_seconds;
-    results.timing.min_latency_ns = static_cast<double>(min_latency_ns);
-    results.timing.max_latency_ns = static_cast<double>(max_latency_ns);
-    results.timing.avg_latency_ns = static_cast<double>(sum_latency_ns) 
-                                    / static_cast<double>(iterations);
-    results.timing.sample_count = iterations;
+    results.timing.avg_latency_ns = sum_latency_ns / static_cast<double>(latencies.size());
+    results.timing.sample_count = latencies.size();
     
     // Calculate variance and standard deviation
     calculate_statistics(latencies, results.timing.avg_latency_ns,
                         results.timing.variance_ns, results.timing.std_deviation_ns);
     
+    std::vector<double> sorted_latencies(latencies);
+    std::sort(sorted_latencies.begin(), sorted_latencies.end());
+    calculate_robust_statistics(sorted_latencies, results.timing);
+
+    // Outlier cycles leave the byte count and their time leaves the wall time
+    if (exclude_outliers_) {
+        results.outliers_excluded = true;
+        for (double latency : latencies) {
+            if (latency < results.timing.outliers.lower_inner_fence ||
+                latency > results.timing.outliers.upper_inner_fence) {
+                results.excluded_cycles++;
+                results.excluded_seconds += latency / 1e9;
+            }
+        }
+    }
+
     // Calculate throughput: (buffer_size * iterations * 3) / time
     // Factor of 3 because we do read-write-read (three operations per cycle)
-    double total_bytes_processed = static_cast<double>(buffer_size_bytes) 
-                                   * static_cast<double>(iterations) * 3.0;
-    results.throughput_mbps = (total_bytes_processed / elapsed_seconds) / (1024.0 * 1024.0);
+    double total_bytes_processed = static_cast<double>(results.buffer_size_bytes) 
+                                   * static_cast<double>(latencies.size() - results.excluded_cycles) * 3.0;
+    results.throughput_mbps = (total_bytes_processed / (elapsed_seconds - results.excluded_seconds))
+                              / (1024.0 * 1024.0);
     
-    results.verification_errors = total_errors;
-    results.verification_passed = (total_errors == 0);
-
-    return results;
+    results.latency_samples_ns = std::move(latencies);
 }
 
 MemoryBenchmark::Results MemoryBenchmark::run_continuous(
@@ -158,11 +312,20 @@ MemoryBenchmark::Results MemoryBenchmark::run_continuous(
     // Track results across runs
     std::vector<double> run_avg_latencies;
     std::vector<double> run_total_times;
+    std::vector<double> run_start_seconds;
+    std::vector<double> run_throughputs;
+    std::vector<DriftAnalysis::Condition> conditions;
     std::size_t total_errors = 0;
     std::size_t completed_runs = 0;
     
     Timer continuous_timer;
     continuous_timer.start();
+    if (telemetry_ != nullptr) {
+        telemetry_->start();
+    }
+    if (condition_sampler_) {
+        conditions.push_back(condition_sampler_());
+    }
 
     // Run continuous benchmark loop
     bool should_continue = true;
@@ -183,12 +346,19 @@ MemoryBenchmark::Results MemoryBenchmark::run_continuous(
         }
 
         // Run a single benchmark with pre-allocated buffer (deterministic, no allocation in loop)
-        Results run_results = run_with_buffer(buffer.data(), buffer_size_bytes, iterations_per_run);
+        TraceScope continuous_run_scope("continuous_run", "memory");
+        double run_start = continuous_timer.elapsed_seconds();
+        Results run_results = run_with_buffer(buffer.data(), buffer_size_bytes, iterations_per_run, telemetry_);
         
         // Aggregate results
         if (run_results.timing.sample_count > 0) {
+            if (condition_sampler_) {
+                conditions.push_back(condition_sampler_());
+            }
             run_avg_latencies.push_back(run_results.timing.avg_latency_ns);
             run_total_times.push_back(run_results.timing.total_time_seconds);
+            run_start_seconds.push_back(run_start);
+            run_throughputs.push_back(run_results.throughput_mbps);
             total_errors += run_results.verification_errors;
             
             // Update min/max across runs
@@ -205,6 +375,8 @@ MemoryBenchmark::Results MemoryBenchmark::run_continuous(
             }
             
             aggregated_results.timing.total_time_seconds += run_results.timing.total_time_seconds;
+            aggregated_results.excluded_cycles += run_results.excluded_cycles;
+            aggregated_results.excluded_seconds += run_results.excluded_seconds;
             completed_runs++;
         } else {
             // Run failed, break to avoid infinite loop
@@ -212,6 +384,10 @@ MemoryBenchmark::Results MemoryBenchmark::run_continuous(
         }
     }
 
+    if (telemetry_ != nullptr) {
+        telemetry_->finish();
+    }
+
     // Calculate aggregated statistics
     if (completed_runs > 0) {
         // Calculate average latency across runs
@@ -227,22 +403,42 @@ MemoryBenchmark::Results MemoryBenchmark::run_continuous(
                             aggregated_results.timing.variance_ns, 
                             aggregated_results.timing.std_deviation_ns);
         
-        // Calculate total throughput
-        double total_bytes_processed = static_cast<double>(buffer_size_bytes) 
-                                      * static_cast<double>(iterations_per_run) 
-                                      * static_cast<double>(completed_runs) * 3.0;
-        aggregated_results.throughput_mbps = (total_bytes_processed / aggregated_results.timing.total_time_seconds) 
+        // Robust statistics of run averages
+        std::vector<double> sorted_averages(run_avg_latencies);
+        std::sort(sorted_averages.begin(), sorted_averages.end());
+        calculate_robust_statistics(sorted_averages, aggregated_results.timing);
+
+        // Calculate total throughput (outlier cycles excluded per run when enabled)
+        double total_cycles = static_cast<double>(iterations_per_run) * static_cast<double>(completed_runs)
+                              - static_cast<double>(aggregated_results.excluded_cycles);
+        double total_bytes_processed = static_cast<double>(buffer_size_bytes) * total_cycles * 3.0;
+        aggregated_results.throughput_mbps = (total_bytes_processed / (aggregated_results.timing.total_time_seconds
+                                                                        - aggregated_results.excluded_seconds))
                                             / (1024.0 * 1024.0);
+        aggregated_results.outliers_excluded = exclude_outliers_;
         
         aggregated_results.iterations = iterations_per_run * completed_runs;
     }
 
     aggregated_results.verification_errors = total_errors;
     aggregated_results.verification_passed = (total_errors == 0);
+    aggregated_results.latency_ci = Statistics::bootstrap_summary(run_avg_latencies);
+    aggregated_results.latency_samples_ns = std::move(run_avg_latencies);
+    aggregated_results.drift = DriftAnalysis::analyze(run_start_seconds, run_throughputs, conditions);
 
     return aggregated_results;
 }
 
+void MemoryBenchmark::calculate_robust_statistics(
+    const std::vector<double>& sorted_samples,
+    TimingStats& timing
+) {
+    timing.median_latency_ns = Statistics::percentile_sorted(sorted_samples, 50.0);
+    timing.mad_ns = Statistics::median_absolute_deviation_sorted(sorted_samples);
+    timing.trimmed_mean_ns = Statistics::trimmed_mean_sorted(sorted_samples, TRIM_FRACTION);
+    timing.outliers = Statistics::classify_outliers_sorted(sorted_samples);
+}
+
 void MemoryBenchmark::calculate_statistics(
     const std::vector<double>& latencies,
     double mean,
@@ -356,6 +552,26 @@ void MemoryBenchmark::print_results(const Results& results) {
               << results.iterations << "\n";
     std::cout << "\n";
 
+    if (results.calibration.enabled) {
+        std::cout << "Calibration:\n";
+        std::cout << "  " << std::left << std::setw(25) << "Warmup Iterations:"
+                  << results.calibration.warmup_iterations
+                  << (results.calibration.warmup_stable ? "" : " (budget exhausted, not stable)") << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "Warmup Time:"
+                  << std::fixed << std::setprecision(3)
+                  << results.calibration.warmup_seconds << " seconds\n";
+        std::cout << "  " << std::left << std::setw(25) << "95% CI Half-Width:"
+                  << std::fixed << std::setprecision(2)
+                  << (results.calibration.relative_ci_half_width * 100.0) << "% of mean\n";
+        std::cout << "  " << std::left << std::setw(25) << "Converged:"
+                  << (results.calibration.converged ? "Yes" : "No (time or iteration budget reached)") << "\n";
+        std::cout << "\n";
+    }
+
+    if (results.drift.enabled) {
+        DriftAnalysis::print_results(results.drift);
+    }
+
     // Timing Statistics Table
     std::cout << "Timing Statistics:\n";
     std::cout << "  " << std::left << std::setw(25) << "Total Time:" 
@@ -405,11 +621,67 @@ void MemoryBenchmark::print_results(const Results& results) {
     }
     std::cout << "\n";
 
+    // Robust estimates resist the single interrupts that dominate min/max
+    if (results.timing.sample_count > 1) {
+        const Statistics::OutlierCounts& outliers = results.timing.outliers;
+        std::cout << "Robust Statistics:\n";
+        std::cout << "  " << std::left << std::setw(25) << "Median Latency:"
+                  << std::fixed << std::setprecision(2)
+                  << results.timing.median_latency_ns << " ns\n";
+        std::cout << "  " << std::left << std::setw(25) << "MAD:"
+                  << std::fixed << std::setprecision(2)
+                  << results.timing.mad_ns << " ns\n";
+        std::cout << "  " << std::left << std::setw(25) << "Trimmed Mean (10%):"
+                  << std::fixed << std::setprecision(2)
+                  << results.timing.trimmed_mean_ns << " ns\n";
+        std::cout << "  " << std::left << std::setw(25) << "Inner Fences:"
+                  << std::fixed << std::setprecision(2)
+                  << outliers.lower_inner_fence << " - "
+                  << outliers.upper_inner_fence << " ns\n";
+
+        std::size_t total_outliers = outliers.low_severe + outliers.low_mild
+                                     + outliers.high_mild + outliers.high_severe;
+        std::cout << "  " << std::left << std::setw(25) << "Outliers:"
+                  << total_outliers << " ("
+                  << std::fixed << std::setprecision(2)
+                  << (100.0 * static_cast<double>(total_outliers)
+                      / static_cast<double>(results.timing.sample_count)) << "%)\n";
+        std::cout << "  " << std::left << std::setw(25) << "  Low Severe / Mild:"
+                  << outliers.low_severe << " / " << outliers.low_mild << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "  High Mild / Severe:"
+                  << outliers.high_mild << " / " << outliers.high_severe << "\n";
+        std::cout << "\n";
+    }
+
+    if (results.latency_ci.sample_count > 1) {
+        std::cout << "Confidence Intervals (" << std::fixed << std::setprecision(0)
+                  << (results.latency_ci.confidence * 100.0) << "%, bootstrap):\n";
+        const std::pair<const char*, const Statistics::ConfidenceInterval*> intervals[] = {
+            {"Mean Latency:", &results.latency_ci.mean},
+            {"Median Latency:", &results.latency_ci.median},
+            {"p99 Latency:", &results.latency_ci.p99},
+        };
+        for (const auto& interval : intervals) {
+            std::cout << "  " << std::left << std::setw(25) << interval.first
+                      << std::fixed << std::setprecision(2)
+                      << interval.second->estimate << " ns  ["
+                      << interval.second->lower << ", "
+                      << interval.second->upper << "]\n";
+        }
+        std::cout << "\n";
+    }
+
     // Performance Metrics Table
     std::cout << "Performance Metrics:\n";
     std::cout << "  " << std::left << std::setw(25) << "Throughput:" 
               << std::fixed << std::setprecision(2) 
               << results.throughput_mbps << " MB/s\n";
+    if (results.outliers_excluded) {
+        std::cout << "  " << std::left << std::setw(25) << "Excluded Cycles:"
+                  << results.excluded_cycles << " outliers ("
+                  << std::fixed << std::setprecision(6)
+                  << results.excluded_seconds << " seconds)\n";
+    }
     
     // Calculate operations per second
     double ops_per_second = static_cast<double>(results.iterations) 
@@ -503,3 +775,56 @@ void MemoryBenchmark::print_results(const Results& results) {
     std::cout << "\n";
 }
 
+
+void MemoryBenchmark::write_results(const Results& results, ResultWriter& writer,
+                                    const std::string& name) {
+    writer.begin_object(name);
+    writer.field("buffer_size_bytes", results.buffer_size_bytes);
+    writer.field("iterations", results.iterations);
+
+    writer.begin_object("timing");
+    writer.field("min_latency_ns", results.timing.min_latency_ns);
+    writer.field("max_latency_ns", results.timing.max_latency_ns);
+    writer.field("avg_latency_ns", results.timing.avg_latency_ns);
+    writer.field("total_time_seconds", results.timing.total_time_seconds);
+    writer.field("variance_ns", results.timing.variance_ns);
+    writer.field("std_deviation_ns", results.timing.std_deviation_ns);
+    writer.field("sample_count", results.timing.sample_count);
+    writer.field("median_latency_ns", results.timing.median_latency_ns);
+    writer.field("mad_ns", results.timing.mad_ns);
+    writer.field("trimmed_mean_ns", results.timing.trimmed_mean_ns);
+    writer.begin_object("outliers");
+    writer.field("lower_inner_fence", results.timing.outliers.lower_inner_fence);
+    writer.field("upper_inner_fence", results.timing.outliers.upper_inner_fence);
+    writer.field("lower_outer_fence", results.timing.outliers.lower_outer_fence);
+    writer.field("upper_outer_fence", results.timing.outliers.upper_outer_fence);
+    writer.field("low_severe", results.timing.outliers.low_severe);
+    writer.field("low_mild", results.timing.outliers.low_mild);
+    writer.field("high_mild", results.timing.outliers.high_mild);
+    writer.field("high_severe", results.timing.outliers.high_severe);
+    writer.end_object();
+    writer.end_object();
+
+    writer.field("throughput_mbps", results.throughput_mbps);
+    writer.field("outliers_excluded", results.outliers_excluded);
+    writer.field("excluded_cycles", results.excluded_cycles);
+    writer.field("excluded_seconds", results.excluded_seconds);
+    writer.field("verification_passed", results.verification_passed);
+    writer.field("verification_errors", results.verification_errors);
+    writer.samples("latency_samples_ns", results.latency_samples_ns);
+    writer.histogram("latency_histogram_ns", results.latency_samples_ns);
+    writer.confidence_intervals("latency_ci_ns", results.latency_ci);
+    if (results.calibration.enabled) {
+        writer.begin_object("calibration");
+        writer.field("warmup_iterations", results.calibration.warmup_iterations);
+        writer.field("warmup_seconds", results.calibration.warmup_seconds);
+        writer.field("warmup_stable", results.calibration.warmup_stable);
+        writer.field("relative_ci_half_width", results.calibration.relative_ci_half_width);
+        writer.field("converged", results.calibration.converged);
+        writer.end_object();
+    }
+    if (results.drift.enabled) {
+        DriftAnalysis::write_results(results.drift, writer);
+    }
+    writer.end_object();
+}
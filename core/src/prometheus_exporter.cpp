@@ -0,0 +1,176 @@
+/**
+ * prometheus_exporter.cpp - Prometheus text format implementation
+ */
+
+#include "prometheus_exporter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+    constexpr const char* PREFIX = "systembenchmark_";
+
+    /**
+     * Escapes a label value (backslash, double quote, newline).
+     */
+    std::string escape_label(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            if (c == '\\') {
+                escaped += "\\\\";
+            } else if (c == '"') {
+                escaped += "\\\"";
+            } else if (c == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    /**
+     * Formats a sample value; Prometheus spells non-finite values NaN/+Inf/-Inf.
+     */
+    std::string format_value(double value) {
+        if (std::isnan(value)) {
+            return "NaN";
+        }
+        if (std::isinf(value)) {
+            return value > 0.0 ? "+Inf" : "-Inf";
+        }
+        // Shortest form that round-trips, so bucket bounds read "0.001", not "0.0010000000000000000208"
+        std::string text;
+        for (int precision = 6; precision <= 17; ++precision) {
+            std::ostringstream out;
+            out.precision(precision);
+            out << value;
+            text = out.str();
+            if (std::strtod(text.c_str(), nullptr) == value) {
+                break;
+            }
+        }
+        return text;
+    }
+
+    void write_header(std::ostringstream& out, const std::string& name,
+                      const char* help, const char* type) {
+        out << "# HELP " << PREFIX << name << " " << help << "\n";
+        out << "# TYPE " << PREFIX << name << " " << type << "\n";
+    }
+}
+
+PrometheusExporter::PrometheusExporter() noexcept {
+}
+
+const std::vector<double>& PrometheusExporter::latency_buckets() {
+    // 1-2.5-5 steps from 1 us to 10 s: covers memory cycles through WAN RTTs
+    static const std::vector<double> buckets = {
+        1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+        1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0,
+    };
+    return buckets;
+}
+
+void PrometheusExporter::update(const BenchmarkResult& result, double timestamp_seconds) {
+    auto inserted = probes_.emplace(result.benchmark_name, ProbeState{});
+    ProbeState& state = inserted.first->second;
+    if (inserted.second) {
+        state.bucket_counts.assign(latency_buckets().size() + 1, 0);
+    }
+
+    state.runs++;
+    state.successful = result.benchmark_successful;
+    state.last_run_timestamp = timestamp_seconds;
+    if (!result.benchmark_successful) {
+        // Keep the last good values visible; success=0 flags the failure
+        state.failures++;
+        return;
+    }
+
+    state.metrics = result.metrics;
+    const std::vector<double>& buckets = latency_buckets();
+    for (double latency : result.latency_samples_seconds) {
+        auto bucket = std::lower_bound(buckets.begin(), buckets.end(), latency);
+        state.bucket_counts[static_cast<std::size_t>(bucket - buckets.begin())]++;
+        state.latency_count++;
+        state.latency_sum += latency;
+    }
+}
+
+void PrometheusExporter::set_gauge(const std::string& name, const std::string& help,
+                                   const std::string& type, double value) {
+    gauges_[name] = Gauge{help, type, value};
+}
+
+std::string PrometheusExporter::render() const {
+    std::ostringstream out;
+
+    for (const auto& gauge : gauges_) {
+        out << "# HELP " << PREFIX << gauge.first << " " << gauge.second.help << "\n";
+        out << "# TYPE " << PREFIX << gauge.first << " " << gauge.second.type << "\n";
+        out << PREFIX << gauge.first << " " << format_value(gauge.second.value) << "\n";
+    }
+    if (probes_.empty()) {
+        return out.str();
+    }
+
+    write_header(out, "probe_value", "Latest value of each benchmark metric", "gauge");
+    for (const auto& probe : probes_) {
+        for (const BenchmarkMetric& metric : probe.second.metrics) {
+            out << PREFIX << "probe_value{benchmark=\"" << escape_label(probe.first)
+                << "\",metric=\"" << escape_label(metric.name)
+                << "\",unit=\"" << escape_label(metric.unit) << "\"} "
+                << format_value(metric.value) << "\n";
+        }
+    }
+
+    write_header(out, "probe_success", "1 if the benchmark's last run succeeded", "gauge");
+    for (const auto& probe : probes_) {
+        out << PREFIX << "probe_success{benchmark=\"" << escape_label(probe.first) << "\"} "
+            << (probe.second.successful ? 1 : 0) << "\n";
+    }
+
+    write_header(out, "probe_runs_total", "Benchmark runs since start", "counter");
+    for (const auto& probe : probes_) {
+        out << PREFIX << "probe_runs_total{benchmark=\"" << escape_label(probe.first) << "\"} "
+            << probe.second.runs << "\n";
+    }
+
+    write_header(out, "probe_failures_total", "Failed benchmark runs since start", "counter");
+    for (const auto& probe : probes_) {
+        out << PREFIX << "probe_failures_total{benchmark=\"" << escape_label(probe.first) << "\"} "
+            << probe.second.failures << "\n";
+    }
+
+    write_header(out, "probe_last_run_timestamp_seconds", "Unix time of the benchmark's last run", "gauge");
+    for (const auto& probe : probes_) {
+        out << PREFIX << "probe_last_run_timestamp_seconds{benchmark=\"" << escape_label(probe.first) << "\"} "
+            << format_value(probe.second.last_run_timestamp) << "\n";
+    }
+
+    write_header(out, "probe_latency_seconds", "Per-operation latency of sampled benchmarks", "histogram");
+    const std::vector<double>& buckets = latency_buckets();
+    for (const auto& probe : probes_) {
+        if (probe.second.latency_count == 0) {
+            continue;
+        }
+        std::string label = "benchmark=\"" + escape_label(probe.first) + "\"";
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            cumulative += probe.second.bucket_counts[i];
+            out << PREFIX << "probe_latency_seconds_bucket{" << label << ",le=\""
+                << format_value(buckets[i]) << "\"} " << cumulative << "\n";
+        }
+        out << PREFIX << "probe_latency_seconds_bucket{" << label << ",le=\"+Inf\"} "
+            << probe.second.latency_count << "\n";
+        out << PREFIX << "probe_latency_seconds_sum{" << label << "} "
+            << format_value(probe.second.latency_sum) << "\n";
+        out << PREFIX << "probe_latency_seconds_count{" << label << "} "
+            << probe.second.latency_count << "\n";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,251 @@
+/**
+ * result_writer.cpp - Machine-readable JSON and CSV result output implementation
+ */
+
+#include "result_writer.h"
+#include "statistics.h"
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <utility>
+
+ResultWriter::ResultWriter(std::ostream& out, Format format) noexcept
+    : out_(out),
+      format_(format),
+      header_written_(false) {
+}
+
+ResultWriter::~ResultWriter() {
+    finish();
+}
+
+bool ResultWriter::parse_format(const std::string& name, Format& format) noexcept {
+    if (name == "json") {
+        format = Format::Json;
+        return true;
+    }
+    if (name == "csv") {
+        format = Format::Csv;
+        return true;
+    }
+    return false;
+}
+
+void ResultWriter::begin_object(const std::string& name) {
+    std::string path = begin_value(name);
+    if (format_ == Format::Json) {
+        out_ << "{";
+    }
+    scopes_.push_back(Scope{false, 0, path});
+}
+
+void ResultWriter::end_object() {
+    if (scopes_.empty() || scopes_.back().is_array) {
+        return;
+    }
+    bool had_values = (scopes_.back().count > 0);
+    scopes_.pop_back();
+    if (format_ == Format::Json) {
+        if (had_values) {
+            write_indent();
+        }
+        out_ << "}";
+        if (scopes_.empty()) {
+            out_ << "\n";
+        }
+    }
+}
+
+void ResultWriter::begin_array(const std::string& name) {
+    std::string path = begin_value(name);
+    if (format_ == Format::Json) {
+        out_ << "[";
+    }
+    scopes_.push_back(Scope{true, 0, path});
+}
+
+void ResultWriter::end_array() {
+    if (scopes_.empty() || !scopes_.back().is_array) {
+        return;
+    }
+    bool had_values = (scopes_.back().count > 0);
+    scopes_.pop_back();
+    if (format_ == Format::Json) {
+        if (had_values) {
+            write_indent();
+        }
+        out_ << "]";
+        if (scopes_.empty()) {
+            out_ << "\n";
+        }
+    }
+}
+
+void ResultWriter::field(const std::string& name, const std::string& value) {
+    write_scalar(name, value, true);
+}
+
+void ResultWriter::field(const std::string& name, const char* value) {
+    write_scalar(name, value != nullptr ? std::string(value) : std::string(), true);
+}
+
+void ResultWriter::field(const std::string& name, double value) {
+    if (!std::isfinite(value)) {
+        write_scalar(name, format_ == Format::Json ? "null" : "", false);
+        return;
+    }
+
+    // Locale-independent so a decimal comma never corrupts the output
+    std::ostringstream text;
+    text.imbue(std::locale::classic());
+    text << std::setprecision(15) << value;
+    write_scalar(name, text.str(), false);
+}
+
+void ResultWriter::field(const std::string& name, bool value) {
+    write_scalar(name, value ? "true" : "false", false);
+}
+
+void ResultWriter::samples(const std::string& name, const std::vector<double>& values) {
+    begin_array(name);
+    for (double value : values) {
+        field("", value);
+    }
+    end_array();
+}
+
+void ResultWriter::histogram(const std::string& name, const std::vector<double>& values,
+                             std::size_t bin_count) {
+    begin_array(name);
+    for (const Statistics::HistogramBin& bin : Statistics::histogram(values, bin_count)) {
+        begin_object();
+        field("lower", bin.lower);
+        field("upper", bin.upper);
+        field("count", bin.count);
+        end_object();
+    }
+    end_array();
+}
+
+void ResultWriter::confidence_intervals(const std::string& name,
+                                        const Statistics::BootstrapSummary& summary) {
+    begin_object(name);
+    field("sample_count", summary.sample_count);
+    field("confidence", summary.confidence);
+    field("resamples", summary.resamples);
+    const std::pair<const char*, const Statistics::ConfidenceInterval*> intervals[] = {
+        {"mean", &summary.mean},
+        {"median", &summary.median},
+        {"p99", &summary.p99},
+    };
+    for (const auto& interval : intervals) {
+        begin_object(interval.first);
+        field("estimate", interval.second->estimate);
+        field("lower", interval.second->lower);
+        field("upper", interval.second->upper);
+        end_object();
+    }
+    end_object();
+}
+
+void ResultWriter::finish() {
+    while (!scopes_.empty()) {
+        if (scopes_.back().is_array) {
+            end_array();
+        } else {
+            end_object();
+        }
+    }
+    out_.flush();
+}
+
+std::string ResultWriter::begin_value(const std::string& name) {
+    if (scopes_.empty()) {
+        return "";
+    }
+
+    Scope& scope = scopes_.back();
+    std::string path;
+    if (scope.is_array) {
+        path = scope.path + "[" + std::to_string(scope.count) + "]";
+    } else {
+        path = scope.path.empty() ? name : scope.path + "." + name;
+    }
+
+    if (format_ == Format::Json) {
+        if (scope.count > 0) {
+            out_ << ",";
+        }
+        write_indent();
+        if (!scope.is_array) {
+            out_ << "\"" << escape_json(name) << "\": ";
+        }
+    }
+    scope.count++;
+    return path;
+}
+
+void ResultWriter::write_scalar(const std::string& name, const std::string& text, bool is_string) {
+    std::string path = begin_value(name);
+    if (format_ == Format::Json) {
+        if (is_string) {
+            out_ << "\"" << escape_json(text) << "\"";
+        } else {
+            out_ << text;
+        }
+        return;
+    }
+
+    if (!header_written_) {
+        out_ << "field,value\n";
+        header_written_ = true;
+    }
+    out_ << escape_csv(path) << "," << escape_csv(text) << "\n";
+}
+
+void ResultWriter::write_indent() {
+    out_ << "\n" << std::string(scopes_.size() * 2, ' ');
+}
+
+std::string ResultWriter::escape_json(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+std::string ResultWriter::escape_csv(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        return text;
+    }
+
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            quoted += "\"\"";
+        } else {
+            quoted += c;
+        }
+    }
+    quoted += "\"";
+    return quoted;
+}
@@ -0,0 +1,262 @@
+/**
+ * roofline_model.cpp - Roofline measurement and workload placement
+ */
+
+#include "roofline_model.h"
+#include "timer.h"
+#include "result_writer.h"
+#include "trace_recorder.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+namespace {
+    constexpr std::size_t PEAK_CHAINS = 16;        // Enough to hide multiply-add latency
+    constexpr std::size_t KIB = 1024;
+    constexpr std::size_t MIB = 1024 * 1024;
+
+    std::string format_size(std::size_t bytes) {
+        if (bytes >= MIB && bytes % MIB == 0) {
+            return std::to_string(bytes / MIB) + " MB";
+        }
+        return std::to_string(bytes / KIB) + " KB";
+    }
+
+    /**
+     * Runs work(count) with count doubling until one call takes at least
+     * min_seconds, then returns the best units per second over repetitions
+     * calls (each call does count units).
+     */
+    template <typename Work>
+    double best_rate(Work work, double min_seconds, std::size_t repetitions) {
+        std::size_t count = 1;
+        Timer timer;
+        while (true) {
+            timer.start();
+            work(count);
+            if (timer.elapsed_seconds() >= min_seconds || count >= (std::size_t(1) << 40)) {
+                break;
+            }
+            count *= 2;
+        }
+        double best = 0.0;
+        for (std::size_t repetition = 0; repetition < std::max<std::size_t>(repetitions, 1); ++repetition) {
+            timer.start();
+            work(count);
+            double seconds = timer.elapsed_seconds();
+            if (seconds > 0.0) {
+                best = std::max(best, static_cast<double>(count) / seconds);
+            }
+        }
+        return best;
+    }
+}
+
+RooflineModel::Config RooflineModel::default_config() {
+    Config config;
+    config.levels = {
+        {"L1", 32 * KIB, 16 * KIB},
+        {"L2", 1 * MIB, 512 * KIB},
+        {"L3", 16 * MIB, 8 * MIB},
+        {"DRAM", 0, 256 * MIB},
+    };
+    return config;
+}
+
+double RooflineModel::peak_kernel(std::size_t iterations) noexcept {
+    double chains[PEAK_CHAINS];
+    for (std::size_t chain = 0; chain < PEAK_CHAINS; ++chain) {
+        chains[chain] = 1.0 + static_cast<double>(chain) * 1e-3;
+    }
+    // Converges to c / (1 - m), so values stay normal however long it runs;
+    // volatile sources keep the compiler from evaluating the recurrence
+    volatile double multiplier_source = 0.999999;
+    volatile double addend_source = 1e-6;
+    const double multiplier = multiplier_source;
+    const double addend = addend_source;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t chain = 0; chain < PEAK_CHAINS; ++chain) {
+            chains[chain] = chains[chain] * multiplier + addend;
+        }
+    }
+    double sum = 0.0;
+    for (double value : chains) {
+        sum += value;
+    }
+    return sum;
+}
+
+double RooflineModel::read_kernel(const double* data, std::size_t count) noexcept {
+    double sum0 = 0.0;
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        sum0 += data[i];
+        sum1 += data[i + 1];
+        sum2 += data[i + 2];
+        sum3 += data[i + 3];
+    }
+    for (; i < count; ++i) {
+        sum0 += data[i];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+RooflineModel::Results RooflineModel::measure(const Config& config) {
+    Results results{};
+    results.benchmark_successful = false;
+    if (config.levels.empty()) {
+        results.error_message = "No memory levels configured";
+        return results;
+    }
+
+    volatile double sink = 0.0;
+    {
+        TraceScope peak_scope("peak", "roofline");
+        double iterations_per_second = best_rate([&sink](std::size_t count) {
+            sink = sink + peak_kernel(count);
+        }, config.min_seconds, config.repetitions);
+        results.peak_gops = iterations_per_second * 2.0 * PEAK_CHAINS / 1e9;
+    }
+
+    for (const MemoryLevel& level : config.levels) {
+        TraceScope level_scope(TraceRecorder::enabled() ? TraceRecorder::intern(level.name) : "", "roofline");
+        std::size_t count = std::max<std::size_t>(level.test_bytes / sizeof(double), 4);
+        std::vector<double> buffer;
+        try {
+            buffer.assign(count, 1.0);      // Also faults every page in before timing
+        } catch (const std::bad_alloc& e) {
+            results.error_message = "Failed to allocate " + format_size(level.test_bytes) +
+                                    " for the " + level.name + " roof";
+            return results;
+        }
+
+        double passes_per_second = best_rate([&sink, &buffer, count](std::size_t passes) {
+            for (std::size_t pass = 0; pass < passes; ++pass) {
+                sink = sink + read_kernel(buffer.data(), count);
+            }
+        }, config.min_seconds, config.repetitions);
+
+        Roof roof{};
+        roof.name = level.name;
+        roof.capacity_bytes = level.capacity_bytes;
+        roof.test_bytes = count * sizeof(double);
+        roof.bandwidth_gbps = passes_per_second * static_cast<double>(roof.test_bytes) / 1e9;
+        roof.ridge_intensity = (roof.bandwidth_gbps > 0.0) ? results.peak_gops / roof.bandwidth_gbps : 0.0;
+        results.roofs.push_back(roof);
+    }
+    (void)sink;
+
+    results.benchmark_successful = true;
+    return results;
+}
+
+void RooflineModel::place(Results& results, const Workload& workload) {
+    Point point{};
+    point.name = workload.name;
+    point.achieved_gops = (workload.seconds > 0.0) ? workload.operations / workload.seconds / 1e9 : 0.0;
+
+    if (workload.bytes <= 0.0 || results.roofs.empty()) {
+        // Register-resident: only the compute roof applies
+        point.roof = "compute";
+        point.attainable_gops = results.peak_gops;
+        point.compute_bound = true;
+    } else {
+        point.intensity = workload.operations / workload.bytes;
+        const Roof* roof = &results.roofs.back();
+        for (const Roof& candidate : results.roofs) {
+            if (candidate.capacity_bytes == 0 || workload.working_set_bytes <= candidate.capacity_bytes) {
+                roof = &candidate;
+                break;
+            }
+        }
+        point.roof = roof->name;
+        point.attainable_gops = std::min(results.peak_gops, point.intensity * roof->bandwidth_gbps);
+        point.compute_bound = (point.intensity >= roof->ridge_intensity);
+    }
+    point.efficiency = (point.attainable_gops > 0.0) ? point.achieved_gops / point.attainable_gops : 0.0;
+    results.points.push_back(point);
+}
+
+void RooflineModel::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Roofline Model\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    if (!results.benchmark_successful) {
+        std::cout << "Error: " << results.error_message << "\n\n";
+        return;
+    }
+
+    std::cout << "Roofs:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Peak Compute:"
+              << std::fixed << std::setprecision(2) << results.peak_gops << " Gop/s\n";
+    for (const Roof& roof : results.roofs) {
+        std::cout << "  " << std::left << std::setw(25) << (roof.name + " Bandwidth:")
+                  << std::fixed << std::setprecision(2) << roof.bandwidth_gbps << " GB/s"
+                  << " (ridge " << std::setprecision(3) << roof.ridge_intensity << " op/B, tested at "
+                  << format_size(roof.test_bytes) << ")\n";
+    }
+    std::cout << "\n";
+
+    if (!results.points.empty()) {
+        std::cout << "Workloads:\n";
+        for (const Point& point : results.points) {
+            std::cout << "  " << std::left << std::setw(25) << (point.name + ":")
+                      << std::fixed << std::setprecision(2) << point.achieved_gops << " Gop/s, ";
+            if (point.intensity > 0.0) {
+                std::cout << std::setprecision(3) << point.intensity << " op/B on " << point.roof << ", ";
+            } else {
+                std::cout << "no memory traffic, ";
+            }
+            std::cout << (point.compute_bound ? "compute-bound" : "memory-bound")
+                      << " (" << std::setprecision(1) << (point.efficiency * 100.0) << "% of "
+                      << std::setprecision(2) << point.attainable_gops << " Gop/s attainable)\n";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Note: Roofs are measured with portable scalar code; SIMD kernels can\n";
+    std::cout << "      exceed the compute roof. Workload operations are nominal counts.\n";
+    std::cout << "\n";
+}
+
+void RooflineModel::write_results(const Results& results, ResultWriter& writer,
+                                  const std::string& name) {
+    writer.begin_object(name);
+    writer.field("peak_gops", results.peak_gops);
+    writer.begin_array("roofs");
+    for (const Roof& roof : results.roofs) {
+        writer.begin_object();
+        writer.field("name", roof.name);
+        writer.field("capacity_bytes", roof.capacity_bytes);
+        writer.field("test_bytes", roof.test_bytes);
+        writer.field("bandwidth_gbps", roof.bandwidth_gbps);
+        writer.field("ridge_intensity", roof.ridge_intensity);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.begin_array("points");
+    for (const Point& point : results.points) {
+        writer.begin_object();
+        writer.field("name", point.name);
+        writer.field("intensity", point.intensity);
+        writer.field("achieved_gops", point.achieved_gops);
+        writer.field("roof", point.roof);
+        writer.field("attainable_gops", point.attainable_gops);
+        writer.field("compute_bound", point.compute_bound);
+        writer.field("efficiency", point.efficiency);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.field("benchmark_successful", results.benchmark_successful);
+    if (!results.benchmark_successful) {
+        writer.field("error_message", results.error_message);
+    }
+    writer.end_object();
+}
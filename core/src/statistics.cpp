@@ -0,0 +1,704 @@
+/**
+ * statistics.cpp - Shared statistical helpers implementation
+ */
+
+#include "statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+    /**
+     * Sum of the ranks of the first sample in the pooled sample (ties get
+     * their average rank), plus the tie correction term sum(t^3 - t).
+     */
+    void rank_sum(const std::vector<double>& first, const std::vector<double>& second,
+                  double& first_rank_sum, double& tie_term) {
+        std::vector<std::pair<double, bool>> pooled;
+        pooled.reserve(first.size() + second.size());
+        for (double value : first) {
+            pooled.emplace_back(value, true);
+        }
+        for (double value : second) {
+            pooled.emplace_back(value, false);
+        }
+        std::sort(pooled.begin(), pooled.end(),
+                  [](const std::pair<double, bool>& a, const std::pair<double, bool>& b) {
+                      return a.first < b.first;
+                  });
+
+        first_rank_sum = 0.0;
+        tie_term = 0.0;
+        std::size_t i = 0;
+        while (i < pooled.size()) {
+            std::size_t j = i;
+            while (j + 1 < pooled.size() && pooled[j + 1].first == pooled[i].first) {
+                ++j;
+            }
+            // Ranks are 1-based; the tied group i..j shares the mean rank
+            double average_rank = (static_cast<double>(i + 1) + static_cast<double>(j + 1)) / 2.0;
+            for (std::size_t k = i; k <= j; ++k) {
+                if (pooled[k].second) {
+                    first_rank_sum += average_rank;
+                }
+            }
+            double tied = static_cast<double>(j - i + 1);
+            tie_term += tied * tied * tied - tied;
+            i = j + 1;
+        }
+    }
+
+    /**
+     * Continued fraction for the regularized incomplete beta function
+     * (modified Lentz's method).
+     */
+    double incomplete_beta_fraction(double a, double b, double x) noexcept {
+        constexpr int MAX_ITERATIONS = 300;
+        constexpr double EPSILON = 3.0e-14;
+        constexpr double TINY = 1.0e-300;
+
+        double qab = a + b;
+        double qap = a + 1.0;
+        double qam = a - 1.0;
+        double c = 1.0;
+        double d = 1.0 - qab * x / qap;
+        if (std::fabs(d) < TINY) {
+            d = TINY;
+        }
+        d = 1.0 / d;
+        double h = d;
+
+        for (int m = 1; m <= MAX_ITERATIONS; ++m) {
+            double m2 = 2.0 * m;
+            double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < TINY) {
+                d = TINY;
+            }
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < TINY) {
+                c = TINY;
+            }
+            d = 1.0 / d;
+            h *= d * c;
+
+            aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+            d = 1.0 + aa * d;
+            if (std::fabs(d) < TINY) {
+                d = TINY;
+            }
+            c = 1.0 + aa / c;
+            if (std::fabs(c) < TINY) {
+                c = TINY;
+            }
+            d = 1.0 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1.0) < EPSILON) {
+                break;
+            }
+        }
+        return h;
+    }
+
+    /**
+     * Regularized incomplete beta function I_x(a, b).
+     */
+    double regularized_incomplete_beta(double a, double b, double x) noexcept {
+        if (x <= 0.0) {
+            return 0.0;
+        }
+        if (x >= 1.0) {
+            return 1.0;
+        }
+        double log_front = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                           a * std::log(x) + b * std::log(1.0 - x);
+        double front = std::exp(log_front);
+        if (x < (a + 1.0) / (a + b + 2.0)) {
+            return front * incomplete_beta_fraction(a, b, x) / a;
+        }
+        return 1.0 - front * incomplete_beta_fraction(b, a, 1.0 - x) / b;
+    }
+
+    /**
+     * Standard normal cumulative distribution function.
+     */
+    double normal_cdf(double z) noexcept {
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+
+    /**
+     * Inverse of the standard normal CDF (Acklam's rational approximation,
+     * refined with one Halley step to near double precision).
+     */
+    double normal_quantile(double p) noexcept {
+        if (p <= 0.0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        if (p >= 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                                   -2.759285104469687e+02, 1.383577518672690e+02,
+                                   -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                                   -1.556989798598866e+02, 6.680131188771972e+01,
+                                   -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                                   -2.400758277161838e+00, -2.549732539343734e+00,
+                                   4.374664141464968e+00, 2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                                   2.445134137142996e+00, 3.754408661907416e+00};
+        constexpr double P_LOW = 0.02425;
+
+        double x = 0.0;
+        if (p < P_LOW) {
+            double q = std::sqrt(-2.0 * std::log(p));
+            x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        } else if (p <= 1.0 - P_LOW) {
+            double q = p - 0.5;
+            double r = q * q;
+            x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+                (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+        } else {
+            double q = std::sqrt(-2.0 * std::log(1.0 - p));
+            x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                 ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+
+        double error = normal_cdf(x) - p;
+        double u = error * 2.5066282746310002 * std::exp(x * x / 2.0);  // sqrt(2 pi)
+        return x - u / (1.0 + x * u / 2.0);
+    }
+
+    /**
+     * P(X >= k) for X ~ Binomial(n, p), k >= 1. The incomplete beta
+     * continued fraction converges slowly for very large n, where the
+     * continuity-corrected normal approximation is accurate instead.
+     */
+    double binomial_upper_tail(std::size_t n, std::size_t k, double p) noexcept {
+        if (p <= 0.0) {
+            return 0.0;
+        }
+        if (p >= 1.0) {
+            return 1.0;
+        }
+        double trials = static_cast<double>(n);
+        if (n > 10000) {
+            double spread = std::sqrt(trials * p * (1.0 - p));
+            return 1.0 - normal_cdf((static_cast<double>(k) - 0.5 - trials * p) / spread);
+        }
+        return regularized_incomplete_beta(static_cast<double>(k),
+                                           trials - static_cast<double>(k) + 1.0, p);
+    }
+
+    /**
+     * SplitMix64: tiny state, no allocation, good enough for resampling.
+     */
+    class SplitMix64 {
+    public:
+        explicit SplitMix64(std::uint64_t seed) noexcept
+            : state_(seed) {
+        }
+
+        std::uint64_t next() noexcept {
+            std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * Uniform index in [0, bound) by multiply-shift (bound < 2^32).
+         */
+        std::size_t next_index(std::size_t bound) noexcept {
+            return static_cast<std::size_t>(((next() >> 32) * static_cast<std::uint64_t>(bound)) >> 32);
+        }
+
+    private:
+        std::uint64_t state_;
+    };
+
+    constexpr std::size_t MIN_BOOTSTRAP_RESAMPLES = 200;
+
+    // Above this size random index draws miss the cache on every access;
+    // Poisson(1) weights walk the samples sequentially instead
+    constexpr std::size_t POISSON_BOOTSTRAP_MIN_SAMPLES = 65536;
+
+    /**
+     * Poisson(1) bootstrap weights from 16 random bits: a 64 KiB table maps
+     * each 16-bit value to the weight whose CDF interval holds its midpoint,
+     * so a 64-bit draw yields four weights without branches. Quantizing the
+     * probabilities to 1/65536 is far below the bootstrap's own error.
+     */
+    class PoissonOneTable {
+    public:
+        PoissonOneTable() {
+            weights_.resize(65536);
+            double probability = std::exp(-1.0);
+            double cumulative = probability;
+            std::uint8_t k = 0;
+            for (std::size_t value = 0; value < weights_.size(); ++value) {
+                double uniform = (static_cast<double>(value) + 0.5) / 65536.0;
+                while (uniform >= cumulative && k < 255) {
+                    ++k;
+                    probability /= static_cast<double>(k);
+                    cumulative += probability;
+                }
+                weights_[value] = k;
+            }
+        }
+
+        std::uint32_t weight(std::uint64_t bits) const noexcept {
+            return weights_[bits & 0xFFFF];
+        }
+
+    private:
+        std::vector<std::uint8_t> weights_;
+    };
+}
+
+namespace Statistics {
+
+double percentile_sorted(const std::vector<double>& sorted_samples,
+                         double percentile) noexcept {
+    if (sorted_samples.empty()) {
+        return 0.0;
+    }
+    if (sorted_samples.size() == 1 || percentile <= 0.0) {
+        return sorted_samples.front();
+    }
+    if (percentile >= 100.0) {
+        return sorted_samples.back();
+    }
+
+    // Linear interpolation between the two closest ranks
+    double rank = (percentile / 100.0) * static_cast<double>(sorted_samples.size() - 1);
+    std::size_t lower = static_cast<std::size_t>(std::floor(rank));
+    std::size_t upper = std::min(lower + 1, sorted_samples.size() - 1);
+    double fraction = rank - static_cast<double>(lower);
+
+    return sorted_samples[lower] + (sorted_samples[upper] - sorted_samples[lower]) * fraction;
+}
+
+double percentile(std::vector<double> samples, double pct) noexcept {
+    std::sort(samples.begin(), samples.end());
+    return percentile_sorted(samples, pct);
+}
+
+double mean(const std::vector<double>& samples) noexcept {
+    if (samples.empty()) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    return sum / static_cast<double>(samples.size());
+}
+
+double standard_deviation(const std::vector<double>& samples) noexcept {
+    if (samples.size() < 2) {
+        return 0.0;
+    }
+
+    double sample_mean = mean(samples);
+    double sum_squares = 0.0;
+    for (double sample : samples) {
+        double difference = sample - sample_mean;
+        sum_squares += difference * difference;
+    }
+    return std::sqrt(sum_squares / static_cast<double>(samples.size() - 1));
+}
+
+double median_absolute_deviation_sorted(const std::vector<double>& sorted_samples) {
+    if (sorted_samples.empty()) {
+        return 0.0;
+    }
+    double median = percentile_sorted(sorted_samples, 50.0);
+    std::vector<double> deviations;
+    deviations.reserve(sorted_samples.size());
+    for (double sample : sorted_samples) {
+        deviations.push_back(std::fabs(sample - median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    return percentile_sorted(deviations, 50.0);
+}
+
+double trimmed_mean_sorted(const std::vector<double>& sorted_samples,
+                           double trim_fraction) noexcept {
+    if (sorted_samples.empty()) {
+        return 0.0;
+    }
+    trim_fraction = std::min(std::max(trim_fraction, 0.0), 0.49);
+    std::size_t trimmed = static_cast<std::size_t>(
+        std::floor(trim_fraction * static_cast<double>(sorted_samples.size())));
+
+    double sum = 0.0;
+    for (std::size_t i = trimmed; i < sorted_samples.size() - trimmed; ++i) {
+        sum += sorted_samples[i];
+    }
+    return sum / static_cast<double>(sorted_samples.size() - 2 * trimmed);
+}
+
+OutlierCounts classify_outliers_sorted(const std::vector<double>& sorted_samples) noexcept {
+    OutlierCounts counts{};
+    if (sorted_samples.empty()) {
+        return counts;
+    }
+    double first_quartile = percentile_sorted(sorted_samples, 25.0);
+    double third_quartile = percentile_sorted(sorted_samples, 75.0);
+    double iqr = third_quartile - first_quartile;
+    counts.lower_inner_fence = first_quartile - 1.5 * iqr;
+    counts.upper_inner_fence = third_quartile + 1.5 * iqr;
+    counts.lower_outer_fence = first_quartile - 3.0 * iqr;
+    counts.upper_outer_fence = third_quartile + 3.0 * iqr;
+
+    for (double sample : sorted_samples) {
+        if (sample < counts.lower_outer_fence) {
+            counts.low_severe++;
+        } else if (sample < counts.lower_inner_fence) {
+            counts.low_mild++;
+        } else if (sample > counts.upper_outer_fence) {
+            counts.high_severe++;
+        } else if (sample > counts.upper_inner_fence) {
+            counts.high_mild++;
+        }
+    }
+    return counts;
+}
+
+std::vector<HistogramBin> histogram(const std::vector<double>& samples,
+                                    std::size_t bin_count) {
+    std::vector<HistogramBin> bins;
+    if (samples.empty() || bin_count == 0) {
+        return bins;
+    }
+
+    auto range = std::minmax_element(samples.begin(), samples.end());
+    double lowest = *range.first;
+    double highest = *range.second;
+    if (lowest == highest) {
+        bins.push_back(HistogramBin{lowest, highest, samples.size()});
+        return bins;
+    }
+
+    bool geometric = (lowest > 0.0);
+    double step = geometric ? std::pow(highest / lowest, 1.0 / static_cast<double>(bin_count))
+                            : (highest - lowest) / static_cast<double>(bin_count);
+
+    double lower = lowest;
+    for (std::size_t i = 0; i < bin_count; ++i) {
+        double upper = (i + 1 == bin_count) ? highest
+                       : (geometric ? lower * step : lower + step);
+        bins.push_back(HistogramBin{lower, upper, 0});
+        lower = upper;
+    }
+
+    for (double sample : samples) {
+        // Bins are few; a linear scan keeps the edge handling obvious
+        std::size_t index = 0;
+        while (index + 1 < bins.size() && sample >= bins[index].upper) {
+            ++index;
+        }
+        bins[index].count++;
+    }
+    return bins;
+}
+
+ConfidenceInterval bootstrap_mean(const std::vector<double>& samples,
+                                  const BootstrapConfig& config,
+                                  std::size_t& resamples_used) {
+    double sample_mean = mean(samples);
+    ConfidenceInterval interval{sample_mean, sample_mean, sample_mean};
+    resamples_used = 0;
+    if (samples.size() < 2 || config.resamples == 0) {
+        return interval;
+    }
+
+    // Jackknife acceleration has a closed form for the mean
+    double sum_squares = 0.0;
+    double sum_cubes = 0.0;
+    for (double sample : samples) {
+        double difference = sample - sample_mean;
+        sum_squares += difference * difference;
+        sum_cubes += difference * difference * difference;
+    }
+    if (sum_squares == 0.0) {
+        return interval;
+    }
+    double acceleration = sum_cubes / (6.0 * std::pow(sum_squares, 1.5));
+
+    std::size_t n = samples.size();
+    std::size_t resamples = std::max(MIN_BOOTSTRAP_RESAMPLES, config.max_draws / n);
+    resamples = std::min(resamples, config.resamples);
+    std::vector<double> replicates(resamples);
+
+    SplitMix64 generator(config.seed);
+    if (n >= POISSON_BOOTSTRAP_MIN_SAMPLES) {
+        // Poisson bootstrap: each sample appears Poisson(1) times. One
+        // 64-bit draw weights the sample in four replicates per pass. The
+        // table is built once per process (thread-safe static initialization).
+        constexpr std::size_t REPLICATES_PER_PASS = 4;
+        static const PoissonOneTable poisson;
+        for (std::size_t r = 0; r < resamples; r += REPLICATES_PER_PASS) {
+            double sums[REPLICATES_PER_PASS] = {};
+            std::uint64_t weights[REPLICATES_PER_PASS] = {};
+            for (double sample : samples) {
+                std::uint64_t bits = generator.next();
+                for (std::size_t j = 0; j < REPLICATES_PER_PASS; ++j) {
+                    std::uint32_t weight = poisson.weight(bits >> (16 * j));
+                    sums[j] += weight * sample;
+                    weights[j] += weight;
+                }
+            }
+            for (std::size_t j = 0; j < REPLICATES_PER_PASS && r + j < resamples; ++j) {
+                replicates[r + j] = sums[j] / static_cast<double>(weights[j]);
+            }
+        }
+    } else {
+        for (double& replicate : replicates) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += samples[generator.next_index(n)];
+            }
+            replicate = sum / static_cast<double>(n);
+        }
+    }
+
+    std::size_t below = 0;
+    std::size_t equal = 0;
+    for (double replicate : replicates) {
+        if (replicate < sample_mean) {
+            ++below;
+        } else if (replicate == sample_mean) {
+            ++equal;
+        }
+    }
+    resamples_used = resamples;
+    std::sort(replicates.begin(), replicates.end());
+
+    // Bias correction from the share of replicates below the estimate
+    double count = static_cast<double>(resamples);
+    double share = (static_cast<double>(below) + 0.5 * static_cast<double>(equal)) / count;
+    share = std::min(std::max(share, 0.5 / count), 1.0 - 0.5 / count);
+    double bias = normal_quantile(share);
+
+    double tail = (1.0 - config.confidence) / 2.0;
+    auto adjusted_percentile = [&](double probability) {
+        double z = bias + normal_quantile(probability);
+        return 100.0 * normal_cdf(bias + z / (1.0 - acceleration * z));
+    };
+    interval.lower = percentile_sorted(replicates, adjusted_percentile(tail));
+    interval.upper = percentile_sorted(replicates, adjusted_percentile(1.0 - tail));
+    return interval;
+}
+
+ConfidenceInterval bootstrap_percentile_sorted(const std::vector<double>& sorted_samples,
+                                               double percentile,
+                                               double confidence) noexcept {
+    double estimate = percentile_sorted(sorted_samples, percentile);
+    ConfidenceInterval interval{estimate, estimate, estimate};
+    std::size_t n = sorted_samples.size();
+    if (n < 2) {
+        return interval;
+    }
+
+    // 1-based order statistic nearest the interpolated rank
+    double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * static_cast<double>(n - 1);
+    std::size_t k = static_cast<std::size_t>(std::lround(rank)) + 1;
+
+    // P(resampled k-th order statistic <= x_(j)) = P(Binomial(n, j/n) >= k),
+    // non-decreasing in j: binary search for the first j reaching the target
+    auto first_index_reaching = [&](double target) {
+        std::size_t low = 1;
+        std::size_t high = n;
+        while (low < high) {
+            std::size_t middle = low + (high - low) / 2;
+            double probability = static_cast<double>(middle) / static_cast<double>(n);
+            if (binomial_upper_tail(n, k, probability) >= target) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        return low - 1;
+    };
+
+    double tail = (1.0 - confidence) / 2.0;
+    interval.lower = std::min(sorted_samples[first_index_reaching(tail)], estimate);
+    interval.upper = std::max(sorted_samples[first_index_reaching(1.0 - tail)], estimate);
+    return interval;
+}
+
+BootstrapSummary bootstrap_summary_sorted(const std::vector<double>& sorted_samples,
+                                          const BootstrapConfig& config) {
+    BootstrapSummary summary{};
+    summary.sample_count = sorted_samples.size();
+    summary.confidence = config.confidence;
+    if (sorted_samples.empty()) {
+        return summary;
+    }
+    summary.mean = bootstrap_mean(sorted_samples, config, summary.resamples);
+    summary.median = bootstrap_percentile_sorted(sorted_samples, 50.0, config.confidence);
+    summary.p99 = bootstrap_percentile_sorted(sorted_samples, 99.0, config.confidence);
+    return summary;
+}
+
+BootstrapSummary bootstrap_summary(std::vector<double> samples,
+                                   const BootstrapConfig& config) {
+    std::sort(samples.begin(), samples.end());
+    return bootstrap_summary_sorted(samples, config);
+}
+
+TestResult mann_whitney_u(const std::vector<double>& first,
+                          const std::vector<double>& second) {
+    TestResult result{0.0, 1.0};
+    if (first.empty() || second.empty()) {
+        return result;
+    }
+
+    double n1 = static_cast<double>(first.size());
+    double n2 = static_cast<double>(second.size());
+    double total = n1 + n2;
+    double first_rank_sum = 0.0;
+    double tie_term = 0.0;
+    rank_sum(first, second, first_rank_sum, tie_term);
+
+    result.statistic = first_rank_sum - n1 * (n1 + 1.0) / 2.0;
+    double expected = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((total + 1.0) - tie_term / (total * (total - 1.0)));
+    if (variance <= 0.0) {
+        return result;  // Every value tied
+    }
+
+    double difference = result.statistic - expected;
+    double corrected = std::max(0.0, std::fabs(difference) - 0.5);
+    double z = corrected / std::sqrt(variance);
+    result.p_value = std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    return result;
+}
+
+TestResult welch_t_test(const std::vector<double>& first,
+                        const std::vector<double>& second) noexcept {
+    TestResult result{0.0, 1.0};
+    if (first.size() < 2 || second.size() < 2) {
+        return result;
+    }
+
+    double n1 = static_cast<double>(first.size());
+    double n2 = static_cast<double>(second.size());
+    double mean_difference = mean(first) - mean(second);
+    double sd1 = standard_deviation(first);
+    double sd2 = standard_deviation(second);
+    double variance1 = sd1 * sd1 / n1;
+    double variance2 = sd2 * sd2 / n2;
+    double standard_error = std::sqrt(variance1 + variance2);
+    if (standard_error == 0.0) {
+        // Both samples constant: any difference is exact
+        result.p_value = (mean_difference == 0.0) ? 1.0 : 0.0;
+        return result;
+    }
+
+    double t = mean_difference / standard_error;
+    double degrees_of_freedom = (variance1 + variance2) * (variance1 + variance2) /
+                                (variance1 * variance1 / (n1 - 1.0) +
+                                 variance2 * variance2 / (n2 - 1.0));
+    result.statistic = t;
+    result.p_value = regularized_incomplete_beta(degrees_of_freedom / 2.0, 0.5,
+                                                 degrees_of_freedom / (degrees_of_freedom + t * t));
+    return result;
+}
+
+double cliffs_delta(const std::vector<double>& first,
+                    const std::vector<double>& second) {
+    if (first.empty() || second.empty()) {
+        return 0.0;
+    }
+    // delta = 2U / (n1 n2) - 1, which avoids the O(n1 n2) pairwise count
+    double u = mann_whitney_u(first, second).statistic;
+    return 2.0 * u / (static_cast<double>(first.size()) * static_cast<double>(second.size())) - 1.0;
+}
+
+std::vector<std::size_t> change_points(const std::vector<double>& series,
+                                       std::size_t min_segment,
+                                       double penalty) {
+    std::vector<std::size_t> changes;
+    std::size_t n = series.size();
+    min_segment = std::max<std::size_t>(min_segment, 1);
+    if (n < 2 * min_segment) {
+        return changes;
+    }
+
+    // Noise scale from first differences: a step affects only one of them
+    std::vector<double> differences;
+    differences.reserve(n - 1);
+    for (std::size_t i = 1; i < n; ++i) {
+        differences.push_back(series[i] - series[i - 1]);
+    }
+    std::sort(differences.begin(), differences.end());
+    double sigma = 1.4826 * median_absolute_deviation_sorted(differences) / std::sqrt(2.0);
+    if (sigma <= 0.0) {
+        sigma = standard_deviation(series);
+    }
+    if (sigma <= 0.0) {
+        return changes;
+    }
+    double beta = penalty * sigma * sigma * std::log(static_cast<double>(n));
+
+    // Prefix sums give the squared-error cost of any segment in O(1)
+    std::vector<double> sums(n + 1, 0.0);
+    std::vector<double> squares(n + 1, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        sums[i + 1] = sums[i] + series[i];
+        squares[i + 1] = squares[i] + series[i] * series[i];
+    }
+    auto cost = [&](std::size_t begin, std::size_t end) {
+        double count = static_cast<double>(end - begin);
+        double sum = sums[end] - sums[begin];
+        return std::max(0.0, squares[end] - squares[begin] - sum * sum / count);
+    };
+
+    // best[t]: optimal penalized cost of series[0, t); previous[t]: its last change
+    std::vector<double> best(n + 1, std::numeric_limits<double>::infinity());
+    std::vector<std::size_t> previous(n + 1, 0);
+    best[0] = -beta;
+    std::vector<std::size_t> candidates{0};
+    for (std::size_t t = min_segment; t <= n; ++t) {
+        for (std::size_t s : candidates) {
+            if (t - s < min_segment) {
+                continue;
+            }
+            double total = best[s] + cost(s, t) + beta;
+            if (total < best[t]) {
+                best[t] = total;
+                previous[t] = s;
+            }
+        }
+
+        // Prune starts that can never beat t again
+        std::vector<std::size_t> kept;
+        kept.reserve(candidates.size() + 1);
+        for (std::size_t s : candidates) {
+            if (t - s < min_segment || best[s] + cost(s, t) <= best[t]) {
+                kept.push_back(s);
+            }
+        }
+        if (t + min_segment <= n) {
+            kept.push_back(t + 1 - min_segment);
+        }
+        candidates.swap(kept);
+    }
+
+    for (std::size_t t = previous[n]; t > 0; t = previous[t]) {
+        changes.push_back(t);
+    }
+    std::reverse(changes.begin(), changes.end());
+    return changes;
+}
+
+} // namespace Statistics
@@ -0,0 +1,292 @@
+/**
+ * suite_config.cpp - Declarative benchmark suite file implementation
+ */
+
+#include "suite_config.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    constexpr const char* DEFAULTS_SECTION = "defaults";
+
+    std::string trim(const std::string& text) {
+        std::size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) {
+            return "";
+        }
+        std::size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    bool valid_name(const std::string& name) {
+        if (name.empty()) {
+            return false;
+        }
+        for (char c : name) {
+            bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                           (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.';
+            if (!allowed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool is_reserved(const std::string& key) {
+        return key == "benchmark" || key == "repetitions" || key == "warmup" ||
+               key == "cpu" || key == "order";
+    }
+
+    /**
+     * Parses a whole-string integer within [minimum, maximum].
+     */
+    bool parse_integer(const std::string& text, long long minimum, long long maximum,
+                       long long& value) {
+        try {
+            std::size_t consumed = 0;
+            value = std::stoll(text, &consumed);
+            return consumed == text.size() && value >= minimum && value <= maximum;
+        } catch (const std::exception& e) {
+            return false;
+        }
+    }
+
+    /**
+     * Key/value pairs of one section, in file order.
+     */
+    struct Section {
+        std::string name;
+        std::size_t line;
+        std::vector<std::pair<std::string, std::string>> values;
+    };
+
+    /**
+     * Applies a reserved key to an instance.
+     */
+    bool apply_reserved(SuiteConfig::Instance& instance, const std::string& key,
+                        const std::string& value, std::string& error_message) {
+        long long number = 0;
+        if (key == "benchmark") {
+            if (!valid_name(value)) {
+                error_message = "invalid benchmark name '" + value + "'";
+                return false;
+            }
+            instance.benchmark = value;
+        } else if (key == "repetitions") {
+            if (!parse_integer(value, 1, 1000000, number)) {
+                error_message = "repetitions must be a positive integer: " + value;
+                return false;
+            }
+            instance.repetitions = static_cast<std::size_t>(number);
+        } else if (key == "warmup") {
+            if (!parse_integer(value, 0, 1000000, number)) {
+                error_message = "warmup must be a non-negative integer: " + value;
+                return false;
+            }
+            instance.warmup = static_cast<std::size_t>(number);
+        } else if (key == "cpu") {
+            if (!parse_integer(value, 0, 65535, number)) {
+                error_message = "cpu must be a CPU number: " + value;
+                return false;
+            }
+            instance.cpu = static_cast<int>(number);
+        } else if (key == "order") {
+            if (!parse_integer(value, -1000000, 1000000, number)) {
+                error_message = "order must be an integer: " + value;
+                return false;
+            }
+            instance.order = static_cast<int>(number);
+        }
+        return true;
+    }
+}
+
+SuiteConfig::SuiteConfig() noexcept {
+}
+
+bool SuiteConfig::parse(const std::string& text, SuiteConfig& suite, std::string& error_message) {
+    suite = SuiteConfig();
+    error_message.clear();
+
+    // First pass: split into sections, checking syntax only
+    std::vector<Section> sections;
+    std::istringstream lines(text);
+    std::string raw_line;
+    std::size_t line_number = 0;
+    while (std::getline(lines, raw_line)) {
+        ++line_number;
+        std::string line = trim(raw_line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        std::string location = "line " + std::to_string(line_number) + ": ";
+
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                error_message = location + "unterminated section header";
+                return false;
+            }
+            std::string name = trim(line.substr(1, line.size() - 2));
+            if (!valid_name(name)) {
+                error_message = location + "invalid section name '" + name + "'";
+                return false;
+            }
+            for (const Section& section : sections) {
+                if (section.name == name) {
+                    error_message = location + "duplicate section [" + name + "]";
+                    return false;
+                }
+            }
+            sections.push_back(Section{name, line_number, {}});
+            continue;
+        }
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error_message = location + "expected 'key = value'";
+            return false;
+        }
+        if (sections.empty()) {
+            error_message = location + "key outside a [section]";
+            return false;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        if (!valid_name(key)) {
+            error_message = location + "invalid key '" + key + "'";
+            return false;
+        }
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+        Section& section = sections.back();
+        for (const auto& existing : section.values) {
+            if (existing.first == key) {
+                error_message = location + "duplicate key '" + key + "' in [" + section.name + "]";
+                return false;
+            }
+        }
+        section.values.emplace_back(key, value);
+    }
+
+    // Defaults apply to every instance, whatever their position in the file
+    Instance defaults{};
+    defaults.repetitions = 1;
+    defaults.cpu = -1;
+    for (const Section& section : sections) {
+        if (section.name != DEFAULTS_SECTION) {
+            continue;
+        }
+        for (const auto& entry : section.values) {
+            if (entry.first == "benchmark") {
+                error_message = "line " + std::to_string(section.line) +
+                                ": [defaults] cannot set benchmark";
+                return false;
+            }
+            if (is_reserved(entry.first)) {
+                if (!apply_reserved(defaults, entry.first, entry.second, error_message)) {
+                    error_message = "line " + std::to_string(section.line) + ": " + error_message;
+                    return false;
+                }
+            } else {
+                suite.default_parameters_[entry.first] = entry.second;
+            }
+        }
+    }
+
+    for (const Section& section : sections) {
+        if (section.name == DEFAULTS_SECTION) {
+            continue;
+        }
+        Instance instance = defaults;
+        instance.name = section.name;
+        instance.benchmark = section.name;
+        instance.line = section.line;
+        for (const auto& entry : section.values) {
+            if (is_reserved(entry.first)) {
+                if (!apply_reserved(instance, entry.first, entry.second, error_message)) {
+                    error_message = "[" + section.name + "] (line " + std::to_string(section.line) +
+                                    "): " + error_message;
+                    return false;
+                }
+            } else {
+                instance.parameters[entry.first] = entry.second;
+            }
+        }
+        suite.instances_.push_back(std::move(instance));
+    }
+
+    if (suite.instances_.empty()) {
+        error_message = "no benchmark instances defined";
+        return false;
+    }
+
+    std::stable_sort(suite.instances_.begin(), suite.instances_.end(),
+                     [](const Instance& a, const Instance& b) {
+                         return a.order < b.order;
+                     });
+    return true;
+}
+
+bool SuiteConfig::parse_file(const std::string& path, SuiteConfig& suite, std::string& error_message) {
+    std::ifstream file(path);
+    if (!file) {
+        error_message = "Cannot open " + path;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (!parse(contents.str(), suite, error_message)) {
+        error_message = path + ": " + error_message;
+        return false;
+    }
+    return true;
+}
+
+bool SuiteConfig::validate(const BenchmarkRegistry& registry, std::string& error_message) const {
+    for (const Instance& instance : instances_) {
+        const BenchmarkRegistry::Entry* entry = registry.find(instance.benchmark);
+        if (entry == nullptr) {
+            error_message = "[" + instance.name + "]: unknown benchmark '" + instance.benchmark + "'";
+            return false;
+        }
+        for (const auto& parameter : instance.parameters) {
+            bool declared = std::any_of(entry->parameters.begin(), entry->parameters.end(),
+                                        [&parameter](const BenchmarkParameter& declared_parameter) {
+                                            return declared_parameter.name == parameter.first;
+                                        });
+            if (!declared) {
+                error_message = "[" + instance.name + "]: " + instance.benchmark +
+                                " has no parameter '" + parameter.first + "'";
+                return false;
+            }
+        }
+    }
+
+    // A default nobody declares is almost certainly a typo
+    for (const auto& parameter : default_parameters_) {
+        bool used = false;
+        for (const Instance& instance : instances_) {
+            const BenchmarkRegistry::Entry* entry = registry.find(instance.benchmark);
+            for (const BenchmarkParameter& declared_parameter : entry->parameters) {
+                if (declared_parameter.name == parameter.first) {
+                    used = true;
+                }
+            }
+        }
+        if (!used) {
+            error_message = "[defaults]: no instance's benchmark has parameter '" + parameter.first + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<SuiteConfig::Instance>& SuiteConfig::instances() const noexcept {
+    return instances_;
+}
+
+const BenchmarkParameters& SuiteConfig::default_parameters() const noexcept {
+    return default_parameters_;
+}
@@ -0,0 +1,213 @@
+/**
+ * trace_recorder.cpp - Chrome trace-event recorder implementation
+ */
+
+#include "trace_recorder.h"
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <vector>
+
+namespace {
+    struct Event {
+        const char* name;
+        const char* category;
+        std::int64_t timestamp_ns;
+        char phase;                     // 'B' or 'E'
+    };
+
+    constexpr std::size_t EVENTS_PER_CHUNK = 1024;
+
+    /**
+     * Events of one thread. Only the owning thread writes; count is
+     * published with release so a reader sees complete events. Storage
+     * is allocated chunk by chunk so idle threads stay cheap, and chunks
+     * never move, so a concurrent reader never sees freed memory.
+     */
+    struct ThreadBuffer {
+        std::vector<std::unique_ptr<Event[]>> chunks;   // Sized once at registration
+        std::size_t capacity;
+        std::atomic<std::size_t> count;
+        std::atomic<std::uint64_t> dropped;
+        std::uint32_t thread_id;
+        std::string thread_name;
+    };
+
+    /**
+     * Shared state; buffers live until exit so a thread's events survive it.
+     */
+    struct TraceState {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::set<std::string> interned;
+        std::size_t events_per_thread = TraceRecorder::DEFAULT_EVENTS_PER_THREAD;
+        std::chrono::steady_clock::time_point epoch;
+    };
+
+    TraceState& state() {
+        static TraceState trace_state;
+        return trace_state;
+    }
+
+    thread_local ThreadBuffer* current_buffer = nullptr;
+
+    /**
+     * Returns the calling thread's buffer, creating it on first use.
+     */
+    ThreadBuffer* thread_buffer() noexcept {
+        if (current_buffer != nullptr) {
+            return current_buffer;
+        }
+        try {
+            TraceState& trace_state = state();
+            std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+            buffer->chunks.resize((trace_state.events_per_thread + EVENTS_PER_CHUNK - 1) / EVENTS_PER_CHUNK);
+            buffer->capacity = trace_state.events_per_thread;
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(trace_state.mutex);
+            buffer->thread_id = static_cast<std::uint32_t>(trace_state.buffers.size() + 1);
+            current_buffer = buffer.get();
+            trace_state.buffers.push_back(std::move(buffer));
+        } catch (const std::exception& e) {
+            // Out of memory: this thread records nothing
+            return nullptr;
+        }
+        return current_buffer;
+    }
+
+    void write_escaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\' << *c;
+            } else if (static_cast<unsigned char>(*c) >= 0x20) {
+                out << *c;
+            }
+        }
+    }
+}
+
+std::atomic<bool> TraceRecorder::enabled_(false);
+
+void TraceRecorder::enable(std::size_t events_per_thread) {
+    TraceState& trace_state = state();
+    std::lock_guard<std::mutex> lock(trace_state.mutex);
+    if (enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    trace_state.events_per_thread = (events_per_thread > 0) ? events_per_thread : DEFAULT_EVENTS_PER_THREAD;
+    trace_state.epoch = std::chrono::steady_clock::now();
+    enabled_.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::begin(const char* name, const char* category) noexcept {
+    // Acquire pairs with enable() so the epoch is visible
+    if (enabled_.load(std::memory_order_acquire)) {
+        record(name, category, 'B');
+    }
+}
+
+void TraceRecorder::end(const char* name, const char* category) noexcept {
+    if (enabled_.load(std::memory_order_acquire)) {
+        record(name, category, 'E');
+    }
+}
+
+void TraceRecorder::record(const char* name, const char* category, char phase) noexcept {
+    ThreadBuffer* buffer = thread_buffer();
+    if (buffer == nullptr) {
+        return;
+    }
+    std::size_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::int64_t timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state().epoch).count();
+    std::unique_ptr<Event[]>& chunk = buffer->chunks[index / EVENTS_PER_CHUNK];
+    if (!chunk) {
+        chunk.reset(new (std::nothrow) Event[EVENTS_PER_CHUNK]);
+        if (!chunk) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    chunk[index % EVENTS_PER_CHUNK] = Event{name, category, timestamp_ns, phase};
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::set_thread_name(const std::string& name) noexcept {
+    if (!enabled()) {
+        return;
+    }
+    ThreadBuffer* buffer = thread_buffer();
+    if (buffer == nullptr) {
+        return;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(state().mutex);
+        buffer->thread_name = name;
+    } catch (const std::exception& e) {
+        // Keep the numeric thread id
+    }
+}
+
+const char* TraceRecorder::intern(const std::string& text) {
+    TraceState& trace_state = state();
+    std::lock_guard<std::mutex> lock(trace_state.mutex);
+    return trace_state.interned.insert(text).first->c_str();
+}
+
+std::uint64_t TraceRecorder::dropped_events() noexcept {
+    TraceState& trace_state = state();
+    std::lock_guard<std::mutex> lock(trace_state.mutex);
+    std::uint64_t dropped = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : trace_state.buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+bool TraceRecorder::write_chrome_trace(std::ostream& out) {
+    std::uint64_t dropped = dropped_events();
+    TraceState& trace_state = state();
+    std::lock_guard<std::mutex> lock(trace_state.mutex);
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << dropped << "},\n";
+    out << "\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : trace_state.buffers) {
+        if (!buffer->thread_name.empty()) {
+            out << (first ? "" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"args\":{\"name\":\"";
+            write_escaped(out, buffer->thread_name.c_str());
+            out << "\"}}";
+            first = false;
+        }
+
+        std::size_t count = buffer->count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Event& event = buffer->chunks[i / EVENTS_PER_CHUNK][i % EVENTS_PER_CHUNK];
+            // Trace timestamps are microseconds; keep nanosecond resolution
+            out << (first ? "" : ",\n") << "{\"name\":\"";
+            write_escaped(out, event.name);
+            out << "\",\"cat\":\"";
+            write_escaped(out, event.category);
+            out << "\",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"ts\":" << (event.timestamp_ns / 1000) << "."
+                << std::setw(3) << std::setfill('0') << (event.timestamp_ns % 1000) << std::setfill(' ')
+                << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    out.flags(flags);
+    return static_cast<bool>(out);
+}
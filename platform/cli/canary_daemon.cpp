@@ -0,0 +1,306 @@
+/**
+ * canary_daemon.cpp - Probe loop and /metrics listener implementation
+ */
+
+#include "canary_daemon.h"
+#include "benchmark_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <ctime>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr int POLL_INTERVAL_MS = 100;
+    constexpr int REQUEST_TIMEOUT_MS = 2000;
+    constexpr std::size_t MAX_REQUEST_SIZE = 8192;
+    constexpr auto SLEEP_STEP = std::chrono::milliseconds(100);
+
+    double unix_time_seconds() {
+        return std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+#ifdef __linux__
+    void send_all(int fd, const std::string& data) noexcept {
+        std::size_t total_sent = 0;
+        while (total_sent < data.size()) {
+            ssize_t bytes_sent = send(fd, data.data() + total_sent, data.size() - total_sent, MSG_NOSIGNAL);
+            if (bytes_sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            total_sent += static_cast<std::size_t>(bytes_sent);
+        }
+    }
+#endif
+}
+
+CanaryDaemon::CanaryDaemon(const BenchmarkRegistry& registry) noexcept
+    : registry_(registry),
+      running_(false),
+      listen_fd_(-1),
+      port_(0) {
+}
+
+CanaryDaemon::~CanaryDaemon() {
+    stop();
+}
+
+BenchmarkParameters CanaryDaemon::probe_defaults() {
+    return {
+        {"memory.buffer_size", "262144"},
+        {"memory.iterations", "20"},
+        {"cpu.iterations", "20000"},
+        {"network.rtt.iterations", "200"},
+    };
+}
+
+bool CanaryDaemon::start(const Config& config) {
+#ifdef __linux__
+    if (running_) {
+        return true;
+    }
+    config_ = config;
+    error_message_.clear();
+    probes_.clear();
+
+    if (config.interval_seconds <= 0.0 || config.cpu_budget <= 0.0 || config.cpu_budget > 1.0) {
+        error_message_ = "Interval must be positive and the CPU budget between 0 and 100%";
+        return false;
+    }
+
+    std::vector<std::string> unmatched;
+    std::vector<std::string> names = registry_.match(config.probes, unmatched);
+    if (!unmatched.empty()) {
+        error_message_ = "No benchmark matches: " + unmatched.front();
+        return false;
+    }
+    if (names.empty()) {
+        error_message_ = "No probes selected";
+        return false;
+    }
+
+    // Same rule as the runner: every override must name a selected probe's parameter
+    for (const auto& override_value : config.overrides) {
+        bool known = false;
+        for (const std::string& name : names) {
+            for (const BenchmarkParameter& parameter : registry_.find(name)->parameters) {
+                if (override_value.first == parameter.name ||
+                    override_value.first == name + "." + parameter.name) {
+                    known = true;
+                }
+            }
+        }
+        if (!known) {
+            error_message_ = "Unknown parameter for the selected probes: " + override_value.first;
+            return false;
+        }
+    }
+
+    BenchmarkParameters overrides = probe_defaults();
+    for (const auto& override_value : config.overrides) {
+        overrides[override_value.first] = override_value.second;
+    }
+    for (const std::string& name : names) {
+        const BenchmarkRegistry::Entry& entry = *registry_.find(name);
+        probes_.push_back(Probe{name, BenchmarkRunner::resolve_parameters(entry, overrides), entry.factory()});
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        error_message_ = "Failed to create metrics socket";
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.bind_address.c_str(), &address.sin_addr) != 1 ||
+        bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listen_fd_, SOMAXCONN) < 0) {
+        error_message_ = "Failed to bind metrics port " + std::to_string(config.port) +
+                         " on " + config.bind_address;
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    socklen_t address_length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), &address_length);
+    port_ = ntohs(address.sin_port);
+
+    {
+        std::lock_guard<std::mutex> lock(exporter_mutex_);
+        exporter_.set_gauge("canary_interval_seconds", "Configured minimum time between probe rounds",
+                            "gauge", config.interval_seconds);
+        exporter_.set_gauge("canary_cpu_budget_ratio", "Configured CPU budget as a fraction of one CPU",
+                            "gauge", config.cpu_budget);
+        exporter_.set_gauge("canary_rounds_total", "Completed probe rounds", "counter", 0.0);
+    }
+
+    running_ = true;
+    server_thread_ = std::thread(&CanaryDaemon::serve_loop, this);
+    return true;
+#else
+    (void)config;
+    error_message_ = "Canary daemon not supported on this platform";
+    return false;
+#endif
+}
+
+void CanaryDaemon::run(const std::function<bool()>& should_stop) {
+    using Clock = std::chrono::steady_clock;
+    double start_cpu = process_cpu_seconds();
+    std::uint64_t rounds = 0;
+
+    while (running_ && !should_stop()) {
+        Clock::time_point round_start = Clock::now();
+        double round_start_cpu = process_cpu_seconds();
+
+        for (Probe& probe : probes_) {
+            if (should_stop()) {
+                break;
+            }
+            BenchmarkResult result = probe.benchmark->run(probe.parameters);
+            std::lock_guard<std::mutex> lock(exporter_mutex_);
+            exporter_.update(result, unix_time_seconds());
+        }
+
+        double round_cpu = process_cpu_seconds() - round_start_cpu;
+        double round_seconds = std::chrono::duration<double>(Clock::now() - round_start).count();
+        rounds++;
+        {
+            std::lock_guard<std::mutex> lock(exporter_mutex_);
+            exporter_.set_gauge("canary_rounds_total", "Completed probe rounds", "counter",
+                                static_cast<double>(rounds));
+            exporter_.set_gauge("canary_cpu_seconds_total", "CPU time consumed by the daemon",
+                                "counter", process_cpu_seconds() - start_cpu);
+            exporter_.set_gauge("canary_round_duration_seconds", "Wall time of the last probe round",
+                                "gauge", round_seconds);
+        }
+
+        // A round that used C CPU seconds must be spread over C / budget of wall time
+        double period = std::max(config_.interval_seconds, round_cpu / config_.cpu_budget);
+        Clock::time_point next_round = round_start +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+        while (running_ && !should_stop() && Clock::now() < next_round) {
+            std::this_thread::sleep_for(std::min<Clock::duration>(SLEEP_STEP, next_round - Clock::now()));
+        }
+    }
+}
+
+void CanaryDaemon::stop() noexcept {
+#ifdef __linux__
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (server_thread_.joinable()) {
+        server_thread_.join();
+    }
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+#endif
+}
+
+std::uint16_t CanaryDaemon::port() const noexcept {
+    return port_;
+}
+
+const std::string& CanaryDaemon::error_message() const noexcept {
+    return error_message_;
+}
+
+double CanaryDaemon::process_cpu_seconds() noexcept {
+#ifdef __linux__
+    struct timespec cpu_time{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_time) == 0) {
+        return static_cast<double>(cpu_time.tv_sec) + static_cast<double>(cpu_time.tv_nsec) / 1e9;
+    }
+#endif
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+void CanaryDaemon::serve_loop() noexcept {
+#ifdef __linux__
+    while (running_) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = listen_fd_;
+        poll_fd.events = POLLIN;
+        if (poll(&poll_fd, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        int connection_fd = accept(listen_fd_, nullptr, nullptr);
+        if (connection_fd < 0) {
+            continue;
+        }
+        // Scrapes are rare and small: serve them inline, one at a time
+        serve_connection(connection_fd);
+    }
+#endif
+}
+
+void CanaryDaemon::serve_connection(int connection_fd) noexcept {
+#ifdef __linux__
+    try {
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE) {
+            struct pollfd poll_fd{};
+            poll_fd.fd = connection_fd;
+            poll_fd.events = POLLIN;
+            if (poll(&poll_fd, 1, REQUEST_TIMEOUT_MS) <= 0) {
+                break;
+            }
+            ssize_t bytes_received = recv(connection_fd, buffer, sizeof(buffer), 0);
+            if (bytes_received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytes_received <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<std::size_t>(bytes_received));
+        }
+
+        std::string request_line = request.substr(0, request.find("\r\n"));
+        std::string status = "200 OK";
+        std::string content_type = "text/plain; version=0.0.4; charset=utf-8";
+        std::string body;
+        if (request_line.compare(0, 13, "GET /metrics ") == 0 ||
+            request_line.compare(0, 13, "GET /metrics?") == 0) {
+            std::lock_guard<std::mutex> lock(exporter_mutex_);
+            body = exporter_.render();
+        } else if (request_line.compare(0, 4, "GET ") == 0) {
+            status = "404 Not Found";
+            content_type = "text/plain; charset=utf-8";
+            body = "Metrics are served at /metrics\n";
+        } else {
+            status = "405 Method Not Allowed";
+            content_type = "text/plain; charset=utf-8";
+            body = "Only GET is supported\n";
+        }
+
+        send_all(connection_fd, "HTTP/1.1 " + status + "\r\n"
+                                "Content-Type: " + content_type + "\r\n"
+                                "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                                "Connection: close\r\n\r\n" + body);
+    } catch (const std::exception& e) {
+        // Out of memory while rendering: drop this scrape, keep serving
+    }
+    close(connection_fd);
+#else
+    (void)connection_fd;
+#endif
+}
@@ -0,0 +1,145 @@
+/**
+ * canary_daemon.h - Long-running probe loop with a Prometheus endpoint (Linux/POSIX)
+ *
+ * Periodically runs a lightweight set of registered benchmarks under a
+ * CPU budget and serves the latest results on GET /metrics, so every host
+ * can act as its own performance canary.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef CANARY_DAEMON_H
+#define CANARY_DAEMON_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark_registry.h"
+#include "prometheus_exporter.h"
+
+/**
+ * Canary Daemon Module
+ *
+ * Each round runs every probe once, in order. The next round starts after
+ * the interval, or later if needed to keep the daemon's CPU time (all
+ * threads, including the loopback echo server) within the budget
+ * fraction of one core. The /metrics listener runs on its own thread and
+ * answers from the last completed round.
+ *
+ * Example usage:
+ *   CanaryDaemon::Config config;
+ *   config.port = 9100;
+ *   CanaryDaemon daemon(registry);
+ *   if (daemon.start(config)) {
+ *       daemon.run([]() { return stop_requested; });
+ *   }
+ */
+class CanaryDaemon {
+public:
+    /**
+     * Daemon configuration.
+     */
+    struct Config {
+        std::string bind_address = "127.0.0.1";
+        std::uint16_t port = 9100;                      // /metrics port (0 = ephemeral)
+        double interval_seconds = 60.0;                 // Minimum time between round starts
+        double cpu_budget = 0.02;                       // Fraction of one CPU (0.02 = 2%)
+        std::string probes = "memory,cpu,network.rtt";  // Registry names or globs
+        BenchmarkParameters overrides;                  // Applied over probe_defaults()
+    };
+
+    /**
+     * Constructs a stopped daemon.
+     *
+     * @param registry Registry to select probes from (must outlive the daemon)
+     */
+    explicit CanaryDaemon(const BenchmarkRegistry& registry) noexcept;
+
+    /**
+     * Stops the listener if it is still running.
+     */
+    ~CanaryDaemon();
+
+    CanaryDaemon(const CanaryDaemon&) = delete;
+    CanaryDaemon& operator=(const CanaryDaemon&) = delete;
+
+    /**
+     * Resolves the probes and starts the /metrics listener.
+     *
+     * @param config Daemon configuration
+     * @return false on an invalid probe set, override or bind failure
+     */
+    bool start(const Config& config);
+
+    /**
+     * Runs probe rounds on the calling thread until should_stop returns true.
+     *
+     * @param should_stop Polled between probes and while sleeping
+     */
+    void run(const std::function<bool()>& should_stop);
+
+    /**
+     * Stops the listener and joins its thread. Safe to call more than once.
+     */
+    void stop() noexcept;
+
+    /**
+     * Returns the port the /metrics listener is bound to.
+     */
+    std::uint16_t port() const noexcept;
+
+    /**
+     * Returns the last error message from start().
+     */
+    const std::string& error_message() const noexcept;
+
+    /**
+     * Reduced default parameters so a round costs milliseconds, keyed
+     * "benchmark.name" like --param overrides.
+     */
+    static BenchmarkParameters probe_defaults();
+
+private:
+    /**
+     * One resolved probe.
+     */
+    struct Probe {
+        std::string name;
+        BenchmarkParameters parameters;
+        std::unique_ptr<Benchmark> benchmark;
+    };
+
+    /**
+     * Accepts scrape connections until stopped.
+     */
+    void serve_loop() noexcept;
+
+    /**
+     * Answers one HTTP request and closes the connection.
+     *
+     * @param connection_fd Connected socket
+     */
+    void serve_connection(int connection_fd) noexcept;
+
+    /**
+     * Returns CPU seconds consumed by the process so far.
+     */
+    static double process_cpu_seconds() noexcept;
+
+    const BenchmarkRegistry& registry_;
+    Config config_;
+    std::string error_message_;
+    std::vector<Probe> probes_;
+    std::mutex exporter_mutex_;
+    PrometheusExporter exporter_;
+    std::atomic<bool> running_;
+    int listen_fd_;
+    std::uint16_t port_;
+    std::thread server_thread_;
+};
+
+#endif // CANARY_DAEMON_H
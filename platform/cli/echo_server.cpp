@@ -0,0 +1,290 @@
+/**
+ * echo_server.cpp - Built-in echo/sink server implementation
+ */
+
+#include "echo_server.h"
+#include "process_priority.h"
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr int POLL_INTERVAL_MS = 100;
+    constexpr std::size_t TCP_BUFFER_SIZE = 256 * 1024;
+    constexpr std::size_t UDP_BUFFER_SIZE = 65536;
+    constexpr int FAST_OPEN_QUEUE_LENGTH = 64;
+}
+
+EchoServer::EchoServer() noexcept
+    : ports_{0, 0, 0},
+      running_(false),
+      echo_listen_fd_(-1),
+      sink_listen_fd_(-1),
+      udp_fd_(-1) {
+}
+
+EchoServer::~EchoServer() {
+    stop();
+}
+
+bool EchoServer::start(const std::string& bind_address, std::uint16_t base_port) {
+#ifdef __linux__
+    if (running_) {
+        return true;
+    }
+    bind_address_ = bind_address;
+    error_message_.clear();
+
+    echo_listen_fd_ = bind_socket(SOCK_STREAM, base_port, ports_.tcp_echo);
+    if (echo_listen_fd_ < 0) {
+        error_message_ = "Failed to bind TCP echo port";
+        return false;
+    }
+
+    // UDP echo shares the TCP echo port number when it is free
+    udp_fd_ = bind_socket(SOCK_DGRAM, ports_.tcp_echo, ports_.udp_echo);
+    if (udp_fd_ < 0 && base_port == 0) {
+        udp_fd_ = bind_socket(SOCK_DGRAM, 0, ports_.udp_echo);
+    }
+
+    std::uint16_t sink_port = (base_port == 0) ? 0 : static_cast<std::uint16_t>(base_port + 1);
+    sink_listen_fd_ = bind_socket(SOCK_STREAM, sink_port, ports_.tcp_sink);
+
+    if (udp_fd_ < 0 || sink_listen_fd_ < 0) {
+        error_message_ = (udp_fd_ < 0) ? "Failed to bind UDP echo port"
+                                       : "Failed to bind TCP sink port";
+        for (int* fd : {&echo_listen_fd_, &sink_listen_fd_, &udp_fd_}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+        return false;
+    }
+
+    // Accept data in the SYN from Fast Open clients (best-effort: the kernel
+    // still requires net.ipv4.tcp_fastopen bit 1 (value 2, server) to honour it)
+    for (int fd : {echo_listen_fd_, sink_listen_fd_}) {
+        int queue_length = FAST_OPEN_QUEUE_LENGTH;
+        setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_length, sizeof(queue_length));
+    }
+
+    listen(echo_listen_fd_, SOMAXCONN);
+    listen(sink_listen_fd_, SOMAXCONN);
+
+    running_ = true;
+    threads_.emplace_back(&EchoServer::accept_loop, this, echo_listen_fd_, false);
+    threads_.emplace_back(&EchoServer::accept_loop, this, sink_listen_fd_, true);
+    threads_.emplace_back(&EchoServer::udp_loop, this);
+    return true;
+#else
+    (void)bind_address;
+    (void)base_port;
+    error_message_ = "Echo server not supported on this platform";
+    return false;
+#endif
+}
+
+void EchoServer::stop() noexcept {
+#ifdef __linux__
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    // Wake connection threads blocked in recv/send and wait for them to exit
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex_);
+        for (int fd : connection_fds_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        connections_cv_.wait(lock, [this]() { return connection_fds_.empty(); });
+    }
+
+    for (int* fd : {&echo_listen_fd_, &sink_listen_fd_, &udp_fd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+}
+
+bool EchoServer::is_running() const noexcept {
+    return running_;
+}
+
+EchoServer::Ports EchoServer::ports() const noexcept {
+    return ports_;
+}
+
+const std::string& EchoServer::error_message() const noexcept {
+    return error_message_;
+}
+
+int EchoServer::bind_socket(int type, std::uint16_t port, std::uint16_t& bound_port) noexcept {
+#ifdef __linux__
+    int socket_fd = socket(AF_INET, type, 0);
+    if (socket_fd < 0) {
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, bind_address_.c_str(), &address.sin_addr) != 1) {
+        close(socket_fd);
+        return -1;
+    }
+
+    if (bind(socket_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0) {
+        close(socket_fd);
+        return -1;
+    }
+
+    socklen_t address_length = sizeof(address);
+    getsockname(socket_fd, reinterpret_cast<struct sockaddr*>(&address), &address_length);
+    bound_port = ntohs(address.sin_port);
+    return socket_fd;
+#else
+    (void)type;
+    (void)port;
+    (void)bound_port;
+    return -1;
+#endif
+}
+
+void EchoServer::accept_loop(int listen_fd, bool sink) noexcept {
+#ifdef __linux__
+    ProcessPriority::place_worker_thread();
+    while (running_) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = listen_fd;
+        poll_fd.events = POLLIN;
+        if (poll(&poll_fd, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+
+        int connection_fd = accept(listen_fd, nullptr, nullptr);
+        if (connection_fd < 0) {
+            continue;
+        }
+
+        if (!sink) {
+            // Echo replies must not wait for Nagle coalescing
+            int flag = 1;
+            setsockopt(connection_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex_);
+            connection_fds_.push_back(connection_fd);
+        }
+        std::thread(&EchoServer::serve_connection, this, connection_fd, sink).detach();
+    }
+#else
+    (void)listen_fd;
+    (void)sink;
+#endif
+}
+
+void EchoServer::serve_connection(int connection_fd, bool sink) noexcept {
+#ifdef __linux__
+    std::vector<std::uint8_t> buffer(TCP_BUFFER_SIZE);
+    std::uint64_t total_received = 0;
+
+    while (true) {
+        ssize_t bytes_received = recv(connection_fd, buffer.data(), buffer.size(), 0);
+        if (bytes_received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_received <= 0) {
+            break;
+        }
+        total_received += static_cast<std::uint64_t>(bytes_received);
+
+        if (sink) {
+            continue;
+        }
+
+        std::size_t total_sent = 0;
+        std::size_t to_send = static_cast<std::size_t>(bytes_received);
+        while (total_sent < to_send) {
+            ssize_t bytes_sent = send(connection_fd, buffer.data() + total_sent,
+                                      to_send - total_sent, MSG_NOSIGNAL);
+            if (bytes_sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            total_sent += static_cast<std::size_t>(bytes_sent);
+        }
+        if (total_sent < to_send) {
+            break;
+        }
+    }
+
+    if (sink) {
+        // Acknowledge the byte count so the client can stop its clock
+        std::uint8_t ack[8];
+        for (int i = 0; i < 8; ++i) {
+            ack[i] = static_cast<std::uint8_t>(total_received >> (56 - 8 * i));
+        }
+        send(connection_fd, ack, sizeof(ack), MSG_NOSIGNAL);
+    }
+
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    connection_fds_.erase(std::remove(connection_fds_.begin(), connection_fds_.end(), connection_fd),
+                          connection_fds_.end());
+    close(connection_fd);
+    connections_cv_.notify_all();
+#else
+    (void)connection_fd;
+    (void)sink;
+#endif
+}
+
+void EchoServer::udp_loop() noexcept {
+#ifdef __linux__
+    ProcessPriority::place_worker_thread();
+    std::vector<std::uint8_t> buffer(UDP_BUFFER_SIZE);
+
+    while (running_) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = udp_fd_;
+        poll_fd.events = POLLIN;
+        if (poll(&poll_fd, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+
+        struct sockaddr_in peer{};
+        socklen_t peer_length = sizeof(peer);
+        ssize_t bytes_received = recvfrom(udp_fd_, buffer.data(), buffer.size(), 0,
+                                          reinterpret_cast<struct sockaddr*>(&peer), &peer_length);
+        if (bytes_received < 0) {
+            continue;
+        }
+        sendto(udp_fd_, buffer.data(), static_cast<std::size_t>(bytes_received), 0,
+               reinterpret_cast<struct sockaddr*>(&peer), peer_length);
+    }
+#endif
+}
@@ -0,0 +1,141 @@
+/**
+ * echo_server.h - Built-in echo/sink server for network benchmarks (Linux/POSIX)
+ *
+ * Provides a self-contained peer for the persistent RTT, bulk and UDP modes
+ * so network tests can run without external infrastructure.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef ECHO_SERVER_H
+#define ECHO_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Echo Server Module
+ *
+ * Serves three endpoints on background threads:
+ * - TCP echo: every received byte is written back (RTT mode)
+ * - TCP sink: reads until the client half-closes, then replies with the
+ *   8-byte big-endian byte count and closes (bulk mode)
+ * - UDP echo: every datagram is sent back to its source (UDP mode)
+ *
+ * Port convention for a fixed base port P: TCP echo on P, UDP echo on P,
+ * TCP sink on P + 1. A base port of 0 picks free ephemeral ports.
+ * Both TCP listeners accept TCP Fast Open when the kernel allows it.
+ *
+ * Example usage:
+ *   EchoServer server;
+ *   if (server.start("127.0.0.1", 0)) {
+ *       auto ports = server.ports();
+ *       // ... run benchmarks against ports.tcp_echo ...
+ *       server.stop();
+ *   }
+ */
+class EchoServer {
+public:
+    /**
+     * Ports the server is listening on.
+     */
+    struct Ports {
+        std::uint16_t tcp_echo;
+        std::uint16_t tcp_sink;
+        std::uint16_t udp_echo;
+    };
+
+    /**
+     * Constructs a stopped server.
+     */
+    EchoServer() noexcept;
+
+    /**
+     * Stops the server if it is still running.
+     */
+    ~EchoServer();
+
+    EchoServer(const EchoServer&) = delete;
+    EchoServer& operator=(const EchoServer&) = delete;
+
+    /**
+     * Binds all endpoints and starts the serving threads.
+     *
+     * @param bind_address IPv4 address to bind (e.g., "127.0.0.1" or "0.0.0.0")
+     * @param base_port Base port (0 = ephemeral ports)
+     * @return true if all endpoints are listening
+     */
+    bool start(const std::string& bind_address, std::uint16_t base_port);
+
+    /**
+     * Stops serving and joins all threads. Safe to call more than once.
+     */
+    void stop() noexcept;
+
+    /**
+     * Returns true while the server is running.
+     */
+    bool is_running() const noexcept;
+
+    /**
+     * Returns the ports bound by start().
+     */
+    Ports ports() const noexcept;
+
+    /**
+     * Returns the last error message from start().
+     */
+    const std::string& error_message() const noexcept;
+
+private:
+    /**
+     * Accepts TCP connections until stopped.
+     *
+     * @param listen_fd Listening socket
+     * @param sink true to serve the sink protocol, false to echo
+     */
+    void accept_loop(int listen_fd, bool sink) noexcept;
+
+    /**
+     * Echoes UDP datagrams until stopped.
+     */
+    void udp_loop() noexcept;
+
+    /**
+     * Serves a single TCP connection on a detached thread, then
+     * unregisters and closes it.
+     *
+     * @param connection_fd Connected socket
+     * @param sink true to serve the sink protocol, false to echo
+     */
+    void serve_connection(int connection_fd, bool sink) noexcept;
+
+    /**
+     * Creates and binds a socket.
+     *
+     * @param type SOCK_STREAM or SOCK_DGRAM
+     * @param port Port to bind (0 = ephemeral)
+     * @param bound_port Output parameter for the port actually bound
+     * @return Socket file descriptor, or -1 on error
+     */
+    int bind_socket(int type, std::uint16_t port, std::uint16_t& bound_port) noexcept;
+
+    std::string bind_address_;
+    std::string error_message_;
+    Ports ports_;
+    std::atomic<bool> running_;
+    int echo_listen_fd_;
+    int sink_listen_fd_;
+    int udp_fd_;
+    std::vector<std::thread> threads_;
+    std::mutex connections_mutex_;
+    std::condition_variable connections_cv_;
+    std::vector<int> connection_fds_;    // Active connections, shut down by stop()
+};
+
+#endif // ECHO_SERVER_H
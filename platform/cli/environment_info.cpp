@@ -0,0 +1,375 @@
+/**
+ * environment_info.cpp - Host configuration capture implementation
+ */
+
+#include "environment_info.h"
+#include "result_writer.h"
+#include "topology_discovery.h"
+#include "sysfs_util.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifdef __linux__
+#include <dirent.h>
+#endif
+
+namespace {
+    using SysfsUtil::numbered_entries;
+    using SysfsUtil::read_line;
+
+    const std::string CPU_ROOT = "/sys/devices/system/cpu/";
+
+    /**
+     * Returns the bracketed choice of a sysfs selector, e.g. "madvise" from
+     * "always [madvise] never".
+     */
+    std::string selected_value(const std::string& line) {
+        std::string::size_type open = line.find('[');
+        std::string::size_type close = line.find(']', open);
+        if (open == std::string::npos || close == std::string::npos) {
+            return line;
+        }
+        return line.substr(open + 1, close - open - 1);
+    }
+
+    /**
+     * Returns the value of a key=value kernel command line parameter.
+     */
+    std::string cmdline_parameter(const std::string& cmdline, const std::string& key) {
+        std::istringstream words(cmdline);
+        std::string word;
+        while (words >> word) {
+            if (word == "--") {
+                break;      // Remaining words belong to init
+            }
+            if (word.compare(0, key.size() + 1, key + "=") == 0) {
+                return word.substr(key.size() + 1);
+            }
+        }
+        return "";
+    }
+
+    double khz_to_mhz(const std::string& khz) {
+        return khz.empty() ? 0.0 : std::strtod(khz.c_str(), nullptr) / 1000.0;
+    }
+
+    std::string join(const std::vector<std::string>& values) {
+        std::string joined;
+        for (const std::string& value : values) {
+            joined += (joined.empty() ? "" : ", ") + value;
+        }
+        return joined;
+    }
+}
+
+EnvironmentInfo::Results EnvironmentInfo::capture() {
+    Results results{};
+
+    // CPU identity: the first processor is representative
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        std::string::size_type colon = line.find(':');
+        if (colon == std::string::npos) {
+            if (!results.cpu_model.empty()) {
+                break;
+            }
+            continue;
+        }
+        std::string key = line.substr(0, line.find_last_not_of(" \t", colon - 1) + 1);
+        std::string value = (colon + 2 <= line.size()) ? line.substr(colon + 2) : "";
+        if (key == "model name" || (key == "Hardware" && results.cpu_model.empty())) {
+            results.cpu_model = value;
+        } else if (key == "microcode") {
+            results.microcode = value;
+        }
+    }
+    results.online_cpus = read_line(CPU_ROOT + "online");
+
+    results.topology = TopologyDiscovery::discover();
+
+    // Frequency scaling: collect every CPU's governor so a mixed setup shows
+    std::vector<int> cpus = numbered_entries(CPU_ROOT, "cpu");
+    results.hardware_threads = cpus.size();
+    for (int cpu : cpus) {
+        std::string governor = read_line(CPU_ROOT + "cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor");
+        if (!governor.empty() &&
+            std::find(results.governors.begin(), results.governors.end(), governor) == results.governors.end()) {
+            results.governors.push_back(governor);
+        }
+    }
+    std::string cpufreq = CPU_ROOT + "cpu0/cpufreq/";
+    results.scaling_driver = read_line(cpufreq + "scaling_driver");
+    results.current_frequency_mhz = khz_to_mhz(read_line(cpufreq + "scaling_cur_freq"));
+    results.min_frequency_mhz = khz_to_mhz(read_line(cpufreq + "scaling_min_freq"));
+    results.max_frequency_mhz = khz_to_mhz(read_line(cpufreq + "scaling_max_freq"));
+
+    // intel_pstate inverts the sense of the generic boost switch
+    std::string no_turbo = read_line(CPU_ROOT + "intel_pstate/no_turbo");
+    std::string boost = read_line(CPU_ROOT + "cpufreq/boost");
+    if (!no_turbo.empty()) {
+        results.boost = (no_turbo == "0") ? "enabled" : "disabled";
+    } else if (!boost.empty()) {
+        results.boost = (boost == "1") ? "enabled" : "disabled";
+    }
+
+    results.smt_control = read_line(CPU_ROOT + "smt/control");
+    results.smt_active = (read_line(CPU_ROOT + "smt/active") == "1");
+
+    results.transparent_hugepages = selected_value(read_line("/sys/kernel/mm/transparent_hugepage/enabled"));
+    results.transparent_hugepages_defrag = selected_value(read_line("/sys/kernel/mm/transparent_hugepage/defrag"));
+
+    // NUMA layout: node cpulists and per-node memory
+    const std::string node_root = "/sys/devices/system/node/";
+    for (int node : numbered_entries(node_root, "node")) {
+        NumaNode numa_node{node, read_line(node_root + "node" + std::to_string(node) + "/cpulist"), 0};
+        std::ifstream node_meminfo(node_root + "node" + std::to_string(node) + "/meminfo");
+        while (std::getline(node_meminfo, line)) {
+            std::string::size_type position = line.find("MemTotal:");
+            if (position != std::string::npos) {
+                numa_node.memory_total_kb = std::strtoull(line.c_str() + position + 9, nullptr, 10);
+                break;
+            }
+        }
+        results.numa_nodes.push_back(numa_node);
+    }
+
+    std::ifstream loadavg("/proc/loadavg");
+    loadavg >> results.load_average[0] >> results.load_average[1] >> results.load_average[2];
+
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    std::size_t value_kb = 0;
+    while (meminfo >> key >> value_kb) {
+        if (key == "MemTotal:") {
+            results.memory_total_kb = value_kb;
+        } else if (key == "MemAvailable:") {
+            results.memory_available_kb = value_kb;
+        }
+        meminfo.ignore(256, '\n');
+    }
+
+    const std::string vulnerabilities = CPU_ROOT + "vulnerabilities/";
+#ifdef __linux__
+    if (DIR* dir = opendir(vulnerabilities.c_str())) {
+        while (struct dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                results.mitigations.emplace_back(entry->d_name, read_line(vulnerabilities + entry->d_name));
+            }
+        }
+        closedir(dir);
+        std::sort(results.mitigations.begin(), results.mitigations.end());
+    }
+#endif
+
+    std::string cmdline = read_line("/proc/cmdline");
+    results.isolcpus = cmdline_parameter(cmdline, "isolcpus");
+    results.nohz_full = cmdline_parameter(cmdline, "nohz_full");
+    results.mitigations_parameter = cmdline_parameter(cmdline, "mitigations");
+
+    add_warnings(results);
+    return results;
+}
+
+void EnvironmentInfo::add_warnings(Results& results) {
+    if (results.governors.size() > 1) {
+        results.warnings.push_back("CPUs use different frequency governors (" + join(results.governors) +
+                                   "); results depend on which CPU runs the benchmark");
+    } else if (!results.governors.empty() && results.governors.front() != "performance") {
+        results.warnings.push_back("Frequency governor is '" + results.governors.front() +
+                                   "'; ramp-up from low clocks inflates short measurements "
+                                   "(use 'performance')");
+    }
+    if (results.boost == "enabled") {
+        results.warnings.push_back("Turbo/boost is enabled; clocks vary with temperature and "
+                                   "the number of busy cores");
+    }
+    if (results.transparent_hugepages == "always") {
+        results.warnings.push_back("Transparent huge pages are 'always'; memory results depend on "
+                                   "whether buffers happen to be huge-page backed");
+    }
+
+    unsigned long cpu_count = results.hardware_threads > 0 ? results.hardware_threads : 1;
+    double busy_threshold = std::max(1.0, 0.1 * static_cast<double>(cpu_count));
+    if (results.load_average[0] >= busy_threshold) {
+        std::ostringstream message;
+        message << std::fixed << std::setprecision(2)
+                << "1-minute load average is " << results.load_average[0] << " on " << cpu_count
+                << " CPUs; other work is competing with the benchmark";
+        results.warnings.push_back(message.str());
+    }
+    if (results.memory_total_kb > 0 && results.memory_available_kb * 10 < results.memory_total_kb) {
+        results.warnings.push_back("Less than 10% of memory is available; reclaim and swapping "
+                                   "distort memory results");
+    }
+    if (results.numa_nodes.size() > 1) {
+        results.warnings.push_back(std::to_string(results.numa_nodes.size()) +
+                                   " NUMA nodes; pin the benchmark to one node for repeatable "
+                                   "memory results");
+    }
+}
+
+void EnvironmentInfo::print_results(const Results& results) {
+    std::cout << "Host Configuration:\n";
+    std::cout << "------------------------\n";
+    if (!results.cpu_model.empty()) {
+        std::cout << "CPU Model: " << results.cpu_model << "\n";
+    }
+    if (!results.microcode.empty()) {
+        std::cout << "Microcode: " << results.microcode << "\n";
+    }
+    if (!results.online_cpus.empty()) {
+        std::cout << "Online CPUs: " << results.online_cpus << "\n";
+    }
+    const CpuTopology& topology = results.topology;
+    if (!topology.empty()) {
+        std::size_t smt_cores = std::count_if(topology.cores().begin(), topology.cores().end(),
+                                              [](const CpuTopology::Core& core) { return core.cpus.size() > 1; });
+        std::cout << "Topology: " << topology.package_count() << " package(s), "
+                  << topology.cores().size() << " cores, " << topology.cpus().size() << " threads, "
+                  << topology.nodes().size() << " node(s)";
+        if (smt_cores > 0) {
+            std::cout << " (SMT on " << smt_cores << " cores)";
+        }
+        std::cout << "\n";
+    }
+    if (!topology.caches().empty()) {
+        // One entry per level and type with its instance count, e.g. "L2 1024 KB x8"
+        std::vector<std::pair<const CpuTopology::Cache*, std::size_t>> kinds;
+        for (const CpuTopology::Cache& cache : topology.caches()) {
+            auto kind = std::find_if(kinds.begin(), kinds.end(), [&cache](const auto& entry) {
+                return entry.first->level == cache.level && entry.first->type == cache.type;
+            });
+            if (kind == kinds.end()) {
+                kinds.emplace_back(&cache, 1);
+            } else {
+                ++kind->second;
+            }
+        }
+        std::cout << "Caches:";
+        for (const auto& kind : kinds) {
+            const CpuTopology::Cache& cache = *kind.first;
+            std::cout << (&kind == &kinds.front() ? " " : ", ") << "L" << cache.level
+                      << (cache.type == "Data" ? "d" : cache.type == "Instruction" ? "i" : "")
+                      << " " << (cache.size_bytes / 1024) << " KB x" << kind.second;
+        }
+        std::cout << "\n";
+    }
+    if (!results.governors.empty()) {
+        std::cout << "Governor: " << join(results.governors);
+        if (!results.scaling_driver.empty()) {
+            std::cout << " (" << results.scaling_driver << ")";
+        }
+        std::cout << "\n";
+    }
+    if (results.max_frequency_mhz > 0.0) {
+        std::cout << std::fixed << std::setprecision(0)
+                  << "Frequency: " << results.current_frequency_mhz << " MHz (range "
+                  << results.min_frequency_mhz << "-" << results.max_frequency_mhz << " MHz)\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+        std::cout << std::setprecision(6);
+    }
+    if (!results.boost.empty()) {
+        std::cout << "Turbo/Boost: " << results.boost << "\n";
+    }
+    if (!results.smt_control.empty()) {
+        std::cout << "SMT: " << results.smt_control << (results.smt_active ? " (active)" : " (inactive)") << "\n";
+    }
+    if (!results.transparent_hugepages.empty()) {
+        std::cout << "Transparent Huge Pages: " << results.transparent_hugepages
+                  << " (defrag: " << results.transparent_hugepages_defrag << ")\n";
+    }
+    if (!results.numa_nodes.empty()) {
+        std::cout << "NUMA Nodes: " << results.numa_nodes.size() << "\n";
+        for (const NumaNode& node : results.numa_nodes) {
+            std::cout << "  node" << node.id << ": CPUs " << node.cpus
+                      << ", " << (node.memory_total_kb / 1024) << " MB\n";
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "Load Average: " << results.load_average[0] << " " << results.load_average[1]
+              << " " << results.load_average[2] << "\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+    if (results.memory_total_kb > 0) {
+        std::cout << "Memory Available: " << (results.memory_available_kb / 1024) << " MB of "
+                  << (results.memory_total_kb / 1024) << " MB\n";
+    }
+    if (!results.mitigations.empty()) {
+        std::size_t vulnerable = 0;
+        for (const auto& mitigation : results.mitigations) {
+            if (mitigation.second.compare(0, 10, "Vulnerable") == 0) {
+                vulnerable++;
+            }
+        }
+        std::cout << "Mitigations: " << (results.mitigations_parameter.empty() ? "default" : results.mitigations_parameter)
+                  << " (" << results.mitigations.size() << " reported, " << vulnerable << " vulnerable)\n";
+    }
+    std::cout << "isolcpus: " << (results.isolcpus.empty() ? "none" : results.isolcpus) << "\n";
+    std::cout << "nohz_full: " << (results.nohz_full.empty() ? "none" : results.nohz_full) << "\n";
+
+    for (const std::string& warning : results.warnings) {
+        std::cout << "Warning: " << warning << "\n";
+    }
+    std::cout << "\n";
+}
+
+void EnvironmentInfo::write_results(const Results& results, ResultWriter& writer, const std::string& name) {
+    writer.begin_object(name);
+    writer.field("cpu_model", results.cpu_model);
+    writer.field("microcode", results.microcode);
+    writer.field("online_cpus", results.online_cpus);
+    CpuTopology::write_results(results.topology, writer);
+    writer.field("scaling_driver", results.scaling_driver);
+    writer.begin_array("governors");
+    for (const std::string& governor : results.governors) {
+        writer.field("", governor);
+    }
+    writer.end_array();
+    writer.field("current_frequency_mhz", results.current_frequency_mhz);
+    writer.field("min_frequency_mhz", results.min_frequency_mhz);
+    writer.field("max_frequency_mhz", results.max_frequency_mhz);
+    writer.field("boost", results.boost);
+    writer.field("smt_control", results.smt_control);
+    writer.field("smt_active", results.smt_active);
+    writer.field("transparent_hugepages", results.transparent_hugepages);
+    writer.field("transparent_hugepages_defrag", results.transparent_hugepages_defrag);
+
+    writer.begin_array("numa_nodes");
+    for (const NumaNode& node : results.numa_nodes) {
+        writer.begin_object();
+        writer.field("id", node.id);
+        writer.field("cpus", node.cpus);
+        writer.field("memory_total_kb", node.memory_total_kb);
+        writer.end_object();
+    }
+    writer.end_array();
+
+    writer.begin_array("load_average");
+    for (double load : results.load_average) {
+        writer.field("", load);
+    }
+    writer.end_array();
+    writer.field("memory_total_kb", results.memory_total_kb);
+    writer.field("memory_available_kb", results.memory_available_kb);
+
+    writer.begin_object("mitigations");
+    for (const auto& mitigation : results.mitigations) {
+        writer.field(mitigation.first, mitigation.second);
+    }
+    writer.end_object();
+    writer.field("mitigations_parameter", results.mitigations_parameter);
+    writer.field("isolcpus", results.isolcpus);
+    writer.field("nohz_full", results.nohz_full);
+
+    writer.begin_array("warnings");
+    for (const std::string& warning : results.warnings) {
+        writer.field("", warning);
+    }
+    writer.end_array();
+    writer.end_object();
+}
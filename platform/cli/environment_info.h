@@ -0,0 +1,101 @@
+/**
+ * environment_info.h - Host configuration capture (Linux)
+ *
+ * Records the CPU, frequency scaling, memory and kernel settings that
+ * commonly make benchmark results irreproducible, and flags the ones
+ * likely to distort the current run.
+ */
+
+#ifndef ENVIRONMENT_INFO_H
+#define ENVIRONMENT_INFO_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "cpu_topology.h"
+
+class ResultWriter;
+
+/**
+ * Environment Information Module
+ *
+ * Reads /proc and /sys; fields that are unavailable (other platforms,
+ * containers, virtual machines without cpufreq) stay empty or 0 and are
+ * left out of the output.
+ *
+ * Example usage:
+ *   EnvironmentInfo::Results environment = EnvironmentInfo::capture();
+ *   EnvironmentInfo::print_results(environment);
+ */
+class EnvironmentInfo {
+public:
+    /**
+     * One NUMA node.
+     */
+    struct NumaNode {
+        int id;
+        std::string cpus;               // Kernel cpulist, e.g. "0-7,16-23"
+        std::size_t memory_total_kb;
+    };
+
+    /**
+     * Captured host configuration.
+     */
+    struct Results {
+        std::string cpu_model;
+        std::string microcode;
+        std::string online_cpus;                    // Kernel cpulist
+        std::size_t hardware_threads;
+        CpuTopology topology;                       // Cores, SMT siblings, caches
+        std::string scaling_driver;
+        std::vector<std::string> governors;         // Distinct governors across CPUs
+        double current_frequency_mhz;               // CPU 0
+        double min_frequency_mhz;                   // CPU 0 scaling limits
+        double max_frequency_mhz;
+        std::string boost;                          // "enabled", "disabled" or empty
+        std::string smt_control;                    // on, off, forceoff, notsupported, ...
+        bool smt_active;
+        std::string transparent_hugepages;          // Selected mode: always, madvise, never
+        std::string transparent_hugepages_defrag;
+        std::vector<NumaNode> numa_nodes;
+        double load_average[3];                     // 1, 5 and 15 minutes
+        std::size_t memory_total_kb;
+        std::size_t memory_available_kb;
+        std::vector<std::pair<std::string, std::string>> mitigations;   // Vulnerability, status
+        std::string isolcpus;                       // Kernel command line values
+        std::string nohz_full;
+        std::string mitigations_parameter;          // mitigations= on the command line
+        std::vector<std::string> warnings;          // Settings likely to distort results
+    };
+
+    /**
+     * Reads the current configuration and derives the warnings.
+     */
+    static Results capture();
+
+    /**
+     * Prints the configuration followed by any warnings.
+     *
+     * @param results Captured configuration
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes every captured field and the warnings as one object.
+     *
+     * @param results Captured configuration
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "host");
+
+private:
+    /**
+     * Appends a warning for every setting likely to distort results.
+     */
+    static void add_warnings(Results& results);
+};
+
+#endif // ENVIRONMENT_INFO_H
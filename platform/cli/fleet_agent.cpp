@@ -0,0 +1,366 @@
+/**
+ * fleet_agent.cpp - Coordinator-driven suite runner implementation
+ */
+
+#include "fleet_agent.h"
+#include "benchmark_runner.h"
+#include "environment_info.h"
+#include "process_priority.h"
+#include "result_writer.h"
+#include "suite_config.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/utsname.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr int POLL_INTERVAL_MS = 100;
+    constexpr int SUITE_TIMEOUT_MS = 30 * 1000;
+    constexpr int START_TIMEOUT_MS = 30 * 60 * 1000;   // Coordinators wait for every agent's READY
+    constexpr std::size_t MAX_HEADER_BYTES = 64;
+
+    /**
+     * Compares without an early exit, so timing does not reveal the token.
+     */
+    bool tokens_equal(const std::string& expected, const std::string& received) {
+        unsigned char difference = (expected.size() == received.size()) ? 0 : 1;
+        for (std::size_t i = 0; i < received.size(); ++i) {
+            difference |= static_cast<unsigned char>(received[i] ^ expected[i % expected.size()]);
+        }
+        return difference == 0;
+    }
+
+    double unix_time_ms() {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+#ifdef __linux__
+    /**
+     * Waits until the socket is readable; false on timeout or error.
+     */
+    bool wait_readable(int socket_fd, int timeout_ms) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = socket_fd;
+        poll_fd.events = POLLIN;
+        while (true) {
+            int ready = poll(&poll_fd, 1, timeout_ms);
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            return ready > 0;
+        }
+    }
+#endif
+}
+
+FleetAgent::FleetAgent(const BenchmarkRegistry& registry) noexcept
+    : registry_(registry),
+      listen_fd_(-1),
+      port_(0) {
+}
+
+FleetAgent::~FleetAgent() {
+#ifdef __linux__
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+    }
+#endif
+}
+
+bool FleetAgent::start(const Config& config) {
+#ifdef __linux__
+    config_ = config;
+    error_message_.clear();
+    if (config.token.empty()) {
+        error_message_ = "A shared token is required (--agent-token-file)";
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        error_message_ = "Failed to create agent socket";
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.bind_address.c_str(), &address.sin_addr) != 1 ||
+        bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listen_fd_, SOMAXCONN) < 0) {
+        error_message_ = "Failed to bind agent port " + std::to_string(config.port) +
+                         " on " + config.bind_address;
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    socklen_t address_length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), &address_length);
+    port_ = ntohs(address.sin_port);
+
+    node_name_ = config.node_name;
+    if (node_name_.empty()) {
+        struct utsname system_info{};
+        node_name_ = (uname(&system_info) == 0 ? std::string(system_info.nodename) : std::string("agent")) +
+                     ":" + std::to_string(port_);
+    }
+    return true;
+#else
+    (void)config;
+    error_message_ = "Fleet agent not supported on this platform";
+    return false;
+#endif
+}
+
+void FleetAgent::run(const std::function<bool()>& should_stop) {
+#ifdef __linux__
+    while (listen_fd_ >= 0 && !should_stop()) {
+        if (!wait_readable(listen_fd_, POLL_INTERVAL_MS)) {
+            continue;
+        }
+        int connection_fd = accept(listen_fd_, nullptr, nullptr);
+        if (connection_fd < 0) {
+            continue;
+        }
+        // One suite at a time: concurrent suites would measure each other
+        serve_session(connection_fd, should_stop);
+        close(connection_fd);
+    }
+#else
+    (void)should_stop;
+#endif
+}
+
+std::uint16_t FleetAgent::port() const noexcept {
+    return port_;
+}
+
+const std::string& FleetAgent::node_name() const noexcept {
+    return node_name_;
+}
+
+const std::string& FleetAgent::error_message() const noexcept {
+    return error_message_;
+}
+
+bool FleetAgent::send_message(int socket_fd, const std::string& keyword, const std::string& payload) noexcept {
+#ifdef __linux__
+    try {
+        std::string message = keyword + " " + std::to_string(payload.size()) + "\n" + payload;
+        std::size_t total_sent = 0;
+        while (total_sent < message.size()) {
+            ssize_t bytes_sent = send(socket_fd, message.data() + total_sent, message.size() - total_sent,
+                                      MSG_NOSIGNAL);
+            if (bytes_sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            total_sent += static_cast<std::size_t>(bytes_sent);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        return false;
+    }
+#else
+    (void)socket_fd;
+    (void)keyword;
+    (void)payload;
+    return false;
+#endif
+}
+
+bool FleetAgent::receive_message(int socket_fd, int timeout_ms, std::size_t max_bytes, std::string& keyword,
+                                 std::string& payload, std::string& error_message) {
+#ifdef __linux__
+    // Header byte by byte so no payload byte is consumed past the newline
+    std::string header;
+    char byte = 0;
+    while (byte != '\n') {
+        if (header.size() > MAX_HEADER_BYTES) {
+            error_message = "Malformed message header";
+            return false;
+        }
+        if (!wait_readable(socket_fd, timeout_ms)) {
+            error_message = "Timed out waiting for the peer";
+            return false;
+        }
+        ssize_t received = recv(socket_fd, &byte, 1, 0);
+        if (received < 0 && errno == EINTR) {
+            byte = 0;
+            continue;
+        }
+        if (received <= 0) {
+            error_message = "Connection closed by the peer";
+            return false;
+        }
+        header += byte;
+    }
+
+    std::istringstream fields(header);
+    unsigned long long length = 0;
+    if (!(fields >> keyword >> length)) {
+        error_message = "Malformed message header";
+        return false;
+    }
+    if (length > max_bytes) {
+        error_message = keyword + " message too large (" + std::to_string(length) + " bytes)";
+        return false;
+    }
+
+    payload.assign(static_cast<std::size_t>(length), '\0');
+    std::size_t total_received = 0;
+    while (total_received < payload.size()) {
+        if (!wait_readable(socket_fd, timeout_ms)) {
+            error_message = "Timed out waiting for the peer";
+            return false;
+        }
+        ssize_t received = recv(socket_fd, &payload[total_received], payload.size() - total_received, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            error_message = "Connection closed by the peer";
+            return false;
+        }
+        total_received += static_cast<std::size_t>(received);
+    }
+    return true;
+#else
+    (void)socket_fd;
+    (void)timeout_ms;
+    (void)max_bytes;
+    (void)keyword;
+    (void)payload;
+    error_message = "Fleet mode not supported on this platform";
+    return false;
+#endif
+}
+
+bool FleetAgent::read_token_file(const std::string& path, std::string& token, std::string& error_message) {
+    std::ifstream file(path);
+    if (!file) {
+        error_message = "Cannot open token file: " + path;
+        return false;
+    }
+    std::getline(file, token);
+    token.erase(token.find_last_not_of(" \t\r") + 1);
+    if (token.empty()) {
+        error_message = "Token file is empty: " + path;
+        return false;
+    }
+    return true;
+}
+
+void FleetAgent::serve_session(int connection_fd, const std::function<bool()>& should_stop) {
+    std::string keyword;
+    std::string payload;
+    std::string error_message;
+    if (!receive_message(connection_fd, SUITE_TIMEOUT_MS, MAX_SUITE_BYTES, keyword, payload, error_message)) {
+        std::cerr << "Agent: " << error_message << "\n";
+        return;
+    }
+    SuiteConfig suite;
+    std::string::size_type token_end = payload.find('\n');
+    if (keyword != "SUITE") {
+        error_message = "Expected SUITE, got " + keyword;
+    } else if (token_end == std::string::npos || !tokens_equal(config_.token, payload.substr(0, token_end))) {
+        error_message = "Invalid token";
+    } else if (SuiteConfig::parse(payload.substr(token_end + 1), suite, error_message)) {
+        suite.validate(registry_, error_message);
+    }
+    if (!error_message.empty()) {
+        std::cerr << "Agent: Rejected suite: " << error_message << "\n";
+        send_message(connection_fd, "ERROR", error_message);
+        return;
+    }
+    if (!send_message(connection_fd, "READY", node_name_)) {
+        return;
+    }
+
+    // Waits in short slices so SIGINT/SIGTERM is honored before the start
+    for (int waited_ms = 0; !wait_readable(connection_fd, POLL_INTERVAL_MS); waited_ms += POLL_INTERVAL_MS) {
+        if (should_stop()) {
+            send_message(connection_fd, "ERROR", "Agent stopping");
+            return;
+        }
+        if (waited_ms >= START_TIMEOUT_MS) {
+            std::cerr << "Agent: No start from the coordinator\n";
+            return;
+        }
+    }
+    if (!receive_message(connection_fd, START_TIMEOUT_MS, MAX_HEADER_BYTES, keyword, payload, error_message) ||
+        keyword != "START") {
+        std::cerr << "Agent: No start from the coordinator: "
+                  << (error_message.empty() ? "got " + keyword : error_message) << "\n";
+        return;
+    }
+    double start_ms = 0.0;
+    try {
+        start_ms = std::stod(payload);
+    } catch (const std::exception& e) {
+        send_message(connection_fd, "ERROR", "Invalid start time: " + payload);
+        return;
+    }
+    double wait_until_ms = std::min(start_ms, unix_time_ms() + MAX_START_WAIT_MS);
+    for (double wait_ms = wait_until_ms - unix_time_ms(); wait_ms > 0.0; wait_ms = wait_until_ms - unix_time_ms()) {
+        if (should_stop()) {
+            send_message(connection_fd, "ERROR", "Agent stopping");
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(
+            std::min(wait_ms, static_cast<double>(POLL_INTERVAL_MS))));
+    }
+    double start_offset_ms = unix_time_ms() - start_ms;
+
+    std::cout << "Agent: Running " << suite.instances().size() << " suite instances (start offset "
+              << start_offset_ms << " ms)\n" << std::flush;
+    EnvironmentInfo::Results host = EnvironmentInfo::capture();
+    ProcessPriority priority;
+    priority.attempt_raise();
+    auto pin_cpu = [&priority](int cpu, std::string& pin_error) {
+        ProcessPriority::Result result = priority.set_cpu_affinity(cpu);
+        if (result != ProcessPriority::Result::Success) {
+            pin_error = ProcessPriority::result_to_string(result);
+            return false;
+        }
+        return true;
+    };
+    BenchmarkRunner runner;
+    std::string runner_error;
+    std::vector<BenchmarkRunner::Run> runs = runner.run_suite(registry_, suite, false, pin_cpu, runner_error);
+    if (!runner_error.empty()) {
+        send_message(connection_fd, "ERROR", runner_error);
+        return;
+    }
+    BenchmarkRunner::print_summary(runs);
+
+    std::ostringstream document;
+    {
+        ResultWriter writer(document, ResultWriter::Format::Json);
+        writer.begin_object();
+        writer.field("node", node_name_);
+        writer.field("start_offset_ms", start_offset_ms);
+        EnvironmentInfo::write_results(host, writer);
+        BenchmarkRunner::write_results(runs, writer);
+        writer.finish();
+    }
+    send_message(connection_fd, "RESULT", document.str());
+    std::cout << "Agent: Results sent\n" << std::flush;
+}
@@ -0,0 +1,157 @@
+/**
+ * fleet_agent.h - Suite runner controlled by a fleet coordinator (Linux/POSIX)
+ *
+ * Listens on a TCP port, receives a suite from a coordinator, starts it at
+ * the coordinator's start time and returns the runner results, so one
+ * coordinator can run the same suite on many hosts in lockstep.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef FLEET_AGENT_H
+#define FLEET_AGENT_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "benchmark_registry.h"
+
+/**
+ * Fleet Agent Module
+ *
+ * Serves one coordinator session at a time. Every message is framed as
+ * "<KEYWORD> <length>\n" followed by length bytes of payload:
+ *   coordinator -> agent   SUITE   shared token, newline, suite file text
+ *   agent -> coordinator   READY   node name, once the suite validated
+ *   coordinator -> agent   START   start time, Unix epoch milliseconds
+ *   agent -> coordinator   RESULT  JSON: node, start_offset_ms, host, runs
+ * Either side may send ERROR with a message instead and close. A suite
+ * runs benchmarks that can load other hosts (network and HTTP targets),
+ * so the agent listens on loopback unless bound elsewhere and rejects a
+ * SUITE without its token. The agent waits until the start time (at most
+ * MAX_START_WAIT_MS, so a skewed clock cannot stall it) and reports how
+ * late it actually started.
+ *
+ * Example usage:
+ *   FleetAgent::Config config;
+ *   config.port = 9400;
+ *   config.token = shared_secret;
+ *   FleetAgent agent(registry);
+ *   if (agent.start(config)) {
+ *       agent.run([]() { return stop_requested; });
+ *   }
+ */
+class FleetAgent {
+public:
+    static constexpr std::uint16_t DEFAULT_PORT = 9400;
+    static constexpr std::size_t MAX_SUITE_BYTES = 1024 * 1024;
+    static constexpr std::size_t MAX_RESULT_BYTES = 256 * 1024 * 1024;
+    static constexpr int MAX_START_WAIT_MS = 60 * 1000;
+
+    /**
+     * Agent configuration.
+     */
+    struct Config {
+        std::string bind_address = "127.0.0.1"; // Other addresses are an explicit opt-in
+        std::uint16_t port = DEFAULT_PORT;
+        std::string node_name;                  // Empty = "<hostname>:<port>"
+        std::string token;                      // Shared secret coordinators must send (required)
+    };
+
+    /**
+     * Constructs a stopped agent.
+     *
+     * @param registry Registry suites run against (must outlive the agent)
+     */
+    explicit FleetAgent(const BenchmarkRegistry& registry) noexcept;
+
+    /**
+     * Closes the listening socket.
+     */
+    ~FleetAgent();
+
+    FleetAgent(const FleetAgent&) = delete;
+    FleetAgent& operator=(const FleetAgent&) = delete;
+
+    /**
+     * Binds the listening socket.
+     *
+     * @param config Agent configuration
+     * @return false without a token or on bind failure (see error_message())
+     */
+    bool start(const Config& config);
+
+    /**
+     * Serves coordinator sessions on the calling thread until should_stop
+     * returns true. A running suite is finished first.
+     *
+     * @param should_stop Polled while waiting for a coordinator or its START
+     */
+    void run(const std::function<bool()>& should_stop);
+
+    /**
+     * Returns the port the agent listens on.
+     */
+    std::uint16_t port() const noexcept;
+
+    /**
+     * Returns the node name reported to coordinators.
+     */
+    const std::string& node_name() const noexcept;
+
+    /**
+     * Returns the last error message from start().
+     */
+    const std::string& error_message() const noexcept;
+
+    /**
+     * Sends one framed message.
+     *
+     * @param socket_fd Connected socket
+     * @param keyword SUITE, READY, START, RESULT or ERROR
+     * @param payload Message body
+     * @return false if the connection failed
+     */
+    static bool send_message(int socket_fd, const std::string& keyword, const std::string& payload) noexcept;
+
+    /**
+     * Receives one framed message.
+     *
+     * @param socket_fd Connected socket
+     * @param timeout_ms Longest wait for any part of the message
+     * @param max_bytes Largest accepted payload
+     * @param keyword Output parameter for the keyword
+     * @param payload Output parameter for the body
+     * @param error_message Set on timeout, disconnect or a malformed header
+     * @return true on success
+     */
+    static bool receive_message(int socket_fd, int timeout_ms, std::size_t max_bytes, std::string& keyword,
+                                std::string& payload, std::string& error_message);
+
+    /**
+     * Reads a shared token from the first line of a file.
+     *
+     * @param path Token file (keeps the secret out of the process list)
+     * @param token Output parameter for the token
+     * @param error_message Set if the file cannot be read or the token is empty
+     * @return true on success
+     */
+    static bool read_token_file(const std::string& path, std::string& token, std::string& error_message);
+
+private:
+    /**
+     * Runs one coordinator session; the caller closes the connection.
+     *
+     * @param connection_fd Connected socket
+     * @param should_stop Abandons the session while it waits for START
+     */
+    void serve_session(int connection_fd, const std::function<bool()>& should_stop);
+
+    const BenchmarkRegistry& registry_;
+    Config config_;
+    std::string node_name_;
+    std::string error_message_;
+    int listen_fd_;
+    std::uint16_t port_;
+};
+
+#endif // FLEET_AGENT_H
@@ -0,0 +1,262 @@
+/**
+ * fleet_coordinator.cpp - Lockstep fleet run implementation
+ */
+
+#include "fleet_coordinator.h"
+#include "fleet_agent.h"
+#include "json_value.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /**
+     * Connection state of one agent across the phases.
+     */
+    struct Session {
+        int socket_fd = -1;
+        bool ready = false;
+        FleetReport::Node node;
+    };
+
+    std::string agent_address(const FleetCoordinator::Agent& agent) {
+        return agent.host + ":" + std::to_string(agent.port);
+    }
+
+    int to_ms(double seconds) {
+        return static_cast<int>(std::min(seconds * 1000.0, 2147483647.0));
+    }
+
+    /**
+     * Calls work(i) for every i below count on up to MAX_WORKERS threads.
+     */
+    template <typename Work>
+    void for_each_agent(std::size_t count, Work work) {
+        std::atomic<std::size_t> next(0);
+        std::vector<std::thread> workers;
+        std::size_t worker_count = std::min(count, FleetCoordinator::MAX_WORKERS);
+        for (std::size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&next, &work, count]() {
+                for (std::size_t i = next++; i < count; i = next++) {
+                    work(i);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+#ifdef __linux__
+    /**
+     * Connects with a timeout. Returns the socket, or -1 with error_message set.
+     */
+    int connect_agent(const FleetCoordinator::Agent& agent, int timeout_ms, std::string& error_message) {
+        struct addrinfo hints{};
+        struct addrinfo* result = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        int status = getaddrinfo(agent.host.c_str(), std::to_string(agent.port).c_str(), &hints, &result);
+        if (status != 0) {
+            error_message = std::string("Cannot resolve host: ") + gai_strerror(status);
+            return -1;
+        }
+        int socket_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (socket_fd < 0) {
+            error_message = std::string("Cannot create socket: ") + std::strerror(errno);
+            freeaddrinfo(result);
+            return -1;
+        }
+
+        int flags = fcntl(socket_fd, F_GETFL, 0);
+        fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK);
+        int connect_result = connect(socket_fd, result->ai_addr, result->ai_addrlen);
+        freeaddrinfo(result);
+        int connect_error = (connect_result == 0) ? 0 : errno;
+        if (connect_error == EINPROGRESS) {
+            struct pollfd poll_fd{};
+            poll_fd.fd = socket_fd;
+            poll_fd.events = POLLOUT;
+            if (poll(&poll_fd, 1, timeout_ms) <= 0) {
+                connect_error = ETIMEDOUT;
+            } else {
+                socklen_t length = sizeof(connect_error);
+                getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &connect_error, &length);
+            }
+        }
+        if (connect_error != 0) {
+            error_message = std::string("Cannot connect: ") + std::strerror(connect_error);
+            close(socket_fd);
+            return -1;
+        }
+        fcntl(socket_fd, F_SETFL, flags);
+        return socket_fd;
+    }
+
+    /**
+     * Raises the open-file soft limit to the hard limit; returns the limit.
+     */
+    rlim_t raise_file_limit() {
+        struct rlimit limit{};
+        if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            return 0;
+        }
+        if (limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+            getrlimit(RLIMIT_NOFILE, &limit);
+        }
+        return limit.rlim_cur;
+    }
+#endif
+}
+
+bool FleetCoordinator::parse_agents(const std::string& list, std::vector<Agent>& agents,
+                                    std::string& error_message) {
+    std::string separated = list;
+    std::replace(separated.begin(), separated.end(), ',', ' ');
+    std::istringstream addresses(separated);
+    std::string address;
+    while (addresses >> address) {
+        Agent agent{address, FleetAgent::DEFAULT_PORT};
+        std::string::size_type colon = address.rfind(':');
+        if (colon != std::string::npos) {
+            agent.host = address.substr(0, colon);
+            std::string port = address.substr(colon + 1);
+            unsigned long port_value = 0;
+            if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos ||
+                (port_value = std::stoul(port)) == 0 || port_value > 65535) {
+                error_message = "Invalid agent port: " + address;
+                return false;
+            }
+            agent.port = static_cast<std::uint16_t>(port_value);
+        }
+        if (agent.host.empty()) {
+            error_message = "Invalid agent address: " + address;
+            return false;
+        }
+        agents.push_back(agent);
+    }
+    return true;
+}
+
+FleetReport::Results FleetCoordinator::run(const Config& config) {
+    FleetReport::Results results{};
+    results.benchmark_successful = false;
+    if (config.agents.empty()) {
+        results.error_message = "No agents";
+        return results;
+    }
+
+#ifdef __linux__
+    rlim_t file_limit = raise_file_limit();
+    if (file_limit != 0 && file_limit != RLIM_INFINITY && file_limit < config.agents.size() + 32) {
+        results.error_message = "Open-file limit (" + std::to_string(file_limit) + ") is too low for " +
+                                std::to_string(config.agents.size()) + " agents; raise ulimit -n";
+        return results;
+    }
+
+    std::vector<Session> sessions(config.agents.size());
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        sessions[i].node.address = agent_address(config.agents[i]);
+        sessions[i].node.name = sessions[i].node.address;
+        sessions[i].node.benchmark_successful = false;
+    }
+
+    // Phase 1: every agent validates the suite before any of them starts
+    for_each_agent(sessions.size(), [&](std::size_t i) {
+        Session& session = sessions[i];
+        std::string error_message;
+        session.socket_fd = connect_agent(config.agents[i], to_ms(config.connect_timeout_seconds), error_message);
+        std::string keyword;
+        std::string payload;
+        if (session.socket_fd >= 0) {
+            if (!FleetAgent::send_message(session.socket_fd, "SUITE", config.token + "\n" + config.suite_text)) {
+                error_message = "Cannot send the suite";
+            } else if (FleetAgent::receive_message(session.socket_fd, to_ms(config.connect_timeout_seconds),
+                                                   FleetAgent::MAX_SUITE_BYTES, keyword, payload,
+                                                   error_message)) {
+                if (keyword == "READY") {
+                    session.ready = true;
+                    session.node.name = payload.empty() ? session.node.address : payload;
+                } else {
+                    error_message = (keyword == "ERROR") ? payload : "Unexpected " + keyword + " message";
+                }
+            }
+        }
+        session.node.error_message = error_message;
+    });
+    std::size_t ready = static_cast<std::size_t>(std::count_if(sessions.begin(), sessions.end(),
+                                                               [](const Session& s) { return s.ready; }));
+    std::cout << "  Ready: " << ready << " of " << sessions.size() << " agents\n" << std::flush;
+
+    // Phase 2: one absolute start time; agents report how late they started
+    if (ready > 0) {
+        double start_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::system_clock::now().time_since_epoch()).count() + config.start_delay_seconds * 1000.0;
+        std::ostringstream start_time;
+        start_time << std::fixed << std::setprecision(0) << start_ms;
+        for_each_agent(sessions.size(), [&](std::size_t i) {
+            Session& session = sessions[i];
+            if (session.ready && !FleetAgent::send_message(session.socket_fd, "START", start_time.str())) {
+                session.ready = false;
+                session.node.error_message = "Cannot send the start time";
+            }
+        });
+        std::cout << "  Started; waiting for results\n" << std::flush;
+    }
+
+    // Phase 3: results arrive as agents finish
+    for_each_agent(sessions.size(), [&](std::size_t i) {
+        Session& session = sessions[i];
+        if (session.ready) {
+            std::string keyword;
+            std::string payload;
+            std::string error_message;
+            JsonValue document;
+            if (!FleetAgent::receive_message(session.socket_fd, to_ms(config.result_timeout_seconds),
+                                             FleetAgent::MAX_RESULT_BYTES, keyword, payload, error_message)) {
+                session.node.error_message = error_message;
+            } else if (keyword != "RESULT") {
+                session.node.error_message = (keyword == "ERROR") ? payload : "Unexpected " + keyword + " message";
+            } else if (!JsonValue::parse(payload, document, error_message)) {
+                session.node.error_message = "Invalid result document: " + error_message;
+            } else {
+                session.node = FleetReport::parse_node(session.node.address, document);
+            }
+        }
+        if (session.socket_fd >= 0) {
+            close(session.socket_fd);
+            session.socket_fd = -1;
+        }
+    });
+
+    for (Session& session : sessions) {
+        results.nodes.push_back(std::move(session.node));
+    }
+    if (ready == 0) {
+        results.error_message = "No agent accepted the suite";
+    }
+    FleetReport::aggregate(results, config.report);
+#else
+    results.error_message = "Fleet coordinator not supported on this platform";
+#endif
+    return results;
+}
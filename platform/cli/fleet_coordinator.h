@@ -0,0 +1,84 @@
+/**
+ * fleet_coordinator.h - Runs one suite on many fleet agents in lockstep (Linux/POSIX)
+ *
+ * Replaces ssh loops and ad-hoc parsing: pushes a suite to every agent,
+ * starts them all at the same wall-clock time, collects their results and
+ * reduces them to fleet aggregates and per-node outliers.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef FLEET_COORDINATOR_H
+#define FLEET_COORDINATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "fleet_report.h"
+
+/**
+ * Fleet Coordinator Module
+ *
+ * Speaks the FleetAgent protocol in three phases, each spread over at most
+ * MAX_WORKERS threads so thousands of agents need no thread apiece:
+ *   1. connect, send SUITE, wait for READY (agents that fail drop out)
+ *   2. send START with one start time, start_delay_seconds from now
+ *   3. wait for every RESULT
+ * Connections stay open from phase 1 to 3, so the open-file limit is
+ * raised to its hard limit and must exceed the agent count.
+ *
+ * Example usage:
+ *   FleetCoordinator::Config config;
+ *   FleetCoordinator::parse_agents("10.0.0.1,10.0.0.2:9500", config.agents, error);
+ *   config.suite_text = suite_file_contents;
+ *   config.token = shared_secret;
+ *   FleetReport::Results results = FleetCoordinator::run(config);
+ *   FleetReport::print_results(results);
+ */
+class FleetCoordinator {
+public:
+    static constexpr std::size_t MAX_WORKERS = 64;
+
+    /**
+     * One agent address.
+     */
+    struct Agent {
+        std::string host;
+        std::uint16_t port;
+    };
+
+    /**
+     * Coordinator configuration.
+     */
+    struct Config {
+        std::vector<Agent> agents;
+        std::string suite_text;                 // Suite file contents, sent verbatim
+        std::string token;                      // Shared secret the agents were started with
+        double connect_timeout_seconds = 10.0;  // Connect and READY, per agent
+        double start_delay_seconds = 2.0;       // Lead time for START to reach every agent
+        double result_timeout_seconds = 3600.0; // Longest suite run
+        FleetReport::Config report;
+    };
+
+    /**
+     * Parses agent addresses separated by commas or whitespace, each
+     * "host" or "host:port" (default FleetAgent::DEFAULT_PORT).
+     *
+     * @param list Address list
+     * @param agents Parsed agents are appended here
+     * @param error_message Set for the first invalid address
+     * @return true on success
+     */
+    static bool parse_agents(const std::string& list, std::vector<Agent>& agents, std::string& error_message);
+
+    /**
+     * Runs the suite on every agent and aggregates the results. Nodes are
+     * reported in agent order; unreachable agents are failed nodes.
+     *
+     * @param config Agents, suite and timeouts
+     * @return Fleet results (error_message set when no agent could start)
+     */
+    static FleetReport::Results run(const Config& config);
+};
+
+#endif // FLEET_COORDINATOR_H
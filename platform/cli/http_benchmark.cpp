@@ -0,0 +1,787 @@
+/**
+ * http_benchmark.cpp - HTTP/1.1 keep-alive load generation implementation
+ */
+
+#include "http_benchmark.h"
+#include "statistics.h"
+#include "timer.h"
+#include "result_writer.h"
+#include "trace_recorder.h"
+#include "process_priority.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <cerrno>
+#include <deque>
+#include <map>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::size_t RECV_BUFFER_SIZE = 64 * 1024;
+    constexpr std::size_t MAX_CHUNK_SIZE_LINE = 1024;
+    constexpr std::size_t MAX_CONSECUTIVE_RECONNECTS = 3;
+
+    char to_lower_ascii(char c) noexcept {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool equals_ignore_case(const char* data, std::size_t length, const char* literal) noexcept {
+        std::size_t literal_length = std::strlen(literal);
+        if (length != literal_length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            if (to_lower_ascii(data[i]) != literal[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool contains_ignore_case(const char* data, std::size_t length, const char* literal) noexcept {
+        std::size_t literal_length = std::strlen(literal);
+        if (literal_length > length) {
+            return false;
+        }
+        for (std::size_t start = 0; start + literal_length <= length; ++start) {
+            if (equals_ignore_case(data + start, literal_length, literal)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Finds a byte sequence within a buffer without copying.
+     * Returns the offset of the first match or length if not found.
+     */
+    std::size_t find_sequence(const char* data, std::size_t length,
+                              const char* needle, std::size_t needle_length) noexcept {
+        if (needle_length == 0 || length < needle_length) {
+            return length;
+        }
+        const char* end = data + length - needle_length + 1;
+        for (const char* p = data; p < end; ++p) {
+            p = static_cast<const char*>(std::memchr(p, needle[0], static_cast<std::size_t>(end - p)));
+            if (p == nullptr) {
+                break;
+            }
+            if (std::memcmp(p, needle, needle_length) == 0) {
+                return static_cast<std::size_t>(p - data);
+            }
+        }
+        return length;
+    }
+
+#ifdef __linux__
+    int open_connection(const std::string& host, std::uint16_t port) noexcept {
+        struct addrinfo hints{};
+        struct addrinfo* result = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+
+        std::string port_string = std::to_string(port);
+        if (getaddrinfo(host.c_str(), port_string.c_str(), &hints, &result) != 0) {
+            return -1;
+        }
+
+        int socket_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (socket_fd < 0) {
+            freeaddrinfo(result);
+            return -1;
+        }
+
+        struct timeval timeout{};
+        timeout.tv_sec = 5;
+        timeout.tv_usec = 0;
+        setsockopt(socket_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        setsockopt(socket_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        // Requests are small; do not let Nagle hold them back
+        int flag = 1;
+        setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+        int connect_result = connect(socket_fd, result->ai_addr, result->ai_addrlen);
+        freeaddrinfo(result);
+
+        if (connect_result < 0) {
+            close(socket_fd);
+            return -1;
+        }
+        return socket_fd;
+    }
+
+    bool send_all(int socket_fd, const char* data, std::size_t size) noexcept {
+        std::size_t total_sent = 0;
+        while (total_sent < size) {
+            ssize_t bytes_sent = send(socket_fd, data + total_sent, size - total_sent, MSG_NOSIGNAL);
+            if (bytes_sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            total_sent += static_cast<std::size_t>(bytes_sent);
+        }
+        return true;
+    }
+#endif
+}
+
+HttpResponseParser::HttpResponseParser() noexcept {
+    reset();
+}
+
+void HttpResponseParser::reset() noexcept {
+    phase_ = Phase::Headers;
+    status_code_ = 0;
+    connection_close_ = false;
+    chunked_ = false;
+    has_content_length_ = false;
+    remaining_ = 0;
+    body_bytes_ = 0;
+}
+
+HttpResponseParser::State HttpResponseParser::feed(
+    const char* data,
+    std::size_t length,
+    std::size_t& consumed
+) noexcept {
+    consumed = 0;
+
+    while (phase_ != Phase::Done) {
+        const char* cursor = data + consumed;
+        std::size_t available = length - consumed;
+
+        switch (phase_) {
+            case Phase::Headers: {
+                std::size_t end = find_sequence(cursor, available, "\r\n\r\n", 4);
+                if (end == available) {
+                    return State::Incomplete;
+                }
+                std::size_t header_length = end + 4;
+                if (!parse_headers(cursor, header_length)) {
+                    return State::Error;
+                }
+                consumed += header_length;
+
+                // Interim responses (100 Continue, 103 Early Hints) precede
+                // the final response to the same request
+                if (status_code_ < 200) {
+                    reset();
+                    break;
+                }
+                // 204 and 304 responses never carry a body
+                if (status_code_ == 204 || status_code_ == 304) {
+                    phase_ = Phase::Done;
+                } else if (chunked_) {
+                    phase_ = Phase::ChunkSize;
+                } else if (!has_content_length_) {
+                    // Read-until-close body: cannot be used with keep-alive
+                    return State::Error;
+                } else if (remaining_ > 0) {
+                    phase_ = Phase::FixedBody;
+                } else {
+                    phase_ = Phase::Done;
+                }
+                break;
+            }
+
+            case Phase::FixedBody:
+            case Phase::ChunkData: {
+                if (available == 0) {
+                    return State::Incomplete;
+                }
+                // Skip body bytes in place - they are never copied
+                std::size_t take = std::min(remaining_, available);
+                consumed += take;
+                remaining_ -= take;
+                body_bytes_ += take;
+                if (remaining_ == 0) {
+                    phase_ = (phase_ == Phase::FixedBody) ? Phase::Done : Phase::ChunkDataEnd;
+                }
+                break;
+            }
+
+            case Phase::ChunkSize: {
+                std::size_t line_end = find_sequence(cursor, available, "\r\n", 2);
+                if (line_end == available) {
+                    return available > MAX_CHUNK_SIZE_LINE ? State::Error : State::Incomplete;
+                }
+
+                std::size_t chunk_size = 0;
+                std::size_t digits = 0;
+                for (std::size_t i = 0; i < line_end; ++i) {
+                    char c = to_lower_ascii(cursor[i]);
+                    int value = -1;
+                    if (c >= '0' && c <= '9') {
+                        value = c - '0';
+                    } else if (c >= 'a' && c <= 'f') {
+                        value = c - 'a' + 10;
+                    } else if (c == ';' || c == ' ' || c == '\t') {
+                        break;  // Chunk extensions are ignored
+                    } else {
+                        return State::Error;
+                    }
+                    if (chunk_size > (static_cast<std::size_t>(-1) >> 4)) {
+                        return State::Error;
+                    }
+                    chunk_size = (chunk_size << 4) | static_cast<std::size_t>(value);
+                    ++digits;
+                }
+                if (digits == 0) {
+                    return State::Error;
+                }
+
+                consumed += line_end + 2;
+                remaining_ = chunk_size;
+                phase_ = (chunk_size == 0) ? Phase::Trailers : Phase::ChunkData;
+                break;
+            }
+
+            case Phase::ChunkDataEnd: {
+                if (available < 2) {
+                    return State::Incomplete;
+                }
+                if (cursor[0] != '\r' || cursor[1] != '\n') {
+                    return State::Error;
+                }
+                consumed += 2;
+                phase_ = Phase::ChunkSize;
+                break;
+            }
+
+            case Phase::Trailers: {
+                std::size_t line_end = find_sequence(cursor, available, "\r\n", 2);
+                if (line_end == available) {
+                    return State::Incomplete;
+                }
+                consumed += line_end + 2;
+                if (line_end == 0) {
+                    phase_ = Phase::Done;
+                }
+                break;
+            }
+
+            case Phase::Done:
+                break;
+        }
+    }
+
+    return State::Complete;
+}
+
+bool HttpResponseParser::parse_headers(const char* data, std::size_t length) noexcept {
+    // Status line: HTTP/1.x SSS Reason
+    if (length < 12 || std::memcmp(data, "HTTP/1.", 7) != 0 || data[8] != ' ') {
+        return false;
+    }
+    bool http_1_0 = (data[7] == '0');
+
+    int status = 0;
+    for (std::size_t i = 9; i < 12; ++i) {
+        if (data[i] < '0' || data[i] > '9') {
+            return false;
+        }
+        status = status * 10 + (data[i] - '0');
+    }
+    status_code_ = status;
+
+    bool keep_alive_requested = false;
+    std::size_t line_start = find_sequence(data, length, "\r\n", 2) + 2;
+
+    while (line_start < length) {
+        const char* line = data + line_start;
+        std::size_t line_length = find_sequence(line, length - line_start, "\r\n", 2);
+        if (line_length == 0) {
+            break;  // Blank line terminating the header block
+        }
+
+        std::size_t colon = find_sequence(line, line_length, ":", 1);
+        if (colon < line_length) {
+            const char* value = line + colon + 1;
+            std::size_t value_length = line_length - colon - 1;
+            while (value_length > 0 && (*value == ' ' || *value == '\t')) {
+                ++value;
+                --value_length;
+            }
+
+            if (equals_ignore_case(line, colon, "content-length")) {
+                while (value_length > 0 && (value[value_length - 1] == ' ' || value[value_length - 1] == '\t')) {
+                    --value_length;
+                }
+                if (value_length == 0) {
+                    return false;
+                }
+                std::size_t content_length = 0;
+                for (std::size_t i = 0; i < value_length; ++i) {
+                    if (value[i] < '0' || value[i] > '9') {
+                        return false;
+                    }
+                    if (content_length > (static_cast<std::size_t>(-1) - 9) / 10) {
+                        return false;
+                    }
+                    content_length = content_length * 10 + static_cast<std::size_t>(value[i] - '0');
+                }
+                remaining_ = content_length;
+                has_content_length_ = true;
+            } else if (equals_ignore_case(line, colon, "transfer-encoding")) {
+                chunked_ = contains_ignore_case(value, value_length, "chunked");
+            } else if (equals_ignore_case(line, colon, "connection")) {
+                if (contains_ignore_case(value, value_length, "close")) {
+                    connection_close_ = true;
+                } else if (contains_ignore_case(value, value_length, "keep-alive")) {
+                    keep_alive_requested = true;
+                }
+            }
+        }
+
+        line_start += line_length + 2;
+    }
+
+    // HTTP/1.0 closes after every response unless keep-alive was negotiated
+    if (http_1_0 && !keep_alive_requested) {
+        connection_close_ = true;
+    }
+    if (chunked_) {
+        remaining_ = 0;
+    }
+    return true;
+}
+
+HttpBenchmark::HttpBenchmark() noexcept {
+}
+
+std::string HttpBenchmark::build_request(const Config& config) {
+    std::string request;
+    request.reserve(256 + config.body_size_bytes);
+    request += config.method;
+    request += " ";
+    request += config.path;
+    request += " HTTP/1.1\r\nHost: ";
+    request += config.host;
+    if (config.port != 80) {
+        request += ":" + std::to_string(config.port);
+    }
+    request += "\r\nUser-Agent: SystemBenchmark\r\nAccept: */*\r\nConnection: keep-alive\r\n";
+
+    if (config.body_size_bytes > 0 || config.method == "POST" || config.method == "PUT") {
+        request += "Content-Type: application/octet-stream\r\n";
+        request += "Content-Length: " + std::to_string(config.body_size_bytes) + "\r\n";
+    }
+    request += "\r\n";
+
+    // Body uses the same repeating pattern as the other network payloads
+    for (std::size_t i = 0; i < config.body_size_bytes; ++i) {
+        request += static_cast<char>('a' + (i % 26));
+    }
+    return request;
+}
+
+HttpBenchmark::Results HttpBenchmark::run(const Config& config) {
+    Results results{};
+    results.config = config;
+    results.benchmark_successful = false;
+
+    // Validate inputs
+    if (config.host.empty()) {
+        results.error_message = "Target host must be specified";
+        return results;
+    }
+    if (config.connections == 0 || config.total_requests == 0 || config.pipeline_depth == 0) {
+        results.error_message = "Connections, requests and pipeline depth must be greater than 0";
+        return results;
+    }
+    if (config.path.empty() || config.path[0] != '/') {
+        results.error_message = "Request path must start with '/'";
+        return results;
+    }
+
+#ifdef __linux__
+    const std::string request = build_request(config);
+    std::size_t connection_count = std::min(config.connections, config.total_requests);
+
+    std::atomic<std::size_t> next_request{0};
+    std::vector<ConnectionStats> connection_stats(connection_count);
+    std::vector<std::thread> workers;
+    workers.reserve(connection_count);
+
+    Timer total_timer;
+    total_timer.start();
+
+    for (std::size_t i = 0; i < connection_count; ++i) {
+        workers.emplace_back(connection_worker, std::cref(config), std::cref(request),
+                             std::ref(next_request), std::ref(connection_stats[i]));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    results.total_time_seconds = total_timer.elapsed_seconds();
+
+    // Merge per-connection statistics
+    std::map<int, std::vector<double>> latencies_by_status;
+    for (const ConnectionStats& stats : connection_stats) {
+        results.requests_sent += stats.requests_sent;
+        results.failed_requests += stats.failed_requests;
+        results.reconnects += stats.reconnects;
+        results.body_bytes_received += stats.body_bytes_received;
+        for (const auto& entry : stats.latencies_ms) {
+            latencies_by_status[entry.first].push_back(entry.second);
+        }
+        if (results.error_message.empty() && !stats.error_message.empty()) {
+            results.error_message = stats.error_message;
+        }
+    }
+
+    for (auto& entry : latencies_by_status) {
+        std::vector<double>& latencies = entry.second;
+        std::sort(latencies.begin(), latencies.end());
+
+        StatusStats status_stats{};
+        status_stats.status_code = entry.first;
+        status_stats.count = latencies.size();
+        status_stats.avg_latency_ms = Statistics::mean(latencies);
+        status_stats.min_latency_ms = latencies.front();
+        status_stats.p50_latency_ms = Statistics::percentile_sorted(latencies, 50.0);
+        status_stats.p90_latency_ms = Statistics::percentile_sorted(latencies, 90.0);
+        status_stats.p99_latency_ms = Statistics::percentile_sorted(latencies, 99.0);
+        status_stats.max_latency_ms = latencies.back();
+        status_stats.latency_ci = Statistics::bootstrap_summary_sorted(latencies);
+        results.status_stats.push_back(status_stats);
+
+        results.responses_received += latencies.size();
+    }
+
+    if (results.total_time_seconds > 0.0) {
+        results.requests_per_second = static_cast<double>(results.responses_received)
+                                      / results.total_time_seconds;
+    }
+    results.benchmark_successful = (results.responses_received > 0);
+    if (!results.benchmark_successful && results.error_message.empty()) {
+        results.error_message = "No responses received";
+    }
+#else
+    results.error_message = "HTTP benchmarking not supported on this platform";
+#endif
+
+    return results;
+}
+
+void HttpBenchmark::connection_worker(
+    const Config& config,
+    const std::string& request,
+    std::atomic<std::size_t>& next_request,
+    ConnectionStats& stats
+) noexcept {
+#ifdef __linux__
+    using Clock = std::chrono::steady_clock;
+    TraceRecorder::set_thread_name("http.connection");
+    ProcessPriority::place_worker_thread();
+    TraceScope worker_scope("connection_worker", "http");
+
+    std::vector<char> recv_buffer(RECV_BUFFER_SIZE);
+    std::size_t buffered = 0;
+    std::deque<Clock::time_point> in_flight;
+    HttpResponseParser parser;
+    std::size_t consecutive_reconnects = 0;
+    bool claims_exhausted = false;
+    bool first_connection = true;
+    int socket_fd = -1;
+
+    // Drops the connection; every request still in flight is lost
+    auto drop_connection = [&]() {
+        if (socket_fd >= 0) {
+            close(socket_fd);
+            socket_fd = -1;
+        }
+        stats.failed_requests += in_flight.size();
+        in_flight.clear();
+        parser.reset();
+        buffered = 0;
+    };
+
+    while (true) {
+        if (socket_fd < 0) {
+            if (claims_exhausted) {
+                break;
+            }
+            if (!first_connection) {
+                if (consecutive_reconnects >= MAX_CONSECUTIVE_RECONNECTS) {
+                    stats.error_message = "Server repeatedly closed connections";
+                    break;
+                }
+                stats.reconnects++;
+                consecutive_reconnects++;
+            }
+            TraceRecorder::begin("connect", "http");
+            socket_fd = open_connection(config.host, config.port);
+            TraceRecorder::end("connect", "http");
+            if (socket_fd < 0) {
+                stats.error_message = "Failed to establish connection";
+                break;
+            }
+            first_connection = false;
+        }
+
+        // Keep the pipeline full
+        bool send_failed = false;
+        while (!claims_exhausted && in_flight.size() < config.pipeline_depth) {
+            std::size_t ticket = next_request.fetch_add(1, std::memory_order_relaxed);
+            if (ticket >= config.total_requests) {
+                claims_exhausted = true;
+                break;
+            }
+            in_flight.push_back(Clock::now());
+            stats.requests_sent++;
+            if (!send_all(socket_fd, request.data(), request.size())) {
+                send_failed = true;
+                break;
+            }
+        }
+        if (send_failed) {
+            drop_connection();
+            continue;
+        }
+        if (in_flight.empty()) {
+            break;
+        }
+
+        if (buffered == recv_buffer.size()) {
+            stats.error_message = "Response headers exceed receive buffer";
+            drop_connection();
+            break;
+        }
+
+        // Time blocked waiting for responses shows server stalls per connection
+        TraceRecorder::begin("recv", "http");
+        ssize_t bytes_received = recv(socket_fd, recv_buffer.data() + buffered,
+                                      recv_buffer.size() - buffered, 0);
+        TraceRecorder::end("recv", "http");
+        if (bytes_received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_received <= 0) {
+            drop_connection();
+            continue;
+        }
+        buffered += static_cast<std::size_t>(bytes_received);
+
+        // Parse every complete response available in the buffer
+        std::size_t offset = 0;
+        bool close_requested = false;
+        bool parse_error = false;
+        while (offset < buffered && !in_flight.empty()) {
+            std::size_t used = 0;
+            HttpResponseParser::State state = parser.feed(recv_buffer.data() + offset,
+                                                          buffered - offset, used);
+            offset += used;
+
+            if (state == HttpResponseParser::State::Complete) {
+                auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - in_flight.front());
+                in_flight.pop_front();
+                stats.latencies_ms.emplace_back(parser.status_code(),
+                                                static_cast<double>(latency.count()) / 1'000'000.0);
+                stats.body_bytes_received += parser.body_bytes();
+                consecutive_reconnects = 0;
+                close_requested = parser.connection_close();
+                parser.reset();
+                if (close_requested) {
+                    break;
+                }
+            } else if (state == HttpResponseParser::State::Error) {
+                parse_error = true;
+                break;
+            } else {
+                break;
+            }
+        }
+
+        if (parse_error) {
+            stats.error_message = "Malformed HTTP response";
+            drop_connection();
+            break;
+        }
+        if (close_requested) {
+            drop_connection();
+            continue;
+        }
+
+        // Compact unparsed bytes to the front of the buffer
+        if (offset > 0) {
+            std::memmove(recv_buffer.data(), recv_buffer.data() + offset, buffered - offset);
+            buffered -= offset;
+        }
+    }
+
+    if (socket_fd >= 0) {
+        close(socket_fd);
+    }
+#else
+    (void)config;
+    (void)request;
+    (void)next_request;
+    (void)stats;
+#endif
+}
+
+void HttpBenchmark::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  HTTP Benchmark Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Target:"
+              << results.config.host << ":" << results.config.port
+              << results.config.path << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Method:"
+              << results.config.method << "\n";
+    if (results.config.body_size_bytes > 0) {
+        std::cout << "  " << std::left << std::setw(25) << "Body Size:"
+                  << results.config.body_size_bytes << " bytes\n";
+    }
+    std::cout << "  " << std::left << std::setw(25) << "Connections:"
+              << results.config.connections << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Pipeline Depth:"
+              << results.config.pipeline_depth << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Requests:"
+              << results.config.total_requests << "\n";
+    std::cout << "\n";
+
+    std::cout << "Summary:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Status:"
+              << (results.benchmark_successful ? "SUCCESS" : "FAILED") << "\n";
+    if (!results.error_message.empty()) {
+        std::cout << "  " << std::left << std::setw(25) << "Error:"
+                  << results.error_message << "\n";
+    }
+    std::cout << "  " << std::left << std::setw(25) << "Requests Sent:"
+              << results.requests_sent << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Responses Received:"
+              << results.responses_received << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Failed Requests:"
+              << results.failed_requests << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Reconnects:"
+              << results.reconnects << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Total Time:"
+              << std::fixed << std::setprecision(6)
+              << results.total_time_seconds << " seconds\n";
+    std::cout << "  " << std::left << std::setw(25) << "Requests/sec:"
+              << std::fixed << std::setprecision(2)
+              << results.requests_per_second << "\n";
+    if (results.total_time_seconds > 0.0) {
+        std::cout << "  " << std::left << std::setw(25) << "Body Throughput:"
+                  << std::fixed << std::setprecision(2)
+                  << (static_cast<double>(results.body_bytes_received)
+                      / results.total_time_seconds / (1024.0 * 1024.0)) << " MB/s\n";
+    }
+    std::cout << "\n";
+
+    if (!results.status_stats.empty()) {
+        std::cout << "Latency by Status Code (ms):\n";
+        std::cout << "  " << std::string(78, '-') << "\n";
+        std::cout << "  " << std::left << std::setw(8) << "Status"
+                  << std::right << std::setw(10) << "Count"
+                  << std::right << std::setw(10) << "Avg"
+                  << std::right << std::setw(10) << "Min"
+                  << std::right << std::setw(10) << "p50"
+                  << std::right << std::setw(10) << "p90"
+                  << std::right << std::setw(10) << "p99"
+                  << std::right << std::setw(10) << "Max" << "\n";
+        std::cout << "  " << std::string(78, '-') << "\n";
+        for (const StatusStats& stats : results.status_stats) {
+            std::cout << "  " << std::left << std::setw(8) << stats.status_code
+                      << std::right << std::setw(10) << stats.count
+                      << std::fixed << std::setprecision(3)
+                      << std::right << std::setw(10) << stats.avg_latency_ms
+                      << std::right << std::setw(10) << stats.min_latency_ms
+                      << std::right << std::setw(10) << stats.p50_latency_ms
+                      << std::right << std::setw(10) << stats.p90_latency_ms
+                      << std::right << std::setw(10) << stats.p99_latency_ms
+                      << std::right << std::setw(10) << stats.max_latency_ms << "\n";
+        }
+        std::cout << "  " << std::string(78, '-') << "\n";
+        std::cout << "\n";
+
+        std::cout << "Latency 95% Confidence Intervals (ms, bootstrap):\n";
+        std::cout << "  " << std::string(78, '-') << "\n";
+        std::cout << "  " << std::left << std::setw(8) << "Status"
+                  << std::right << std::setw(23) << "Avg"
+                  << std::right << std::setw(23) << "p50"
+                  << std::right << std::setw(23) << "p99" << "\n";
+        std::cout << "  " << std::string(78, '-') << "\n";
+        for (const StatusStats& stats : results.status_stats) {
+            std::cout << "  " << std::left << std::setw(8) << stats.status_code;
+            for (const Statistics::ConfidenceInterval* interval :
+                 {&stats.latency_ci.mean, &stats.latency_ci.median, &stats.latency_ci.p99}) {
+                std::ostringstream range;
+                range << std::fixed << std::setprecision(3)
+                      << "[" << interval->lower << ", " << interval->upper << "]";
+                std::cout << std::right << std::setw(23) << range.str();
+            }
+            std::cout << "\n";
+        }
+        std::cout << "  " << std::string(78, '-') << "\n";
+        std::cout << "\n";
+    }
+}
+
+void HttpBenchmark::write_results(const Results& results, ResultWriter& writer,
+                                  const std::string& name) {
+    writer.begin_object(name);
+
+    writer.begin_object("config");
+    writer.field("host", results.config.host);
+    writer.field("port", results.config.port);
+    writer.field("path", results.config.path);
+    writer.field("method", results.config.method);
+    writer.field("body_size_bytes", results.config.body_size_bytes);
+    writer.field("connections", results.config.connections);
+    writer.field("total_requests", results.config.total_requests);
+    writer.field("pipeline_depth", results.config.pipeline_depth);
+    writer.end_object();
+
+    writer.field("requests_sent", results.requests_sent);
+    writer.field("responses_received", results.responses_received);
+    writer.field("failed_requests", results.failed_requests);
+    writer.field("reconnects", results.reconnects);
+    writer.field("body_bytes_received", results.body_bytes_received);
+    writer.field("total_time_seconds", results.total_time_seconds);
+    writer.field("requests_per_second", results.requests_per_second);
+
+    writer.begin_array("status_stats");
+    for (const StatusStats& stats : results.status_stats) {
+        writer.begin_object();
+        writer.field("status_code", stats.status_code);
+        writer.field("count", stats.count);
+        writer.field("avg_latency_ms", stats.avg_latency_ms);
+        writer.field("min_latency_ms", stats.min_latency_ms);
+        writer.field("p50_latency_ms", stats.p50_latency_ms);
+        writer.field("p90_latency_ms", stats.p90_latency_ms);
+        writer.field("p99_latency_ms", stats.p99_latency_ms);
+        writer.field("max_latency_ms", stats.max_latency_ms);
+        writer.confidence_intervals("latency_ci_ms", stats.latency_ci);
+        writer.end_object();
+    }
+    writer.end_array();
+
+    writer.field("error_message", results.error_message);
+    writer.field("benchmark_successful", results.benchmark_successful);
+    writer.end_object();
+}
@@ -0,0 +1,244 @@
+/**
+ * http_benchmark.h - HTTP/1.1 keep-alive load generation (Linux/POSIX)
+ *
+ * Sends GET/POST requests over persistent connections with optional
+ * pipelining and reports request rate and latency percentiles per status code.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef HTTP_BENCHMARK_H
+#define HTTP_BENCHMARK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "statistics.h"
+
+class ResultWriter;
+
+/**
+ * Minimal zero-copy HTTP/1.1 response parser.
+ *
+ * Parses the status line and the headers needed for framing
+ * (Content-Length, Transfer-Encoding: chunked, Connection: close) directly
+ * from the receive buffer. Body bytes are skipped, never copied. A body
+ * delimited only by closing the connection cannot be reused for keep-alive
+ * and is reported as an error, as is a Content-Length that is not a plain
+ * decimal number. Interim 1xx responses are skipped.
+ *
+ * The parser is incremental: feed() consumes as many bytes as it can and
+ * reports how many were used, so the caller can compact its buffer.
+ *
+ * Example usage:
+ *   HttpResponseParser parser;
+ *   std::size_t used = 0;
+ *   auto state = parser.feed(data, length, used);
+ *   if (state == HttpResponseParser::State::Complete) { ... parser.reset(); }
+ */
+class HttpResponseParser {
+public:
+    /**
+     * Parser progress after a feed() call.
+     */
+    enum class State {
+        Incomplete,  // More bytes are needed to finish the response
+        Complete,    // A full response has been parsed
+        Error        // Malformed response; the connection should be dropped
+    };
+
+    /**
+     * Constructs a parser ready for the first response.
+     */
+    HttpResponseParser() noexcept;
+
+    /**
+     * Prepares the parser for the next response on the same connection.
+     */
+    void reset() noexcept;
+
+    /**
+     * Consumes bytes from the receive buffer.
+     *
+     * @param data Pointer to unconsumed received bytes
+     * @param length Number of bytes available
+     * @param consumed Output parameter for number of bytes consumed
+     * @return Parser state after consuming the bytes
+     */
+    State feed(const char* data, std::size_t length, std::size_t& consumed) noexcept;
+
+    /**
+     * Returns the status code of the current response (0 if not yet parsed).
+     */
+    int status_code() const noexcept { return status_code_; }
+
+    /**
+     * Returns true if the server asked to close the connection.
+     */
+    bool connection_close() const noexcept { return connection_close_; }
+
+    /**
+     * Returns the number of body bytes seen for the current response.
+     */
+    std::size_t body_bytes() const noexcept { return body_bytes_; }
+
+private:
+    enum class Phase {
+        Headers,
+        FixedBody,
+        ChunkSize,
+        ChunkData,
+        ChunkDataEnd,
+        Trailers,
+        Done
+    };
+
+    /**
+     * Parses the status line and headers once the header block is complete.
+     *
+     * @param data Start of the header block
+     * @param length Length of the header block including the final CRLFCRLF
+     * @return false if the header block is malformed
+     */
+    bool parse_headers(const char* data, std::size_t length) noexcept;
+
+    Phase phase_;
+    int status_code_;
+    bool connection_close_;
+    bool chunked_;
+    bool has_content_length_;
+    std::size_t remaining_;
+    std::size_t body_bytes_;
+};
+
+/**
+ * HTTP Load Generation Module
+ *
+ * Drives a fixed number of requests across one or more keep-alive
+ * connections. Each connection runs on its own thread and keeps up to
+ * pipeline_depth requests in flight.
+ *
+ * Example usage:
+ *   HttpBenchmark benchmark;
+ *   HttpBenchmark::Config config;
+ *   config.host = "127.0.0.1";
+ *   config.port = 8080;
+ *   auto results = benchmark.run(config);
+ */
+class HttpBenchmark {
+public:
+    /**
+     * Load generation parameters.
+     */
+    struct Config {
+        std::string host;
+        std::uint16_t port = 80;
+        std::string path = "/";
+        std::string method = "GET";
+        std::size_t body_size_bytes = 0;     // Request body size for POST
+        std::size_t connections = 1;         // Concurrent keep-alive connections
+        std::size_t total_requests = 1000;   // Requests across all connections
+        std::size_t pipeline_depth = 1;      // Requests in flight per connection
+    };
+
+    /**
+     * Latency distribution for a single response status code.
+     */
+    struct StatusStats {
+        int status_code;
+        std::size_t count;
+        double avg_latency_ms;
+        double min_latency_ms;
+        double p50_latency_ms;
+        double p90_latency_ms;
+        double p99_latency_ms;
+        double max_latency_ms;
+        Statistics::BootstrapSummary latency_ci;
+    };
+
+    /**
+     * Results structure containing HTTP benchmark metrics.
+     */
+    struct Results {
+        Config config;
+        std::size_t requests_sent;
+        std::size_t responses_received;
+        std::size_t failed_requests;     // Requests lost to errors or closed connections
+        std::size_t reconnects;
+        std::uint64_t body_bytes_received;
+        double total_time_seconds;
+        double requests_per_second;
+        std::vector<StatusStats> status_stats;   // Sorted by status code
+        std::string error_message;
+        bool benchmark_successful;
+    };
+
+    /**
+     * Constructs an HTTP benchmark instance.
+     */
+    HttpBenchmark() noexcept;
+
+    /**
+     * Runs the HTTP load generation.
+     *
+     * @param config Target and load parameters
+     * @return Results structure with benchmark metrics
+     */
+    Results run(const Config& config);
+
+    /**
+     * Prints HTTP benchmark results in a clear table format.
+     *
+     * @param results The benchmark results to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes the configuration, every result field and the per-status
+     * latency distribution as one object.
+     *
+     * @param results The benchmark results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "http");
+
+private:
+    /**
+     * Per-connection outcome merged into Results after all threads finish.
+     */
+    struct ConnectionStats {
+        std::size_t requests_sent = 0;
+        std::size_t failed_requests = 0;
+        std::size_t reconnects = 0;
+        std::uint64_t body_bytes_received = 0;
+        std::vector<std::pair<int, double>> latencies_ms;  // (status, latency)
+        std::string error_message;
+    };
+
+    /**
+     * Builds the serialized request sent for every iteration.
+     *
+     * @param config Target and load parameters
+     * @return Complete HTTP/1.1 request including body
+     */
+    static std::string build_request(const Config& config);
+
+    /**
+     * Runs the request loop for a single connection.
+     *
+     * @param config Target and load parameters
+     * @param request Serialized request to send
+     * @param next_request Shared counter of claimed requests
+     * @param stats Output statistics for this connection
+     */
+    static void connection_worker(const Config& config,
+                                  const std::string& request,
+                                  std::atomic<std::size_t>& next_request,
+                                  ConnectionStats& stats) noexcept;
+};
+
+#endif // HTTP_BENCHMARK_H
@@ -0,0 +1,705 @@
+/**
+ * impairment_proxy.cpp - User-space WAN emulation proxy implementation
+ */
+
+#include "impairment_proxy.h"
+#include "process_priority.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int POLL_INTERVAL_MS = 100;
+    constexpr std::size_t TCP_CHUNK_SIZE = 16 * 1024;
+    constexpr std::size_t TCP_QUEUE_LIMIT_BYTES = 4 * 1024 * 1024;
+    constexpr std::size_t UDP_BUFFER_SIZE = 65536;
+    constexpr double MIN_RETRANSMIT_TIMEOUT_MS = 200.0;  // Linux TCP_RTO_MIN
+
+    /**
+     * One direction of the emulated link. Shared by every connection and
+     * datagram flow so competing traffic queues behind each other, as it
+     * would at a real bottleneck.
+     */
+    struct SharedLink {
+        std::mutex mutex;
+        Clock::time_point free_at = Clock::now();
+    };
+
+    /**
+     * Per-flow, per-direction impairment state: delay and the random draws
+     * for jitter, loss and reordering. Serialization uses the shared link.
+     */
+    class DelayModel {
+    public:
+        DelayModel(const ImpairmentProxy::Config& config, std::uint32_t seed, SharedLink& link)
+            : config_(config),
+              rng_(seed),
+              link_(link),
+              last_release_(Clock::now()) {
+        }
+
+        /**
+         * Computes when a chunk of the given size may leave the proxy.
+         *
+         * @param bytes Chunk or datagram size
+         * @param in_order true for TCP (release times never go backwards)
+         * @param lost Output: the chunk was lost (UDP drop / TCP retransmit)
+         * @param reordered Output: the datagram skips the delay queue
+         * @return Release time
+         */
+        Clock::time_point schedule(std::size_t bytes, bool in_order,
+                                   bool& lost, bool& reordered) {
+            Clock::time_point now = Clock::now();
+            lost = config_.loss_percent > 0.0 && percent_(rng_) < config_.loss_percent;
+            reordered = !in_order && config_.reorder_percent > 0.0 &&
+                        percent_(rng_) < config_.reorder_percent;
+
+            // Serialize onto the emulated link behind all queued traffic
+            Clock::time_point link_free;
+            {
+                std::lock_guard<std::mutex> lock(link_.mutex);
+                if (link_.free_at < now) {
+                    link_.free_at = now;
+                }
+                if (config_.bandwidth_mbps > 0.0) {
+                    double transmit_seconds = static_cast<double>(bytes) * 8.0
+                                              / (config_.bandwidth_mbps * 1'000'000.0);
+                    link_.free_at += to_duration(transmit_seconds * 1000.0);
+                }
+                link_free = link_.free_at;
+            }
+
+            if (reordered) {
+                return now;
+            }
+
+            double delay_ms = config_.delay_ms;
+            if (config_.jitter_ms > 0.0) {
+                std::normal_distribution<double> jitter(0.0, config_.jitter_ms);
+                delay_ms = std::max(0.0, delay_ms + jitter(rng_));
+            }
+            if (lost && in_order) {
+                // A lost TCP segment surfaces as a retransmission stall
+                delay_ms += std::max(MIN_RETRANSMIT_TIMEOUT_MS, 2.0 * config_.delay_ms);
+            }
+
+            Clock::time_point release = link_free + to_duration(delay_ms);
+            if (in_order) {
+                release = std::max(release, last_release_);
+                last_release_ = release;
+            }
+            return release;
+        }
+
+    private:
+        static Clock::duration to_duration(double milliseconds) {
+            return std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(milliseconds));
+        }
+
+        const ImpairmentProxy::Config& config_;
+        std::mt19937 rng_;
+        std::uniform_real_distribution<double> percent_{0.0, 100.0};
+        SharedLink& link_;
+        Clock::time_point last_release_;
+    };
+
+    /**
+     * Delay queue for one TCP direction, bounded to apply backpressure.
+     */
+    struct TcpPipe {
+        struct Chunk {
+            Clock::time_point release;
+            std::vector<std::uint8_t> data;   // Empty data marks end of stream
+        };
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Chunk> chunks;
+        std::size_t queued_bytes = 0;
+        bool closed = false;
+    };
+
+#ifdef __linux__
+    bool resolve_ipv4(const std::string& host, std::uint16_t port, struct sockaddr_in& address) {
+        struct addrinfo hints{};
+        struct addrinfo* result = nullptr;
+        hints.ai_family = AF_INET;
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0) {
+            return false;
+        }
+        address = *reinterpret_cast<struct sockaddr_in*>(result->ai_addr);
+        address.sin_port = htons(port);
+        freeaddrinfo(result);
+        return true;
+    }
+
+    bool send_all(int socket_fd, const std::uint8_t* data, std::size_t size) noexcept {
+        std::size_t total_sent = 0;
+        while (total_sent < size) {
+            ssize_t bytes_sent = send(socket_fd, data + total_sent, size - total_sent, MSG_NOSIGNAL);
+            if (bytes_sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            total_sent += static_cast<std::size_t>(bytes_sent);
+        }
+        return true;
+    }
+
+    void tcp_reader(int source_fd, TcpPipe& pipe, DelayModel& model,
+                    std::atomic<std::uint64_t>& retransmit_penalties) {
+        std::vector<std::uint8_t> buffer(TCP_CHUNK_SIZE);
+        while (true) {
+            ssize_t bytes_received = recv(source_fd, buffer.data(), buffer.size(), 0);
+            if (bytes_received < 0 && errno == EINTR) {
+                continue;
+            }
+
+            std::size_t size = bytes_received > 0 ? static_cast<std::size_t>(bytes_received) : 0;
+            bool lost = false;
+            bool reordered = false;
+            TcpPipe::Chunk chunk;
+            chunk.release = model.schedule(size, true, lost, reordered);
+            chunk.data.assign(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+            if (lost) {
+                retransmit_penalties++;
+            }
+
+            std::unique_lock<std::mutex> lock(pipe.mutex);
+            pipe.cv.wait(lock, [&pipe]() {
+                return pipe.closed || pipe.queued_bytes < TCP_QUEUE_LIMIT_BYTES;
+            });
+            if (pipe.closed) {
+                return;
+            }
+            pipe.queued_bytes += size;
+            pipe.chunks.push_back(std::move(chunk));
+            pipe.cv.notify_all();
+
+            if (size == 0) {
+                return;  // End of stream forwarded (after the same delay as data)
+            }
+        }
+    }
+
+    void tcp_writer(int destination_fd, int source_fd, TcpPipe& pipe,
+                    const std::atomic<bool>& running,
+                    std::atomic<std::uint64_t>& bytes_forwarded) {
+        while (true) {
+            std::unique_lock<std::mutex> lock(pipe.mutex);
+            if (pipe.chunks.empty()) {
+                pipe.cv.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS));
+                if (!running && pipe.chunks.empty()) {
+                    break;
+                }
+                continue;
+            }
+
+            Clock::time_point release = pipe.chunks.front().release;
+            if (Clock::now() < release) {
+                // Wake periodically so stop() is not held up by long delays
+                Clock::time_point wake = std::min(release,
+                    Clock::now() + std::chrono::milliseconds(POLL_INTERVAL_MS));
+                pipe.cv.wait_until(lock, wake);
+                if (!running) {
+                    break;
+                }
+                continue;
+            }
+
+            TcpPipe::Chunk chunk = std::move(pipe.chunks.front());
+            pipe.chunks.pop_front();
+            pipe.queued_bytes -= chunk.data.size();
+            pipe.cv.notify_all();
+            lock.unlock();
+
+            if (chunk.data.empty()) {
+                shutdown(destination_fd, SHUT_WR);
+                return;
+            }
+            if (!send_all(destination_fd, chunk.data.data(), chunk.data.size())) {
+                break;
+            }
+            bytes_forwarded += chunk.data.size();
+        }
+
+        // Abort: unblock the reader feeding this pipe
+        std::lock_guard<std::mutex> lock(pipe.mutex);
+        pipe.closed = true;
+        pipe.cv.notify_all();
+        shutdown(source_fd, SHUT_RDWR);
+    }
+#endif
+}
+
+/**
+ * Both directions of the emulated link.
+ */
+struct ImpairmentProxy::LinkState {
+    SharedLink to_upstream;
+    SharedLink to_client;
+};
+
+ImpairmentProxy::ImpairmentProxy() noexcept
+    : running_(false),
+      active_connections_(0),
+      connection_counter_(0),
+      tcp_connections_(0),
+      tcp_bytes_forwarded_(0),
+      tcp_retransmit_penalties_(0),
+      udp_datagrams_forwarded_(0),
+      udp_datagrams_dropped_(0),
+      udp_datagrams_reordered_(0),
+      udp_flows_expired_(0),
+      udp_datagrams_unrouted_(0) {
+}
+
+ImpairmentProxy::~ImpairmentProxy() {
+    stop();
+}
+
+bool ImpairmentProxy::start(
+    const Config& config,
+    const std::string& upstream_host,
+    std::vector<Route>& routes
+) {
+#ifdef __linux__
+    if (running_) {
+        error_message_ = "Proxy is already running";
+        return false;
+    }
+    config_ = config;
+    upstream_host_ = upstream_host;
+    error_message_.clear();
+    links_ = std::make_unique<LinkState>();
+
+    struct sockaddr_in probe{};
+    if (!resolve_ipv4(upstream_host_, 0, probe)) {
+        error_message_ = "Failed to resolve upstream host";
+        return false;
+    }
+
+    for (Route& route : routes) {
+        int socket_fd = socket(AF_INET, route.udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+        struct sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = 0;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (socket_fd < 0 ||
+            bind(socket_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 ||
+            (!route.udp && listen(socket_fd, SOMAXCONN) < 0)) {
+            if (socket_fd >= 0) {
+                close(socket_fd);
+            }
+            for (int fd : listen_fds_) {
+                close(fd);
+            }
+            listen_fds_.clear();
+            error_message_ = "Failed to bind proxy port";
+            return false;
+        }
+
+        socklen_t address_length = sizeof(address);
+        getsockname(socket_fd, reinterpret_cast<struct sockaddr*>(&address), &address_length);
+        route.listen_port = ntohs(address.sin_port);
+        listen_fds_.push_back(socket_fd);
+    }
+
+    running_ = true;
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        if (routes[i].udp) {
+            threads_.emplace_back(&ImpairmentProxy::udp_loop, this,
+                                  listen_fds_[i], routes[i].upstream_port);
+        } else {
+            threads_.emplace_back(&ImpairmentProxy::tcp_accept_loop, this,
+                                  listen_fds_[i], routes[i].upstream_port);
+        }
+    }
+    return true;
+#else
+    (void)config;
+    (void)upstream_host;
+    (void)routes;
+    error_message_ = "Impairment proxy not supported on this platform";
+    return false;
+#endif
+}
+
+void ImpairmentProxy::stop() noexcept {
+#ifdef __linux__
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    {
+        std::unique_lock<std::mutex> lock(sockets_mutex_);
+        for (int fd : active_sockets_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        sockets_cv_.wait(lock, [this]() { return active_connections_ == 0; });
+    }
+
+    for (int fd : listen_fds_) {
+        close(fd);
+    }
+    listen_fds_.clear();
+#endif
+}
+
+ImpairmentProxy::Stats ImpairmentProxy::stats() const noexcept {
+    Stats stats{};
+    stats.tcp_connections = tcp_connections_;
+    stats.tcp_bytes_forwarded = tcp_bytes_forwarded_;
+    stats.tcp_retransmit_penalties = tcp_retransmit_penalties_;
+    stats.udp_datagrams_forwarded = udp_datagrams_forwarded_;
+    stats.udp_datagrams_dropped = udp_datagrams_dropped_;
+    stats.udp_datagrams_reordered = udp_datagrams_reordered_;
+    stats.udp_flows_expired = udp_flows_expired_;
+    stats.udp_datagrams_unrouted = udp_datagrams_unrouted_;
+    return stats;
+}
+
+const std::string& ImpairmentProxy::error_message() const noexcept {
+    return error_message_;
+}
+
+bool ImpairmentProxy::is_active(const Config& config) noexcept {
+    return config.delay_ms > 0.0 || config.jitter_ms > 0.0 || config.bandwidth_mbps > 0.0 ||
+           config.loss_percent > 0.0 || config.reorder_percent > 0.0;
+}
+
+void ImpairmentProxy::track_socket(int socket_fd, bool active) noexcept {
+    std::lock_guard<std::mutex> lock(sockets_mutex_);
+    if (active) {
+        active_sockets_.push_back(socket_fd);
+    } else {
+        active_sockets_.erase(std::remove(active_sockets_.begin(), active_sockets_.end(), socket_fd),
+                              active_sockets_.end());
+    }
+}
+
+void ImpairmentProxy::tcp_accept_loop(int listen_fd, std::uint16_t upstream_port) noexcept {
+#ifdef __linux__
+    ProcessPriority::place_worker_thread();
+    while (running_) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = listen_fd;
+        poll_fd.events = POLLIN;
+        if (poll(&poll_fd, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sockets_mutex_);
+            active_sockets_.push_back(client_fd);
+            active_connections_++;
+        }
+        tcp_connections_++;
+        std::uint32_t seed = config_.seed + 2 * connection_counter_.fetch_add(1);
+        std::thread(&ImpairmentProxy::tcp_connection, this, client_fd, upstream_port, seed).detach();
+    }
+#else
+    (void)listen_fd;
+    (void)upstream_port;
+#endif
+}
+
+void ImpairmentProxy::tcp_connection(
+    int client_fd,
+    std::uint16_t upstream_port,
+    std::uint32_t seed
+) noexcept {
+#ifdef __linux__
+    struct sockaddr_in upstream_address{};
+    int upstream_fd = -1;
+    if (running_ && resolve_ipv4(upstream_host_, upstream_port, upstream_address)) {
+        upstream_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (upstream_fd >= 0 &&
+            connect(upstream_fd, reinterpret_cast<struct sockaddr*>(&upstream_address),
+                    sizeof(upstream_address)) < 0) {
+            close(upstream_fd);
+            upstream_fd = -1;
+        }
+    }
+
+    if (upstream_fd >= 0) {
+        track_socket(upstream_fd, true);
+
+        // The proxy adds its own delay; do not add Nagle delays on top
+        int flag = 1;
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+        setsockopt(upstream_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+        TcpPipe to_upstream;
+        TcpPipe to_client;
+        DelayModel upstream_model(config_, seed, links_->to_upstream);
+        DelayModel client_model(config_, seed + 1, links_->to_client);
+
+        std::thread up_reader(tcp_reader, client_fd, std::ref(to_upstream),
+                              std::ref(upstream_model), std::ref(tcp_retransmit_penalties_));
+        std::thread up_writer(tcp_writer, upstream_fd, client_fd, std::ref(to_upstream),
+                              std::cref(running_), std::ref(tcp_bytes_forwarded_));
+        std::thread down_reader(tcp_reader, upstream_fd, std::ref(to_client),
+                                std::ref(client_model), std::ref(tcp_retransmit_penalties_));
+        tcp_writer(client_fd, upstream_fd, to_client, running_, tcp_bytes_forwarded_);
+
+        up_reader.join();
+        up_writer.join();
+        down_reader.join();
+
+        track_socket(upstream_fd, false);
+        close(upstream_fd);
+    }
+
+    std::lock_guard<std::mutex> lock(sockets_mutex_);
+    active_sockets_.erase(std::remove(active_sockets_.begin(), active_sockets_.end(), client_fd),
+                          active_sockets_.end());
+    close(client_fd);
+    active_connections_--;
+    sockets_cv_.notify_all();
+#else
+    (void)client_fd;
+    (void)upstream_port;
+    (void)seed;
+#endif
+}
+
+void ImpairmentProxy::udp_loop(int listen_fd, std::uint16_t upstream_port) noexcept {
+#ifdef __linux__
+    ProcessPriority::place_worker_thread();
+    struct Flow {
+        struct sockaddr_in client;
+        int upstream_fd;
+        std::unique_ptr<DelayModel> to_upstream;
+        std::unique_ptr<DelayModel> to_client;
+        Clock::time_point last_active;  // Latest receive or scheduled release
+    };
+
+    struct Pending {
+        Clock::time_point release;
+        std::uint64_t sequence;
+        int socket_fd;
+        bool reply;                     // true: sendto() the client address
+        struct sockaddr_in destination;
+        std::vector<std::uint8_t> data;
+
+        bool operator>(const Pending& other) const {
+            return release != other.release ? release > other.release
+                                            : sequence > other.sequence;
+        }
+    };
+
+    struct sockaddr_in upstream_address{};
+    if (!resolve_ipv4(upstream_host_, upstream_port, upstream_address)) {
+        return;
+    }
+
+    std::vector<Flow> flows;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending;
+    std::uint64_t sequence = 0;
+    std::vector<std::uint8_t> buffer(UDP_BUFFER_SIZE);
+
+    auto enqueue = [&](Flow& flow, DelayModel& model, int socket_fd, bool reply,
+                       const struct sockaddr_in& destination, std::size_t size) {
+        bool lost = false;
+        bool reordered = false;
+        Clock::time_point release = model.schedule(size, false, lost, reordered);
+        // A flow is not expired while it still has datagrams queued
+        flow.last_active = std::max(Clock::now(), release);
+        if (lost) {
+            udp_datagrams_dropped_++;
+            return;
+        }
+        if (reordered) {
+            udp_datagrams_reordered_++;
+        }
+        pending.push(Pending{release, sequence++, socket_fd, reply, destination,
+                             std::vector<std::uint8_t>(buffer.begin(),
+                                 buffer.begin() + static_cast<std::ptrdiff_t>(size))});
+    };
+
+    while (running_) {
+        int timeout_ms = POLL_INTERVAL_MS;
+        if (!pending.empty()) {
+            auto until_release = std::chrono::duration_cast<std::chrono::milliseconds>(
+                pending.top().release - Clock::now()).count();
+            timeout_ms = static_cast<int>(std::max<long long>(0, std::min<long long>(
+                until_release, POLL_INTERVAL_MS)));
+        }
+
+        std::vector<struct pollfd> poll_fds(flows.size() + 1);
+        poll_fds[0].fd = listen_fd;
+        poll_fds[0].events = POLLIN;
+        for (std::size_t i = 0; i < flows.size(); ++i) {
+            poll_fds[i + 1].fd = flows[i].upstream_fd;
+            poll_fds[i + 1].events = POLLIN;
+        }
+
+        if (poll(poll_fds.data(), poll_fds.size(), timeout_ms) > 0) {
+            // Client -> upstream
+            if (poll_fds[0].revents & POLLIN) {
+                struct sockaddr_in client{};
+                socklen_t client_length = sizeof(client);
+                ssize_t size = recvfrom(listen_fd, buffer.data(), buffer.size(), 0,
+                                        reinterpret_cast<struct sockaddr*>(&client), &client_length);
+                if (size >= 0) {
+                    auto flow = std::find_if(flows.begin(), flows.end(), [&client](const Flow& f) {
+                        return f.client.sin_addr.s_addr == client.sin_addr.s_addr &&
+                               f.client.sin_port == client.sin_port;
+                    });
+                    if (flow == flows.end() && flows.size() < MAX_UDP_FLOWS) {
+                        int upstream_fd = socket(AF_INET, SOCK_DGRAM, 0);
+                        if (upstream_fd >= 0 &&
+                            connect(upstream_fd, reinterpret_cast<struct sockaddr*>(&upstream_address),
+                                    sizeof(upstream_address)) == 0) {
+                            std::uint32_t seed = config_.seed + 2 * connection_counter_.fetch_add(1);
+                            flows.push_back(Flow{client, upstream_fd,
+                                                 std::make_unique<DelayModel>(config_, seed,
+                                                                              links_->to_upstream),
+                                                 std::make_unique<DelayModel>(config_, seed + 1,
+                                                                              links_->to_client),
+                                                 Clock::now()});
+                            flow = flows.end() - 1;
+                        } else if (upstream_fd >= 0) {
+                            close(upstream_fd);
+                        }
+                    }
+                    if (flow != flows.end()) {
+                        enqueue(*flow, *flow->to_upstream, flow->upstream_fd, false,
+                                upstream_address, static_cast<std::size_t>(size));
+                    } else {
+                        udp_datagrams_unrouted_++;
+                    }
+                }
+            }
+
+            // Upstream -> client
+            for (std::size_t i = 0; i < flows.size(); ++i) {
+                if (!(poll_fds[i + 1].revents & POLLIN)) {
+                    continue;
+                }
+                ssize_t size = recv(flows[i].upstream_fd, buffer.data(), buffer.size(), 0);
+                if (size >= 0) {
+                    enqueue(flows[i], *flows[i].to_client, listen_fd, true,
+                            flows[i].client, static_cast<std::size_t>(size));
+                }
+            }
+        }
+
+        // Release every datagram whose time has come
+        Clock::time_point now = Clock::now();
+        while (!pending.empty() && pending.top().release <= now) {
+            const Pending& datagram = pending.top();
+            if (datagram.reply) {
+                sendto(datagram.socket_fd, datagram.data.data(), datagram.data.size(), 0,
+                       reinterpret_cast<const struct sockaddr*>(&datagram.destination),
+                       sizeof(datagram.destination));
+            } else {
+                send(datagram.socket_fd, datagram.data.data(), datagram.data.size(), 0);
+            }
+            udp_datagrams_forwarded_++;
+            pending.pop();
+        }
+
+        // Idle flows free their socket and table slot for new clients
+        auto idle = std::remove_if(flows.begin(), flows.end(), [&](const Flow& flow) {
+            if (now - flow.last_active < std::chrono::milliseconds(UDP_FLOW_IDLE_TIMEOUT_MS)) {
+                return false;
+            }
+            close(flow.upstream_fd);
+            udp_flows_expired_++;
+            return true;
+        });
+        flows.erase(idle, flows.end());
+    }
+
+    for (Flow& flow : flows) {
+        close(flow.upstream_fd);
+    }
+#else
+    (void)listen_fd;
+    (void)upstream_port;
+#endif
+}
+
+void ImpairmentProxy::print_summary(const Config& config, const Stats& stats) {
+    std::cout << "========================================\n";
+    std::cout << "  Impairment Proxy Summary\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    std::cout << "Impairments (per direction):\n";
+    std::cout << "  " << std::left << std::setw(25) << "Delay:"
+              << std::fixed << std::setprecision(2) << config.delay_ms << " ms\n";
+    std::cout << "  " << std::left << std::setw(25) << "Jitter:"
+              << std::fixed << std::setprecision(2) << config.jitter_ms << " ms\n";
+    std::cout << "  " << std::left << std::setw(25) << "Bandwidth:";
+    if (config.bandwidth_mbps > 0.0) {
+        std::cout << std::fixed << std::setprecision(2) << config.bandwidth_mbps << " Mbit/s\n";
+    } else {
+        std::cout << "unlimited\n";
+    }
+    std::cout << "  " << std::left << std::setw(25) << "Loss:"
+              << std::fixed << std::setprecision(2) << config.loss_percent << " %\n";
+    std::cout << "  " << std::left << std::setw(25) << "Reordering (UDP):"
+              << std::fixed << std::setprecision(2) << config.reorder_percent << " %\n";
+    std::cout << "\n";
+
+    std::cout << "Forwarding:\n";
+    std::cout << "  " << std::left << std::setw(25) << "TCP Connections:"
+              << stats.tcp_connections << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "TCP Bytes Forwarded:"
+              << stats.tcp_bytes_forwarded << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "TCP Retransmit Stalls:"
+              << stats.tcp_retransmit_penalties << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "UDP Forwarded:"
+              << stats.udp_datagrams_forwarded << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "UDP Dropped:"
+              << stats.udp_datagrams_dropped << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "UDP Reordered:"
+              << stats.udp_datagrams_reordered << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "UDP Flows Expired:"
+              << stats.udp_flows_expired << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "UDP Flow Table Full:"
+              << stats.udp_datagrams_unrouted << " datagrams dropped\n";
+    std::cout << "\n";
+    std::cout << "Note: TCP loss is emulated as a retransmission stall because a\n";
+    std::cout << "      user-space proxy cannot drop bytes from a stream.\n";
+    std::cout << "\n";
+}
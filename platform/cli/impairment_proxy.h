@@ -0,0 +1,186 @@
+/**
+ * impairment_proxy.h - User-space WAN emulation proxy (Linux/POSIX)
+ *
+ * Forwards TCP and UDP traffic between the benchmark client and a server
+ * while injecting delay, jitter, bandwidth limits, loss and reordering.
+ * Needs no tc/netem privileges, so WAN-like paths can be reproduced in CI.
+ */
+
+#ifndef IMPAIRMENT_PROXY_H
+#define IMPAIRMENT_PROXY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Impairment Proxy Module
+ *
+ * Each route listens on a loopback port and forwards to one upstream port.
+ * Impairments are applied independently per direction:
+ * - delay/jitter: every chunk or datagram is held for delay +/- jitter
+ *   (normal distribution, never negative)
+ * - bandwidth: chunks are serialized at the configured rate onto one link
+ *   per direction shared by all routes, so concurrent flows compete for it
+ * - loss: UDP datagrams are dropped; a TCP byte stream cannot lose data, so
+ *   a "lost" TCP chunk is held for an extra retransmission timeout instead
+ * - reordering: UDP datagrams skip the delay queue; TCP stays in order
+ *
+ * Each UDP client address gets its own upstream socket (a flow). Flows
+ * idle for UDP_FLOW_IDLE_TIMEOUT_MS are closed; while MAX_UDP_FLOWS are
+ * open, datagrams from new clients are dropped and counted.
+ *
+ * Example usage:
+ *   ImpairmentProxy proxy;
+ *   ImpairmentProxy::Config config;
+ *   config.delay_ms = 40.0;
+ *   std::vector<ImpairmentProxy::Route> routes = {{false, 7000, 0}};
+ *   proxy.start(config, "127.0.0.1", routes);
+ *   // ... connect to 127.0.0.1:routes[0].listen_port ...
+ */
+class ImpairmentProxy {
+public:
+    static constexpr std::size_t MAX_UDP_FLOWS = 64;
+    static constexpr int UDP_FLOW_IDLE_TIMEOUT_MS = 30 * 1000;
+
+    /**
+     * Impairment parameters (applied to each direction).
+     */
+    struct Config {
+        double delay_ms = 0.0;          // One-way delay
+        double jitter_ms = 0.0;         // Standard deviation of the delay
+        double bandwidth_mbps = 0.0;    // Link rate in Mbit/s (0 = unlimited)
+        double loss_percent = 0.0;      // Chunk/datagram loss probability
+        double reorder_percent = 0.0;   // UDP datagrams sent ahead of the queue
+        std::uint32_t seed = 1;         // Deterministic impairment sequence
+    };
+
+    /**
+     * A forwarded port. listen_port is filled in by start().
+     */
+    struct Route {
+        bool udp;
+        std::uint16_t upstream_port;
+        std::uint16_t listen_port;
+    };
+
+    /**
+     * Forwarding counters.
+     */
+    struct Stats {
+        std::uint64_t tcp_connections;
+        std::uint64_t tcp_bytes_forwarded;
+        std::uint64_t tcp_retransmit_penalties;
+        std::uint64_t udp_datagrams_forwarded;
+        std::uint64_t udp_datagrams_dropped;
+        std::uint64_t udp_datagrams_reordered;
+        std::uint64_t udp_flows_expired;        // Closed after UDP_FLOW_IDLE_TIMEOUT_MS without traffic
+        std::uint64_t udp_datagrams_unrouted;   // From new clients while the flow table was full
+    };
+
+    /**
+     * Constructs a stopped proxy.
+     */
+    ImpairmentProxy() noexcept;
+
+    /**
+     * Stops the proxy if it is still running.
+     */
+    ~ImpairmentProxy();
+
+    ImpairmentProxy(const ImpairmentProxy&) = delete;
+    ImpairmentProxy& operator=(const ImpairmentProxy&) = delete;
+
+    /**
+     * Binds every route on 127.0.0.1 and starts forwarding.
+     *
+     * @param config Impairment parameters
+     * @param upstream_host IPv4 address of the server being fronted
+     * @param routes Routes to forward; listen_port is set on success
+     * @return true if all routes are listening
+     */
+    bool start(const Config& config, const std::string& upstream_host,
+               std::vector<Route>& routes);
+
+    /**
+     * Stops forwarding and joins all threads. Safe to call more than once.
+     */
+    void stop() noexcept;
+
+    /**
+     * Returns a snapshot of the forwarding counters.
+     */
+    Stats stats() const noexcept;
+
+    /**
+     * Returns the last error message from start().
+     */
+    const std::string& error_message() const noexcept;
+
+    /**
+     * Returns true if any impairment is configured.
+     */
+    static bool is_active(const Config& config) noexcept;
+
+    /**
+     * Prints the impairment configuration and forwarding counters.
+     *
+     * @param config Impairment parameters
+     * @param stats Forwarding counters
+     */
+    static void print_summary(const Config& config, const Stats& stats);
+
+private:
+    /**
+     * Accepts TCP connections for a route until stopped.
+     */
+    void tcp_accept_loop(int listen_fd, std::uint16_t upstream_port) noexcept;
+
+    /**
+     * Forwards one TCP connection in both directions, then closes it.
+     */
+    void tcp_connection(int client_fd, std::uint16_t upstream_port,
+                        std::uint32_t seed) noexcept;
+
+    /**
+     * Forwards datagrams for a UDP route until stopped.
+     */
+    void udp_loop(int listen_fd, std::uint16_t upstream_port) noexcept;
+
+    /**
+     * Registers or unregisters a socket that stop() must shut down.
+     */
+    void track_socket(int socket_fd, bool active) noexcept;
+
+    struct LinkState;
+
+    Config config_;
+    std::unique_ptr<LinkState> links_;  // Shared per-direction link clocks
+    std::string upstream_host_;
+    std::string error_message_;
+    std::atomic<bool> running_;
+    std::vector<int> listen_fds_;
+    std::vector<std::thread> threads_;
+    std::mutex sockets_mutex_;
+    std::condition_variable sockets_cv_;
+    std::vector<int> active_sockets_;
+    std::size_t active_connections_;
+    std::atomic<std::uint32_t> connection_counter_;
+
+    std::atomic<std::uint64_t> tcp_connections_;
+    std::atomic<std::uint64_t> tcp_bytes_forwarded_;
+    std::atomic<std::uint64_t> tcp_retransmit_penalties_;
+    std::atomic<std::uint64_t> udp_datagrams_forwarded_;
+    std::atomic<std::uint64_t> udp_datagrams_dropped_;
+    std::atomic<std::uint64_t> udp_datagrams_reordered_;
+    std::atomic<std::uint64_t> udp_flows_expired_;
+    std::atomic<std::uint64_t> udp_datagrams_unrouted_;
+};
+
+#endif // IMPAIRMENT_PROXY_H
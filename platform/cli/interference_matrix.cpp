@@ -0,0 +1,256 @@
+/**
+ * interference_matrix.cpp - Pairwise cross-benchmark interference implementation
+ */
+
+#include "interference_matrix.h"
+#include "tenant_contention.h"
+#include "process_priority.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    constexpr std::size_t MIN_COLUMN_WIDTH = 10;
+
+    /**
+     * Returns the most specific error of a failed contention run.
+     */
+    std::string first_error(const TenantContention::Results& results) {
+        for (const TenantContention::TenantResults& tenant : results.tenants) {
+            if (!tenant.benchmark_successful) {
+                return tenant.name + ": " + tenant.error_message;
+            }
+        }
+        return results.error_message;
+    }
+
+    /**
+     * Returns the primary metric a tenant measured for its benchmark, or
+     * nullptr if it has none.
+     */
+    const TenantContention::TenantMetric* tenant_metric(const TenantContention::TenantResults& tenant,
+                                                        const std::string& benchmark) {
+        for (const TenantContention::TenantMetric& metric : tenant.metrics) {
+            if (metric.benchmark == benchmark) {
+                return &metric;
+            }
+        }
+        return nullptr;
+    }
+}
+
+InterferenceMatrix::Results InterferenceMatrix::run(const BenchmarkRegistry& registry, const Config& config,
+                                                    const CpuTopology& topology) {
+    Results results{};
+    results.benchmark_successful = false;
+    results.benchmarks = config.benchmarks;
+
+    if (config.benchmarks.empty() || config.benchmarks.size() > TenantContention::MAX_TENANTS) {
+        results.error_message = "Benchmark count must be between 1 and " +
+                                std::to_string(TenantContention::MAX_TENANTS);
+        return results;
+    }
+    for (std::size_t i = 0; i < config.benchmarks.size(); ++i) {
+        const std::string& name = config.benchmarks[i];
+        if (registry.find(name) == nullptr) {
+            results.error_message = "Unknown benchmark: " + name;
+            return results;
+        }
+        if (std::find(config.benchmarks.begin(), config.benchmarks.begin() + i, name) !=
+            config.benchmarks.begin() + i) {
+            results.error_message = "Benchmark listed twice: " + name;
+            return results;
+        }
+    }
+    BenchmarkParameters used_overrides = TenantContention::applicable_overrides(registry, config.benchmarks,
+                                                                                config.overrides);
+    for (const auto& override_value : config.overrides) {
+        if (used_overrides.count(override_value.first) == 0) {
+            results.error_message = "Unknown parameter for the interference benchmarks: " + override_value.first;
+            return results;
+        }
+    }
+
+    // Halves sharing a core would report time-slicing as interference
+    std::vector<int> allowed_cpus = ProcessPriority::allowed_cpus();
+    std::size_t allowed_cores = TenantContention::allowed_cores(topology, allowed_cpus);
+    if (!topology.cores().empty() && allowed_cores < 2) {
+        results.error_message = "Interference needs two cores; this process may run on " +
+                                std::to_string(allowed_cores) + " (CPUs " +
+                                CpuTopology::format_cpulist(allowed_cpus) + ")";
+        return results;
+    }
+    std::vector<TenantContention::Tenant> halves = TenantContention::assign_tenants(2, {}, topology, allowed_cpus);
+    results.half_cpus[0] = halves[0].cpus;
+    results.half_cpus[1] = halves[1].cpus;
+
+    // Baselines: every benchmark alone on each half, since a pair puts
+    // one benchmark on either half
+    std::size_t count = config.benchmarks.size();
+    results.baselines.resize(count);
+    for (int half = 0; half < 2; ++half) {
+        TenantContention::Config solo_config;
+        solo_config.repetitions = config.repetitions;
+        solo_config.overrides = config.overrides;
+        solo_config.contended_phase = false;
+        for (const std::string& name : config.benchmarks) {
+            solo_config.tenants.push_back({name, name, results.half_cpus[half]});
+        }
+        std::cout << "  Baselines: " << count << " benchmarks alone on "
+                  << TenantContention::format_cpus(results.half_cpus[half]) << "\n" << std::flush;
+        TenantContention::Results solo = TenantContention::run(registry, solo_config);
+        if (!solo.benchmark_successful) {
+            results.baselines.clear();
+            results.error_message = "Baseline failed: " + first_error(solo);
+            return results;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            const TenantContention::TenantMetric* metric = tenant_metric(solo.tenants[i], config.benchmarks[i]);
+            if (metric == nullptr) {
+                results.baselines.clear();
+                results.error_message = "Baseline failed: " + config.benchmarks[i] + " reported no primary metric";
+                return results;
+            }
+            Baseline& baseline = results.baselines[i];
+            baseline.benchmark = metric->benchmark;
+            baseline.metric = metric->metric;
+            baseline.unit = metric->unit;
+            baseline.higher_is_better = metric->higher_is_better;
+            baseline.solo[half] = metric->solo;
+        }
+    }
+
+    // Pairs: row i on the first half, column j on the second; (i, j) also
+    // yields the (j, i) cell, whose row benchmark ran on the second half
+    std::vector<double> contended(count * count, 0.0);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = i; j < count; ++j) {
+            const std::string& victim = config.benchmarks[i];
+            const std::string& aggressor = config.benchmarks[j];
+            TenantContention::Config pair_config;
+            pair_config.repetitions = config.repetitions;
+            pair_config.overrides = TenantContention::applicable_overrides(registry, {victim, aggressor},
+                                                                           config.overrides);
+            pair_config.solo_phase = false;
+            pair_config.tenants.push_back({victim, victim, results.half_cpus[0]});
+            pair_config.tenants.push_back({i == j ? aggressor + " (copy)" : aggressor, aggressor,
+                                           results.half_cpus[1]});
+
+            std::cout << "  Pair: " << victim << " + " << aggressor << "\n" << std::flush;
+            TenantContention::Results pair = TenantContention::run(registry, pair_config);
+            const TenantContention::TenantMetric* victim_metric =
+                pair.benchmark_successful ? tenant_metric(pair.tenants[0], victim) : nullptr;
+            const TenantContention::TenantMetric* aggressor_metric =
+                pair.benchmark_successful ? tenant_metric(pair.tenants[1], aggressor) : nullptr;
+            if (victim_metric == nullptr || aggressor_metric == nullptr) {
+                results.error_message = "Pair " + victim + " + " + aggressor + " failed: " +
+                                        (pair.benchmark_successful ? "no primary metric" : first_error(pair));
+                return results;
+            }
+            // The diagonal keeps the first-half copy, like the upper triangle
+            contended[i * count + j] = victim_metric->contended;
+            if (i != j) {
+                contended[j * count + i] = aggressor_metric->contended;
+            }
+        }
+    }
+
+    for (std::size_t row = 0; row < count; ++row) {
+        const Baseline& baseline = results.baselines[row];
+        for (std::size_t column = 0; column < count; ++column) {
+            int half = (column >= row) ? 0 : 1;
+            double value = contended[row * count + column];
+            results.cells.push_back({baseline.benchmark, config.benchmarks[column], half, baseline.solo[half], value,
+                                     TenantContention::degradation(baseline.solo[half], value,
+                                                                   baseline.higher_is_better)});
+        }
+    }
+    results.benchmark_successful = true;
+    return results;
+}
+
+void InterferenceMatrix::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Interference Matrix Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    if (!results.baselines.empty()) {
+        std::cout << "Baselines (alone on " << TenantContention::format_cpus(results.half_cpus[0]) << " / "
+                  << TenantContention::format_cpus(results.half_cpus[1]) << "):\n";
+        for (const Baseline& baseline : results.baselines) {
+            std::cout << "  " << std::left << std::setw(25) << (baseline.benchmark + ":") << baseline.metric
+                      << " " << std::fixed << std::setprecision(2) << baseline.solo[0] << " / "
+                      << baseline.solo[1] << " " << baseline.unit << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    if (!results.cells.empty()) {
+        std::size_t width = MIN_COLUMN_WIDTH;
+        for (const std::string& name : results.benchmarks) {
+            width = std::max(width, name.size() + 2);
+        }
+        std::cout << "Slowdown of the row benchmark next to the column benchmark, % (each against its\n"
+                  << "baseline on the same half; upper triangle and diagonal on the first half):\n";
+        std::cout << "  " << std::left << std::setw(25) << "";
+        for (const std::string& name : results.benchmarks) {
+            std::cout << std::right << std::setw(static_cast<int>(width)) << name;
+        }
+        std::cout << "\n";
+        std::size_t column = 0;
+        for (const Cell& cell : results.cells) {
+            if (column == 0) {
+                std::cout << "  " << std::left << std::setw(25) << (cell.benchmark + ":");
+            }
+            std::cout << std::right << std::setw(static_cast<int>(width)) << std::showpos << std::fixed
+                      << std::setprecision(1) << cell.slowdown_percent << std::noshowpos;
+            if (++column == results.benchmarks.size()) {
+                std::cout << "\n";
+                column = 0;
+            }
+        }
+        std::cout << std::left << "\n";
+    }
+
+    if (!results.benchmark_successful) {
+        std::cout << "Error: " << results.error_message << "\n\n";
+    }
+}
+
+void InterferenceMatrix::write_results(const Results& results, ResultWriter& writer, const std::string& name) {
+    writer.begin_object(name);
+    writer.field("first_half_cpus", CpuTopology::format_cpulist(results.half_cpus[0]));
+    writer.field("second_half_cpus", CpuTopology::format_cpulist(results.half_cpus[1]));
+    writer.begin_array("baselines");
+    for (const Baseline& baseline : results.baselines) {
+        writer.begin_object();
+        writer.field("benchmark", baseline.benchmark);
+        writer.field("metric", baseline.metric);
+        writer.field("unit", baseline.unit);
+        writer.field("higher_is_better", baseline.higher_is_better);
+        writer.field("solo_first_half", baseline.solo[0]);
+        writer.field("solo_second_half", baseline.solo[1]);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.begin_array("cells");
+    for (const Cell& cell : results.cells) {
+        writer.begin_object();
+        writer.field("benchmark", cell.benchmark);
+        writer.field("aggressor", cell.aggressor);
+        writer.field("half", cell.half);
+        writer.field("solo", cell.solo);
+        writer.field("contended", cell.contended);
+        writer.field("slowdown_percent", cell.slowdown_percent);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.field("benchmark_successful", results.benchmark_successful);
+    if (!results.benchmark_successful) {
+        writer.field("error_message", results.error_message);
+    }
+    writer.end_object();
+}
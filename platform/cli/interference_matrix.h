@@ -0,0 +1,112 @@
+/**
+ * interference_matrix.h - Pairwise cross-benchmark interference (Linux)
+ *
+ * Runs every pair of registered benchmarks at the same time on separate
+ * cores and reports how much each one slows down next to the other, so a
+ * scheduler can tell which workloads may share a host.
+ */
+
+#ifndef INTERFERENCE_MATRIX_H
+#define INTERFERENCE_MATRIX_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "benchmark_registry.h"
+#include "cpu_topology.h"
+
+class ResultWriter;
+
+/**
+ * Interference Matrix Module
+ *
+ * Built on TenantContention: the host's cores are split into two halves,
+ * every benchmark is first measured alone on each half (baselines), then
+ * each unordered pair runs as two tenants, one per half. A cell is the
+ * slowdown of the row benchmark's primary metric while the column
+ * benchmark runs beside it, against the baseline from the half the row
+ * benchmark ran on, so placement differences between the halves do not
+ * show up as interference. The diagonal pairs a benchmark with a copy of
+ * itself.
+ *
+ * Example usage:
+ *   InterferenceMatrix::Config config;
+ *   config.benchmarks = {"memory", "cpu", "network.rtt"};
+ *   InterferenceMatrix::Results results = InterferenceMatrix::run(registry, config, CpuTopology::current());
+ *   InterferenceMatrix::print_results(results);
+ */
+class InterferenceMatrix {
+public:
+    /**
+     * Interference run configuration.
+     */
+    struct Config {
+        std::vector<std::string> benchmarks;    // Registered names (rows and columns)
+        std::size_t repetitions = 3;            // Measured runs per benchmark and run
+        BenchmarkParameters overrides;          // As BenchmarkRunner::Config::overrides
+    };
+
+    /**
+     * Solo measurement of one benchmark.
+     */
+    struct Baseline {
+        std::string benchmark;
+        std::string metric;                     // Primary metric of the benchmark
+        std::string unit;
+        bool higher_is_better;
+        double solo[2];                         // Mean over repetitions, per half
+    };
+
+    /**
+     * One benchmark measured next to another.
+     */
+    struct Cell {
+        std::string benchmark;                  // Victim (row)
+        std::string aggressor;                  // Co-runner (column)
+        int half;                               // Half the row benchmark ran on (0 or 1)
+        double solo;                            // Baseline on that half
+        double contended;                       // Mean over repetitions
+        double slowdown_percent;                // Positive = worse than the baseline
+    };
+
+    /**
+     * Baselines and the matrix, row by row.
+     */
+    struct Results {
+        std::vector<std::string> benchmarks;
+        std::vector<int> half_cpus[2];          // The two core groups
+        std::vector<Baseline> baselines;
+        std::vector<Cell> cells;
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * Measures the baselines and every pair, one pair at a time.
+     *
+     * @param registry Registry the names refer to
+     * @param config Benchmarks, repetitions and overrides
+     * @param topology Host topology used to split the cores
+     * @return Results (error_message set on the first failed run)
+     */
+    static Results run(const BenchmarkRegistry& registry, const Config& config, const CpuTopology& topology);
+
+    /**
+     * Prints the baselines and the slowdown matrix.
+     *
+     * @param results Results to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes baselines and cells as one object.
+     *
+     * @param results Results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "interference");
+};
+
+#endif // INTERFERENCE_MATRIX_H
@@ -11,7 +11,16 @@
 #include <ctime>
 #include <cstring>
 #include <string>
+#include <sstream>
+#include <vector>
 #include <cstdint>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <memory>
+#include <functional>
+#include <csignal>
 
 #ifdef __linux__
 #include <unistd.h>
@@ -21,8 +30,31 @@
 #include "timer.h"
 #include "memory_benchmark.h"
 #include "process_priority.h"
+#include "environment_info.h"
+#include "topology_discovery.h"
+#include "thermal_sampler.h"
 #include "network_benchmark.h"
+#include "echo_server.h"
+#include "canary_daemon.h"
+#include "fleet_agent.h"
+#include "fleet_coordinator.h"
+#include "tenant_contention.h"
+#include "interference_matrix.h"
+#include "impairment_proxy.h"
+#include "http_benchmark.h"
 #include "cpu_benchmark.h"
+#include "roofline_model.h"
+#include "cpu_topology.h"
+#include "demo_config.h"
+#include "benchmark_registry.h"
+#include "suite_config.h"
+#include "interval_telemetry.h"
+#include "trace_recorder.h"
+#include "benchmark_runner.h"
+#include "platform_benchmarks.h"
+#include "result_writer.h"
+#include "json_value.h"
+#include "baseline_comparison.h"
 
 namespace {
     constexpr const char* VERSION = "1.0.0";
@@ -35,7 +67,7 @@ namespace {
         std::cout << "\n";
     }
     
-    void print_environment_info() {
+    void print_environment_info(const EnvironmentInfo::Results& host) {
         std::cout << "Environment Information:\n";
         std::cout << "------------------------\n";
         
@@ -78,6 +110,165 @@ namespace {
         std::cout << "Timer Resolution: ~" << elapsed << " ns (test measurement)\n";
         
         std::cout << "\n";
+        EnvironmentInfo::print_results(host);
+    }
+    
+    void print_cpu_placement(const ProcessPriority::PlacementResults& placement) {
+        std::cout << "CPU Placement:\n";
+        if (placement.result != ProcessPriority::Result::Success) {
+            std::cout << "  Status: " << ProcessPriority::result_to_string(placement.result)
+                      << " - " << placement.error_message << "\n\n";
+            return;
+        }
+        std::cout << "  Measuring CPU: " << placement.measuring_cpu << "\n";
+        std::cout << "  Worker CPUs: "
+                  << (placement.worker_cpus.empty() ? "none (workers share the measuring CPU)"
+                                                    : CpuTopology::format_cpulist(placement.worker_cpus)) << "\n";
+        if (!placement.idle_siblings.empty()) {
+            std::cout << "  Idle SMT Siblings: " << CpuTopology::format_cpulist(placement.idle_siblings) << "\n";
+        }
+        if (!placement.reserved_cpus.empty()) {
+            std::cout << "  Isolated CPUs: " << CpuTopology::format_cpulist(placement.reserved_cpus)
+                      << " (" << placement.migrated_threads << " threads moved, "
+                      << placement.unmovable_threads << " could not be moved)\n";
+        }
+        std::cout << "\n";
+    }
+    
+    void print_realtime(const ProcessPriority::RealtimeResults& realtime) {
+        auto status = [](ProcessPriority::Result result) {
+            return ProcessPriority::result_to_string(result);
+        };
+        std::cout << "Real-Time Mode:\n";
+        std::cout << "  Scheduler: " << ProcessPriority::policy_to_string(realtime.policy)
+                  << " priority " << realtime.priority << " - " << status(realtime.scheduler) << "\n";
+        std::cout << "  Memory Lock: " << status(realtime.memory_lock) << "\n";
+        std::cout << "  Heap Retention: " << status(realtime.heap_retention) << "\n";
+        std::cout << "  Stack Prefault: " << status(realtime.stack_prefault);
+        if (realtime.stack_prefault_bytes > 0) {
+            std::cout << " (" << (realtime.stack_prefault_bytes / 1024) << " KB)";
+        }
+        std::cout << "\n";
+        std::cout << "  Timer Slack: " << status(realtime.timer_slack) << "\n";
+        for (const std::string& error : realtime.errors) {
+            std::cout << "  Note: " << error << "\n";
+        }
+        std::cout << "\n";
+    }
+    
+    void write_realtime(ResultWriter& writer, const ProcessPriority::RealtimeResults& realtime) {
+        writer.begin_object("realtime");
+        writer.field("policy", ProcessPriority::policy_to_string(realtime.policy));
+        writer.field("priority", realtime.priority);
+        writer.field("scheduler", ProcessPriority::result_to_string(realtime.scheduler));
+        writer.field("memory_lock", ProcessPriority::result_to_string(realtime.memory_lock));
+        writer.field("heap_retention", ProcessPriority::result_to_string(realtime.heap_retention));
+        writer.field("stack_prefault", ProcessPriority::result_to_string(realtime.stack_prefault));
+        writer.field("stack_prefault_bytes", realtime.stack_prefault_bytes);
+        writer.field("timer_slack", ProcessPriority::result_to_string(realtime.timer_slack));
+        writer.begin_array("errors");
+        for (const std::string& error : realtime.errors) {
+            writer.field("", error);
+        }
+        writer.end_array();
+        writer.end_object();
+    }
+    
+    void write_cpu_placement(ResultWriter& writer, const ProcessPriority::PlacementResults& placement) {
+        writer.begin_object("cpu_placement");
+        writer.field("result", ProcessPriority::result_to_string(placement.result));
+        writer.field("measuring_cpu", placement.measuring_cpu);
+        writer.field("worker_cpus", CpuTopology::format_cpulist(placement.worker_cpus));
+        writer.field("idle_siblings", CpuTopology::format_cpulist(placement.idle_siblings));
+        writer.field("isolated_cpus", CpuTopology::format_cpulist(placement.reserved_cpus));
+        writer.field("migrated_threads", placement.migrated_threads);
+        writer.field("unmovable_threads", placement.unmovable_threads);
+        if (placement.result != ProcessPriority::Result::Success) {
+            writer.field("error_message", placement.error_message);
+        }
+        writer.end_object();
+    }
+    
+    void write_environment(ResultWriter& writer, std::int32_t initial_priority,
+                           std::int32_t final_priority, ProcessPriority::Result priority_result,
+                           const ProcessPriority::PlacementResults* placement,
+                           const ProcessPriority::RealtimeResults* realtime,
+                           const EnvironmentInfo::Results& host) {
+        writer.begin_object("environment");
+        
+        // UTC timestamp so results from different hosts sort together
+        std::time_t now = std::time(nullptr);
+        std::tm utc_time{};
+        gmtime_r(&now, &utc_time);
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc_time);
+        writer.field("timestamp", timestamp);
+        
+        #if defined(__clang__)
+            writer.field("compiler", "Clang " + std::to_string(__clang_major__) + "." +
+                         std::to_string(__clang_minor__) + "." + std::to_string(__clang_patchlevel__));
+        #elif defined(__GNUC__)
+            writer.field("compiler", "GCC " + std::to_string(__GNUC__) + "." +
+                         std::to_string(__GNUC_MINOR__) + "." + std::to_string(__GNUC_PATCHLEVEL__));
+        #else
+            writer.field("compiler", "Unknown");
+        #endif
+        writer.field("cxx_standard", static_cast<long>(__cplusplus));
+        
+        #ifdef __linux__
+            struct utsname sys_info;
+            if (uname(&sys_info) == 0) {
+                writer.field("hostname", sys_info.nodename);
+                writer.field("system", sys_info.sysname);
+                writer.field("release", sys_info.release);
+                writer.field("kernel_version", sys_info.version);
+                writer.field("machine", sys_info.machine);
+            }
+        #endif
+        writer.field("hardware_threads", std::thread::hardware_concurrency());
+        
+        writer.begin_object("process_priority");
+        writer.field("initial", initial_priority);
+        writer.field("final", final_priority);
+        writer.field("adjustment", ProcessPriority::result_to_string(priority_result));
+        writer.end_object();
+        if (placement != nullptr) {
+            write_cpu_placement(writer, *placement);
+        }
+        if (realtime != nullptr) {
+            write_realtime(writer, *realtime);
+        }
+        
+        EnvironmentInfo::write_results(host, writer);
+        writer.end_object();
+    }
+    
+    /**
+     * Roofline levels from the host's caches, each tested at half its
+     * capacity; DRAM is tested well beyond the largest cache.
+     */
+    RooflineModel::Config roofline_config(const EnvironmentInfo::Results& host) {
+        RooflineModel::Config config = RooflineModel::default_config();
+        std::vector<RooflineModel::MemoryLevel> levels;
+        std::size_t largest_cache = 0;
+        for (int level = 1; level <= host.topology.last_level(); ++level) {
+            std::size_t size_bytes = host.topology.cache_size(level);
+            if (size_bytes == 0) {
+                continue;
+            }
+            levels.push_back({"L" + std::to_string(level), size_bytes, size_bytes / 2});
+            largest_cache = std::max(largest_cache, size_bytes);
+        }
+        if (levels.empty()) {
+            return config;
+        }
+        std::size_t dram_bytes = std::max<std::size_t>(256 * 1024 * 1024, 2 * largest_cache);
+        if (host.memory_available_kb > 0) {
+            dram_bytes = std::min<std::size_t>(dram_bytes, host.memory_available_kb * 1024 / 4);
+        }
+        levels.push_back({"DRAM", 0, dram_bytes});
+        config.levels = levels;
+        return config;
     }
     
     void print_usage(const char* program_name) {
@@ -86,21 +277,121 @@ namespace {
                   << "[--network-host HOST] [--network-port PORT] [--help]\n";
         std::cout << "\n";
         std::cout << "Options:\n";
-        std::cout << "  --buffer-size SIZE    Buffer size in bytes (default: 1048576 = 1MB)\n";
-        std::cout << "  --iterations COUNT    Number of iterations (default: 1000)\n";
+        std::cout << "  --buffer-size SIZE    Buffer size in bytes or relative to a cache: L2, 2xL2,\n";
+        std::cout << "                        L3/2 (default: 2xL2, or 1048576 if the L2 is unknown)\n";
+        std::cout << "  --iterations COUNT    Number of iterations (default: 1000), or 'auto' to calibrate\n";
+        std::cout << "  --target-precision PCT Auto iterations: stop at this 95% CI half-width (default: 1)\n";
+        std::cout << "  --time-budget SEC     Auto iterations: measurement time limit (default: 10)\n";
+        std::cout << "  --exclude-outliers    Memory throughput from cycles inside the Tukey inner fences\n";
+        std::cout << "  --roofline            Measure peak compute and cache/DRAM bandwidth, then place the CPU\n";
+        std::cout << "                        workloads (--cpu-iterations) and memory workload on that roofline\n";
         std::cout << "  --network-host HOST   Run network benchmark (hostname or IP)\n";
         std::cout << "  --network-port PORT   Network benchmark port (default: 80)\n";
         std::cout << "  --network-iterations COUNT Network benchmark iterations (default: 1)\n";
+        std::cout << "  --network-mode MODE   connect, handshake, rtt, bulk, udp or loaded (default: connect)\n";
+        std::cout << "                        handshake/rtt/udp use PORT, bulk uses PORT+1 (built-in server layout)\n";
+        std::cout << "                        loaded: RTT idle vs. while bulk flows saturate the path\n";
+        std::cout << "  --load-flows COUNT    Bulk flows for the loaded mode (default: 4)\n";
+        std::cout << "  --network-server      Start the built-in echo/sink server on loopback and test it\n";
+        std::cout << "  --payload-size SIZE   Network payload size in bytes (default: 1024)\n";
+        std::cout << "  --payload-sweep       Sweep rtt, bulk and udp over power-of-two payload sizes\n";
+        std::cout << "  --sweep-min SIZE      Smallest sweep payload in bytes (default: 1)\n";
+        std::cout << "  --sweep-max SIZE      Largest sweep payload in bytes (default: 16777216)\n";
+        std::cout << "  --bulk-duration SEC   Seconds per bulk measurement (default: 1.0, sweep: 0.5)\n";
+        std::cout << "  --tcp-fastopen        Connect TCP tests with TCP Fast Open (TCP_FASTOPEN_CONNECT)\n";
+        std::cout << "  --tcp-congestion ALG  Congestion-control algorithm for TCP tests (TCP_CONGESTION)\n";
+        std::cout << "  --cc-compare LIST     Compare handshake, RTT and bulk per algorithm plus Fast Open\n";
+        std::cout << "                        (comma-separated list, or 'all' for every available algorithm)\n";
+        std::cout << "  --proxy-delay MS      Route network tests through a WAN-emulation proxy with MS one-way delay\n";
+        std::cout << "  --proxy-jitter MS     Proxy delay jitter (standard deviation, ms)\n";
+        std::cout << "  --proxy-rate MBIT     Proxy bandwidth cap in Mbit/s per direction\n";
+        std::cout << "  --proxy-loss PCT      Proxy loss percentage (UDP drop, TCP retransmit stall)\n";
+        std::cout << "  --proxy-reorder PCT   Proxy UDP reordering percentage\n";
+        std::cout << "  --proxy-seed N        Seed for the proxy's impairment sequence (default: 1)\n";
+        std::cout << "  --tcp-info-interval MS TCP_INFO sampling interval (default: 100, 0 = end only)\n";
+        std::cout << "  --serve PORT          Run the echo/sink server on PORT (TCP/UDP echo) and PORT+1 (sink)\n";
+        std::cout << "  --daemon PORT         Run probes periodically and serve Prometheus metrics on 127.0.0.1:PORT/metrics\n";
+        std::cout << "  --daemon-interval SEC Minimum time between probe rounds (default: 60)\n";
+        std::cout << "  --daemon-cpu-budget PCT Daemon CPU limit in percent of one CPU (default: 2)\n";
+        std::cout << "  --daemon-probes LIST  Registered benchmarks to probe (default: memory,cpu,network.rtt)\n";
+        std::cout << "  --agent PORT          Run suites pushed by a fleet coordinator (listens on 127.0.0.1:PORT)\n";
+        std::cout << "  --agent-bind ADDR     Agent listen address, e.g. 0.0.0.0 for remote coordinators\n";
+        std::cout << "  --agent-token-file FILE Shared token for --agent and --agents (first line; required)\n";
+        std::cout << "  --agent-name NAME     Node name reported to the coordinator (default: hostname:PORT)\n";
+        std::cout << "  --agents LIST         With --suite: run it on these agents (host[:port], comma-separated,\n";
+        std::cout << "                        default port 9400) in lockstep and report fleet aggregates\n";
+        std::cout << "  --agents-file FILE    Agent addresses, one or more per line ('#' starts a comment)\n";
+        std::cout << "  --agent-timeout SEC   Longest wait for an agent's results (default: 3600)\n";
+        std::cout << "  --http-host HOST      Run HTTP/1.1 keep-alive load generation against HOST\n";
+        std::cout << "  --http-port PORT      HTTP port (default: 80)\n";
+        std::cout << "  --http-path PATH      Request path (default: /)\n";
+        std::cout << "  --http-method METHOD  GET or POST (default: GET)\n";
+        std::cout << "  --http-body-size SIZE POST body size in bytes (requires --http-method POST)\n";
+        std::cout << "  --http-requests COUNT Total HTTP requests (default: 1000)\n";
+        std::cout << "  --http-connections COUNT Concurrent keep-alive connections (default: 1)\n";
+        std::cout << "  --http-pipeline DEPTH Requests in flight per connection (default: 1)\n";
         std::cout << "  --continuous-runs COUNT Run benchmark in continuous mode for COUNT runs\n";
         std::cout << "  --continuous-duration SEC Run benchmark in continuous mode for SEC seconds\n";
+        std::cout << "  --telemetry FILE      Continuous mode: write per-interval JSON lines to FILE ('-' = stdout)\n";
+        std::cout << "  --telemetry-interval SEC Telemetry interval in seconds (default: 1)\n";
+        std::cout << "  --cpus LIST           Run in these CPUs (cpulist, e.g. 2-5,8): the measuring thread takes\n";
+        std::cout << "                        the first, worker threads one each of the rest\n";
+        std::cout << "  --avoid-smt           Keep the measuring CPU's SMT siblings free of benchmark threads\n";
+        std::cout << "  --isolate             Move other processes' threads off the --cpus CPUs (or the\n";
+        std::cout << "                        measuring core) while the benchmark runs; needs CAP_SYS_NICE\n";
+        std::cout << "  --realtime POLICY     fifo or rr: real-time scheduling, mlockall, prefaulted stack and\n";
+        std::cout << "                        heap, 1 ns timer slack (each step reported; needs privileges)\n";
+        std::cout << "  --rt-priority N       Real-time priority with --realtime, 1-99 (default: 49)\n";
+        std::cout << "  --trace FILE          Write benchmark phases as Chrome trace-event JSON (chrome://tracing, Perfetto)\n";
+        std::cout << "  --list                List registered benchmarks and their parameters\n";
+        std::cout << "  --run PATTERNS        Run registered benchmarks by name or glob (comma-separated)\n";
+        std::cout << "  --repetitions N       Measured runs per selected benchmark (default: 1)\n";
+        std::cout << "  --warmup N            Discarded runs per selected benchmark (default: 0)\n";
+        std::cout << "  --tenants K           Fork K tenant processes on separate cores; each runs its mix alone,\n";
+        std::cout << "                        then all together (uses --repetitions and --param)\n";
+        std::cout << "  --tenant-mix LIST     Benchmark selections assigned round-robin, ';'-separated\n";
+        std::cout << "                        (default: memory), e.g. 'memory;cpu,memory'\n";
+        std::cout << "  --interference LIST   Run every pair of these benchmarks on separate cores and print each\n";
+        std::cout << "                        one's slowdown next to the other (names or globs, comma-separated)\n";
+        std::cout << "  --suite FILE          Run the benchmark instances defined in FILE (INI format)\n";
+        std::cout << "  --param NAME=VALUE    Parameter override, NAME or BENCHMARK.NAME (repeatable)\n";
+        std::cout << "  --details             Print each benchmark's full report after its last run\n";
+        std::cout << "  --output-format FMT   text, json or csv (default: text; json if --output is given)\n";
+        std::cout << "  --output FILE         Write JSON/CSV results to FILE (default: stdout; tables go to stderr)\n";
+        std::cout << "  --compare FILE        Compare with a saved JSON result; exit 1 on significant regressions\n";
+        std::cout << "  --compare-alpha A     Significance level for --compare (default: 0.05)\n";
+        std::cout << "  --compare-raw         Also fail on within-run samples (memory latency, RTT samples)\n";
+        std::cout << "  --compare-threshold PCT Smallest median change treated as a regression (default: 5)\n";
         std::cout << "  --help                Show this help message\n";
         std::cout << "\n";
         std::cout << "Examples:\n";
         std::cout << "  " << program_name << " --buffer-size 1048576 --iterations 10000\n";
         std::cout << "  " << program_name << " --buffer-size 10485760 --iterations 1000000\n";
+        std::cout << "  " << program_name << " --buffer-size 2xL3 --iterations 1000\n";
+        std::cout << "  " << program_name << " --buffer-size 1048576 --iterations auto --target-precision 0.5\n";
         std::cout << "  " << program_name << " --network-host 127.0.0.1 --network-port 80\n";
         std::cout << "  " << program_name << " --network-host example.com --network-iterations 10\n";
         std::cout << "  " << program_name << " --buffer-size 1048576 --iterations 1000 --network-host 127.0.0.1\n";
+        std::cout << "  " << program_name << " --network-server --network-mode rtt --network-iterations 1000\n";
+        std::cout << "  " << program_name << " --network-server --payload-sweep --sweep-max 1048576\n";
+        std::cout << "  " << program_name << " --network-server --network-mode rtt --network-iterations 200 --proxy-delay 20 --proxy-jitter 2\n";
+        std::cout << "  " << program_name << " --network-server --cc-compare cubic,bbr\n";
+        std::cout << "  " << program_name << " --network-server --network-mode loaded --load-flows 4 --proxy-rate 100\n";
+        std::cout << "  " << program_name << " --http-host 127.0.0.1 --http-port 8080 --http-connections 4 --http-pipeline 8\n";
+        std::cout << "  " << program_name << " --run 'memory,cpu' --repetitions 5 --warmup 1\n";
+        std::cout << "  " << program_name << " --run 'network.*' --param iterations=200 --param network.bulk.duration=2\n";
+        std::cout << "  " << program_name << " --suite fleet.ini --details\n";
+        std::cout << "  " << program_name << " --tenants 4 --tenant-mix 'memory;cpu' --repetitions 5\n";
+        std::cout << "  " << program_name << " --interference 'memory,cpu,network.rtt' --param iterations=200\n";
+        std::cout << "  " << program_name << " --daemon 9100 --daemon-interval 30 --daemon-cpu-budget 1\n";
+        std::cout << "  " << program_name << " --agent 9400 --agent-bind 0.0.0.0 --agent-token-file fleet.token\n";
+        std::cout << "  " << program_name << " --suite fleet.ini --agents-file hosts.txt --agent-token-file fleet.token"
+                     " --output fleet.json\n";
+        std::cout << "  " << program_name << " --buffer-size 1048576 --cpu-iterations 100000 --output results.json\n";
+        std::cout << "  " << program_name << " --roofline --cpu-iterations 1000000\n";
+        std::cout << "  " << program_name << " --cpus 2-5 --avoid-smt --isolate --buffer-size 2xL2 --iterations 10000\n";
+        std::cout << "  " << program_name << " --cpus 3 --realtime fifo --buffer-size L1/2 --iterations 100000\n";
+        std::cout << "  " << program_name << " --run 'memory,cpu' --repetitions 10 --compare baseline.json\n";
         std::cout << "\n";
     }
     
@@ -119,22 +410,142 @@ namespace {
             return 0;
         }
     }
+    
+    /**
+     * Parses a buffer size in bytes or relative to a cache level ("2xL2").
+     * Returns 0 on error.
+     */
+    std::size_t parse_buffer_size(const char* str, const char* option_name) {
+        std::size_t bytes = 0;
+        std::string error_message;
+        if (!CpuTopology::current().parse_size(str, bytes, error_message)) {
+            std::cerr << "Error: Invalid value for " << option_name << ": " << error_message << "\n";
+            return 0;
+        }
+        return bytes;
+    }
+    
+    volatile std::sig_atomic_t stop_requested = 0;
+
+    void handle_stop_signal(int) {
+        stop_requested = 1;
+    }
+
+    // Set while --isolate has moved other processes' threads
+    const ProcessPriority* isolating_priority = nullptr;
+
+    /**
+     * Undoes isolation, then dies of the signal as it would have without
+     * the handler; benchmarks cannot be interrupted part-way.
+     */
+    void handle_isolation_signal(int signal_number) {
+        if (isolating_priority != nullptr) {
+            isolating_priority->restore_isolation();
+        }
+        std::signal(signal_number, SIG_DFL);
+        std::raise(signal_number);
+    }
+
+    /**
+     * Clears isolating_priority before the ProcessPriority it points to
+     * is destroyed (declare it after that object).
+     */
+    struct IsolationSignalGuard {
+        ~IsolationSignalGuard() {
+            isolating_priority = nullptr;
+        }
+    };
+
+    /**
+     * Restores std::cout's original buffer when main returns, after the
+     * tables were moved to stderr to keep stdout for a document.
+     */
+    struct StdoutRedirectGuard {
+        std::streambuf* original = std::cout.rdbuf();
+        ~StdoutRedirectGuard() {
+            std::cout.flush();
+            std::cout.rdbuf(original);
+        }
+    };
+
+    bool parse_port(const char* str, std::uint16_t& port) {
+        try {
+            unsigned long port_value = std::stoul(str);
+            if (port_value == 0 || port_value > 65535) {
+                std::cerr << "Error: Port must be between 1 and 65535\n";
+                return false;
+            }
+            port = static_cast<std::uint16_t>(port_value);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Invalid port number: " << str << "\n";
+            return false;
+        }
+    }
 }
 
 int main(int argc, char* argv[]) {
+    // Cache sizes and cores are needed by --buffer-size and the registry defaults
+    CpuTopology::set_current(TopologyDiscovery::discover());
+    
     // Default values
-    std::size_t buffer_size = 1048576;  // 1 MB
+    std::size_t buffer_size = DemoConfig::demo_buffer_size();  // 2x L2, or 1 MB
     std::size_t iterations = 1000;
+    bool auto_iterations = false;
+    MemoryBenchmark::CalibrationConfig calibration_config;
+    bool exclude_outliers = false;
     bool run_benchmark = false;
     bool run_cpu_benchmark = false;
     std::size_t cpu_iterations = 100000;
+    bool roofline_mode = false;
     bool run_network_benchmark = false;
     std::string network_host;
     std::uint16_t network_port = 80;
     std::size_t network_iterations = 1;
+    std::string network_mode = "connect";
+    bool use_builtin_server = false;
+    std::size_t payload_size = 1024;
+    std::size_t load_flows = 4;
+    bool payload_sweep = false;
+    std::size_t sweep_min = 1;
+    std::size_t sweep_max = 16 * 1024 * 1024;
+    double bulk_duration = 0.0;
+    std::uint16_t serve_port = 0;
+    bool daemon_mode = false;
+    CanaryDaemon::Config daemon_config;
+    bool agent_mode = false;
+    FleetAgent::Config agent_config;
+    FleetCoordinator::Config fleet_config;
+    double tcp_info_interval_ms = -1.0;
+    NetworkBenchmark::SocketOptions socket_options;
+    std::string cc_compare_list;
+    ImpairmentProxy::Config proxy_config;
+    bool run_http_benchmark = false;
+    HttpBenchmark::Config http_config;
     bool continuous_mode = false;
     std::size_t continuous_runs = 0;
     double continuous_duration = 0.0;
+    std::string telemetry_path;
+    std::string trace_path;
+    ProcessPriority::Placement placement;
+    bool apply_placement = false;
+    std::size_t tenant_count = 0;
+    std::vector<std::string> tenant_mixes;
+    std::string interference_selection;
+    ProcessPriority::RealtimeConfig realtime_config;
+    bool realtime_mode = false;
+    bool rt_priority_set = false;
+    double telemetry_interval = 1.0;
+    bool list_benchmarks = false;
+    bool use_runner = false;
+    BenchmarkRunner::Config runner_config;
+    bool runner_options_set = false;
+    std::string suite_path;
+    bool structured_output = false;
+    ResultWriter::Format output_format = ResultWriter::Format::Json;
+    std::string output_path = "-";
+    std::string baseline_path;
+    BaselineComparison::Config comparison_config;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -145,41 +556,275 @@ int main(int argc, char* argv[]) {
             print_usage(argv[0]);
             return EXIT_SUCCESS;
         } else if (arg == "--buffer-size" && i + 1 < argc) {
-            buffer_size = parse_size_t(argv[++i], "--buffer-size");
+            buffer_size = parse_buffer_size(argv[++i], "--buffer-size");
             if (buffer_size == 0) {
                 return EXIT_FAILURE;
             }
             run_benchmark = true;
         } else if (arg == "--iterations" && i + 1 < argc) {
-            iterations = parse_size_t(argv[++i], "--iterations");
-            if (iterations == 0) {
-                return EXIT_FAILURE;
+            if (std::string(argv[i + 1]) == "auto") {
+                ++i;
+                auto_iterations = true;
+            } else {
+                iterations = parse_size_t(argv[++i], "--iterations");
+                if (iterations == 0) {
+                    return EXIT_FAILURE;
+                }
+                auto_iterations = false;
             }
             run_benchmark = true;
+        } else if (arg == "--target-precision" && i + 1 < argc) {
+            try {
+                calibration_config.target_relative_ci = std::stod(argv[++i]) / 100.0;
+                if (calibration_config.target_relative_ci <= 0.0) {
+                    std::cerr << "Error: --target-precision must be greater than 0\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --target-precision: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--exclude-outliers") {
+            exclude_outliers = true;
+        } else if (arg == "--time-budget" && i + 1 < argc) {
+            try {
+                calibration_config.max_seconds = std::stod(argv[++i]);
+                if (calibration_config.max_seconds <= 0.0) {
+                    std::cerr << "Error: --time-budget must be greater than 0\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --time-budget: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
         } else if (arg == "--cpu-iterations" && i + 1 < argc) {
             cpu_iterations = parse_size_t(argv[++i], "--cpu-iterations");
             if (cpu_iterations == 0) {
                 return EXIT_FAILURE;
             }
             run_cpu_benchmark = true;
+        } else if (arg == "--roofline") {
+            roofline_mode = true;
         } else if (arg == "--network-host" && i + 1 < argc) {
             network_host = argv[++i];
             run_network_benchmark = true;
         } else if (arg == "--network-port" && i + 1 < argc) {
+            if (!parse_port(argv[++i], network_port)) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--network-iterations" && i + 1 < argc) {
+            network_iterations = parse_size_t(argv[++i], "--network-iterations");
+            if (network_iterations == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--network-mode" && i + 1 < argc) {
+            network_mode = argv[++i];
+            if (network_mode != "connect" && network_mode != "handshake" && network_mode != "rtt" &&
+                network_mode != "bulk" && network_mode != "udp" && network_mode != "loaded") {
+                std::cerr << "Error: --network-mode must be connect, handshake, rtt, bulk, udp or loaded\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--load-flows" && i + 1 < argc) {
+            load_flows = parse_size_t(argv[++i], "--load-flows");
+            if (load_flows == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--network-server") {
+            use_builtin_server = true;
+            run_network_benchmark = true;
+        } else if (arg == "--payload-size" && i + 1 < argc) {
+            payload_size = parse_size_t(argv[++i], "--payload-size");
+            if (payload_size == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--payload-sweep") {
+            payload_sweep = true;
+        } else if (arg == "--sweep-min" && i + 1 < argc) {
+            sweep_min = parse_size_t(argv[++i], "--sweep-min");
+            if (sweep_min == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--sweep-max" && i + 1 < argc) {
+            sweep_max = parse_size_t(argv[++i], "--sweep-max");
+            if (sweep_max == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--bulk-duration" && i + 1 < argc) {
             try {
-                unsigned long port_value = std::stoul(argv[++i]);
-                if (port_value == 0 || port_value > 65535) {
-                    std::cerr << "Error: Port must be between 1 and 65535\n";
+                bulk_duration = std::stod(argv[++i]);
+                if (bulk_duration <= 0.0) {
+                    std::cerr << "Error: Bulk duration must be greater than 0\n";
                     return EXIT_FAILURE;
                 }
-                network_port = static_cast<std::uint16_t>(port_value);
             } catch (const std::exception& e) {
-                std::cerr << "Error: Invalid port number: " << argv[i] << "\n";
+                std::cerr << "Error: Invalid duration value: " << argv[i] << "\n";
                 return EXIT_FAILURE;
             }
-        } else if (arg == "--network-iterations" && i + 1 < argc) {
-            network_iterations = parse_size_t(argv[++i], "--network-iterations");
-            if (network_iterations == 0) {
+        } else if (arg == "--tcp-fastopen") {
+            socket_options.fast_open = true;
+        } else if (arg == "--tcp-congestion" && i + 1 < argc) {
+            socket_options.congestion_control = argv[++i];
+        } else if (arg == "--cc-compare" && i + 1 < argc) {
+            cc_compare_list = argv[++i];
+        } else if ((arg == "--proxy-delay" || arg == "--proxy-jitter" || arg == "--proxy-rate" ||
+                    arg == "--proxy-loss" || arg == "--proxy-reorder") && i + 1 < argc) {
+            double value = 0.0;
+            try {
+                value = std::stod(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for " << arg << ": " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+            bool is_percent = (arg == "--proxy-loss" || arg == "--proxy-reorder");
+            if (value < 0.0 || (is_percent && value > 100.0)) {
+                std::cerr << "Error: " << arg << " out of range: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+            if (arg == "--proxy-delay") {
+                proxy_config.delay_ms = value;
+            } else if (arg == "--proxy-jitter") {
+                proxy_config.jitter_ms = value;
+            } else if (arg == "--proxy-rate") {
+                proxy_config.bandwidth_mbps = value;
+            } else if (arg == "--proxy-loss") {
+                proxy_config.loss_percent = value;
+            } else {
+                proxy_config.reorder_percent = value;
+            }
+        } else if (arg == "--proxy-seed" && i + 1 < argc) {
+            std::size_t seed = parse_size_t(argv[++i], "--proxy-seed");
+            if (seed == 0) {
+                return EXIT_FAILURE;
+            }
+            if (seed > std::numeric_limits<std::uint32_t>::max()) {
+                std::cerr << "Error: --proxy-seed must be between 1 and 4294967295\n";
+                return EXIT_FAILURE;
+            }
+            proxy_config.seed = static_cast<std::uint32_t>(seed);
+        } else if (arg == "--tcp-info-interval" && i + 1 < argc) {
+            try {
+                tcp_info_interval_ms = std::stod(argv[++i]);
+                if (tcp_info_interval_ms < 0.0) {
+                    std::cerr << "Error: TCP_INFO interval must not be negative\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid interval value: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--daemon" && i + 1 < argc) {
+            if (!parse_port(argv[++i], daemon_config.port)) {
+                return EXIT_FAILURE;
+            }
+            daemon_mode = true;
+        } else if (arg == "--agent" && i + 1 < argc) {
+            if (!parse_port(argv[++i], agent_config.port)) {
+                return EXIT_FAILURE;
+            }
+            agent_mode = true;
+        } else if (arg == "--agent-bind" && i + 1 < argc) {
+            agent_config.bind_address = argv[++i];
+        } else if (arg == "--agent-name" && i + 1 < argc) {
+            agent_config.node_name = argv[++i];
+        } else if (arg == "--agent-token-file" && i + 1 < argc) {
+            std::string token_error;
+            if (!FleetAgent::read_token_file(argv[++i], agent_config.token, token_error)) {
+                std::cerr << "Error: " << token_error << "\n";
+                return EXIT_FAILURE;
+            }
+            fleet_config.token = agent_config.token;
+        } else if ((arg == "--agents" || arg == "--agents-file") && i + 1 < argc) {
+            std::string list = argv[++i];
+            if (arg == "--agents-file") {
+                std::ifstream agents_file(list);
+                if (!agents_file) {
+                    std::cerr << "Error: Cannot open agents file: " << list << "\n";
+                    return EXIT_FAILURE;
+                }
+                list.clear();
+                std::string line;
+                while (std::getline(agents_file, line)) {
+                    list += line.substr(0, line.find('#')) + "\n";
+                }
+            }
+            std::string agents_error;
+            if (!FleetCoordinator::parse_agents(list, fleet_config.agents, agents_error)) {
+                std::cerr << "Error: " << agents_error << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--agent-timeout" && i + 1 < argc) {
+            try {
+                fleet_config.result_timeout_seconds = std::stod(argv[++i]);
+                if (fleet_config.result_timeout_seconds <= 0.0) {
+                    std::cerr << "Error: --agent-timeout must be greater than 0\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --agent-timeout: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--daemon-interval" && i + 1 < argc) {
+            try {
+                daemon_config.interval_seconds = std::stod(argv[++i]);
+                if (daemon_config.interval_seconds <= 0.0) {
+                    std::cerr << "Error: --daemon-interval must be greater than 0\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --daemon-interval: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--daemon-cpu-budget" && i + 1 < argc) {
+            try {
+                double budget_percent = std::stod(argv[++i]);
+                if (budget_percent <= 0.0 || budget_percent > 100.0) {
+                    std::cerr << "Error: --daemon-cpu-budget must be between 0 and 100\n";
+                    return EXIT_FAILURE;
+                }
+                daemon_config.cpu_budget = budget_percent / 100.0;
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --daemon-cpu-budget: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--daemon-probes" && i + 1 < argc) {
+            daemon_config.probes = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            if (!parse_port(argv[++i], serve_port)) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-host" && i + 1 < argc) {
+            http_config.host = argv[++i];
+            run_http_benchmark = true;
+        } else if (arg == "--http-port" && i + 1 < argc) {
+            if (!parse_port(argv[++i], http_config.port)) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-path" && i + 1 < argc) {
+            http_config.path = argv[++i];
+        } else if (arg == "--http-method" && i + 1 < argc) {
+            http_config.method = argv[++i];
+            if (http_config.method != "GET" && http_config.method != "POST") {
+                std::cerr << "Error: --http-method must be GET or POST\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-body-size" && i + 1 < argc) {
+            http_config.body_size_bytes = parse_size_t(argv[++i], "--http-body-size");
+            if (http_config.body_size_bytes == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-requests" && i + 1 < argc) {
+            http_config.total_requests = parse_size_t(argv[++i], "--http-requests");
+            if (http_config.total_requests == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-connections" && i + 1 < argc) {
+            http_config.connections = parse_size_t(argv[++i], "--http-connections");
+            if (http_config.connections == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--http-pipeline" && i + 1 < argc) {
+            http_config.pipeline_depth = parse_size_t(argv[++i], "--http-pipeline");
+            if (http_config.pipeline_depth == 0) {
                 return EXIT_FAILURE;
             }
         } else if (arg == "--continuous-runs" && i + 1 < argc) {
@@ -202,6 +847,143 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Invalid duration value: " << argv[i] << "\n";
                 return EXIT_FAILURE;
             }
+        } else if (arg == "--cpus" && i + 1 < argc) {
+            placement.cpus = CpuTopology::parse_cpulist(argv[++i]);
+            if (placement.cpus.empty()) {
+                std::cerr << "Error: Invalid CPU list: " << argv[i] << " (expected e.g. 2-5,8)\n";
+                return EXIT_FAILURE;
+            }
+            apply_placement = true;
+        } else if (arg == "--avoid-smt") {
+            placement.avoid_smt_siblings = true;
+            apply_placement = true;
+        } else if (arg == "--isolate") {
+            placement.isolate = true;
+            apply_placement = true;
+        } else if (arg == "--realtime" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "fifo") {
+                realtime_config.policy = ProcessPriority::RealtimePolicy::Fifo;
+            } else if (policy == "rr") {
+                realtime_config.policy = ProcessPriority::RealtimePolicy::RoundRobin;
+            } else {
+                std::cerr << "Error: --realtime must be fifo or rr\n";
+                return EXIT_FAILURE;
+            }
+            realtime_mode = true;
+        } else if (arg == "--rt-priority" && i + 1 < argc) {
+            std::size_t rt_priority = parse_size_t(argv[++i], "--rt-priority");
+            if (rt_priority == 0 || rt_priority > 99) {
+                std::cerr << "Error: --rt-priority must be between 1 and 99\n";
+                return EXIT_FAILURE;
+            }
+            realtime_config.priority = static_cast<int>(rt_priority);
+            rt_priority_set = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (arg == "--telemetry" && i + 1 < argc) {
+            telemetry_path = argv[++i];
+        } else if (arg == "--telemetry-interval" && i + 1 < argc) {
+            try {
+                telemetry_interval = std::stod(argv[++i]);
+                if (telemetry_interval <= 0.0) {
+                    std::cerr << "Error: --telemetry-interval must be greater than 0\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --telemetry-interval: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--list") {
+            list_benchmarks = true;
+        } else if (arg == "--run" && i + 1 < argc) {
+            runner_config.selection = argv[++i];
+            use_runner = true;
+        } else if (arg == "--tenants" && i + 1 < argc) {
+            tenant_count = parse_size_t(argv[++i], "--tenants");
+            if (tenant_count == 0) {
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--tenant-mix" && i + 1 < argc) {
+            std::istringstream mixes(argv[++i]);
+            std::string mix;
+            while (std::getline(mixes, mix, ';')) {
+                if (!mix.empty()) {
+                    tenant_mixes.push_back(mix);
+                }
+            }
+            if (tenant_mixes.empty()) {
+                std::cerr << "Error: --tenant-mix needs at least one selection\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--interference" && i + 1 < argc) {
+            interference_selection = argv[++i];
+        } else if (arg == "--suite" && i + 1 < argc) {
+            suite_path = argv[++i];
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            runner_config.repetitions = parse_size_t(argv[++i], "--repetitions");
+            if (runner_config.repetitions == 0) {
+                return EXIT_FAILURE;
+            }
+            runner_options_set = true;
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            try {
+                runner_config.warmup = static_cast<std::size_t>(std::stoull(argv[++i]));
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --warmup: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+            runner_options_set = true;
+        } else if (arg == "--param" && i + 1 < argc) {
+            std::string assignment = argv[++i];
+            std::size_t equals = assignment.find('=');
+            if (equals == std::string::npos || equals == 0) {
+                std::cerr << "Error: --param expects NAME=VALUE: " << assignment << "\n";
+                return EXIT_FAILURE;
+            }
+            runner_config.overrides[assignment.substr(0, equals)] = assignment.substr(equals + 1);
+            runner_options_set = true;
+        } else if (arg == "--details") {
+            runner_config.print_details = true;
+        } else if (arg == "--output-format" && i + 1 < argc) {
+            std::string format_name = argv[++i];
+            if (format_name == "text") {
+                structured_output = false;
+            } else if (ResultWriter::parse_format(format_name, output_format)) {
+                structured_output = true;
+            } else {
+                std::cerr << "Error: --output-format must be text, json or csv\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--compare" && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (arg == "--compare-raw") {
+            comparison_config.gate_within_run_samples = true;
+        } else if (arg == "--compare-alpha" && i + 1 < argc) {
+            try {
+                comparison_config.alpha = std::stod(argv[++i]);
+                if (comparison_config.alpha <= 0.0 || comparison_config.alpha >= 1.0) {
+                    std::cerr << "Error: --compare-alpha must be between 0 and 1\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --compare-alpha: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--compare-threshold" && i + 1 < argc) {
+            try {
+                comparison_config.threshold_percent = std::stod(argv[++i]);
+                if (comparison_config.threshold_percent < 0.0) {
+                    std::cerr << "Error: --compare-threshold must not be negative\n";
+                    return EXIT_FAILURE;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid value for --compare-threshold: " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+            structured_output = true;
         } else {
             std::cerr << "Error: Unknown option: " << arg << "\n";
             std::cerr << "Use --help for usage information.\n";
@@ -209,11 +991,312 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Recording starts before anything runs; the file is written by finish_run
+    if (!trace_path.empty()) {
+        // Long-running modes only stop on a signal and never reach finish_run
+        if (serve_port != 0 || daemon_mode || agent_mode) {
+            std::cerr << "Error: --trace cannot be combined with --serve, --daemon or --agent\n";
+            return EXIT_FAILURE;
+        }
+        if (!std::ofstream(trace_path)) {
+            std::cerr << "Error: Cannot open trace file: " << trace_path << "\n";
+            return EXIT_FAILURE;
+        }
+        TraceRecorder::enable();
+        TraceRecorder::set_thread_name("main");
+    }
+    
+    BenchmarkRegistry registry;
+    register_core_benchmarks(registry);
+    register_platform_benchmarks(registry);
+    
+    if (list_benchmarks) {
+        registry.print_list();
+        return EXIT_SUCCESS;
+    }
+    
+    // Suite files are checked before anything runs so typos fail fast
+    SuiteConfig suite;
+    if (!suite_path.empty()) {
+        if (use_runner) {
+            std::cerr << "Error: --suite cannot be combined with --run\n";
+            return EXIT_FAILURE;
+        }
+        // Instances carry their own values; set them in [defaults] instead
+        if (runner_options_set) {
+            std::cerr << "Error: --suite cannot be combined with --repetitions, --warmup or --param "
+                         "(set them in the suite file)\n";
+            return EXIT_FAILURE;
+        }
+        std::string suite_error;
+        if (!SuiteConfig::parse_file(suite_path, suite, suite_error)) {
+            std::cerr << "Error: " << suite_error << "\n";
+            return EXIT_FAILURE;
+        }
+        if (!suite.validate(registry, suite_error)) {
+            std::cerr << "Error: " << suite_path << ": " << suite_error << "\n";
+            std::cerr << "Use --list for available benchmarks and parameters.\n";
+            return EXIT_FAILURE;
+        }
+    }
+    
+    // Tenants are placed on their own cores by the tenant processes
+    if (tenant_count > 0 && (apply_placement || !suite_path.empty() || use_runner)) {
+        std::cerr << "Error: --tenants cannot be combined with --cpus, --avoid-smt, --isolate, --suite or --run\n";
+        return EXIT_FAILURE;
+    }
+    if (payload_sweep && !run_network_benchmark) {
+        std::cerr << "Error: --payload-sweep requires --network-host or --network-server\n";
+        return EXIT_FAILURE;
+    }
+    if (payload_sweep && (!cc_compare_list.empty() || network_mode == "loaded")) {
+        std::cerr << "Error: --payload-sweep cannot be combined with --cc-compare or --network-mode loaded\n";
+        return EXIT_FAILURE;
+    }
+    if (http_config.body_size_bytes > 0 && http_config.method != "POST") {
+        std::cerr << "Error: --http-body-size requires --http-method POST\n";
+        return EXIT_FAILURE;
+    }
+    if (roofline_mode && (run_network_benchmark || run_http_benchmark)) {
+        std::cerr << "Error: --roofline cannot be combined with --network-host, --network-server or --http-host\n";
+        return EXIT_FAILURE;
+    }
+    if (auto_iterations && continuous_mode) {
+        std::cerr << "Error: --iterations auto cannot be combined with continuous mode\n";
+        return EXIT_FAILURE;
+    }
+    if (rt_priority_set && !realtime_mode) {
+        std::cerr << "Error: --rt-priority requires --realtime\n";
+        return EXIT_FAILURE;
+    }
+    if (!tenant_mixes.empty() && tenant_count == 0) {
+        std::cerr << "Error: --tenant-mix requires --tenants\n";
+        return EXIT_FAILURE;
+    }
+    // Agents take their suite from the coordinator; the coordinator runs nothing locally
+    if (agent_mode && (!suite_path.empty() || use_runner || tenant_count > 0 ||
+                       !interference_selection.empty() || !fleet_config.agents.empty())) {
+        std::cerr << "Error: --agent cannot be combined with --suite, --run, --tenants, --interference or --agents\n";
+        return EXIT_FAILURE;
+    }
+    if (!fleet_config.agents.empty() &&
+        (suite_path.empty() || apply_placement || realtime_mode || tenant_count > 0 ||
+         !interference_selection.empty())) {
+        std::cerr << "Error: --agents requires --suite and cannot be combined with --cpus, --avoid-smt, "
+                     "--isolate, --realtime, --tenants or --interference\n";
+        return EXIT_FAILURE;
+    }
+    if ((agent_mode || !fleet_config.agents.empty()) && agent_config.token.empty()) {
+        std::cerr << "Error: --agent and --agents require --agent-token-file\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> interference_benchmarks;
+    if (!interference_selection.empty()) {
+        if (apply_placement || !suite_path.empty() || use_runner || tenant_count > 0) {
+            std::cerr << "Error: --interference cannot be combined with --cpus, --avoid-smt, --isolate, "
+                         "--suite, --run or --tenants\n";
+            return EXIT_FAILURE;
+        }
+        std::vector<std::string> unmatched;
+        interference_benchmarks = registry.match(interference_selection, unmatched);
+        if (!unmatched.empty() || interference_benchmarks.empty()) {
+            std::cerr << "Error: No registered benchmark matches: "
+                      << (unmatched.empty() ? interference_selection : unmatched.front()) << "\n";
+            std::cerr << "Use --list for available benchmarks.\n";
+            return EXIT_FAILURE;
+        }
+    }
+    
+    // Structured results go to --output, or to stdout with the human-readable
+    // tables moved to stderr so the document stays parseable
+    std::ostream console_stdout(std::cout.rdbuf());
+    StdoutRedirectGuard stdout_redirect_guard;
+    std::ofstream output_file;
+    std::vector<std::unique_ptr<ResultWriter>> result_writers;
+    if (structured_output && serve_port == 0 && !daemon_mode && !agent_mode) {
+        std::ostream* structured_stream = &console_stdout;
+        if (output_path != "-") {
+            output_file.open(output_path);
+            if (!output_file) {
+                std::cerr << "Error: Cannot open output file: " << output_path << "\n";
+                return EXIT_FAILURE;
+            }
+            structured_stream = &output_file;
+        } else {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        }
+        result_writers.push_back(std::make_unique<ResultWriter>(*structured_stream, output_format));
+    }
+    
+    // Telemetry lines share stdout the same way, so the two cannot both use it
+    std::ofstream telemetry_file;
+    std::unique_ptr<IntervalTelemetry> telemetry;
+    if (!telemetry_path.empty()) {
+        if (!continuous_mode || !run_benchmark) {
+            std::cerr << "Error: --telemetry requires the memory benchmark in continuous mode\n";
+            return EXIT_FAILURE;
+        }
+        std::ostream* telemetry_stream = &console_stdout;
+        if (telemetry_path != "-") {
+            telemetry_file.open(telemetry_path);
+            if (!telemetry_file) {
+                std::cerr << "Error: Cannot open telemetry file: " << telemetry_path << "\n";
+                return EXIT_FAILURE;
+            }
+            telemetry_stream = &telemetry_file;
+        } else if (!result_writers.empty() && output_path == "-") {
+            std::cerr << "Error: --telemetry - and structured output cannot both use stdout\n";
+            return EXIT_FAILURE;
+        } else {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        }
+        telemetry = std::make_unique<IntervalTelemetry>(*telemetry_stream, "memory.continuous",
+                                                        telemetry_interval);
+    }
+    
+    // --compare collects the same records into an in-memory JSON document
+    std::ostringstream comparison_document;
+    ResultWriter* comparison_writer = nullptr;
+    if (!baseline_path.empty() && serve_port == 0 && !daemon_mode && !agent_mode) {
+        result_writers.push_back(std::make_unique<ResultWriter>(comparison_document,
+                                                                ResultWriter::Format::Json));
+        comparison_writer = result_writers.back().get();
+    }
+    auto write_structured = [&result_writers](const std::function<void(ResultWriter&)>& write) {
+        for (const std::unique_ptr<ResultWriter>& writer : result_writers) {
+            write(*writer);
+        }
+    };
+    // Compares against the baseline (if requested) once every benchmark ran;
+    // a significant regression turns a successful run into a failure
+    auto finish_run = [&](int exit_code) {
+        if (!trace_path.empty()) {
+            std::ofstream trace_file(trace_path);
+            if (!trace_file || !TraceRecorder::write_chrome_trace(trace_file)) {
+                std::cerr << "Error: Cannot write trace file: " << trace_path << "\n";
+                exit_code = EXIT_FAILURE;
+            } else if (TraceRecorder::dropped_events() > 0) {
+                std::cerr << "Warning: Trace buffers were full; " << TraceRecorder::dropped_events()
+                          << " events dropped\n";
+            }
+        }
+        if (comparison_writer == nullptr) {
+            return exit_code;
+        }
+        comparison_writer->finish();
+        
+        JsonValue baseline;
+        JsonValue current;
+        std::string parse_error;
+        if (!JsonValue::parse_file(baseline_path, baseline, parse_error)) {
+            std::cerr << "Error: Cannot load baseline: " << parse_error << "\n";
+            return EXIT_FAILURE;
+        }
+        if (!JsonValue::parse(comparison_document.str(), current, parse_error)) {
+            std::cerr << "Error: Cannot read current results: " << parse_error << "\n";
+            return EXIT_FAILURE;
+        }
+        
+        BaselineComparison comparison(comparison_config);
+        BaselineComparison::Results comparison_results = comparison.compare(baseline, current);
+        BaselineComparison::print_results(comparison_results);
+        for (const std::unique_ptr<ResultWriter>& writer : result_writers) {
+            if (writer.get() != comparison_writer) {
+                BaselineComparison::write_results(comparison_results, *writer);
+            }
+        }
+        
+        if (!comparison_results.comparison_successful || comparison_results.regressions > 0) {
+            return EXIT_FAILURE;
+        }
+        return exit_code;
+    };
+    
     print_banner();
-    print_environment_info();
+    
+    // Server mode: act as the peer for another host's network benchmarks
+    if (serve_port != 0) {
+        EchoServer server;
+        if (!server.start("0.0.0.0", serve_port)) {
+            std::cerr << "Error: " << server.error_message() << "\n";
+            return EXIT_FAILURE;
+        }
+        EchoServer::Ports ports = server.ports();
+        std::cout << "Serving network benchmark endpoints (Ctrl+C to stop):\n";
+        std::cout << "  TCP echo: " << ports.tcp_echo << "\n";
+        std::cout << "  TCP sink: " << ports.tcp_sink << "\n";
+        std::cout << "  UDP echo: " << ports.udp_echo << "\n";
+        std::cout << std::flush;
+        while (server.is_running()) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        return EXIT_SUCCESS;
+    }
+    
+    // Canary mode: lightweight probes forever, results scraped over HTTP
+    if (daemon_mode) {
+        daemon_config.overrides = runner_config.overrides;
+        CanaryDaemon daemon(registry);
+        if (!daemon.start(daemon_config)) {
+            std::cerr << "Error: " << daemon.error_message() << "\n";
+            return EXIT_FAILURE;
+        }
+        std::signal(SIGINT, handle_stop_signal);
+        std::signal(SIGTERM, handle_stop_signal);
+        std::cout << "Canary daemon (SIGINT/SIGTERM to stop):\n";
+        std::cout << "  Metrics: http://" << daemon_config.bind_address << ":" << daemon.port() << "/metrics\n";
+        std::cout << "  Probes: " << daemon_config.probes << "\n";
+        std::cout << "  Interval: " << daemon_config.interval_seconds << " s, CPU budget: "
+                  << (daemon_config.cpu_budget * 100.0) << "%\n";
+        std::cout << std::flush;
+        daemon.run([]() { return stop_requested != 0; });
+        daemon.stop();
+        return EXIT_SUCCESS;
+    }
+    
+    // Fleet agent: serve coordinator sessions until stopped
+    if (agent_mode) {
+        FleetAgent agent(registry);
+        if (!agent.start(agent_config)) {
+            std::cerr << "Error: " << agent.error_message() << "\n";
+            return EXIT_FAILURE;
+        }
+        std::signal(SIGINT, handle_stop_signal);
+        std::signal(SIGTERM, handle_stop_signal);
+        std::cout << "Fleet agent (SIGINT/SIGTERM to stop):\n";
+        std::cout << "  Listening: " << agent_config.bind_address << ":" << agent.port() << "\n";
+        std::cout << "  Node: " << agent.node_name() << "\n";
+        std::cout << std::flush;
+        agent.run([]() { return stop_requested != 0; });
+        return EXIT_SUCCESS;
+    }
+    
+    // Fleet coordinator: the suite runs on the agents, not on this host
+    if (!fleet_config.agents.empty()) {
+        std::ifstream suite_file(suite_path);
+        std::ostringstream suite_text;
+        suite_text << suite_file.rdbuf();
+        fleet_config.suite_text = suite_text.str();
+        std::cout << "Running " << suite_path << " on " << fleet_config.agents.size() << " agents...\n"
+                  << std::flush;
+        FleetReport::Results fleet_results = FleetCoordinator::run(fleet_config);
+        FleetReport::print_results(fleet_results);
+        write_structured([&](ResultWriter& writer) {
+            writer.begin_object();
+            writer.field("tool", "SystemBenchmark");
+            writer.field("version", VERSION);
+            FleetReport::write_results(fleet_results, writer);
+        });
+        return finish_run(fleet_results.benchmark_successful ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    
+    // Captured before priority changes so the load average reflects the host alone
+    EnvironmentInfo::Results host = EnvironmentInfo::capture();
+    print_environment_info(host);
     
     // Attempt to raise process priority (best-effort, non-blocking)
     ProcessPriority priority;
+    IsolationSignalGuard isolation_signal_guard;
     std::int32_t initial_priority = priority.get_current_priority();
     ProcessPriority::Result priority_result = priority.attempt_raise();
     std::int32_t final_priority = priority.get_current_priority();
@@ -236,11 +1319,183 @@ int main(int argc, char* argv[]) {
     }
     std::cout << "\n";
     
+    // Pinned before any worker or server thread exists; those claim worker CPUs
+    ProcessPriority::PlacementResults placement_results{};
+    if (apply_placement) {
+        placement_results = priority.apply_placement(placement, CpuTopology::current());
+        if (placement_results.result == ProcessPriority::Result::Error) {
+            std::cerr << "Error: " << placement_results.error_message << "\n";
+            return finish_run(EXIT_FAILURE);
+        }
+        print_cpu_placement(placement_results);
+        // ~ProcessPriority does not run when a signal kills the process
+        if (placement.isolate) {
+            isolating_priority = &priority;
+            std::signal(SIGINT, handle_isolation_signal);
+            std::signal(SIGTERM, handle_isolation_signal);
+        }
+    }
+    
+    // After placement so the measuring thread is on its CPU before it
+    // stops yielding; threads created later inherit the policy
+    ProcessPriority::RealtimeResults realtime_results{};
+    if (realtime_mode) {
+        realtime_results = priority.enter_realtime(realtime_config);
+        print_realtime(realtime_results);
+    }
+    
+    write_structured([&](ResultWriter& writer) {
+        writer.begin_object();
+        writer.field("tool", "SystemBenchmark");
+        writer.field("version", VERSION);
+        write_environment(writer, initial_priority, final_priority, priority_result,
+                          apply_placement ? &placement_results : nullptr,
+                          realtime_mode ? &realtime_results : nullptr, host);
+    });
+    
+    // Registry mode: selected benchmarks replace the individual modes below
+    if (!suite_path.empty()) {
+        BenchmarkRunner runner;
+        std::string runner_error;
+        auto pin_cpu = [&priority](int cpu, std::string& error_message) {
+            ProcessPriority::Result result = priority.set_cpu_affinity(cpu);
+            if (result != ProcessPriority::Result::Success) {
+                error_message = ProcessPriority::result_to_string(result);
+                return false;
+            }
+            return true;
+        };
+        std::vector<BenchmarkRunner::Run> runs = runner.run_suite(registry, suite, runner_config.print_details,
+                                                                  pin_cpu, runner_error);
+        if (!runner_error.empty()) {
+            std::cerr << "Error: " << runner_error << "\n";
+            return finish_run(EXIT_FAILURE);
+        }
+        BenchmarkRunner::print_summary(runs);
+        write_structured([&](ResultWriter& writer) {
+            BenchmarkRunner::write_results(runs, writer);
+        });
+        int exit_code = EXIT_SUCCESS;
+        for (const BenchmarkRunner::Run& run : runs) {
+            if (!run.benchmark_successful) {
+                exit_code = EXIT_FAILURE;
+            }
+        }
+        return finish_run(exit_code);
+    }
+    
+    if (tenant_count > 0) {
+        // Tenants sharing a core would measure time-slicing, not contention
+        std::vector<int> allowed_cpus = ProcessPriority::allowed_cpus();
+        std::size_t allowed_cores = TenantContention::allowed_cores(CpuTopology::current(), allowed_cpus);
+        if (!CpuTopology::current().cores().empty() && allowed_cores < tenant_count) {
+            std::cerr << "Error: --tenants " << tenant_count << " needs a core per tenant; this process may run on "
+                      << allowed_cores << " cores (CPUs " << CpuTopology::format_cpulist(allowed_cpus) << ")\n";
+            return finish_run(EXIT_FAILURE);
+        }
+        TenantContention::Config tenant_config;
+        tenant_config.tenants = TenantContention::assign_tenants(tenant_count, tenant_mixes, CpuTopology::current(),
+                                                                 allowed_cpus);
+        tenant_config.repetitions = runner_config.repetitions;
+        tenant_config.overrides = runner_config.overrides;
+        std::cout << "Running " << tenant_count << " tenants, each alone and then all together...\n";
+        for (const TenantContention::Tenant& tenant : tenant_config.tenants) {
+            std::cout << "  " << tenant.name << ": " << tenant.selection << " on CPUs "
+                      << (tenant.cpus.empty() ? "(unpinned)" : CpuTopology::format_cpulist(tenant.cpus)) << "\n";
+        }
+        std::cout << std::flush;
+        TenantContention::Results tenant_results = TenantContention::run(registry, tenant_config);
+        TenantContention::print_results(tenant_results);
+        write_structured([&](ResultWriter& writer) {
+            TenantContention::write_results(tenant_results, writer);
+        });
+        return finish_run(tenant_results.benchmark_successful ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    
+    if (!interference_benchmarks.empty()) {
+        std::vector<int> allowed_cpus = ProcessPriority::allowed_cpus();
+        std::size_t allowed_cores = TenantContention::allowed_cores(CpuTopology::current(), allowed_cpus);
+        if (!CpuTopology::current().cores().empty() && allowed_cores < 2) {
+            std::cerr << "Error: --interference needs two cores; this process may run on " << allowed_cores
+                      << " cores (CPUs " << CpuTopology::format_cpulist(allowed_cpus) << ")\n";
+            return finish_run(EXIT_FAILURE);
+        }
+        InterferenceMatrix::Config interference_config;
+        interference_config.benchmarks = interference_benchmarks;
+        interference_config.repetitions = runner_config.repetitions;
+        interference_config.overrides = runner_config.overrides;
+        std::size_t pairs = interference_benchmarks.size() * (interference_benchmarks.size() + 1) / 2;
+        std::cout << "Running " << interference_benchmarks.size() << " benchmarks alone, then "
+                  << pairs << " pairs on separate cores...\n" << std::flush;
+        InterferenceMatrix::Results interference_results =
+            InterferenceMatrix::run(registry, interference_config, CpuTopology::current());
+        InterferenceMatrix::print_results(interference_results);
+        write_structured([&](ResultWriter& writer) {
+            InterferenceMatrix::write_results(interference_results, writer);
+        });
+        return finish_run(interference_results.benchmark_successful ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    
+    if (use_runner) {
+        BenchmarkRunner runner;
+        std::string runner_error;
+        std::vector<BenchmarkRunner::Run> runs = runner.run(registry, runner_config, runner_error);
+        if (!runner_error.empty()) {
+            std::cerr << "Error: " << runner_error << "\n";
+            std::cerr << "Use --list for available benchmarks and parameters.\n";
+            return finish_run(EXIT_FAILURE);
+        }
+        BenchmarkRunner::print_summary(runs);
+        write_structured([&](ResultWriter& writer) {
+            BenchmarkRunner::write_results(runs, writer);
+        });
+        int exit_code = EXIT_SUCCESS;
+        for (const BenchmarkRunner::Run& run : runs) {
+            if (!run.benchmark_successful) {
+                exit_code = EXIT_FAILURE;
+            }
+        }
+        return finish_run(exit_code);
+    }
+    
+    if (roofline_mode) {
+        RooflineModel::Config config = roofline_config(host);
+        std::cout << "Measuring roofline (peak compute, " << config.levels.size() << " memory levels)...\n";
+        RooflineModel::Results roofline = RooflineModel::measure(config);
+        if (roofline.benchmark_successful) {
+            CpuBenchmark cpu_benchmark;
+            CpuBenchmark::Results cpu_results = cpu_benchmark.run(cpu_iterations);
+            for (const CpuBenchmark::WorkloadStats& workload : cpu_results.workloads) {
+                RooflineModel::place(roofline, {"cpu." + workload.name, workload.operations, workload.bytes,
+                                                workload.seconds, workload.working_set_bytes});
+            }
+
+            // Memory workload at every level. Per byte it reads (XOR into the
+            // sink), writes (pattern AND, store) and verifies (pattern AND,
+            // compare): four operations over three bytes of traffic
+            MemoryBenchmark memory_benchmark;
+            for (const RooflineModel::Roof& roof : roofline.roofs) {
+                std::size_t memory_iterations = std::max<std::size_t>(2, (64 * 1024 * 1024) / roof.test_bytes);
+                MemoryBenchmark::Results memory_results = memory_benchmark.run(roof.test_bytes, memory_iterations);
+                double touched = static_cast<double>(roof.test_bytes) * static_cast<double>(memory_iterations);
+                RooflineModel::place(roofline, {"memory." + roof.name, 4.0 * touched, 3.0 * touched,
+                                                memory_results.timing.total_time_seconds, roof.test_bytes});
+            }
+        }
+        RooflineModel::print_results(roofline);
+        write_structured([&](ResultWriter& writer) {
+            RooflineModel::write_results(roofline, writer);
+        });
+        return finish_run(roofline.benchmark_successful ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    
     // Run memory benchmark if parameters provided
     double memory_latency_ns = 0.0;
     if (run_benchmark) {
         MemoryBenchmark benchmark;
         MemoryBenchmark::Results results;
+        benchmark.set_exclude_outliers(exclude_outliers);
+        benchmark.set_telemetry(telemetry.get());
         
         if (continuous_mode) {
             std::cout << "Running RAM Benchmark (Continuous/Stability Mode)...\n";
@@ -253,10 +1508,28 @@ int main(int argc, char* argv[]) {
                           << continuous_duration << " seconds\n";
             }
             std::cout << "Note: Tracking consistency and variance across runs.\n";
+            
+            // Throughput shifts are correlated with frequency and throttling between runs
+            ThermalSampler thermal_sampler;
+            if (thermal_sampler.available()) {
+                benchmark.set_condition_sampler([&thermal_sampler]() { return thermal_sampler.sample(); });
+            } else {
+                std::cout << "Note: No CPU frequency, temperature or throttle counters found; "
+                          << "drift is reported without host correlation.\n";
+            }
             std::cout << "\n";
             
             results = benchmark.run_continuous(buffer_size, iterations, 
                                               continuous_runs, continuous_duration);
+        } else if (auto_iterations) {
+            std::cout << "Running RAM Benchmark (Auto-Calibrated)...\n";
+            std::cout << "Buffer Size: " << buffer_size << " bytes\n";
+            std::cout << "Target: 95% CI within " << std::fixed << std::setprecision(2)
+                      << (calibration_config.target_relative_ci * 100.0) << "% of the mean, budget "
+                      << calibration_config.max_seconds << " seconds\n";
+            std::cout << "\n";
+
+            results = benchmark.run_calibrated(buffer_size, calibration_config);
         } else {
             std::cout << "Running RAM Benchmark (Single Run Mode)...\n";
             std::cout << "Buffer Size: " << buffer_size << " bytes\n";
@@ -267,11 +1540,14 @@ int main(int argc, char* argv[]) {
         }
         
         MemoryBenchmark::print_results(results);
+        write_structured([&](ResultWriter& writer) {
+            MemoryBenchmark::write_results(results, writer);
+        });
         
         memory_latency_ns = results.timing.avg_latency_ns;
         
         if (!results.verification_passed) {
-            return EXIT_FAILURE;
+            return finish_run(EXIT_FAILURE);
         }
     }
 
@@ -285,6 +1561,9 @@ int main(int argc, char* argv[]) {
         CpuBenchmark cpu_benchmark;
         CpuBenchmark::Results cpu_results = cpu_benchmark.run(cpu_iterations);
         CpuBenchmark::print_results(cpu_results);
+        write_structured([&](ResultWriter& writer) {
+            CpuBenchmark::write_results(cpu_results, writer);
+        });
         
         cpu_time_per_op_ns = cpu_results.timing.time_per_operation_ns;
 
@@ -295,53 +1574,247 @@ int main(int argc, char* argv[]) {
 
     // Run network benchmark if requested
     if (run_network_benchmark) {
+        EchoServer echo_server;
+        EchoServer::Ports ports{network_port, static_cast<std::uint16_t>(network_port + 1), network_port};
+        
+        if (use_builtin_server) {
+            if (!echo_server.start("127.0.0.1", 0)) {
+                std::cerr << "Error: Failed to start built-in server: "
+                          << echo_server.error_message() << "\n";
+                return finish_run(EXIT_FAILURE);
+            }
+            ports = echo_server.ports();
+            if (network_host.empty()) {
+                network_host = "127.0.0.1";
+            }
+            std::cout << "Built-in server: TCP echo " << ports.tcp_echo 
+                      << ", TCP sink " << ports.tcp_sink 
+                      << ", UDP echo " << ports.udp_echo << "\n";
+        }
+        
         if (network_host.empty()) {
             std::cerr << "Error: --network-host requires a hostname or IP address\n";
-            return EXIT_FAILURE;
+            return finish_run(EXIT_FAILURE);
         }
         
-        std::cout << "Running Network Benchmark...\n";
-        std::cout << "Target: " << network_host << ":" << network_port << "\n";
-        if (network_iterations > 1) {
-            std::cout << "Iterations: " << network_iterations << " (call-like loop)\n";
+        // Insert the WAN-emulation proxy between client and server
+        ImpairmentProxy proxy;
+        bool use_proxy = ImpairmentProxy::is_active(proxy_config);
+        if (use_proxy) {
+            std::vector<ImpairmentProxy::Route> routes = {
+                {false, ports.tcp_echo, 0},
+                {false, ports.tcp_sink, 0},
+                {true, ports.udp_echo, 0}
+            };
+            if (!proxy.start(proxy_config, network_host, routes)) {
+                std::cerr << "Error: Failed to start impairment proxy: "
+                          << proxy.error_message() << "\n";
+                return finish_run(EXIT_FAILURE);
+            }
+            ports = EchoServer::Ports{routes[0].listen_port, routes[1].listen_port, 
+                                      routes[2].listen_port};
+            network_host = "127.0.0.1";
+            std::cout << "Impairment proxy: delay " << proxy_config.delay_ms << " ms, jitter " 
+                      << proxy_config.jitter_ms << " ms, loss " << proxy_config.loss_percent 
+                      << " % (ports " << ports.tcp_echo << "/" << ports.tcp_sink 
+                      << "/" << ports.udp_echo << ")\n";
         }
-        std::cout << "\n";
+        
+        network_port = (network_mode == "bulk") ? ports.tcp_sink : ports.tcp_echo;
         
         NetworkBenchmark network_benchmark;
-        NetworkBenchmark::Results network_results;
+        if (tcp_info_interval_ms >= 0.0) {
+            network_benchmark.set_tcp_info_interval_ms(tcp_info_interval_ms);
+        }
+        network_benchmark.set_socket_options(socket_options);
         
-        if (network_iterations > 1) {
-            network_results = network_benchmark.run_call_loop(
-                network_host, network_port, network_iterations, 1024);
+        if (!cc_compare_list.empty()) {
+            NetworkBenchmark::TransportCompareConfig compare_config;
+            if (cc_compare_list == "all") {
+                compare_config.congestion_controls = NetworkBenchmark::available_congestion_controls();
+            } else {
+                std::stringstream list_stream(cc_compare_list);
+                std::string algorithm;
+                while (std::getline(list_stream, algorithm, ',')) {
+                    if (!algorithm.empty()) {
+                        compare_config.congestion_controls.push_back(algorithm);
+                    }
+                }
+            }
+            compare_config.echo_port = ports.tcp_echo;
+            compare_config.sink_port = ports.tcp_sink;
+            compare_config.payload_size_bytes = payload_size;
+            if (network_iterations > 1) {
+                compare_config.handshake_iterations = network_iterations;
+                compare_config.rtt_iterations = network_iterations;
+            }
+            if (bulk_duration > 0.0) {
+                compare_config.bulk_duration_seconds = bulk_duration;
+            }
+            
+            std::cout << "Running Transport Comparison...\n";
+            std::cout << "Target: " << network_host << "\n";
+            std::cout << "Algorithms: ";
+            if (compare_config.congestion_controls.empty()) {
+                std::cout << "system default";
+            }
+            for (std::size_t a = 0; a < compare_config.congestion_controls.size(); ++a) {
+                std::cout << (a > 0 ? ", " : "") << compare_config.congestion_controls[a];
+            }
+            std::cout << "\n\n";
+            
+            std::vector<NetworkBenchmark::TransportResults> comparison = 
+                network_benchmark.run_transport_comparison(network_host, compare_config);
+            NetworkBenchmark::print_transport_comparison(comparison);
+            write_structured([&](ResultWriter& writer) {
+                NetworkBenchmark::write_transport_comparison(comparison, writer,
+                                                             "transport_comparison");
+            });
+        } else if (network_mode == "loaded") {
+            NetworkBenchmark::LoadedLatencyConfig loaded_config;
+            loaded_config.echo_port = ports.tcp_echo;
+            loaded_config.sink_port = ports.tcp_sink;
+            loaded_config.load_flows = load_flows;
+            if (network_iterations > 1) {
+                loaded_config.rtt_iterations = network_iterations;
+            }
+            
+            std::cout << "Running Latency Under Load...\n";
+            std::cout << "Target: " << network_host << " (echo " << ports.tcp_echo 
+                      << ", sink " << ports.tcp_sink << ")\n";
+            std::cout << "\n";
+            
+            NetworkBenchmark::LoadedLatencyResults loaded_results = 
+                network_benchmark.run_latency_under_load(network_host, loaded_config);
+            NetworkBenchmark::print_latency_under_load(loaded_results);
+            write_structured([&](ResultWriter& writer) {
+                NetworkBenchmark::write_latency_under_load(loaded_results, writer,
+                                                           "latency_under_load");
+            });
+            
+            if (!loaded_results.benchmark_successful) {
+                std::cerr << "Warning: Latency-under-load test failed: " 
+                          << loaded_results.error_message << "\n";
+            }
+        } else if (payload_sweep) {
+            NetworkBenchmark::SweepConfig sweep_config;
+            sweep_config.payload_sizes = NetworkBenchmark::power_of_two_sizes(sweep_min, sweep_max);
+            sweep_config.rtt_port = ports.tcp_echo;
+            sweep_config.bulk_port = ports.tcp_sink;
+            sweep_config.udp_port = ports.udp_echo;
+            if (network_iterations > 1) {
+                sweep_config.rtt_iterations = network_iterations;
+                sweep_config.udp_iterations = network_iterations;
+            }
+            if (bulk_duration > 0.0) {
+                sweep_config.bulk_duration_seconds = bulk_duration;
+            }
+            
+            std::cout << "Running Network Payload Sweep...\n";
+            std::cout << "Target: " << network_host << "\n";
+            std::cout << "Payload Sizes: " << sweep_config.payload_sizes.size() 
+                      << " points from " << sweep_min << " to " << sweep_max << " bytes\n";
+            std::cout << "\n";
+            
+            NetworkBenchmark::PathLimits path_limits =
+                network_benchmark.probe_path_limits(network_host, ports.tcp_echo);
+            std::vector<NetworkBenchmark::Results> sweep_results = 
+                network_benchmark.run_payload_sweep(network_host, sweep_config);
+            NetworkBenchmark::print_sweep(sweep_results, path_limits);
+            write_structured([&](ResultWriter& writer) {
+                NetworkBenchmark::write_path_limits(path_limits, writer, "payload_sweep_limits");
+                writer.begin_array("payload_sweep");
+                for (const NetworkBenchmark::Results& point : sweep_results) {
+                    NetworkBenchmark::write_results(point, writer);
+                }
+                writer.end_array();
+            });
         } else {
-            network_results = network_benchmark.run(
-                network_host, network_port, 1024);
+            std::cout << "Running Network Benchmark...\n";
+            std::cout << "Target: " << network_host << ":" << network_port << "\n";
+            std::cout << "Mode: " << network_mode << "\n";
+            if (network_mode == "connect" && network_iterations > 1) {
+                std::cout << "Iterations: " << network_iterations << " (call-like loop)\n";
+            }
+            std::cout << "\n";
+            
+            NetworkBenchmark::Results network_results;
+            
+            if (network_mode == "rtt") {
+                network_results = network_benchmark.run_rtt(
+                    network_host, network_port, network_iterations, payload_size);
+            } else if (network_mode == "bulk") {
+                network_results = network_benchmark.run_bulk(
+                    network_host, network_port, bulk_duration > 0.0 ? bulk_duration : 1.0, 
+                    payload_size);
+            } else if (network_mode == "handshake") {
+                network_results = network_benchmark.run_handshake(
+                    network_host, network_port, network_iterations, payload_size);
+            } else if (network_mode == "udp") {
+                network_results = network_benchmark.run_udp(
+                    network_host, ports.udp_echo, network_iterations, payload_size);
+            } else if (network_iterations > 1) {
+                network_results = network_benchmark.run_call_loop(
+                    network_host, network_port, network_iterations, payload_size);
+            } else {
+                network_results = network_benchmark.run(
+                    network_host, network_port, payload_size);
+            }
+            
+            NetworkBenchmark::print_results(network_results);
+            write_structured([&](ResultWriter& writer) {
+                NetworkBenchmark::write_results(network_results, writer, "network");
+            });
+            
+            // Print comparisons if other benchmarks were also run
+            if (run_benchmark && memory_latency_ns > 0.0) {
+                NetworkBenchmark::print_comparison(network_results, memory_latency_ns);
+            }
+            
+            if (run_cpu_benchmark && cpu_time_per_op_ns > 0.0) {
+                NetworkBenchmark::print_cpu_comparison(network_results, cpu_time_per_op_ns);
+            }
+            
+            if (!network_results.benchmark_successful) {
+                std::cerr << "Warning: Network benchmark failed. "
+                          << "This may be due to network connectivity issues, "
+                          << "firewall rules, or the target server not accepting connections.\n";
+            }
         }
         
-        NetworkBenchmark::print_results(network_results);
-        
-        // Print comparisons if other benchmarks were also run
-        if (run_benchmark && memory_latency_ns > 0.0) {
-            NetworkBenchmark::print_comparison(network_results, memory_latency_ns);
+        if (use_proxy) {
+            proxy.stop();
+            ImpairmentProxy::print_summary(proxy_config, proxy.stats());
         }
+    }
+    
+    // Run HTTP load generation if requested
+    if (run_http_benchmark) {
+        std::cout << "Running HTTP Benchmark...\n";
+        std::cout << "Target: " << http_config.host << ":" << http_config.port 
+                  << http_config.path << "\n";
+        std::cout << "Requests: " << http_config.total_requests 
+                  << " over " << http_config.connections << " connection(s)\n";
+        std::cout << "\n";
         
-        if (run_cpu_benchmark && cpu_time_per_op_ns > 0.0) {
-            NetworkBenchmark::print_cpu_comparison(network_results, cpu_time_per_op_ns);
-        }
+        HttpBenchmark http_benchmark;
+        HttpBenchmark::Results http_results = http_benchmark.run(http_config);
+        HttpBenchmark::print_results(http_results);
+        write_structured([&](ResultWriter& writer) {
+            HttpBenchmark::write_results(http_results, writer);
+        });
         
-        if (!network_results.benchmark_successful) {
-            std::cerr << "Warning: Network benchmark failed. "
-                      << "This may be due to network connectivity issues, "
-                      << "firewall rules, or the target server not accepting connections.\n";
+        if (!http_results.benchmark_successful) {
+            std::cerr << "Warning: HTTP benchmark failed: " << http_results.error_message << "\n";
         }
     }
     
-    if (!run_benchmark && !run_cpu_benchmark && !run_network_benchmark) {
+    if (!run_benchmark && !run_cpu_benchmark && !run_network_benchmark && !run_http_benchmark) {
         std::cout << "Benchmarking framework initialized.\n";
         std::cout << "Use --help to see usage information.\n";
         std::cout << "\n";
     }
     
-    return EXIT_SUCCESS;
+    return finish_run(EXIT_SUCCESS);
 }
 
@@ -3,7 +3,11 @@
  */
 
 #include "network_benchmark.h"
+#include "statistics.h"
 #include "timer.h"
+#include "result_writer.h"
+#include "trace_recorder.h"
+#include "process_priority.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -13,17 +17,125 @@
 #include <cstddef>
 #include <limits>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <thread>
+#include <chrono>
 
 #ifdef __linux__
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <poll.h>
 #include <unistd.h>
 #include <fcntl.h>
 #endif
 
-NetworkBenchmark::NetworkBenchmark() noexcept {
+namespace {
+    constexpr int UDP_REPLY_TIMEOUT_MS = 200;
+    constexpr int EXCHANGE_TIMEOUT_MS = 5000;
+    constexpr std::uint64_t MIN_SWEEP_ITERATIONS = 5;
+    constexpr double DEFAULT_TCP_INFO_INTERVAL_MS = 100.0;
+    constexpr const char* AVAILABLE_CC_PATH = "/proc/sys/net/ipv4/tcp_available_congestion_control";
+    constexpr const char* FAST_OPEN_SYSCTL_PATH = "/proc/sys/net/ipv4/tcp_fastopen";
+
+    /**
+     * Reads net.ipv4.tcp_fastopen (bit 0 = client, bit 1 = server), or -1.
+     */
+    int read_fast_open_sysctl() {
+        std::ifstream file(FAST_OPEN_SYSCTL_PATH);
+        int value = -1;
+        if (!(file >> value)) {
+            return -1;
+        }
+        return value;
+    }
+
+    std::string format_size(std::size_t size_bytes) {
+        if (size_bytes < 1024) {
+            return std::to_string(size_bytes) + " B";
+        } else if (size_bytes < 1024 * 1024) {
+            return std::to_string(size_bytes / 1024) + " KB";
+        }
+        return std::to_string(size_bytes / (1024 * 1024)) + " MB";
+    }
+
+    /**
+     * Names the path limits a sweep crosses between two consecutive
+     * payload sizes, e.g. "  <- MTU, SO_SNDBUF".
+     */
+    std::string limit_marks(std::size_t previous_payload, std::size_t payload,
+                            const NetworkBenchmark::PathLimits& limits) {
+        const std::pair<const char*, std::size_t> named_limits[] = {
+            {"MTU", limits.mtu_bytes},
+            {"SO_SNDBUF", limits.send_buffer_bytes},
+            {"SO_RCVBUF", limits.receive_buffer_bytes},
+        };
+        std::string marks;
+        for (const auto& limit : named_limits) {
+            if (limit.second > previous_payload && limit.second <= payload) {
+                marks += (marks.empty() ? "  <- " : ", ") + std::string(limit.first);
+            }
+        }
+        return marks;
+    }
+
+    /**
+     * Prints the bootstrap intervals of the round-trip mean, p50 and p99.
+     */
+    void print_round_trip_intervals(const Statistics::BootstrapSummary& summary) {
+        if (summary.sample_count < 2) {
+            return;
+        }
+        const std::pair<const char*, const Statistics::ConfidenceInterval*> intervals[] = {
+            {"Mean 95% CI:", &summary.mean},
+            {"p50 95% CI:", &summary.median},
+            {"p99 95% CI:", &summary.p99},
+        };
+        for (const auto& interval : intervals) {
+            std::cout << "  " << std::left << std::setw(25) << interval.first
+                      << std::fixed << std::setprecision(3)
+                      << "[" << interval.second->lower << ", "
+                      << interval.second->upper << "] ms\n";
+        }
+    }
+}
+
+NetworkBenchmark::NetworkBenchmark() noexcept
+    : tcp_info_interval_ms_(DEFAULT_TCP_INFO_INTERVAL_MS),
+      rejected_option_(RejectedOption::None),
+      rejected_errno_(0) {
+}
+
+void NetworkBenchmark::set_tcp_info_interval_ms(double interval_ms) noexcept {
+    tcp_info_interval_ms_ = interval_ms > 0.0 ? interval_ms : 0.0;
+}
+
+void NetworkBenchmark::set_socket_options(const SocketOptions& options) {
+    socket_options_ = options;
+}
+
+std::vector<std::string> NetworkBenchmark::available_congestion_controls() {
+    std::vector<std::string> algorithms;
+    std::ifstream file(AVAILABLE_CC_PATH);
+    std::string algorithm;
+    while (file >> algorithm) {
+        algorithms.push_back(algorithm);
+    }
+    return algorithms;
+}
+
+void NetworkBenchmark::record_tcp_info(
+    TcpInfoSampler& sampler,
+    int socket_fd,
+    Results& results
+) noexcept {
+    results.tcp_info_available = sampler.finish(socket_fd);
+    results.tcp_info_samples = sampler.samples();
+    results.tcp_info_final = sampler.final_sample();
 }
 
 NetworkBenchmark::Results NetworkBenchmark::run(
@@ -32,6 +144,9 @@ NetworkBenchmark::Results NetworkBenchmark::run(
     std::size_t payload_size_bytes
 ) {
     Results results{};
+    results.mode = "connect";
+    results.congestion_control = socket_options_.congestion_control;
+    results.fast_open = socket_options_.fast_open;
     results.target_host = host;
     results.target_port = port;
     results.payload_size_bytes = payload_size_bytes;
@@ -53,7 +168,7 @@ NetworkBenchmark::Results NetworkBenchmark::run(
     int socket_fd = connect_to_host(host, port, connection_time_ms);
     
     if (socket_fd < 0) {
-        results.error_message = "Failed to establish connection";
+        results.error_message = connection_error();
         results.timing.connection_successful = false;
         return results;
     }
@@ -74,6 +189,8 @@ NetworkBenchmark::Results NetworkBenchmark::run(
     }
 
     // Measure round-trip time
+    TcpInfoSampler tcp_info_sampler(tcp_info_interval_ms_);
+    tcp_info_sampler.start();
     Timer round_trip_timer;
     round_trip_timer.start();
 
@@ -98,6 +215,7 @@ NetworkBenchmark::Results NetworkBenchmark::run(
     
     double round_trip_time_ms = round_trip_timer.elapsed_milliseconds();
     
+    record_tcp_info(tcp_info_sampler, socket_fd, results);
     results.timing.receive_time_ms = receive_time_ms;
     results.timing.round_trip_time_ms = round_trip_time_ms;
     
@@ -130,6 +248,9 @@ NetworkBenchmark::Results NetworkBenchmark::run_call_loop(
     std::size_t payload_size_bytes
 ) {
     Results results{};
+    results.mode = "call-loop";
+    results.congestion_control = socket_options_.congestion_control;
+    results.fast_open = socket_options_.fast_open;
     results.target_host = host;
     results.target_port = port;
     results.payload_size_bytes = payload_size_bytes;
@@ -188,7 +309,8 @@ NetworkBenchmark::Results NetworkBenchmark::run_call_loop(
         std::cout << "Completed " << successful_connections << "/" << iterations 
                   << " connection cycles successfully.\n";
     } else {
-        results.error_message = "All connection attempts failed";
+        results.error_message = (rejected_option_ == RejectedOption::None) ? "All connection attempts failed"
+                                                                           : connection_error();
         std::cout << "All connection attempts failed.\n";
     }
 #else
@@ -199,6 +321,634 @@ NetworkBenchmark::Results NetworkBenchmark::run_call_loop(
     return results;
 }
 
+NetworkBenchmark::Results NetworkBenchmark::make_results(
+    const char* mode,
+    const std::string& host,
+    std::uint16_t port,
+    std::size_t iterations,
+    std::size_t payload_size_bytes
+) const {
+    Results results{};
+    results.mode = mode;
+    if (std::strcmp(mode, "udp") != 0) {
+        results.congestion_control = socket_options_.congestion_control;
+        results.fast_open = socket_options_.fast_open;
+    }
+    results.target_host = host;
+    results.target_port = port;
+    results.payload_size_bytes = payload_size_bytes;
+    results.iterations = iterations;
+    results.benchmark_successful = false;
+    results.timing.connection_successful = false;
+    results.timing.data_exchange_successful = false;
+    return results;
+}
+
+NetworkBenchmark::Results NetworkBenchmark::run_handshake(
+    const std::string& host,
+    std::uint16_t port,
+    std::size_t iterations,
+    std::size_t payload_size_bytes
+) {
+    Results results = make_results("handshake", host, port, iterations, payload_size_bytes);
+
+    // Validate inputs
+    if (iterations == 0 || payload_size_bytes == 0) {
+        results.error_message = "Iterations and payload size must be greater than 0";
+        return results;
+    }
+
+#ifdef __linux__
+    std::vector<std::uint8_t> send_buffer(payload_size_bytes);
+    std::vector<std::uint8_t> recv_buffer(payload_size_bytes);
+    for (std::size_t i = 0; i < payload_size_bytes; ++i) {
+        send_buffer[i] = static_cast<std::uint8_t>(i & 0xFF);
+    }
+
+    results.round_trip_samples_ms.reserve(iterations);
+    double total_connection_time = 0.0;
+    double min_connection_time = std::numeric_limits<double>::max();
+    double max_connection_time = 0.0;
+    Timer total_timer;
+    total_timer.start();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Timer cycle_timer;
+        cycle_timer.start();
+
+        // With Fast Open, connect() returns at once and the SYN is sent
+        // together with the first write below
+        double connection_time_ms = 0.0;
+        int socket_fd = connect_to_host(host, port, connection_time_ms);
+        if (socket_fd < 0) {
+            results.error_message = connection_error();
+            if (rejected_option_ != RejectedOption::None) {
+                break;  // Option rejected; every attempt would fail the same way
+            }
+            continue;
+        }
+
+        int flag = 1;
+        setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+        double send_time_ms = 0.0;
+        double receive_time_ms = 0.0;
+        ssize_t bytes_sent = send_data(socket_fd, send_buffer.data(),
+                                       payload_size_bytes, send_time_ms);
+        ssize_t bytes_received = -1;
+        if (bytes_sent == static_cast<ssize_t>(payload_size_bytes)) {
+            bytes_received = receive_data(socket_fd, recv_buffer.data(),
+                                          payload_size_bytes, receive_time_ms);
+        }
+        double cycle_time_ms = cycle_timer.elapsed_milliseconds();
+
+        TcpInfoSampler::Sample tcp_info{};
+        if (TcpInfoSampler::read(socket_fd, tcp_info) && tcp_info.syn_data_acked) {
+            results.fast_open_accepted++;
+        }
+        close_socket(socket_fd);
+
+        if (bytes_received != static_cast<ssize_t>(payload_size_bytes)) {
+            results.error_message = "Echo exchange failed (is the target an echo server?)";
+            continue;
+        }
+        results.round_trip_samples_ms.push_back(cycle_time_ms);
+        total_connection_time += connection_time_ms;
+        min_connection_time = std::min(min_connection_time, connection_time_ms);
+        max_connection_time = std::max(max_connection_time, connection_time_ms);
+    }
+
+    double elapsed_seconds = total_timer.elapsed_seconds();
+    std::size_t completed = results.round_trip_samples_ms.size();
+    results.bytes_transferred = static_cast<std::uint64_t>(completed) * payload_size_bytes * 2;
+    if (completed > 0) {
+        results.timing.connection_successful = true;
+        results.timing.data_exchange_successful = true;
+        results.timing.avg_connection_time_ms = total_connection_time / static_cast<double>(completed);
+        results.timing.min_connection_time_ms = min_connection_time;
+        results.timing.max_connection_time_ms = max_connection_time;
+        results.timing.connection_time_ms = results.timing.avg_connection_time_ms;
+        summarize_round_trips(results.round_trip_samples_ms, results.timing);
+        if (elapsed_seconds > 0.0) {
+            results.timing.throughput_mbps = (static_cast<double>(results.bytes_transferred)
+                                              / elapsed_seconds) / (1024.0 * 1024.0);
+        }
+        results.benchmark_successful = (completed == iterations);
+        if (completed == iterations) {
+            results.error_message.clear();
+        }
+    }
+#else
+    results.error_message = "Network benchmarking not supported on this platform";
+#endif
+
+    return results;
+}
+
+NetworkBenchmark::Results NetworkBenchmark::run_rtt(
+    const std::string& host,
+    std::uint16_t port,
+    std::size_t iterations,
+    std::size_t payload_size_bytes
+) {
+    Results results = make_results("rtt", host, port, iterations, payload_size_bytes);
+
+    // Validate inputs
+    if (iterations == 0 || payload_size_bytes == 0) {
+        results.error_message = "Iterations and payload size must be greater than 0";
+        return results;
+    }
+
+#ifdef __linux__
+    double connection_time_ms = 0.0;
+    int socket_fd = connect_to_host(host, port, connection_time_ms);
+    if (socket_fd < 0) {
+        results.error_message = connection_error();
+        return results;
+    }
+    results.timing.connection_successful = true;
+    results.timing.connection_time_ms = connection_time_ms;
+
+    // Small request/response exchanges must not wait for Nagle coalescing
+    int flag = 1;
+    setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+    std::vector<std::uint8_t> send_buffer(payload_size_bytes);
+    std::vector<std::uint8_t> recv_buffer(payload_size_bytes);
+    for (std::size_t i = 0; i < payload_size_bytes; ++i) {
+        send_buffer[i] = static_cast<std::uint8_t>(i & 0xFF);
+    }
+
+    results.round_trip_samples_ms.reserve(iterations);
+    TcpInfoSampler tcp_info_sampler(tcp_info_interval_ms_);
+    tcp_info_sampler.start();
+    Timer total_timer;
+    total_timer.start();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Timer round_trip_timer;
+        round_trip_timer.start();
+        if (!exchange_payload(socket_fd, send_buffer.data(), recv_buffer.data(),
+                              payload_size_bytes)) {
+            results.error_message = "Echo exchange failed (is the target an echo server?)";
+            break;
+        }
+        results.round_trip_samples_ms.push_back(round_trip_timer.elapsed_milliseconds());
+        tcp_info_sampler.poll(socket_fd);
+    }
+
+    double elapsed_seconds = total_timer.elapsed_seconds();
+    record_tcp_info(tcp_info_sampler, socket_fd, results);
+    close_socket(socket_fd);
+
+    std::size_t completed = results.round_trip_samples_ms.size();
+    results.bytes_transferred = static_cast<std::uint64_t>(completed) * payload_size_bytes * 2;
+    if (completed > 0) {
+        summarize_round_trips(results.round_trip_samples_ms, results.timing);
+        if (elapsed_seconds > 0.0) {
+            results.timing.throughput_mbps = (static_cast<double>(results.bytes_transferred)
+                                              / elapsed_seconds) / (1024.0 * 1024.0);
+        }
+        results.timing.data_exchange_successful = true;
+        results.benchmark_successful = (completed == iterations);
+    }
+#else
+    results.error_message = "Network benchmarking not supported on this platform";
+#endif
+
+    return results;
+}
+
+NetworkBenchmark::Results NetworkBenchmark::run_bulk(
+    const std::string& host,
+    std::uint16_t port,
+    double duration_seconds,
+    std::size_t payload_size_bytes
+) {
+    return bulk_transfer(host, port, duration_seconds, payload_size_bytes, nullptr);
+}
+
+NetworkBenchmark::Results NetworkBenchmark::bulk_transfer(
+    const std::string& host,
+    std::uint16_t port,
+    double duration_seconds,
+    std::size_t payload_size_bytes,
+    const std::atomic<bool>* stop_requested
+) {
+    Results results = make_results("bulk", host, port, 0, payload_size_bytes);
+
+    // Validate inputs
+    if (duration_seconds <= 0.0 || payload_size_bytes == 0) {
+        results.error_message = "Duration and payload size must be greater than 0";
+        return results;
+    }
+
+#ifdef __linux__
+    double connection_time_ms = 0.0;
+    int socket_fd = connect_to_host(host, port, connection_time_ms);
+    if (socket_fd < 0) {
+        results.error_message = connection_error();
+        return results;
+    }
+    results.timing.connection_successful = true;
+    results.timing.connection_time_ms = connection_time_ms;
+
+    std::vector<std::uint8_t> send_buffer(payload_size_bytes, 0xAA);
+    std::uint64_t bytes_sent_total = 0;
+    std::size_t send_calls = 0;
+    bool send_failed = false;
+
+    TcpInfoSampler tcp_info_sampler(tcp_info_interval_ms_);
+    tcp_info_sampler.start();
+    Timer total_timer;
+    total_timer.start();
+
+    while (total_timer.elapsed_seconds() < duration_seconds &&
+           (stop_requested == nullptr || !stop_requested->load(std::memory_order_relaxed))) {
+        double send_time_ms = 0.0;
+        ssize_t bytes_sent = send_data(socket_fd, send_buffer.data(),
+                                       payload_size_bytes, send_time_ms);
+        if (bytes_sent < 0) {
+            send_failed = true;
+            break;
+        }
+        bytes_sent_total += static_cast<std::uint64_t>(bytes_sent);
+        send_calls++;
+        tcp_info_sampler.poll(socket_fd);
+    }
+
+    // Half-close and wait for the sink to acknowledge everything it received
+    shutdown(socket_fd, SHUT_WR);
+    std::uint8_t ack[8] = {};
+    double receive_time_ms = 0.0;
+    ssize_t ack_bytes = receive_data(socket_fd, ack, sizeof(ack), receive_time_ms);
+    double elapsed_seconds = total_timer.elapsed_seconds();
+    record_tcp_info(tcp_info_sampler, socket_fd, results);
+    close_socket(socket_fd);
+
+    std::uint64_t acknowledged = 0;
+    for (std::size_t i = 0; i < sizeof(ack); ++i) {
+        acknowledged = (acknowledged << 8) | ack[i];
+    }
+
+    results.iterations = send_calls;
+    results.bytes_transferred = bytes_sent_total;
+    results.timing.send_time_ms = elapsed_seconds * 1000.0;
+
+    if (send_failed) {
+        results.error_message = "Connection failed during bulk send";
+    } else if (ack_bytes != static_cast<ssize_t>(sizeof(ack)) || acknowledged != bytes_sent_total) {
+        results.error_message = "Sink did not acknowledge all bytes (is the target a sink server?)";
+    } else {
+        results.timing.data_exchange_successful = true;
+        results.timing.throughput_mbps = (static_cast<double>(bytes_sent_total)
+                                          / elapsed_seconds) / (1024.0 * 1024.0);
+        results.benchmark_successful = true;
+    }
+#else
+    results.error_message = "Network benchmarking not supported on this platform";
+#endif
+
+    return results;
+}
+
+NetworkBenchmark::Results NetworkBenchmark::run_udp(
+    const std::string& host,
+    std::uint16_t port,
+    std::size_t iterations,
+    std::size_t payload_size_bytes
+) {
+    Results results = make_results("udp", host, port, iterations, payload_size_bytes);
+
+    // Validate inputs
+    if (iterations == 0 || payload_size_bytes == 0) {
+        results.error_message = "Iterations and payload size must be greater than 0";
+        return results;
+    }
+    if (payload_size_bytes > MAX_UDP_PAYLOAD) {
+        results.error_message = "Payload exceeds maximum UDP datagram size";
+        return results;
+    }
+
+#ifdef __linux__
+    int socket_fd = connect_udp(host, port);
+    if (socket_fd < 0) {
+        results.error_message = "Failed to create UDP socket";
+        return results;
+    }
+    results.timing.connection_successful = true;
+
+    std::vector<std::uint8_t> send_buffer(payload_size_bytes, 0x55);
+    std::vector<std::uint8_t> recv_buffer(MAX_UDP_PAYLOAD);
+    results.round_trip_samples_ms.reserve(iterations);
+
+    Timer total_timer;
+    total_timer.start();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        // Tag datagrams with a sequence number so late replies are not
+        // mistaken for the current one
+        std::uint32_t sequence = static_cast<std::uint32_t>(i);
+        if (payload_size_bytes >= sizeof(sequence)) {
+            std::memcpy(send_buffer.data(), &sequence, sizeof(sequence));
+        }
+
+        Timer round_trip_timer;
+        round_trip_timer.start();
+        if (send(socket_fd, send_buffer.data(), payload_size_bytes, 0) < 0) {
+            results.packets_lost++;
+            continue;
+        }
+
+        bool matched = false;
+        while (!matched) {
+            int remaining_ms = UDP_REPLY_TIMEOUT_MS
+                               - static_cast<int>(round_trip_timer.elapsed_milliseconds());
+            if (remaining_ms <= 0) {
+                break;
+            }
+            struct pollfd poll_fd{};
+            poll_fd.fd = socket_fd;
+            poll_fd.events = POLLIN;
+            if (poll(&poll_fd, 1, remaining_ms) <= 0) {
+                break;
+            }
+            ssize_t bytes_received = recv(socket_fd, recv_buffer.data(), recv_buffer.size(), 0);
+            if (bytes_received != static_cast<ssize_t>(payload_size_bytes)) {
+                continue;
+            }
+            matched = (payload_size_bytes < sizeof(sequence)) ||
+                      std::memcmp(recv_buffer.data(), &sequence, sizeof(sequence)) == 0;
+        }
+
+        if (matched) {
+            results.round_trip_samples_ms.push_back(round_trip_timer.elapsed_milliseconds());
+        } else {
+            results.packets_lost++;
+        }
+    }
+
+    double elapsed_seconds = total_timer.elapsed_seconds();
+    close_socket(socket_fd);
+
+    std::size_t completed = results.round_trip_samples_ms.size();
+    results.bytes_transferred = static_cast<std::uint64_t>(completed) * payload_size_bytes * 2;
+    if (completed > 0) {
+        summarize_round_trips(results.round_trip_samples_ms, results.timing);
+        if (elapsed_seconds > 0.0) {
+            results.timing.throughput_mbps = (static_cast<double>(results.bytes_transferred)
+                                              / elapsed_seconds) / (1024.0 * 1024.0);
+        }
+        results.timing.data_exchange_successful = true;
+        results.benchmark_successful = true;
+        if (results.packets_lost > 0) {
+            results.error_message = std::to_string(results.packets_lost) + " datagram(s) lost";
+        }
+    } else {
+        results.error_message = "No UDP replies received (is the target a UDP echo server?)";
+    }
+#else
+    results.error_message = "Network benchmarking not supported on this platform";
+#endif
+
+    return results;
+}
+
+std::vector<NetworkBenchmark::Results> NetworkBenchmark::run_payload_sweep(
+    const std::string& host,
+    const SweepConfig& config
+) {
+    std::vector<Results> sweep_results;
+
+    for (std::size_t payload_size : config.payload_sizes) {
+        if (config.rtt_port != 0) {
+            // Bound bytes moved per point so multi-MB payloads stay fast
+            std::uint64_t budget_iterations = config.max_bytes_per_point / (2 * payload_size);
+            std::size_t iterations = static_cast<std::size_t>(std::max<std::uint64_t>(
+                MIN_SWEEP_ITERATIONS,
+                std::min<std::uint64_t>(config.rtt_iterations, budget_iterations)));
+            std::cout << "  rtt  " << std::setw(10) << payload_size << " B x " << iterations << "\n";
+            sweep_results.push_back(run_rtt(host, config.rtt_port, iterations, payload_size));
+        }
+    }
+
+    for (std::size_t payload_size : config.payload_sizes) {
+        if (config.bulk_port != 0) {
+            std::cout << "  bulk " << std::setw(10) << payload_size << " B for "
+                      << config.bulk_duration_seconds << " s\n";
+            sweep_results.push_back(run_bulk(host, config.bulk_port,
+                                             config.bulk_duration_seconds, payload_size));
+        }
+    }
+
+    for (std::size_t payload_size : config.payload_sizes) {
+        if (config.udp_port != 0 && payload_size <= MAX_UDP_PAYLOAD) {
+            std::cout << "  udp  " << std::setw(10) << payload_size << " B x "
+                      << config.udp_iterations << "\n";
+            sweep_results.push_back(run_udp(host, config.udp_port,
+                                            config.udp_iterations, payload_size));
+        }
+    }
+
+    return sweep_results;
+}
+
+NetworkBenchmark::PathLimits NetworkBenchmark::probe_path_limits(const std::string& host, std::uint16_t port) {
+    PathLimits limits{};
+#ifdef __linux__
+    double connection_time_ms = 0.0;
+    int socket_fd = connect_to_host(host, port, connection_time_ms);
+    if (socket_fd < 0) {
+        return limits;
+    }
+    int value = 0;
+    socklen_t length = sizeof(value);
+    if (getsockopt(socket_fd, IPPROTO_IP, IP_MTU, &value, &length) == 0 && value > 0) {
+        limits.mtu_bytes = static_cast<std::size_t>(value);
+    }
+    length = sizeof(value);
+    if (getsockopt(socket_fd, SOL_SOCKET, SO_SNDBUF, &value, &length) == 0 && value > 0) {
+        limits.send_buffer_bytes = static_cast<std::size_t>(value);
+    }
+    length = sizeof(value);
+    if (getsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &value, &length) == 0 && value > 0) {
+        limits.receive_buffer_bytes = static_cast<std::size_t>(value);
+    }
+    close_socket(socket_fd);
+#else
+    (void)host;
+    (void)port;
+#endif
+    return limits;
+}
+
+std::vector<NetworkBenchmark::TransportResults> NetworkBenchmark::run_transport_comparison(
+    const std::string& host,
+    const TransportCompareConfig& config
+) {
+    std::vector<TransportResults> comparison;
+    SocketOptions saved_options = socket_options_;
+
+    std::vector<std::string> algorithms = config.congestion_controls;
+    if (algorithms.empty()) {
+        algorithms.push_back("");
+    }
+
+    for (const std::string& algorithm : algorithms) {
+        SocketOptions options;
+        options.congestion_control = algorithm;
+        set_socket_options(options);
+
+        TransportResults row{};
+        row.congestion_control = algorithm.empty() ? "default" : algorithm;
+        row.fast_open = false;
+        std::cout << "  " << std::left << std::setw(10) << row.congestion_control
+                  << "handshake x " << config.handshake_iterations
+                  << ", rtt x " << config.rtt_iterations
+                  << ", bulk " << config.bulk_duration_seconds << " s\n";
+        row.handshake = run_handshake(host, config.echo_port, config.handshake_iterations,
+                                      config.payload_size_bytes);
+        row.rtt = run_rtt(host, config.echo_port, config.rtt_iterations,
+                          config.payload_size_bytes);
+        row.bulk = run_bulk(host, config.sink_port, config.bulk_duration_seconds,
+                            config.bulk_write_size_bytes);
+        comparison.push_back(row);
+
+        // Fast Open only changes the handshake; the algorithm sets the
+        // initial window the SYN data and first echo are sent with
+        options.fast_open = true;
+        set_socket_options(options);
+
+        TransportResults fast_open_row{};
+        fast_open_row.congestion_control = row.congestion_control;
+        fast_open_row.fast_open = true;
+        std::cout << "  " << std::left << std::setw(10) << fast_open_row.congestion_control
+                  << "handshake x " << config.handshake_iterations << " with Fast Open\n";
+        fast_open_row.handshake = run_handshake(host, config.echo_port, config.handshake_iterations,
+                                                config.payload_size_bytes);
+        comparison.push_back(fast_open_row);
+    }
+
+    set_socket_options(saved_options);
+    return comparison;
+}
+
+NetworkBenchmark::LoadedLatencyResults NetworkBenchmark::run_latency_under_load(
+    const std::string& host,
+    const LoadedLatencyConfig& config
+) {
+    LoadedLatencyResults results{};
+    results.benchmark_successful = false;
+
+    // Validate inputs
+    if (config.load_flows == 0 || config.rtt_iterations == 0 || config.probe_size_bytes == 0) {
+        results.error_message = "Load flows, iterations and probe size must be greater than 0";
+        return results;
+    }
+
+    std::cout << "  idle   rtt x " << config.rtt_iterations << "\n";
+    TraceRecorder::begin("idle_rtt", "network");
+    results.idle = run_rtt(host, config.echo_port, config.rtt_iterations, config.probe_size_bytes);
+    TraceRecorder::end("idle_rtt", "network");
+    if (!results.idle.benchmark_successful) {
+        results.error_message = "Idle RTT probe failed: " + results.idle.error_message;
+        return results;
+    }
+
+    std::cout << "  loaded rtt x " << config.rtt_iterations << " with "
+              << config.load_flows << " bulk flow(s)\n";
+    std::atomic<bool> stop_requested(false);
+    results.load_flows.resize(config.load_flows);
+    std::vector<std::thread> flows;
+    flows.reserve(config.load_flows);
+
+    for (std::size_t i = 0; i < config.load_flows; ++i) {
+        flows.emplace_back([this, &host, &config, &results, &stop_requested, i]() {
+            TraceRecorder::set_thread_name("network.load_flow");
+            ProcessPriority::place_worker_thread();
+            TraceScope flow_scope("bulk_flow", "network");
+            // Separate instance per flow: connection errors are tracked per instance
+            NetworkBenchmark flow;
+            flow.set_tcp_info_interval_ms(tcp_info_interval_ms_);
+            flow.set_socket_options(socket_options_);
+            results.load_flows[i] = flow.bulk_transfer(host, config.sink_port,
+                                                       config.max_load_seconds,
+                                                       config.bulk_write_size_bytes,
+                                                       &stop_requested);
+        });
+    }
+
+    TraceRecorder::begin("ramp", "network");
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.ramp_seconds));
+    TraceRecorder::end("ramp", "network");
+    TraceRecorder::begin("loaded_rtt", "network");
+    results.loaded = run_rtt(host, config.echo_port, config.rtt_iterations, config.probe_size_bytes);
+    TraceRecorder::end("loaded_rtt", "network");
+    stop_requested = true;
+
+    for (std::thread& flow : flows) {
+        flow.join();
+    }
+
+    std::size_t failed_flows = 0;
+    results.aggregate_throughput_mbps = 0.0;
+    for (const Results& flow : results.load_flows) {
+        if (flow.benchmark_successful) {
+            results.aggregate_throughput_mbps += flow.timing.throughput_mbps;
+        } else {
+            failed_flows++;
+        }
+    }
+
+    if (!results.loaded.benchmark_successful) {
+        results.error_message = "Loaded RTT probe failed: " + results.loaded.error_message;
+    } else if (failed_flows == config.load_flows) {
+        results.error_message = "All bulk flows failed: " + results.load_flows.front().error_message;
+    } else {
+        if (failed_flows > 0) {
+            results.error_message = std::to_string(failed_flows) + " bulk flow(s) failed";
+        }
+        results.benchmark_successful = true;
+    }
+
+    return results;
+}
+
+std::vector<std::size_t> NetworkBenchmark::power_of_two_sizes(
+    std::size_t min_size_bytes,
+    std::size_t max_size_bytes
+) {
+    std::vector<std::size_t> sizes;
+    if (min_size_bytes == 0) {
+        min_size_bytes = 1;
+    }
+    for (std::size_t size = min_size_bytes; size <= max_size_bytes; size *= 2) {
+        sizes.push_back(size);
+        if (size > max_size_bytes / 2) {
+            break;
+        }
+    }
+    return sizes;
+}
+
+void NetworkBenchmark::summarize_round_trips(
+    const std::vector<double>& samples,
+    TimingStats& timing
+) {
+    if (samples.empty()) {
+        return;
+    }
+    std::vector<double> sorted_samples(samples);
+    std::sort(sorted_samples.begin(), sorted_samples.end());
+
+    timing.round_trip_time_ms = Statistics::mean(sorted_samples);
+    timing.min_round_trip_ms = sorted_samples.front();
+    timing.p50_round_trip_ms = Statistics::percentile_sorted(sorted_samples, 50.0);
+    timing.p99_round_trip_ms = Statistics::percentile_sorted(sorted_samples, 99.0);
+    timing.max_round_trip_ms = sorted_samples.back();
+    timing.round_trip_ci = Statistics::bootstrap_summary_sorted(sorted_samples);
+}
+
 void NetworkBenchmark::print_results(const Results& results) {
     std::cout << "\n";
     std::cout << "========================================\n";
@@ -222,6 +972,14 @@ void NetworkBenchmark::print_results(const Results& results) {
         std::cout << "  " << std::left << std::setw(25) << "Iterations:"
                   << results.iterations << "\n";
     }
+    if (!results.congestion_control.empty()) {
+        std::cout << "  " << std::left << std::setw(25) << "Congestion Control:"
+                  << results.congestion_control << "\n";
+    }
+    if (results.fast_open) {
+        std::cout << "  " << std::left << std::setw(25) << "TCP Fast Open:"
+                  << "requested\n";
+    }
     std::cout << "\n";
 
     std::cout << "Connection Status:\n";
@@ -238,7 +996,7 @@ void NetworkBenchmark::print_results(const Results& results) {
 
     if (results.timing.connection_successful) {
         std::cout << "Timing Statistics:\n";
-        if (results.iterations > 1) {
+        if (results.mode == "call-loop" || results.mode == "handshake") {
             std::cout << "  " << std::left << std::setw(25) << "Avg Connection Time:"
                       << std::fixed << std::setprecision(3) 
                       << results.timing.avg_connection_time_ms << " ms\n";
@@ -254,7 +1012,54 @@ void NetworkBenchmark::print_results(const Results& results) {
                       << results.timing.connection_time_ms << " ms\n";
         }
         
-        if (results.benchmark_successful) {
+        if (results.mode == "handshake") {
+            std::cout << "  " << std::left << std::setw(25) << "Avg Connect-to-Reply:"
+                      << std::fixed << std::setprecision(3)
+                      << results.timing.round_trip_time_ms << " ms\n";
+            std::cout << "  " << std::left << std::setw(25) << "Min / p50 / p99 / Max:"
+                      << std::fixed << std::setprecision(3)
+                      << results.timing.min_round_trip_ms << " / "
+                      << results.timing.p50_round_trip_ms << " / "
+                      << results.timing.p99_round_trip_ms << " / "
+                      << results.timing.max_round_trip_ms << " ms\n";
+            print_round_trip_intervals(results.timing.round_trip_ci);
+            std::cout << "  " << std::left << std::setw(25) << "Completed Handshakes:"
+                      << results.round_trip_samples_ms.size() << "\n";
+            if (results.fast_open) {
+                std::cout << "  " << std::left << std::setw(25) << "Fast Open Accepted:"
+                          << results.fast_open_accepted << "/"
+                          << results.round_trip_samples_ms.size() << "\n";
+            }
+        } else if (results.mode == "rtt" || results.mode == "udp") {
+            std::cout << "  " << std::left << std::setw(25) << "Avg Round-Trip:"
+                      << std::fixed << std::setprecision(3)
+                      << results.timing.round_trip_time_ms << " ms\n";
+            std::cout << "  " << std::left << std::setw(25) << "Min / p50 / p99 / Max:"
+                      << std::fixed << std::setprecision(3)
+                      << results.timing.min_round_trip_ms << " / "
+                      << results.timing.p50_round_trip_ms << " / "
+                      << results.timing.p99_round_trip_ms << " / "
+                      << results.timing.max_round_trip_ms << " ms\n";
+            print_round_trip_intervals(results.timing.round_trip_ci);
+            std::cout << "  " << std::left << std::setw(25) << "Completed Round-Trips:"
+                      << results.round_trip_samples_ms.size() << "\n";
+            if (results.mode == "udp") {
+                std::cout << "  " << std::left << std::setw(25) << "Datagrams Lost:"
+                          << results.packets_lost << "\n";
+            }
+            std::cout << "  " << std::left << std::setw(25) << "Throughput:"
+                      << std::fixed << std::setprecision(2)
+                      << results.timing.throughput_mbps << " MB/s\n";
+        } else if (results.mode == "bulk") {
+            std::cout << "  " << std::left << std::setw(25) << "Bytes Sent:"
+                      << results.bytes_transferred << "\n";
+            std::cout << "  " << std::left << std::setw(25) << "Transfer Time:"
+                      << std::fixed << std::setprecision(3)
+                      << results.timing.send_time_ms << " ms\n";
+            std::cout << "  " << std::left << std::setw(25) << "Throughput:"
+                      << std::fixed << std::setprecision(2)
+                      << results.timing.throughput_mbps << " MB/s\n";
+        } else if (results.benchmark_successful) {
             std::cout << "  " << std::left << std::setw(25) << "Send Time:"
                       << std::fixed << std::setprecision(3) 
                       << results.timing.send_time_ms << " ms\n";
@@ -277,6 +1082,10 @@ void NetworkBenchmark::print_results(const Results& results) {
         std::cout << "\n";
     }
 
+    if (results.tcp_info_available) {
+        TcpInfoSampler::print_summary(results.tcp_info_samples, results.tcp_info_final);
+    }
+
     // Print limitations
     std::cout << "Limitations:\n";
     std::cout << "  - Network timing depends on network conditions\n";
@@ -395,6 +1204,428 @@ void NetworkBenchmark::print_cpu_comparison(
     std::cout << "\n";
 }
 
+void NetworkBenchmark::print_sweep(const std::vector<Results>& sweep_results, const PathLimits& limits) {
+    if (sweep_results.empty()) {
+        return;
+    }
+
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Network Payload Sweep Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+    std::cout << "Target: " << sweep_results.front().target_host << "\n";
+
+    for (const char* mode : {"rtt", "bulk", "udp"}) {
+        bool header_printed = false;
+        bool is_bulk = (std::strcmp(mode, "bulk") == 0);
+        std::size_t previous_payload = 0;
+
+        for (const Results& point : sweep_results) {
+            if (point.mode != mode) {
+                continue;
+            }
+
+            if (!header_printed) {
+                std::cout << "\n";
+                if (is_bulk) {
+                    std::cout << "Bulk TCP Throughput (port " << point.target_port << "):\n";
+                    std::cout << "  " << std::string(66, '-') << "\n";
+                    std::cout << "  " << std::left << std::setw(12) << "Write Size"
+                              << std::right << std::setw(14) << "Writes"
+                              << std::right << std::setw(14) << "Bytes (MB)"
+                              << std::right << std::setw(12) << "MB/s"
+                              << std::right << std::setw(14) << "Writes/s" << "\n";
+                } else {
+                    std::cout << (std::strcmp(mode, "rtt") == 0 ? "Persistent TCP RTT"
+                                                                : "UDP RTT")
+                              << " (port " << point.target_port << ", ms):\n";
+                    std::cout << "  " << std::string(76, '-') << "\n";
+                    std::cout << "  " << std::left << std::setw(12) << "Payload"
+                              << std::right << std::setw(8) << "Iter"
+                              << std::right << std::setw(10) << "Avg"
+                              << std::right << std::setw(10) << "Min"
+                              << std::right << std::setw(10) << "p50"
+                              << std::right << std::setw(10) << "p99"
+                              << std::right << std::setw(10) << "MB/s"
+                              << std::right << std::setw(6) << "Lost" << "\n";
+                }
+                std::cout << "  " << std::string(is_bulk ? 66 : 76, '-') << "\n";
+                header_printed = true;
+            }
+
+            std::string marks = limit_marks(previous_payload, point.payload_size_bytes, limits);
+            previous_payload = point.payload_size_bytes;
+            std::cout << "  " << std::left << std::setw(12) << format_size(point.payload_size_bytes);
+            if (!point.timing.data_exchange_successful) {
+                std::cout << "FAILED: " << point.error_message << marks << "\n";
+                continue;
+            }
+
+            if (is_bulk) {
+                double elapsed_seconds = point.timing.send_time_ms / 1000.0;
+                double writes_per_second = elapsed_seconds > 0.0
+                    ? static_cast<double>(point.iterations) / elapsed_seconds : 0.0;
+                std::cout << std::right << std::setw(14) << point.iterations
+                          << std::fixed << std::setprecision(2)
+                          << std::right << std::setw(14)
+                          << (static_cast<double>(point.bytes_transferred) / (1024.0 * 1024.0))
+                          << std::right << std::setw(12) << point.timing.throughput_mbps
+                          << std::setprecision(0)
+                          << std::right << std::setw(14) << writes_per_second << marks << "\n";
+            } else {
+                std::cout << std::right << std::setw(8) << point.round_trip_samples_ms.size()
+                          << std::fixed << std::setprecision(3)
+                          << std::right << std::setw(10) << point.timing.round_trip_time_ms
+                          << std::right << std::setw(10) << point.timing.min_round_trip_ms
+                          << std::right << std::setw(10) << point.timing.p50_round_trip_ms
+                          << std::right << std::setw(10) << point.timing.p99_round_trip_ms
+                          << std::setprecision(2)
+                          << std::right << std::setw(10) << point.timing.throughput_mbps
+                          << std::right << std::setw(6) << point.packets_lost << marks << "\n";
+            }
+        }
+
+        if (header_printed) {
+            std::cout << "  " << std::string(is_bulk ? 66 : 76, '-') << "\n";
+        }
+    }
+
+    std::cout << "\n";
+    std::cout << "Path Limits (\"<-\" marks the first point at or above each):\n";
+    const std::pair<const char*, std::size_t> named_limits[] = {
+        {"MTU:", limits.mtu_bytes},
+        {"SO_SNDBUF (initial):", limits.send_buffer_bytes},
+        {"SO_RCVBUF (initial):", limits.receive_buffer_bytes},
+    };
+    for (const auto& limit : named_limits) {
+        std::cout << "  " << std::left << std::setw(25) << limit.first;
+        if (limit.second > 0) {
+            std::cout << limit.second << " bytes\n";
+        } else {
+            std::cout << "unknown\n";
+        }
+    }
+    std::cout << "  Note: TCP autotuning can grow the socket buffers during a test\n";
+    std::cout << "        (net.ipv4.tcp_rmem / tcp_wmem).\n";
+    std::cout << "\n";
+}
+
+void NetworkBenchmark::write_path_limits(const PathLimits& limits, ResultWriter& writer, const std::string& name) {
+    writer.begin_object(name);
+    writer.field("mtu_bytes", limits.mtu_bytes);
+    writer.field("send_buffer_bytes", limits.send_buffer_bytes);
+    writer.field("receive_buffer_bytes", limits.receive_buffer_bytes);
+    writer.end_object();
+}
+
+void NetworkBenchmark::print_transport_comparison(
+    const std::vector<TransportResults>& comparison
+) {
+    if (comparison.empty()) {
+        return;
+    }
+
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Transport Comparison Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+    const Results& first = comparison.front().handshake;
+    std::cout << "Target: " << first.target_host << " (echo " << first.target_port
+              << ", sink " << comparison.front().bulk.target_port << ")\n";
+    std::cout << "\n";
+
+    std::cout << "Congestion Control (ms unless noted):\n";
+    std::cout << "  " << std::string(82, '-') << "\n";
+    std::cout << "  " << std::left << std::setw(12) << "Algorithm"
+              << std::right << std::setw(12) << "Handshake"
+              << std::right << std::setw(10) << "RTT p50"
+              << std::right << std::setw(10) << "RTT p99"
+              << std::right << std::setw(12) << "Bulk MB/s"
+              << std::right << std::setw(10) << "Retrans"
+              << std::right << std::setw(8) << "cwnd"
+              << std::right << std::setw(8) << "sRTT" << "\n";
+    std::cout << "  " << std::string(82, '-') << "\n";
+
+    for (const TransportResults& row : comparison) {
+        if (row.fast_open) {
+            continue;
+        }
+        std::cout << "  " << std::left << std::setw(12) << row.congestion_control;
+        const Results* failed = nullptr;
+        for (const Results* part : {&row.handshake, &row.rtt, &row.bulk}) {
+            if (!part->timing.data_exchange_successful) {
+                failed = part;
+                break;
+            }
+        }
+        if (failed != nullptr) {
+            std::cout << "FAILED (" << failed->mode << "): " << failed->error_message << "\n";
+            continue;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::right << std::setw(12) << row.handshake.timing.p50_round_trip_ms
+                  << std::right << std::setw(10) << row.rtt.timing.p50_round_trip_ms
+                  << std::right << std::setw(10) << row.rtt.timing.p99_round_trip_ms
+                  << std::setprecision(2)
+                  << std::right << std::setw(12) << row.bulk.timing.throughput_mbps;
+        if (row.bulk.tcp_info_available) {
+            std::cout << std::right << std::setw(10) << row.bulk.tcp_info_final.total_retrans
+                      << std::right << std::setw(8) << row.bulk.tcp_info_final.snd_cwnd
+                      << std::setprecision(3)
+                      << std::right << std::setw(8) << row.bulk.tcp_info_final.rtt_ms << "\n";
+        } else {
+            std::cout << std::right << std::setw(10) << "-"
+                      << std::right << std::setw(8) << "-"
+                      << std::right << std::setw(8) << "-" << "\n";
+        }
+    }
+    std::cout << "  " << std::string(82, '-') << "\n";
+    std::cout << "  Handshake = connect + first " << first.payload_size_bytes
+              << " B echo on a new connection (p50)\n";
+    std::cout << "\n";
+
+    // Fast Open savings against the same algorithm without Fast Open
+    for (const TransportResults& row : comparison) {
+        if (!row.fast_open) {
+            continue;
+        }
+        const Results* baseline = nullptr;
+        for (const TransportResults& candidate : comparison) {
+            if (!candidate.fast_open && candidate.congestion_control == row.congestion_control) {
+                baseline = &candidate.handshake;
+                break;
+            }
+        }
+
+        std::cout << "TCP Fast Open (" << row.congestion_control << "):\n";
+        if (!row.handshake.timing.data_exchange_successful || baseline == nullptr ||
+            !baseline->timing.data_exchange_successful) {
+            std::cout << "  " << std::left << std::setw(25) << "Error:"
+                      << (row.handshake.error_message.empty() ? "Baseline handshake failed"
+                                                              : row.handshake.error_message)
+                      << "\n\n";
+            continue;
+        }
+
+        double saved_ms = baseline->timing.p50_round_trip_ms - row.handshake.timing.p50_round_trip_ms;
+        std::cout << "  " << std::left << std::setw(25) << "Handshake p50 (off):"
+                  << std::fixed << std::setprecision(3)
+                  << baseline->timing.p50_round_trip_ms << " ms\n";
+        std::cout << "  " << std::left << std::setw(25) << "Handshake p50 (on):"
+                  << std::fixed << std::setprecision(3)
+                  << row.handshake.timing.p50_round_trip_ms << " ms\n";
+        std::cout << "  " << std::left << std::setw(25) << "Savings:"
+                  << std::fixed << std::setprecision(3) << saved_ms << " ms";
+        if (baseline->timing.p50_round_trip_ms > 0.0) {
+            std::cout << " (" << std::setprecision(1)
+                      << (100.0 * saved_ms / baseline->timing.p50_round_trip_ms) << "%)";
+        }
+        std::cout << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "SYN Data Accepted:"
+                  << row.handshake.fast_open_accepted << "/"
+                  << row.handshake.round_trip_samples_ms.size() << "\n";
+
+        if (row.handshake.fast_open_accepted == 0) {
+            int sysctl_value = read_fast_open_sysctl();
+            std::cout << "  Note: The server never accepted data in the SYN, so no round trip\n";
+            std::cout << "        was saved. Server-side Fast Open needs net.ipv4.tcp_fastopen\n";
+            std::cout << "        bit 1 (value 2, server) set on the server host";
+            if (sysctl_value >= 0) {
+                std::cout << " (local value: " << sysctl_value << ")";
+            }
+            std::cout << ".\n";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Note: The congestion controller acts on the client's first hop. The\n";
+    std::cout << "      impairment proxy terminates TCP, so compare algorithms over a real\n";
+    std::cout << "      path (or a netem-shaped link) rather than through --proxy-* options.\n";
+    std::cout << "\n";
+}
+
+void NetworkBenchmark::print_latency_under_load(const LoadedLatencyResults& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Latency Under Load Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    const Results& idle = results.idle;
+    const Results& loaded = results.loaded;
+
+    std::cout << "Configuration:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Target Host:"
+              << idle.target_host << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Probe Port:"
+              << idle.target_port << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Probe Size:"
+              << idle.payload_size_bytes << " bytes\n";
+    std::cout << "  " << std::left << std::setw(25) << "Probe Iterations:"
+              << idle.iterations << "\n";
+    std::cout << "  " << std::left << std::setw(25) << "Load Flows:"
+              << results.load_flows.size() << "\n";
+    if (!results.error_message.empty()) {
+        std::cout << "  " << std::left << std::setw(25) << "Error:"
+                  << results.error_message << "\n";
+    }
+    std::cout << "\n";
+
+    if (!idle.timing.data_exchange_successful || !loaded.timing.data_exchange_successful) {
+        return;
+    }
+
+    std::cout << "Round-Trip Time (ms):\n";
+    std::cout << "  " << std::string(62, '-') << "\n";
+    std::cout << "  " << std::left << std::setw(10) << "Metric"
+              << std::right << std::setw(12) << "Idle"
+              << std::right << std::setw(12) << "Loaded"
+              << std::right << std::setw(14) << "Inflation"
+              << std::right << std::setw(14) << "Ratio" << "\n";
+    std::cout << "  " << std::string(62, '-') << "\n";
+
+    struct Row {
+        const char* label;
+        double idle_ms;
+        double loaded_ms;
+    };
+    const Row rows[] = {
+        {"Min", idle.timing.min_round_trip_ms, loaded.timing.min_round_trip_ms},
+        {"Avg", idle.timing.round_trip_time_ms, loaded.timing.round_trip_time_ms},
+        {"p50", idle.timing.p50_round_trip_ms, loaded.timing.p50_round_trip_ms},
+        {"p99", idle.timing.p99_round_trip_ms, loaded.timing.p99_round_trip_ms},
+        {"Max", idle.timing.max_round_trip_ms, loaded.timing.max_round_trip_ms},
+    };
+    for (const Row& row : rows) {
+        std::cout << "  " << std::left << std::setw(10) << row.label
+                  << std::fixed << std::setprecision(3)
+                  << std::right << std::setw(12) << row.idle_ms
+                  << std::right << std::setw(12) << row.loaded_ms
+                  << std::right << std::setw(14) << (row.loaded_ms - row.idle_ms);
+        if (row.idle_ms > 0.0) {
+            std::cout << std::setprecision(2)
+                      << std::right << std::setw(13) << (row.loaded_ms / row.idle_ms) << "x\n";
+        } else {
+            std::cout << std::right << std::setw(14) << "-" << "\n";
+        }
+    }
+    std::cout << "  " << std::string(62, '-') << "\n";
+    std::cout << "\n";
+
+    std::cout << "Load:\n";
+    std::cout << "  " << std::left << std::setw(25) << "Aggregate Throughput:"
+              << std::fixed << std::setprecision(2)
+              << results.aggregate_throughput_mbps << " MB/s\n";
+    for (std::size_t i = 0; i < results.load_flows.size(); ++i) {
+        const Results& flow = results.load_flows[i];
+        std::string label = "Flow " + std::to_string(i + 1) + ":";
+        std::cout << "  " << std::left << std::setw(25) << label;
+        if (!flow.benchmark_successful) {
+            std::cout << "FAILED: " << flow.error_message << "\n";
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(2) << flow.timing.throughput_mbps << " MB/s";
+        if (flow.tcp_info_available) {
+            std::cout << " (sRTT " << std::setprecision(3) << flow.tcp_info_final.rtt_ms
+                      << " ms, cwnd " << flow.tcp_info_final.snd_cwnd
+                      << ", retrans " << flow.tcp_info_final.total_retrans << ")";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "Note: Inflation is queueing delay added by the bulk flows. Large p99\n";
+    std::cout << "      growth points at oversized buffers (bufferbloat); AQM such as\n";
+    std::cout << "      fq_codel or a delay-based congestion controller reduces it.\n";
+    std::cout << "\n";
+}
+
+void NetworkBenchmark::write_results(const Results& results, ResultWriter& writer,
+                                     const std::string& name) {
+    writer.begin_object(name);
+    writer.field("mode", results.mode);
+    writer.field("target_host", results.target_host);
+    writer.field("target_port", results.target_port);
+    writer.field("payload_size_bytes", results.payload_size_bytes);
+    writer.field("iterations", results.iterations);
+
+    writer.begin_object("timing");
+    writer.field("connection_time_ms", results.timing.connection_time_ms);
+    writer.field("send_time_ms", results.timing.send_time_ms);
+    writer.field("receive_time_ms", results.timing.receive_time_ms);
+    writer.field("round_trip_time_ms", results.timing.round_trip_time_ms);
+    writer.field("avg_connection_time_ms", results.timing.avg_connection_time_ms);
+    writer.field("min_connection_time_ms", results.timing.min_connection_time_ms);
+    writer.field("max_connection_time_ms", results.timing.max_connection_time_ms);
+    writer.field("min_round_trip_ms", results.timing.min_round_trip_ms);
+    writer.field("p50_round_trip_ms", results.timing.p50_round_trip_ms);
+    writer.field("p99_round_trip_ms", results.timing.p99_round_trip_ms);
+    writer.field("max_round_trip_ms", results.timing.max_round_trip_ms);
+    writer.field("throughput_mbps", results.timing.throughput_mbps);
+    writer.field("connection_successful", results.timing.connection_successful);
+    writer.field("data_exchange_successful", results.timing.data_exchange_successful);
+    writer.end_object();
+
+    writer.field("bytes_transferred", results.bytes_transferred);
+    writer.field("packets_lost", results.packets_lost);
+    writer.samples("round_trip_samples_ms", results.round_trip_samples_ms);
+    writer.histogram("round_trip_histogram_ms", results.round_trip_samples_ms);
+    writer.confidence_intervals("round_trip_ci_ms", results.timing.round_trip_ci);
+    writer.field("congestion_control", results.congestion_control);
+    writer.field("fast_open", results.fast_open);
+    writer.field("fast_open_accepted", results.fast_open_accepted);
+    writer.field("tcp_info_available", results.tcp_info_available);
+    writer.begin_array("tcp_info_samples");
+    for (const TcpInfoSampler::Sample& sample : results.tcp_info_samples) {
+        TcpInfoSampler::write_sample(sample, writer);
+    }
+    writer.end_array();
+    TcpInfoSampler::write_sample(results.tcp_info_final, writer, "tcp_info_final");
+    writer.field("error_message", results.error_message);
+    writer.field("benchmark_successful", results.benchmark_successful);
+    writer.end_object();
+}
+
+void NetworkBenchmark::write_transport_comparison(
+    const std::vector<TransportResults>& comparison,
+    ResultWriter& writer,
+    const std::string& name
+) {
+    writer.begin_array(name);
+    for (const TransportResults& row : comparison) {
+        writer.begin_object();
+        writer.field("congestion_control", row.congestion_control);
+        writer.field("fast_open", row.fast_open);
+        write_results(row.handshake, writer, "handshake");
+        if (!row.fast_open) {
+            write_results(row.rtt, writer, "rtt");
+            write_results(row.bulk, writer, "bulk");
+        }
+        writer.end_object();
+    }
+    writer.end_array();
+}
+
+void NetworkBenchmark::write_latency_under_load(const LoadedLatencyResults& results,
+                                                ResultWriter& writer,
+                                                const std::string& name) {
+    writer.begin_object(name);
+    write_results(results.idle, writer, "idle");
+    write_results(results.loaded, writer, "loaded");
+    writer.begin_array("load_flows");
+    for (const Results& flow : results.load_flows) {
+        write_results(flow, writer);
+    }
+    writer.end_array();
+    writer.field("aggregate_throughput_mbps", results.aggregate_throughput_mbps);
+    writer.field("error_message", results.error_message);
+    writer.field("benchmark_successful", results.benchmark_successful);
+    writer.end_object();
+}
+
 int NetworkBenchmark::connect_to_host(
     const std::string& host,
     std::uint16_t port,
@@ -410,6 +1641,7 @@ int NetworkBenchmark::connect_to_host(
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_protocol = IPPROTO_TCP;
 
+    rejected_option_ = RejectedOption::None;
     int status = getaddrinfo(host.c_str(), nullptr, &hints, &result);
     if (status != 0) {
         return -1;
@@ -422,6 +1654,13 @@ int NetworkBenchmark::connect_to_host(
         return -1;
     }
 
+    // Transport options must be in place before the SYN is sent
+    if (!apply_socket_options(socket_fd)) {
+        freeaddrinfo(result);
+        close_socket(socket_fd);
+        return -1;
+    }
+
     // Set socket timeout for connection
     struct timeval timeout{};
     timeout.tv_sec = 5;  // 5 second timeout
@@ -472,6 +1711,52 @@ int NetworkBenchmark::connect_to_host(
 #endif
 }
 
+bool NetworkBenchmark::apply_socket_options(int socket_fd) noexcept {
+#ifdef __linux__
+    const std::string& algorithm = socket_options_.congestion_control;
+    if (!algorithm.empty() &&
+        setsockopt(socket_fd, IPPROTO_TCP, TCP_CONGESTION, algorithm.c_str(),
+                   static_cast<socklen_t>(algorithm.size())) != 0) {
+        rejected_option_ = RejectedOption::CongestionControl;
+        rejected_errno_ = errno;
+        return false;
+    }
+
+    if (socket_options_.fast_open) {
+        int enable = 1;
+        if (setsockopt(socket_fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable, sizeof(enable)) != 0) {
+            rejected_option_ = RejectedOption::FastOpen;
+            rejected_errno_ = errno;
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)socket_fd;
+    return socket_options_.congestion_control.empty() && !socket_options_.fast_open;
+#endif
+}
+
+std::string NetworkBenchmark::connection_error() const {
+    switch (rejected_option_) {
+        case RejectedOption::CongestionControl: {
+            std::string message = "Congestion control '" + socket_options_.congestion_control + "' rejected: " +
+                                  std::strerror(rejected_errno_);
+            if (rejected_errno_ == EPERM) {
+                message += " (not in net.ipv4.tcp_allowed_congestion_control)";
+            } else if (rejected_errno_ == ENOENT) {
+                message += " (see net.ipv4.tcp_available_congestion_control)";
+            }
+            return message;
+        }
+        case RejectedOption::FastOpen:
+            return std::string("TCP_FASTOPEN_CONNECT rejected: ") + std::strerror(rejected_errno_);
+        case RejectedOption::None:
+            break;
+    }
+    return "Failed to establish connection";
+}
+
 ssize_t NetworkBenchmark::send_data(
     int socket_fd,
     const void* data,
@@ -489,7 +1774,7 @@ ssize_t NetworkBenchmark::send_data(
         ssize_t bytes_sent = send(socket_fd, 
                                       data_ptr + total_sent,
                                       size - total_sent,
-                                      0);
+                                      MSG_NOSIGNAL);
         
         if (bytes_sent < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
@@ -565,6 +1850,104 @@ ssize_t NetworkBenchmark::receive_data(
 #endif
 }
 
+bool NetworkBenchmark::exchange_payload(
+    int socket_fd,
+    const std::uint8_t* send_buffer,
+    std::uint8_t* recv_buffer,
+    std::size_t size
+) noexcept {
+#ifdef __linux__
+    std::size_t total_sent = 0;
+    std::size_t total_received = 0;
+
+    while (total_received < size) {
+        struct pollfd poll_fd{};
+        poll_fd.fd = socket_fd;
+        poll_fd.events = static_cast<short>(POLLIN | (total_sent < size ? POLLOUT : 0));
+
+        int ready = poll(&poll_fd, 1, EXCHANGE_TIMEOUT_MS);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (ready == 0) {
+            return false;  // Peer stopped echoing
+        }
+
+        if (total_sent < size && (poll_fd.revents & POLLOUT)) {
+            ssize_t bytes_sent = send(socket_fd, send_buffer + total_sent, size - total_sent,
+                                      MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (bytes_sent > 0) {
+                total_sent += static_cast<std::size_t>(bytes_sent);
+            } else if (bytes_sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+        }
+
+        if (poll_fd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t bytes_received = recv(socket_fd, recv_buffer + total_received,
+                                          size - total_received, MSG_DONTWAIT);
+            if (bytes_received == 0) {
+                return false;  // Connection closed
+            }
+            if (bytes_received > 0) {
+                total_received += static_cast<std::size_t>(bytes_received);
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+    return total_sent == size;
+#else
+    (void)socket_fd;
+    (void)send_buffer;
+    (void)recv_buffer;
+    (void)size;
+    return false;
+#endif
+}
+
+int NetworkBenchmark::connect_udp(
+    const std::string& host,
+    std::uint16_t port
+) noexcept {
+#ifdef __linux__
+    struct addrinfo hints{};
+    struct addrinfo* result = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+
+    std::string port_string = std::to_string(port);
+    if (getaddrinfo(host.c_str(), port_string.c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+
+    int socket_fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (socket_fd < 0) {
+        freeaddrinfo(result);
+        return -1;
+    }
+
+    // Connected UDP sockets only receive datagrams from the target
+    int connect_result = connect(socket_fd, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+    if (connect_result < 0) {
+        close_socket(socket_fd);
+        return -1;
+    }
+
+    return socket_fd;
+#else
+    (void)host;
+    (void)port;
+    return -1;
+#endif
+}
+
 void NetworkBenchmark::close_socket(int socket_fd) noexcept {
 #ifdef __linux__
     if (socket_fd >= 0) {
@@ -2,15 +2,23 @@
  * network_benchmark.h - Network latency measurement (Linux/POSIX)
  * 
  * Measures TCP connection time, send/receive latency, and round-trip time.
+ * TCP tests can opt into TCP Fast Open and a per-socket congestion-control
+ * algorithm so transport settings can be compared on the same path.
  * Requires POSIX sockets - not available on iOS.
  */
 
 #ifndef NETWORK_BENCHMARK_H
 #define NETWORK_BENCHMARK_H
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include <vector>
+#include "statistics.h"
+#include "tcp_info_sampler.h"
+
+class ResultWriter;
 
 #ifdef __linux__
 #include <sys/types.h>  // Provides ssize_t on POSIX systems
@@ -25,6 +33,9 @@ typedef long ssize_t;
  * Performs basic network timing measurements using standard sockets.
  * Measures connection time, send/receive latency, and round-trip time.
  * 
+ * The persistent RTT, bulk and UDP modes expect the protocol served by
+ * EchoServer (echo for RTT/UDP, byte-count acknowledgement for bulk).
+ * 
  * Limitations:
  * - Requires network connectivity
  * - Requires a reachable target host/port
@@ -48,6 +59,12 @@ public:
         double avg_connection_time_ms;
         double min_connection_time_ms;
         double max_connection_time_ms;
+        double min_round_trip_ms;       // Persistent RTT / UDP modes
+        double p50_round_trip_ms;
+        double p99_round_trip_ms;
+        double max_round_trip_ms;
+        Statistics::BootstrapSummary round_trip_ci;
+        double throughput_mbps;         // Payload bytes moved per second
         bool connection_successful;
         bool data_exchange_successful;
     };
@@ -56,20 +73,138 @@ public:
      * Results structure containing network benchmark metrics.
      */
     struct Results {
+        std::string mode;               // "connect", "call-loop", "handshake", "rtt", "bulk" or "udp"
         std::string target_host;
         std::uint16_t target_port;
         std::size_t payload_size_bytes;
         std::size_t iterations;
         TimingStats timing;
+        std::uint64_t bytes_transferred;
+        std::size_t packets_lost;       // UDP datagrams without a reply
+        std::vector<double> round_trip_samples_ms;
+        std::string congestion_control; // Algorithm requested via TCP_CONGESTION (empty = default)
+        bool fast_open;                 // TCP_FASTOPEN_CONNECT was requested
+        std::size_t fast_open_accepted; // Handshakes whose SYN data the server accepted
+        bool tcp_info_available;        // Kernel TCP_INFO was read for this test
+        std::vector<TcpInfoSampler::Sample> tcp_info_samples;
+        TcpInfoSampler::Sample tcp_info_final;
+        std::string error_message;
+        bool benchmark_successful;
+    };
+
+    /**
+     * Payload-size sweep parameters. Each mode is measured at every size;
+     * UDP sizes above the maximum datagram payload are skipped.
+     */
+    struct SweepConfig {
+        std::vector<std::size_t> payload_sizes;
+        std::uint16_t rtt_port = 0;             // 0 = skip RTT mode
+        std::uint16_t bulk_port = 0;            // 0 = skip bulk mode
+        std::uint16_t udp_port = 0;             // 0 = skip UDP mode
+        std::size_t rtt_iterations = 200;       // Upper bound per size
+        std::size_t udp_iterations = 200;
+        double bulk_duration_seconds = 0.5;
+        std::uint64_t max_bytes_per_point = 256ULL * 1024 * 1024;  // Caps RTT iterations
+    };
+
+    /**
+     * Limits of the path to a sweep target, read from a connected TCP
+     * socket. Sweep points at which the payload reaches a limit are
+     * marked, since latency and throughput often step there.
+     */
+    struct PathLimits {
+        std::size_t mtu_bytes;              // IP_MTU of the route (0 = unknown)
+        std::size_t send_buffer_bytes;      // Initial SO_SNDBUF (0 = unknown)
+        std::size_t receive_buffer_bytes;   // Initial SO_RCVBUF (0 = unknown)
+    };
+
+    /**
+     * Transport options applied to every TCP socket before connect().
+     */
+    struct SocketOptions {
+        bool fast_open = false;             // TCP_FASTOPEN_CONNECT: data rides in the SYN
+        std::string congestion_control;     // TCP_CONGESTION algorithm (empty = system default)
+    };
+
+    /**
+     * Transport comparison parameters. Every algorithm is measured with the
+     * handshake, RTT and bulk modes; its handshake mode is then repeated
+     * with TCP Fast Open to report the handshake savings.
+     */
+    struct TransportCompareConfig {
+        std::vector<std::string> congestion_controls;   // Empty = system default only
+        std::uint16_t echo_port = 0;
+        std::uint16_t sink_port = 0;
+        std::size_t handshake_iterations = 100;
+        std::size_t rtt_iterations = 200;
+        std::size_t payload_size_bytes = 1024;
+        double bulk_duration_seconds = 1.0;
+        std::size_t bulk_write_size_bytes = 64 * 1024;
+    };
+
+    /**
+     * One row of a transport comparison.
+     */
+    struct TransportResults {
+        std::string congestion_control;
+        bool fast_open;
+        Results handshake;
+        Results rtt;                    // Not run for Fast Open rows
+        Results bulk;                   // Not run for Fast Open rows
+    };
+
+    /**
+     * Latency-under-load parameters. The RTT probe is measured once on an
+     * idle path and once while load_flows bulk connections fill it.
+     */
+    struct LoadedLatencyConfig {
+        std::uint16_t echo_port = 0;
+        std::uint16_t sink_port = 0;
+        std::size_t load_flows = 4;
+        std::size_t rtt_iterations = 200;
+        std::size_t probe_size_bytes = 64;
+        std::size_t bulk_write_size_bytes = 64 * 1024;
+        double ramp_seconds = 0.5;          // Let the flows fill queues before probing
+        double max_load_seconds = 60.0;     // Safety cap on each bulk flow
+    };
+
+    /**
+     * Latency-under-load results.
+     */
+    struct LoadedLatencyResults {
+        Results idle;                       // RTT probe with no competing traffic
+        Results loaded;                     // RTT probe while the bulk flows run
+        std::vector<Results> load_flows;    // One bulk result per flow
+        double aggregate_throughput_mbps;   // Sum over the flows
         std::string error_message;
         bool benchmark_successful;
     };
 
+    /**
+     * Largest payload that fits in a single IPv4 UDP datagram.
+     */
+    static constexpr std::size_t MAX_UDP_PAYLOAD = 65507;
+
     /**
      * Constructs a network benchmark instance.
      */
     NetworkBenchmark() noexcept;
 
+    /**
+     * Sets how often TCP_INFO is sampled during connect, RTT and bulk tests.
+     * An end-of-test sample is always taken.
+     * 
+     * @param interval_ms Sampling interval in milliseconds (0 = end of test only)
+     */
+    void set_tcp_info_interval_ms(double interval_ms) noexcept;
+
+    /**
+     * Sets the transport options used by all subsequent TCP tests.
+     * 
+     * @param options Fast Open and congestion-control selection
+     */
+    void set_socket_options(const SocketOptions& options);
+
     /**
      * Runs the network benchmark.
      * 
@@ -95,6 +230,120 @@ public:
                           std::size_t iterations,
                           std::size_t payload_size_bytes = 1024);
 
+    /**
+     * Measures the cost of a fresh connection: each iteration connects,
+     * exchanges one payload with a TCP echo endpoint and closes. With
+     * TCP Fast Open the payload travels in the SYN, saving one round trip
+     * once the server has issued a cookie.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port of a TCP echo endpoint
+     * @param iterations Number of connections to perform
+     * @param payload_size_bytes Size of the first request
+     * @return Results structure with the connect-to-first-reply distribution
+     */
+    Results run_handshake(const std::string& host, std::uint16_t port,
+                          std::size_t iterations, std::size_t payload_size_bytes);
+
+    /**
+     * Measures round-trip time over one persistent TCP connection.
+     * Each iteration sends the payload and waits for the full echo.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port of a TCP echo endpoint
+     * @param iterations Number of round trips to perform
+     * @param payload_size_bytes Size of payload per round trip
+     * @return Results structure with RTT distribution and throughput
+     */
+    Results run_rtt(const std::string& host, std::uint16_t port,
+                    std::size_t iterations, std::size_t payload_size_bytes);
+
+    /**
+     * Measures one-way bulk TCP throughput. Writes payload-sized chunks for
+     * the given duration, half-closes, and waits for the byte-count ack.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port of a TCP sink endpoint
+     * @param duration_seconds How long to keep sending
+     * @param payload_size_bytes Size of each send() call
+     * @return Results structure with throughput
+     */
+    Results run_bulk(const std::string& host, std::uint16_t port,
+                     double duration_seconds, std::size_t payload_size_bytes);
+
+    /**
+     * Measures UDP round-trip time and loss against a UDP echo endpoint.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port of a UDP echo endpoint
+     * @param iterations Number of datagrams to send
+     * @param payload_size_bytes Datagram payload size (max MAX_UDP_PAYLOAD)
+     * @return Results structure with RTT distribution and loss
+     */
+    Results run_udp(const std::string& host, std::uint16_t port,
+                    std::size_t iterations, std::size_t payload_size_bytes);
+
+    /**
+     * Measures how much request/response RTT inflates when bulk flows
+     * saturate the same path (bufferbloat). Runs the RTT probe idle, then
+     * again on a fresh connection while the bulk flows are sending.
+     * 
+     * @param host Target hostname or IP address
+     * @param config Ports, probe and load parameters
+     * @return Idle and loaded RTT distributions plus per-flow throughput
+     */
+    LoadedLatencyResults run_latency_under_load(const std::string& host,
+                                                const LoadedLatencyConfig& config);
+
+    /**
+     * Runs the RTT, bulk and UDP modes across a range of payload sizes.
+     * 
+     * @param host Target hostname or IP address
+     * @param config Sweep parameters and per-mode ports
+     * @return One Results entry per (mode, payload size) point
+     */
+    std::vector<Results> run_payload_sweep(const std::string& host,
+                                           const SweepConfig& config);
+
+    /**
+     * Connects once and reads the MTU and socket buffer sizes of the path.
+     * 
+     * @param host Target hostname or IP address
+     * @param port TCP port that accepts connections
+     * @return Limits (all 0 if the connection failed)
+     */
+    PathLimits probe_path_limits(const std::string& host, std::uint16_t port);
+
+    /**
+     * Runs the handshake, RTT and bulk modes once per congestion-control
+     * algorithm, each followed by the handshake mode with TCP Fast Open.
+     * Restores the previous socket options before returning.
+     * 
+     * @param host Target hostname or IP address
+     * @param config Algorithms, ports and per-mode parameters
+     * @return Per algorithm, its row followed by its Fast Open row
+     */
+    std::vector<TransportResults> run_transport_comparison(const std::string& host,
+                                                           const TransportCompareConfig& config);
+
+    /**
+     * Reads the algorithms listed in
+     * /proc/sys/net/ipv4/tcp_available_congestion_control.
+     * 
+     * @return Algorithm names (empty if unavailable)
+     */
+    static std::vector<std::string> available_congestion_controls();
+
+    /**
+     * Builds power-of-two payload sizes from min to max (inclusive).
+     * 
+     * @param min_size_bytes Smallest payload size
+     * @param max_size_bytes Largest payload size
+     * @return Sorted payload sizes
+     */
+    static std::vector<std::size_t> power_of_two_sizes(std::size_t min_size_bytes,
+                                                       std::size_t max_size_bytes);
+
     /**
      * Prints network benchmark results in a clear table format.
      * 
@@ -120,6 +369,72 @@ public:
     static void print_cpu_comparison(const Results& network_results,
                                      double cpu_time_per_op_ns);
 
+    /**
+     * Prints one table per mode for a payload-size sweep, marking the
+     * first point at or above each path limit.
+     * 
+     * @param sweep_results Results returned by run_payload_sweep()
+     * @param limits Limits returned by probe_path_limits()
+     */
+    static void print_sweep(const std::vector<Results>& sweep_results, const PathLimits& limits);
+
+    /**
+     * Prints the per-algorithm table and the Fast Open handshake savings.
+     * 
+     * @param comparison Rows returned by run_transport_comparison()
+     */
+    static void print_transport_comparison(const std::vector<TransportResults>& comparison);
+
+    /**
+     * Prints idle vs loaded RTT percentiles and their inflation.
+     * 
+     * @param results Results returned by run_latency_under_load()
+     */
+    static void print_latency_under_load(const LoadedLatencyResults& results);
+
+    /**
+     * Writes every result field plus the RTT samples, their histogram and
+     * the TCP_INFO samples as one object.
+     * 
+     * @param results The benchmark results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "");
+
+    /**
+     * Writes the path limits of a sweep as one object.
+     * 
+     * @param limits Limits returned by probe_path_limits()
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_path_limits(const PathLimits& limits, ResultWriter& writer,
+                                  const std::string& name = "path_limits");
+
+    /**
+     * Writes a transport comparison as an array of rows.
+     * 
+     * @param comparison Rows returned by run_transport_comparison()
+     * @param writer Destination JSON/CSV writer
+     * @param name Array name in the enclosing object (ignored in arrays)
+     */
+    static void write_transport_comparison(const std::vector<TransportResults>& comparison,
+                                           ResultWriter& writer,
+                                           const std::string& name = "");
+
+    /**
+     * Writes idle, loaded and per-flow results as one object.
+     * 
+     * @param results Results returned by run_latency_under_load()
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_latency_under_load(const LoadedLatencyResults& results,
+                                         ResultWriter& writer,
+                                         const std::string& name = "");
+
 private:
     /**
      * Creates a TCP socket and connects to the target.
@@ -132,6 +447,21 @@ private:
     int connect_to_host(const std::string& host, std::uint16_t port,
                        double& connection_time_ms) noexcept;
 
+    /**
+     * Applies the configured transport options to an unconnected socket.
+     * 
+     * @param socket_fd TCP socket
+     * @return true on success; rejected_option_ and rejected_errno_
+     *         record a failure
+     */
+    bool apply_socket_options(int socket_fd) noexcept;
+
+    /**
+     * Returns the reason the last connect_to_host() call failed (built
+     * here so the noexcept connect path never allocates).
+     */
+    std::string connection_error() const;
+
     /**
      * Sends data over a socket.
      * 
@@ -156,6 +486,70 @@ private:
     ssize_t receive_data(int socket_fd, void* buffer, std::size_t size,
                          double& receive_time_ms) noexcept;
 
+    /**
+     * Sends a payload and receives the same number of bytes back,
+     * interleaving both directions so large payloads cannot deadlock
+     * against a blocking echo peer.
+     * 
+     * @param socket_fd Connected socket
+     * @param send_buffer Payload to send
+     * @param recv_buffer Buffer for the echoed payload
+     * @param size Payload size in bytes
+     * @return true if the full payload was sent and received
+     */
+    bool exchange_payload(int socket_fd, const std::uint8_t* send_buffer,
+                          std::uint8_t* recv_buffer, std::size_t size) noexcept;
+
+    /**
+     * Bulk send loop shared by run_bulk() and the latency-under-load flows.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port of a TCP sink endpoint
+     * @param duration_seconds Maximum time to keep sending
+     * @param payload_size_bytes Size of each send() call
+     * @param stop_requested Ends the transfer early when set (may be null)
+     * @return Results structure with throughput
+     */
+    Results bulk_transfer(const std::string& host, std::uint16_t port,
+                          double duration_seconds, std::size_t payload_size_bytes,
+                          const std::atomic<bool>* stop_requested);
+
+    /**
+     * Creates a UDP socket connected to the target.
+     * 
+     * @param host Target hostname or IP address
+     * @param port Target port number
+     * @return Socket file descriptor, or -1 on error
+     */
+    int connect_udp(const std::string& host, std::uint16_t port) noexcept;
+
+    /**
+     * Fills the RTT distribution fields of TimingStats from samples.
+     * 
+     * @param samples Round-trip samples in milliseconds
+     * @param timing Output timing statistics
+     */
+    static void summarize_round_trips(const std::vector<double>& samples,
+                                      TimingStats& timing);
+
+    /**
+     * Stores the sampler's TCP_INFO snapshots in the results.
+     * 
+     * @param sampler Sampler that observed the connection
+     * @param socket_fd Connected socket for the end-of-test sample
+     * @param results Results to update
+     */
+    static void record_tcp_info(TcpInfoSampler& sampler, int socket_fd,
+                                Results& results) noexcept;
+
+    /**
+     * Initializes a Results structure for the given mode and records the
+     * transport options in effect.
+     */
+    Results make_results(const char* mode, const std::string& host,
+                         std::uint16_t port, std::size_t iterations,
+                         std::size_t payload_size_bytes) const;
+
     /**
      * Closes a socket.
      * 
@@ -175,6 +569,20 @@ private:
     bool single_connection_cycle(const std::string& host, std::uint16_t port,
                                  std::size_t payload_size_bytes,
                                  double& connection_time_ms) noexcept;
+
+    double tcp_info_interval_ms_;
+    SocketOptions socket_options_;
+
+    /**
+     * Transport option the kernel rejected on the last connect attempt.
+     */
+    enum class RejectedOption {
+        None,
+        CongestionControl,
+        FastOpen
+    };
+    RejectedOption rejected_option_;
+    int rejected_errno_;                // errno from the rejected setsockopt()
 };
 
 #endif // NETWORK_BENCHMARK_H
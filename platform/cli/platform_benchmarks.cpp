@@ -0,0 +1,395 @@
+/**
+ * platform_benchmarks.cpp - Registry adapters for the Linux network modules
+ */
+
+#include "platform_benchmarks.h"
+#include "network_benchmark.h"
+#include "echo_server.h"
+#include "http_benchmark.h"
+
+namespace {
+    constexpr std::uint16_t DEFAULT_REMOTE_PORT = 9000;
+
+    /**
+     * Shared target handling for the NetworkBenchmark modes: an empty host
+     * starts the built-in server once and reuses it for every repetition.
+     */
+    class NetworkRegistryBenchmark : public Benchmark {
+    public:
+        NetworkRegistryBenchmark(const char* mode, const char* description, bool uses_tcp,
+                                 std::vector<BenchmarkParameter> mode_parameters)
+            : mode_(mode),
+              description_(description),
+              uses_tcp_(uses_tcp),
+              mode_parameters_(std::move(mode_parameters)) {
+        }
+
+        std::string name() const override {
+            return std::string("network.") + mode_;
+        }
+
+        std::string description() const override {
+            return description_;
+        }
+
+        std::vector<BenchmarkParameter> parameters() const override {
+            std::vector<BenchmarkParameter> parameters = {
+                {"host", "", "Target host (empty = built-in loopback server)"},
+                {"port", std::to_string(DEFAULT_REMOTE_PORT), "Echo port of a remote host (sink = port + 1)"},
+            };
+            if (uses_tcp_) {
+                parameters.push_back({"congestion", "", "TCP congestion-control algorithm (empty = default)"});
+                parameters.push_back({"fast_open", "0", "1 = connect with TCP Fast Open"});
+            }
+            parameters.insert(parameters.end(), mode_parameters_.begin(), mode_parameters_.end());
+            return parameters;
+        }
+
+        BenchmarkResult run(const BenchmarkParameters& parameters) override {
+            BenchmarkResult result = make_result(parameters);
+            if (!resolve_target(parameters, result.error_message)) {
+                return result;
+            }
+
+            if (uses_tcp_) {
+                NetworkBenchmark::SocketOptions options;
+                options.congestion_control = parameters.at("congestion");
+                if (!get_bool(parameters, "fast_open", options.fast_open, result.error_message)) {
+                    return result;
+                }
+                benchmark_.set_socket_options(options);
+            }
+
+            run_mode(parameters, result);
+            return result;
+        }
+
+        void print_details() const override {
+            NetworkBenchmark::print_results(last_results_);
+        }
+
+    protected:
+        /**
+         * Runs the mode against host_/ports_ and fills the result.
+         */
+        virtual void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) = 0;
+
+        /**
+         * Copies the RTT distribution of a Results structure into metrics.
+         */
+        static void add_round_trip_metrics(const NetworkBenchmark::Results& results,
+                                           BenchmarkResult& result) {
+            result.metrics.push_back({"avg_round_trip_ms", results.timing.round_trip_time_ms, "ms", false});
+            result.metrics.push_back({"min_round_trip_ms", results.timing.min_round_trip_ms, "ms", false});
+            result.metrics.push_back({"p50_round_trip_ms", results.timing.p50_round_trip_ms, "ms", false});
+            result.metrics.push_back({"p99_round_trip_ms", results.timing.p99_round_trip_ms, "ms", false});
+            result.metrics.push_back({"max_round_trip_ms", results.timing.max_round_trip_ms, "ms", false});
+            result.primary_metric = "p50_round_trip_ms";
+            result.latency_samples_seconds.reserve(results.round_trip_samples_ms.size());
+            for (double round_trip_ms : results.round_trip_samples_ms) {
+                result.latency_samples_seconds.push_back(round_trip_ms / 1e3);
+            }
+        }
+
+        /**
+         * Marks the result with the module's success flag and error.
+         */
+        static void finish(const NetworkBenchmark::Results& results, BenchmarkResult& result) {
+            result.benchmark_successful = results.benchmark_successful;
+            result.error_message = results.error_message;
+        }
+
+        NetworkBenchmark benchmark_;
+        std::string host_;
+        EchoServer::Ports ports_{0, 0, 0};
+        NetworkBenchmark::Results last_results_{};
+
+    private:
+        bool resolve_target(const BenchmarkParameters& parameters, std::string& error_message) {
+            const std::string& host = parameters.at("host");
+            if (!host.empty()) {
+                std::size_t port = 0;
+                if (!get_size(parameters, "port", port, error_message) || port >= 65535) {
+                    if (error_message.empty()) {
+                        error_message = "Port must be between 1 and 65534";
+                    }
+                    return false;
+                }
+                host_ = host;
+                ports_ = EchoServer::Ports{static_cast<std::uint16_t>(port),
+                                           static_cast<std::uint16_t>(port + 1),
+                                           static_cast<std::uint16_t>(port)};
+                return true;
+            }
+
+            if (!server_.is_running()) {
+                if (!server_.start("127.0.0.1", 0)) {
+                    error_message = "Failed to start built-in server: " + server_.error_message();
+                    return false;
+                }
+            }
+            host_ = "127.0.0.1";
+            ports_ = server_.ports();
+            return true;
+        }
+
+        const char* mode_;
+        const char* description_;
+        bool uses_tcp_;
+        std::vector<BenchmarkParameter> mode_parameters_;
+        EchoServer server_;
+    };
+
+    class ConnectRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        ConnectRegistryBenchmark()
+            : NetworkRegistryBenchmark("connect", "TCP open/send/close cycle time", true,
+                                       {{"iterations", "10", "Connection cycles"},
+                                        {"payload_size", "1024", "Bytes sent per cycle"}}) {
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            std::size_t iterations = 0;
+            std::size_t payload_size = 0;
+            if (!get_size(parameters, "iterations", iterations, result.error_message) ||
+                !get_size(parameters, "payload_size", payload_size, result.error_message)) {
+                return;
+            }
+            last_results_ = benchmark_.run_call_loop(host_, ports_.tcp_echo, iterations, payload_size);
+            result.metrics = {
+                {"avg_connection_time_ms", last_results_.timing.avg_connection_time_ms, "ms", false},
+                {"min_connection_time_ms", last_results_.timing.min_connection_time_ms, "ms", false},
+                {"max_connection_time_ms", last_results_.timing.max_connection_time_ms, "ms", false},
+            };
+            result.primary_metric = "avg_connection_time_ms";
+            finish(last_results_, result);
+        }
+    };
+
+    class HandshakeRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        HandshakeRegistryBenchmark()
+            : NetworkRegistryBenchmark("handshake", "Connect plus first echoed request on a new connection", true,
+                                       {{"iterations", "100", "Connections"},
+                                        {"payload_size", "1024", "First request size in bytes"}}) {
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            std::size_t iterations = 0;
+            std::size_t payload_size = 0;
+            if (!get_size(parameters, "iterations", iterations, result.error_message) ||
+                !get_size(parameters, "payload_size", payload_size, result.error_message)) {
+                return;
+            }
+            last_results_ = benchmark_.run_handshake(host_, ports_.tcp_echo, iterations, payload_size);
+            add_round_trip_metrics(last_results_, result);
+            result.metrics.push_back({"fast_open_accepted",
+                                      static_cast<double>(last_results_.fast_open_accepted), "", true});
+            finish(last_results_, result);
+        }
+    };
+
+    class RttRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        RttRegistryBenchmark()
+            : NetworkRegistryBenchmark("rtt", "Round-trip time over a persistent TCP connection", true,
+                                       {{"iterations", "1000", "Round trips"},
+                                        {"payload_size", "64", "Bytes per round trip"}}) {
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            std::size_t iterations = 0;
+            std::size_t payload_size = 0;
+            if (!get_size(parameters, "iterations", iterations, result.error_message) ||
+                !get_size(parameters, "payload_size", payload_size, result.error_message)) {
+                return;
+            }
+            last_results_ = benchmark_.run_rtt(host_, ports_.tcp_echo, iterations, payload_size);
+            add_round_trip_metrics(last_results_, result);
+            result.metrics.push_back({"throughput_mbps", last_results_.timing.throughput_mbps, "MB/s", true});
+            finish(last_results_, result);
+        }
+    };
+
+    class BulkRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        BulkRegistryBenchmark()
+            : NetworkRegistryBenchmark("bulk", "One-way TCP throughput into a sink", true,
+                                       {{"duration", "1.0", "Seconds to send"},
+                                        {"payload_size", "65536", "Bytes per send() call"}}) {
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            double duration = 0.0;
+            std::size_t payload_size = 0;
+            if (!get_double(parameters, "duration", duration, result.error_message) ||
+                !get_size(parameters, "payload_size", payload_size, result.error_message)) {
+                return;
+            }
+            last_results_ = benchmark_.run_bulk(host_, ports_.tcp_sink, duration, payload_size);
+            result.metrics = {
+                {"throughput_mbps", last_results_.timing.throughput_mbps, "MB/s", true},
+                {"bytes_transferred", static_cast<double>(last_results_.bytes_transferred), "B", true},
+            };
+            if (last_results_.tcp_info_available) {
+                result.metrics.push_back({"total_retrans",
+                                          static_cast<double>(last_results_.tcp_info_final.total_retrans),
+                                          "segs", false});
+            }
+            result.primary_metric = "throughput_mbps";
+            finish(last_results_, result);
+        }
+    };
+
+    class UdpRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        UdpRegistryBenchmark()
+            : NetworkRegistryBenchmark("udp", "UDP round-trip time and loss", false,
+                                       {{"iterations", "1000", "Datagrams"},
+                                        {"payload_size", "64", "Datagram payload in bytes"}}) {
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            std::size_t iterations = 0;
+            std::size_t payload_size = 0;
+            if (!get_size(parameters, "iterations", iterations, result.error_message) ||
+                !get_size(parameters, "payload_size", payload_size, result.error_message)) {
+                return;
+            }
+            last_results_ = benchmark_.run_udp(host_, ports_.udp_echo, iterations, payload_size);
+            add_round_trip_metrics(last_results_, result);
+            result.metrics.push_back({"packets_lost", static_cast<double>(last_results_.packets_lost), "", false});
+            finish(last_results_, result);
+        }
+    };
+
+    class LoadedRegistryBenchmark : public NetworkRegistryBenchmark {
+    public:
+        LoadedRegistryBenchmark()
+            : NetworkRegistryBenchmark("loaded", "RTT inflation while bulk flows saturate the path", true,
+                                       {{"iterations", "200", "Round trips per phase"},
+                                        {"load_flows", "4", "Concurrent bulk flows"}}) {
+        }
+
+        void print_details() const override {
+            NetworkBenchmark::print_latency_under_load(last_loaded_results_);
+        }
+
+    protected:
+        void run_mode(const BenchmarkParameters& parameters, BenchmarkResult& result) override {
+            NetworkBenchmark::LoadedLatencyConfig config;
+            if (!get_size(parameters, "iterations", config.rtt_iterations, result.error_message) ||
+                !get_size(parameters, "load_flows", config.load_flows, result.error_message)) {
+                return;
+            }
+            config.echo_port = ports_.tcp_echo;
+            config.sink_port = ports_.tcp_sink;
+            last_loaded_results_ = benchmark_.run_latency_under_load(host_, config);
+
+            const NetworkBenchmark::TimingStats& idle = last_loaded_results_.idle.timing;
+            const NetworkBenchmark::TimingStats& loaded = last_loaded_results_.loaded.timing;
+            result.metrics = {
+                {"idle_p50_round_trip_ms", idle.p50_round_trip_ms, "ms", false},
+                {"loaded_p50_round_trip_ms", loaded.p50_round_trip_ms, "ms", false},
+                {"loaded_p99_round_trip_ms", loaded.p99_round_trip_ms, "ms", false},
+                {"p99_inflation_ms", loaded.p99_round_trip_ms - idle.p99_round_trip_ms, "ms", false},
+                {"aggregate_throughput_mbps", last_loaded_results_.aggregate_throughput_mbps, "MB/s", true},
+            };
+            result.primary_metric = "p99_inflation_ms";
+            result.benchmark_successful = last_loaded_results_.benchmark_successful;
+            result.error_message = last_loaded_results_.error_message;
+        }
+
+    private:
+        NetworkBenchmark::LoadedLatencyResults last_loaded_results_{};
+    };
+
+    class HttpRegistryBenchmark : public Benchmark {
+    public:
+        std::string name() const override {
+            return "http";
+        }
+
+        std::string description() const override {
+            return "HTTP/1.1 keep-alive load generation";
+        }
+
+        std::vector<BenchmarkParameter> parameters() const override {
+            return {
+                {"host", "", "Target host (required)"},
+                {"port", "80", "Target port"},
+                {"path", "/", "Request path"},
+                {"requests", "1000", "Total requests"},
+                {"connections", "1", "Concurrent keep-alive connections"},
+                {"pipeline", "1", "Requests in flight per connection"},
+            };
+        }
+
+        BenchmarkResult run(const BenchmarkParameters& parameters) override {
+            BenchmarkResult result = make_result(parameters);
+            HttpBenchmark::Config config;
+            config.host = parameters.at("host");
+            config.path = parameters.at("path");
+            std::size_t port = 0;
+            if (config.host.empty()) {
+                result.error_message = "Parameter host is required (e.g., --param http.host=127.0.0.1)";
+                return result;
+            }
+            if (!get_size(parameters, "port", port, result.error_message) ||
+                !get_size(parameters, "requests", config.total_requests, result.error_message) ||
+                !get_size(parameters, "connections", config.connections, result.error_message) ||
+                !get_size(parameters, "pipeline", config.pipeline_depth, result.error_message)) {
+                return result;
+            }
+            if (port > 65535) {
+                result.error_message = "Port must be between 1 and 65535";
+                return result;
+            }
+            config.port = static_cast<std::uint16_t>(port);
+
+            last_results_ = benchmark_.run(config);
+            result.metrics = {
+                {"requests_per_second", last_results_.requests_per_second, "req/s", true},
+                {"failed_requests", static_cast<double>(last_results_.failed_requests), "", false},
+            };
+            if (!last_results_.status_stats.empty()) {
+                // Latency of the most common status (normally 200)
+                const HttpBenchmark::StatusStats* dominant = &last_results_.status_stats.front();
+                for (const HttpBenchmark::StatusStats& stats : last_results_.status_stats) {
+                    if (stats.count > dominant->count) {
+                        dominant = &stats;
+                    }
+                }
+                result.metrics.push_back({"p50_latency_ms", dominant->p50_latency_ms, "ms", false});
+                result.metrics.push_back({"p99_latency_ms", dominant->p99_latency_ms, "ms", false});
+            }
+            result.primary_metric = "requests_per_second";
+            result.benchmark_successful = last_results_.benchmark_successful;
+            result.error_message = last_results_.error_message;
+            return result;
+        }
+
+        void print_details() const override {
+            HttpBenchmark::print_results(last_results_);
+        }
+
+    private:
+        HttpBenchmark benchmark_;
+        HttpBenchmark::Results last_results_{};
+    };
+}
+
+void register_platform_benchmarks(BenchmarkRegistry& registry) {
+    registry.add([]() { return std::make_unique<ConnectRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<HandshakeRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<RttRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<BulkRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<UdpRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<LoadedRegistryBenchmark>(); });
+    registry.add([]() { return std::make_unique<HttpRegistryBenchmark>(); });
+}
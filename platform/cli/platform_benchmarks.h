@@ -0,0 +1,26 @@
+/**
+ * platform_benchmarks.h - Registry adapters for the Linux network modules
+ *
+ * Exposes the NetworkBenchmark modes and the HTTP load generator through
+ * the common Benchmark interface so the generic runner can select them.
+ * Requires POSIX sockets - not available on iOS.
+ */
+
+#ifndef PLATFORM_BENCHMARKS_H
+#define PLATFORM_BENCHMARKS_H
+
+#include "benchmark_registry.h"
+
+/**
+ * Registers "network.connect", "network.handshake", "network.rtt",
+ * "network.bulk", "network.udp", "network.loaded" and "http".
+ *
+ * Network benchmarks run against the built-in loopback echo/sink server
+ * unless a host parameter is given; remote hosts must follow the
+ * EchoServer port layout (echo on port, sink on port + 1).
+ *
+ * @param registry Registry to add to
+ */
+void register_platform_benchmarks(BenchmarkRegistry& registry);
+
+#endif // PLATFORM_BENCHMARKS_H
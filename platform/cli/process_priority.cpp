@@ -3,15 +3,88 @@
  */
 
 #include "process_priority.h"
+#include "sysfs_util.h"
+#include <algorithm>
+#include <atomic>
 
 #ifdef __linux__
+#include <alloca.h>
+#include <sched.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
 #include <sys/resource.h>
 #include <cerrno>
 #include <cstring>
 #endif
 
-ProcessPriority::ProcessPriority() noexcept {
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+    /**
+     * Worker CPUs of the applied placement, written before any worker
+     * starts and read-only afterwards.
+     */
+    std::vector<int>& worker_cpus() {
+        static std::vector<int> cpus;
+        return cpus;
+    }
+
+    std::atomic<std::size_t> next_worker{0};
+
+#ifdef __linux__
+    /**
+     * Writes one byte per page of the next bytes of stack below the
+     * caller; a separate frame so the allocation is released on return.
+     */
+    __attribute__((noinline)) void touch_stack(std::size_t bytes) {
+        constexpr std::size_t PAGE_BYTES = 4096;
+        volatile char* stack = static_cast<volatile char*>(alloca(bytes));
+        for (std::size_t offset = 0; offset < bytes; offset += PAGE_BYTES) {
+            stack[offset] = 0;
+        }
+    }
+
+    void mask_to_bits(const cpu_set_t& mask, std::uint64_t* bits, int max_cpus) {
+        for (int i = 0; i < max_cpus && i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &mask)) {
+                bits[i / 64] |= (std::uint64_t{1} << (i % 64));
+            } else {
+                bits[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+            }
+        }
+    }
+
+    void bits_to_mask(const std::uint64_t* bits, int max_cpus, cpu_set_t& mask) {
+        CPU_ZERO(&mask);
+        for (int i = 0; i < max_cpus && i < CPU_SETSIZE; ++i) {
+            if (bits[i / 64] & (std::uint64_t{1} << (i % 64))) {
+                CPU_SET(i, &mask);
+            }
+        }
+    }
+#endif
+}
+
+ProcessPriority::ProcessPriority() noexcept
+    : default_affinity_saved_(false),
+      default_affinity_{} {
+}
+
+ProcessPriority::~ProcessPriority() {
+    restore_isolation();
+}
+
+void ProcessPriority::restore_isolation() const noexcept {
+#ifdef __linux__
+    for (const MigratedThread& thread : migrated_threads_) {
+        cpu_set_t mask;
+        bits_to_mask(thread.affinity, MAX_CPUS, mask);
+        sched_setaffinity(thread.tid, sizeof(mask), &mask);     // Best-effort; the thread may be gone
+    }
+#endif
 }
 
 ProcessPriority::Result ProcessPriority::attempt_raise() noexcept {
@@ -22,6 +95,275 @@ std::int32_t ProcessPriority::get_current_priority() const noexcept {
     return get_current_priority_impl();
 }
 
+bool ProcessPriority::save_default_affinity() noexcept {
+#ifdef __linux__
+    if (!default_affinity_saved_) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+            return false;
+        }
+        mask_to_bits(mask, default_affinity_, MAX_CPUS);
+        default_affinity_saved_ = true;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProcessPriority::Result ProcessPriority::set_cpu_affinity(int cpu) noexcept {
+#ifdef __linux__
+    if (cpu >= MAX_CPUS || cpu >= CPU_SETSIZE) {
+        return Result::Error;
+    }
+    if (!save_default_affinity()) {
+        return Result::Error;
+    }
+
+    cpu_set_t mask;
+    if (cpu < 0) {
+        bits_to_mask(default_affinity_, MAX_CPUS, mask);
+    } else {
+        CPU_ZERO(&mask);
+        CPU_SET(cpu, &mask);
+    }
+
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+        return (errno == EPERM) ? Result::InsufficientPrivs : Result::Error;
+    }
+    return Result::Success;
+#else
+    (void)cpu;
+    return Result::NotSupported;
+#endif
+}
+
+ProcessPriority::PlacementResults ProcessPriority::apply_placement(const Placement& placement,
+                                                                   const CpuTopology& topology) {
+    PlacementResults results{};
+    results.result = Result::Error;
+    results.measuring_cpu = -1;
+#ifdef __linux__
+    if (!save_default_affinity()) {
+        results.error_message = std::string("Cannot read the CPU affinity: ") + std::strerror(errno);
+        return results;
+    }
+    std::vector<int> allowed;
+    for (int i = 0; i < MAX_CPUS && i < CPU_SETSIZE; ++i) {
+        if (default_affinity_[i / 64] & (std::uint64_t{1} << (i % 64))) {
+            allowed.push_back(i);
+        }
+    }
+    std::vector<int> cpuset = placement.cpus.empty() ? allowed : placement.cpus;
+    for (int cpu : cpuset) {
+        if (!std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+            results.error_message = "CPU " + std::to_string(cpu) + " is not available to this process (allowed: " +
+                                    CpuTopology::format_cpulist(allowed) + ")";
+            return results;
+        }
+    }
+    if (cpuset.empty()) {
+        results.error_message = "No CPU available for placement";
+        return results;
+    }
+
+    // Topology order: one CPU per core (alternating nodes) before siblings;
+    // CPUs the topology does not know follow in numeric order
+    std::vector<int> ordered;
+    for (int cpu : topology.spread_cpus(topology.cpus().size())) {
+        if (std::find(cpuset.begin(), cpuset.end(), cpu) != cpuset.end()) {
+            ordered.push_back(cpu);
+        }
+    }
+    std::sort(cpuset.begin(), cpuset.end());
+    for (int cpu : cpuset) {
+        if (std::find(ordered.begin(), ordered.end(), cpu) == ordered.end()) {
+            ordered.push_back(cpu);
+        }
+    }
+
+    results.measuring_cpu = ordered.front();
+    if (placement.avoid_smt_siblings) {
+        results.idle_siblings = topology.smt_siblings(results.measuring_cpu);
+    }
+    for (int cpu : ordered) {
+        if (cpu != results.measuring_cpu &&
+            std::find(results.idle_siblings.begin(), results.idle_siblings.end(), cpu) == results.idle_siblings.end()) {
+            results.worker_cpus.push_back(cpu);
+        }
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(results.measuring_cpu, &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+        results.result = (errno == EPERM) ? Result::InsufficientPrivs : Result::Error;
+        results.error_message = std::string("Cannot pin to CPU ") + std::to_string(results.measuring_cpu) +
+                                ": " + std::strerror(errno);
+        results.measuring_cpu = -1;
+        return results;
+    }
+    // Per-run pinning (suite cpu keys) returns to the measuring CPU
+    mask_to_bits(mask, default_affinity_, MAX_CPUS);
+
+    worker_cpus() = results.worker_cpus;
+    next_worker = 0;
+
+    if (placement.isolate) {
+        // Without an explicit cpuset only the measuring core is reserved
+        std::vector<int> reserved = placement.cpus.empty() ? std::vector<int>{results.measuring_cpu} : cpuset;
+        reserved.insert(reserved.end(), results.idle_siblings.begin(), results.idle_siblings.end());
+        std::sort(reserved.begin(), reserved.end());
+        reserved.erase(std::unique(reserved.begin(), reserved.end()), reserved.end());
+        isolate_cpus(reserved, results);
+    }
+    results.result = Result::Success;
+#else
+    (void)placement;
+    (void)topology;
+    results.result = Result::NotSupported;
+    results.error_message = "CPU placement is not supported on this platform";
+#endif
+    return results;
+}
+
+void ProcessPriority::isolate_cpus(const std::vector<int>& reserved, PlacementResults& results) {
+    results.reserved_cpus = reserved;
+#ifdef __linux__
+    const int self = static_cast<int>(getpid());
+    for (int pid : SysfsUtil::numbered_entries("/proc", "")) {
+        if (pid == self) {
+            continue;       // Benchmark threads are placed explicitly
+        }
+        for (int tid : SysfsUtil::numbered_entries("/proc/" + std::to_string(pid) + "/task", "")) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            if (sched_getaffinity(tid, sizeof(mask), &mask) != 0) {
+                continue;   // Exited since the listing
+            }
+            cpu_set_t moved = mask;
+            bool overlaps = false;
+            for (int cpu : reserved) {
+                if (CPU_ISSET(cpu, &mask)) {
+                    CPU_CLR(cpu, &moved);
+                    overlaps = true;
+                }
+            }
+            if (!overlaps) {
+                continue;
+            }
+            // Threads bound to reserved CPUs only (per-CPU kernel threads)
+            // or owned by other users stay where they are
+            if (CPU_COUNT(&moved) == 0 || sched_setaffinity(tid, sizeof(moved), &moved) != 0) {
+                ++results.unmovable_threads;
+                continue;
+            }
+            MigratedThread thread{tid, {}};
+            mask_to_bits(mask, thread.affinity, MAX_CPUS);
+            migrated_threads_.push_back(thread);
+            ++results.migrated_threads;
+        }
+    }
+#endif
+}
+
+ProcessPriority::RealtimeResults ProcessPriority::enter_realtime(const RealtimeConfig& config) {
+    RealtimeResults results{};
+    results.policy = config.policy;
+    results.priority = config.priority;
+    results.stack_prefault_bytes = 0;
+    results.scheduler = Result::NotSupported;
+    results.memory_lock = Result::NotSupported;
+    results.heap_retention = Result::NotSupported;
+    results.stack_prefault = Result::NotSupported;
+    results.timer_slack = Result::NotSupported;
+#ifdef __linux__
+    auto failure = [&results](const std::string& step) {
+        int error = errno;
+        results.errors.push_back(step + ": " + std::strerror(error));
+        return (error == EPERM || error == EACCES || error == ENOMEM) ? Result::InsufficientPrivs : Result::Error;
+    };
+
+#ifdef __GLIBC__
+    // Before locking: freed buffers then stay in the (locked) heap
+    results.heap_retention = (mallopt(M_TRIM_THRESHOLD, -1) == 1 && mallopt(M_MMAP_MAX, 0) == 1)
+                                 ? Result::Success : Result::Error;
+    if (results.heap_retention != Result::Success) {
+        results.errors.push_back("mallopt: heap trimming could not be disabled");
+    }
+#endif
+
+    // Current mappings are locked whole; later ones only as pages are
+    // touched, so each new thread (one per HTTP connection) does not lock
+    // its full stack reservation
+    results.memory_lock = (mlockall(MCL_CURRENT) == 0 && mlockall(MCL_FUTURE | MCL_ONFAULT) == 0)
+                              ? Result::Success : failure("mlockall");
+
+    // Faulting the stack in is useful without the lock too (first touch)
+    if (config.stack_prefault_bytes > 0) {
+        touch_stack(config.stack_prefault_bytes);
+        results.stack_prefault = Result::Success;
+        results.stack_prefault_bytes = config.stack_prefault_bytes;
+    }
+
+    results.timer_slack = (prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL) == 0) ? Result::Success
+                                                                                : failure("PR_SET_TIMERSLACK");
+
+    int policy = (config.policy == RealtimePolicy::Fifo) ? SCHED_FIFO : SCHED_RR;
+    int min_priority = sched_get_priority_min(policy);
+    int max_priority = sched_get_priority_max(policy);
+    if (config.priority < min_priority || config.priority > max_priority) {
+        results.scheduler = Result::Error;
+        results.errors.push_back(std::string(policy_to_string(config.policy)) + " priority must be between " +
+                                 std::to_string(min_priority) + " and " + std::to_string(max_priority));
+    } else {
+        struct sched_param parameters{};
+        parameters.sched_priority = config.priority;
+        results.scheduler = (sched_setscheduler(0, policy, &parameters) == 0)
+                                ? Result::Success : failure(policy_to_string(config.policy));
+    }
+#else
+    (void)config;
+    results.errors.push_back("Real-time mode is not supported on this platform");
+#endif
+    return results;
+}
+
+const char* ProcessPriority::policy_to_string(RealtimePolicy policy) noexcept {
+    return (policy == RealtimePolicy::Fifo) ? "SCHED_FIFO" : "SCHED_RR";
+}
+
+void ProcessPriority::place_worker_thread() noexcept {
+    const std::vector<int>& cpus = worker_cpus();
+    if (cpus.empty()) {
+        return;
+    }
+#ifdef __linux__
+    int cpu = cpus[next_worker.fetch_add(1) % cpus.size()];
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    sched_setaffinity(0, sizeof(mask), &mask);      // Best-effort; stays on the inherited CPU otherwise
+#endif
+}
+
+std::vector<int> ProcessPriority::allowed_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
 const char* ProcessPriority::result_to_string(Result result) noexcept {
     switch (result) {
         case Result::Success:
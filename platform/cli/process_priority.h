@@ -1,14 +1,20 @@
 /**
- * process_priority.h - Process priority adjustment (Linux)
+ * process_priority.h - Process priority, CPU placement and real-time mode (Linux)
  * 
- * Best-effort attempt to raise process priority for more consistent
- * benchmark timing. Requires elevated privileges for full effect.
+ * Best-effort attempt to raise process priority, keep the measuring thread
+ * on one CPU and remove page faults and preemption from measurements for
+ * more consistent benchmark timing. Requires elevated privileges for full
+ * effect.
  */
 
 #ifndef PROCESS_PRIORITY_H
 #define PROCESS_PRIORITY_H
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
+#include "cpu_topology.h"
 
 /**
  * Process Priority Management Module
@@ -17,12 +23,27 @@
  * Attempts to raise process priority where permitted by the system.
  * Gracefully handles cases where privileges are insufficient.
  * 
+ * CPU placement pins the calling (measuring) thread to one CPU of a
+ * cpuset and hands the remaining CPUs to worker threads, which claim one
+ * each by calling place_worker_thread() when they start. Threads inherit
+ * their creator's affinity, so a thread that does not claim a CPU shares
+ * the measuring CPU. Optionally the measuring CPU's SMT siblings are kept
+ * idle and other processes' threads are moved off the reserved CPUs;
+ * moved threads get their affinity back when the object is destroyed.
+ * 
  * Example usage:
  *   ProcessPriority priority;
  *   bool success = priority.attempt_raise();
  *   if (success) {
  *       std::cout << "Priority raised successfully\n";
  *   }
+ *   ProcessPriority::Placement placement;
+ *   placement.cpus = CpuTopology::parse_cpulist("2-5");
+ *   placement.avoid_smt_siblings = true;
+ *   ProcessPriority::PlacementResults placed =
+ *       priority.apply_placement(placement, CpuTopology::current());
+ *   ProcessPriority::RealtimeResults realtime =
+ *       priority.enter_realtime(ProcessPriority::RealtimeConfig{});
  */
 class ProcessPriority {
 public:
@@ -36,11 +57,81 @@ public:
         Error              // Other error occurred
     };
 
+    /**
+     * Requested CPU placement.
+     */
+    struct Placement {
+        std::vector<int> cpus;              // Cpuset to run in (empty = current affinity)
+        bool avoid_smt_siblings = false;    // Keep the measuring CPU's siblings idle
+        bool isolate = false;               // Move other threads off the reserved CPUs
+    };
+
+    /**
+     * Outcome of apply_placement().
+     */
+    struct PlacementResults {
+        Result result;
+        int measuring_cpu;                  // CPU of the calling thread, -1 = not pinned
+        std::vector<int> worker_cpus;       // Claimed in order by place_worker_thread()
+        std::vector<int> idle_siblings;     // SMT siblings kept free of benchmark threads
+        std::vector<int> reserved_cpus;     // CPUs isolation moved other threads off
+        std::size_t migrated_threads;       // Other threads moved off reserved_cpus
+        std::size_t unmovable_threads;      // Threads that could not be moved (kernel, other users)
+        std::string error_message;
+    };
+
+    /**
+     * Real-time scheduling policy.
+     */
+    enum class RealtimePolicy {
+        Fifo,               // SCHED_FIFO: runs until it blocks or yields
+        RoundRobin          // SCHED_RR: time-sliced among equal priorities
+    };
+
+    /**
+     * Requested real-time mode.
+     */
+    struct RealtimeConfig {
+        RealtimePolicy policy = RealtimePolicy::Fifo;
+        int priority = 49;                          // Just below threaded IRQ handlers (50)
+        std::size_t stack_prefault_bytes = 512 * 1024;
+    };
+
+    /**
+     * Outcome of each real-time step; steps fail independently.
+     */
+    struct RealtimeResults {
+        Result scheduler;                   // sched_setscheduler on the calling thread
+        RealtimePolicy policy;
+        int priority;
+        Result memory_lock;                 // mlockall(MCL_CURRENT | MCL_FUTURE)
+        Result heap_retention;              // Freed heap memory kept mapped (and locked)
+        Result stack_prefault;
+        std::size_t stack_prefault_bytes;
+        Result timer_slack;                 // PR_SET_TIMERSLACK to 1 ns
+        std::vector<std::string> errors;    // One line per failed step
+    };
+
     /**
      * Constructs a process priority manager.
      */
     ProcessPriority() noexcept;
 
+    /**
+     * Gives threads moved by isolation their original affinity back.
+     */
+    ~ProcessPriority();
+
+    /**
+     * Gives threads moved by isolation their original affinity back.
+     * Async-signal-safe, so a SIGINT/SIGTERM handler can undo isolation
+     * before the process dies; the destructor covers normal exits.
+     */
+    void restore_isolation() const noexcept;
+
+    ProcessPriority(const ProcessPriority&) = delete;
+    ProcessPriority& operator=(const ProcessPriority&) = delete;
+
     /**
      * Attempts to raise the current process priority.
      * This is a best-effort operation and will not fail if privileges
@@ -50,6 +141,68 @@ public:
      */
     Result attempt_raise() noexcept;
 
+    /**
+     * Pins the calling thread to one CPU. The affinity in effect on the
+     * first call (or the measuring CPU once a placement is applied) is
+     * restored by passing -1.
+     * 
+     * @param cpu CPU number, or -1 to restore the default affinity
+     * @return Result indicating success or reason for failure
+     */
+    Result set_cpu_affinity(int cpu) noexcept;
+
+    /**
+     * Pins the calling thread to the measuring CPU and prepares the worker
+     * CPUs; see the class comment. The measuring CPU is the first CPU of
+     * the cpuset in topology order, and workers follow the topology's
+     * spread order (one thread per core before SMT siblings).
+     * 
+     * @param placement Cpuset and options
+     * @param topology Host topology (SMT siblings and spread order)
+     * @return Chosen CPUs and isolation counts; result is not Success and
+     *         error_message is set when the cpuset is not usable
+     */
+    PlacementResults apply_placement(const Placement& placement, const CpuTopology& topology);
+
+    /**
+     * Switches the calling thread to a real-time policy and removes page
+     * faults from later allocations. Steps, each attempted independently:
+     *   - keep freed heap memory (no trimming, no per-allocation mmap), so
+     *     buffers reuse pages that are already faulted in and locked
+     *   - mlockall(MCL_CURRENT), then mlockall(MCL_FUTURE | MCL_ONFAULT):
+     *     current mappings are faulted in and locked; later mappings (new
+     *     buffers, thread stacks) are locked page by page on first touch
+     *   - touch stack_prefault_bytes of stack below the caller
+     *   - timer slack of 1 ns so sleeps and timeouts wake on time
+     *   - SCHED_FIFO or SCHED_RR at the given priority
+     * Threads created afterwards inherit the policy and timer slack. Needs
+     * CAP_SYS_NICE/CAP_IPC_LOCK or matching RLIMIT_RTPRIO/RLIMIT_MEMLOCK.
+     * 
+     * @param config Policy, priority and stack size
+     * @return Result of every step
+     */
+    RealtimeResults enter_realtime(const RealtimeConfig& config);
+
+    /**
+     * Converts a RealtimePolicy to its scheduler name ("SCHED_FIFO").
+     */
+    static const char* policy_to_string(RealtimePolicy policy) noexcept;
+
+    /**
+     * Pins the calling thread to the next worker CPU of the applied
+     * placement (round-robin). Does nothing without a placement.
+     * Call at the start of every benchmark worker thread. Threads the
+     * caller creates afterwards inherit its CPU, so a server's accept
+     * loop that calls this also places its connection threads.
+     */
+    static void place_worker_thread() noexcept;
+
+    /**
+     * Returns the CPUs the calling thread may run on (its affinity mask),
+     * ascending; empty if the mask cannot be read.
+     */
+    static std::vector<int> allowed_cpus();
+
     /**
      * Gets the current process priority (nice value).
      * 
@@ -79,6 +232,31 @@ private:
      * @return Current nice value, or 0 if not available
      */
     std::int32_t get_current_priority_impl() const noexcept;
+
+    static constexpr int MAX_CPUS = 1024;
+    static constexpr int MASK_WORDS = MAX_CPUS / 64;
+
+    /**
+     * Affinity of another thread before isolation moved it.
+     */
+    struct MigratedThread {
+        int tid;
+        std::uint64_t affinity[MASK_WORDS];
+    };
+
+    /**
+     * Saves the calling thread's affinity as the default on first use.
+     */
+    bool save_default_affinity() noexcept;
+
+    /**
+     * Moves every other thread on the host off the reserved CPUs.
+     */
+    void isolate_cpus(const std::vector<int>& reserved, PlacementResults& results);
+
+    bool default_affinity_saved_;
+    std::uint64_t default_affinity_[MASK_WORDS];   // Bit per CPU
+    std::vector<MigratedThread> migrated_threads_;
 };
 
 #endif // PROCESS_PRIORITY_H
@@ -0,0 +1,49 @@
+/**
+ * sysfs_util.cpp - Shared sysfs and procfs readers implementation
+ */
+
+#include "sysfs_util.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef __linux__
+#include <dirent.h>
+#endif
+
+namespace SysfsUtil {
+
+std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return "";
+    }
+    line.erase(line.find_last_not_of(" \t\r\n") + 1);
+    return line;
+}
+
+std::vector<int> numbered_entries(const std::string& directory, const std::string& prefix) {
+    std::vector<int> numbers;
+#ifdef __linux__
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        return numbers;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+            name.find_first_not_of("0123456789", prefix.size()) == std::string::npos) {
+            numbers.push_back(std::atoi(name.c_str() + prefix.size()));
+        }
+    }
+    closedir(dir);
+    std::sort(numbers.begin(), numbers.end());
+#else
+    (void)directory;
+    (void)prefix;
+#endif
+    return numbers;
+}
+
+} // namespace SysfsUtil
@@ -0,0 +1,44 @@
+/**
+ * sysfs_util.h - Shared readers for sysfs and procfs files (Linux)
+ *
+ * Used by the modules that describe the host (topology, environment,
+ * thermal sampling, CPU isolation) so every one of them reads kernel
+ * files the same way.
+ */
+
+#ifndef SYSFS_UTIL_H
+#define SYSFS_UTIL_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Sysfs Helpers
+ *
+ * Stateless functions. Missing or unreadable files read as empty, so
+ * callers treat an absent attribute like an unknown one. Directory
+ * listings are empty on other platforms.
+ */
+namespace SysfsUtil {
+    /**
+     * Returns the first line of a file without trailing whitespace, or an
+     * empty string when it cannot be read.
+     *
+     * @param path File to read
+     * @return First line
+     */
+    std::string read_line(const std::string& path);
+
+    /**
+     * Returns the numbers of the entries named prefix<N> in a directory,
+     * ascending ("cpu" matches cpu0 but not cpufreq).
+     *
+     * @param directory Directory to list
+     * @param prefix Name prefix; empty lists purely numeric entries
+     *               (pids in /proc, tids in /proc/<pid>/task)
+     * @return Entry numbers
+     */
+    std::vector<int> numbered_entries(const std::string& directory, const std::string& prefix);
+}
+
+#endif // SYSFS_UTIL_H
@@ -0,0 +1,177 @@
+/**
+ * tcp_info_sampler.cpp - Kernel TCP_INFO sampling implementation
+ */
+
+#include "tcp_info_sampler.h"
+#include "result_writer.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#ifdef __linux__
+// <linux/tcp.h> carries the full kernel struct tcp_info (delivery rate and
+// limited-time counters); glibc's <netinet/tcp.h> stops at tcpi_total_retrans
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/tcp.h>
+#endif
+
+TcpInfoSampler::TcpInfoSampler(double interval_ms) noexcept
+    : interval_ms_(interval_ms),
+      next_sample_ms_(0.0),
+      final_sample_{} {
+}
+
+void TcpInfoSampler::start() noexcept {
+    samples_.clear();
+    final_sample_ = Sample{};
+    next_sample_ms_ = interval_ms_;
+    timer_.start();
+}
+
+void TcpInfoSampler::poll(int socket_fd) noexcept {
+    if (interval_ms_ <= 0.0) {
+        return;
+    }
+
+    double elapsed_ms = timer_.elapsed_milliseconds();
+    if (elapsed_ms < next_sample_ms_) {
+        return;
+    }
+
+    Sample sample{};
+    if (read(socket_fd, sample)) {
+        sample.elapsed_ms = elapsed_ms;
+        samples_.push_back(sample);
+    }
+    // Schedule from now so a stalled loop does not produce a burst of samples
+    next_sample_ms_ = elapsed_ms + interval_ms_;
+}
+
+bool TcpInfoSampler::finish(int socket_fd) noexcept {
+    Sample sample{};
+    if (!read(socket_fd, sample)) {
+        return false;
+    }
+    sample.elapsed_ms = timer_.elapsed_milliseconds();
+    final_sample_ = sample;
+    return true;
+}
+
+const std::vector<TcpInfoSampler::Sample>& TcpInfoSampler::samples() const noexcept {
+    return samples_;
+}
+
+const TcpInfoSampler::Sample& TcpInfoSampler::final_sample() const noexcept {
+    return final_sample_;
+}
+
+bool TcpInfoSampler::read(int socket_fd, Sample& sample) noexcept {
+#ifdef __linux__
+    struct tcp_info info{};
+    socklen_t info_length = sizeof(info);
+    if (getsockopt(socket_fd, IPPROTO_TCP, TCP_INFO, &info, &info_length) != 0) {
+        return false;
+    }
+
+    sample.rtt_ms = static_cast<double>(info.tcpi_rtt) / 1000.0;
+    sample.rttvar_ms = static_cast<double>(info.tcpi_rttvar) / 1000.0;
+    sample.snd_cwnd = info.tcpi_snd_cwnd;
+    sample.snd_mss = info.tcpi_snd_mss;
+    sample.total_retrans = info.tcpi_total_retrans;
+    sample.syn_data_acked = (info.tcpi_options & TCPI_OPT_SYN_DATA) != 0;
+
+    // Older kernels return a shorter struct; only trust fields they filled
+    std::size_t extended_end = offsetof(struct tcp_info, tcpi_sndbuf_limited)
+                               + sizeof(info.tcpi_sndbuf_limited);
+    sample.extended_fields_valid = (info_length >= extended_end);
+    if (sample.extended_fields_valid) {
+        sample.delivery_rate_bps = info.tcpi_delivery_rate;
+        sample.busy_time_us = info.tcpi_busy_time;
+        sample.rwnd_limited_us = info.tcpi_rwnd_limited;
+        sample.sndbuf_limited_us = info.tcpi_sndbuf_limited;
+    }
+    return true;
+#else
+    (void)socket_fd;
+    (void)sample;
+    return false;
+#endif
+}
+
+void TcpInfoSampler::print_summary(
+    const std::vector<Sample>& samples,
+    const Sample& final_sample
+) {
+    std::cout << "Kernel TCP_INFO (end of test):\n";
+    std::cout << "  " << std::left << std::setw(25) << "Smoothed RTT:"
+              << std::fixed << std::setprecision(3)
+              << final_sample.rtt_ms << " ms (rttvar "
+              << final_sample.rttvar_ms << " ms)\n";
+    std::cout << "  " << std::left << std::setw(25) << "Congestion Window:"
+              << final_sample.snd_cwnd << " segments (MSS "
+              << final_sample.snd_mss << " B)\n";
+    std::cout << "  " << std::left << std::setw(25) << "Retransmits:"
+              << final_sample.total_retrans << "\n";
+
+    if (final_sample.extended_fields_valid) {
+        std::cout << "  " << std::left << std::setw(25) << "Delivery Rate:"
+                  << std::fixed << std::setprecision(2)
+                  << (static_cast<double>(final_sample.delivery_rate_bps) / (1024.0 * 1024.0))
+                  << " MB/s\n";
+
+        double busy_ms = static_cast<double>(final_sample.busy_time_us) / 1000.0;
+        std::cout << "  " << std::left << std::setw(25) << "Busy Time:"
+                  << std::fixed << std::setprecision(3) << busy_ms << " ms\n";
+        if (final_sample.busy_time_us > 0) {
+            double busy_us = static_cast<double>(final_sample.busy_time_us);
+            std::cout << "  " << std::left << std::setw(25) << "Receive-Window Limited:"
+                      << std::fixed << std::setprecision(1)
+                      << (100.0 * static_cast<double>(final_sample.rwnd_limited_us) / busy_us)
+                      << " % of busy time\n";
+            std::cout << "  " << std::left << std::setw(25) << "Send-Buffer Limited:"
+                      << std::fixed << std::setprecision(1)
+                      << (100.0 * static_cast<double>(final_sample.sndbuf_limited_us) / busy_us)
+                      << " % of busy time\n";
+        }
+    } else {
+        std::cout << "  Note: Kernel does not report delivery rate or limited times.\n";
+    }
+
+    if (!samples.empty()) {
+        auto rtt_range = std::minmax_element(samples.begin(), samples.end(),
+            [](const Sample& a, const Sample& b) { return a.rtt_ms < b.rtt_ms; });
+        auto cwnd_range = std::minmax_element(samples.begin(), samples.end(),
+            [](const Sample& a, const Sample& b) { return a.snd_cwnd < b.snd_cwnd; });
+
+        std::cout << "  " << std::left << std::setw(25) << "Periodic Samples:"
+                  << samples.size() << "\n";
+        std::cout << "  " << std::left << std::setw(25) << "Smoothed RTT Range:"
+                  << std::fixed << std::setprecision(3)
+                  << rtt_range.first->rtt_ms << " - " << rtt_range.second->rtt_ms << " ms\n";
+        std::cout << "  " << std::left << std::setw(25) << "Congestion Window Range:"
+                  << cwnd_range.first->snd_cwnd << " - " << cwnd_range.second->snd_cwnd
+                  << " segments\n";
+    }
+    std::cout << "\n";
+}
+
+void TcpInfoSampler::write_sample(const Sample& sample, ResultWriter& writer,
+                                  const std::string& name) {
+    writer.begin_object(name);
+    writer.field("elapsed_ms", sample.elapsed_ms);
+    writer.field("rtt_ms", sample.rtt_ms);
+    writer.field("rttvar_ms", sample.rttvar_ms);
+    writer.field("snd_cwnd", sample.snd_cwnd);
+    writer.field("snd_mss", sample.snd_mss);
+    writer.field("total_retrans", sample.total_retrans);
+    writer.field("delivery_rate_bps", sample.delivery_rate_bps);
+    writer.field("busy_time_us", sample.busy_time_us);
+    writer.field("rwnd_limited_us", sample.rwnd_limited_us);
+    writer.field("sndbuf_limited_us", sample.sndbuf_limited_us);
+    writer.field("syn_data_acked", sample.syn_data_acked);
+    writer.field("extended_fields_valid", sample.extended_fields_valid);
+    writer.end_object();
+}
@@ -0,0 +1,127 @@
+/**
+ * tcp_info_sampler.h - Kernel TCP_INFO sampling for network benchmarks (Linux)
+ *
+ * Periodically reads getsockopt(TCP_INFO) on a benchmark connection so that
+ * application-level timings can be explained by kernel-side state
+ * (smoothed RTT, congestion window, retransmits, delivery rate, and the
+ * time the connection spent limited by the receiver window or send buffer).
+ */
+
+#ifndef TCP_INFO_SAMPLER_H
+#define TCP_INFO_SAMPLER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "timer.h"
+
+class ResultWriter;
+
+/**
+ * TCP_INFO Sampling Module
+ *
+ * Call poll() from the benchmark loop; it only issues getsockopt() once the
+ * configured interval has elapsed, so the per-iteration cost is a clock read.
+ * Call finish() before closing the socket to record the end-of-test state.
+ *
+ * Example usage:
+ *   TcpInfoSampler sampler(100.0);
+ *   sampler.start();
+ *   while (...) { ...; sampler.poll(socket_fd); }
+ *   sampler.finish(socket_fd);
+ */
+class TcpInfoSampler {
+public:
+    /**
+     * A single TCP_INFO snapshot.
+     */
+    struct Sample {
+        double elapsed_ms;              // Time since start()
+        double rtt_ms;                  // Smoothed RTT
+        double rttvar_ms;               // RTT variance
+        std::uint32_t snd_cwnd;         // Congestion window (segments)
+        std::uint32_t snd_mss;          // Sender MSS (bytes)
+        std::uint32_t total_retrans;    // Retransmitted segments over the connection
+        std::uint64_t delivery_rate_bps;     // Most recent delivery rate (bytes/s)
+        std::uint64_t busy_time_us;          // Time busy sending data
+        std::uint64_t rwnd_limited_us;       // Time limited by receive window
+        std::uint64_t sndbuf_limited_us;     // Time limited by send buffer
+        bool syn_data_acked;            // TCP Fast Open data in the SYN was accepted
+        bool extended_fields_valid;     // Kernel provided delivery rate / limited times
+    };
+
+    /**
+     * Constructs a sampler.
+     *
+     * @param interval_ms Sampling interval in milliseconds (0 = end of test only)
+     */
+    explicit TcpInfoSampler(double interval_ms) noexcept;
+
+    /**
+     * Resets samples and starts the interval clock.
+     */
+    void start() noexcept;
+
+    /**
+     * Takes a sample if the interval has elapsed since the previous one.
+     *
+     * @param socket_fd Connected TCP socket
+     */
+    void poll(int socket_fd) noexcept;
+
+    /**
+     * Records the end-of-test sample.
+     *
+     * @param socket_fd Connected TCP socket
+     * @return true if TCP_INFO could be read
+     */
+    bool finish(int socket_fd) noexcept;
+
+    /**
+     * Returns the periodic samples taken so far.
+     */
+    const std::vector<Sample>& samples() const noexcept;
+
+    /**
+     * Returns the end-of-test sample (zeroed if finish() failed).
+     */
+    const Sample& final_sample() const noexcept;
+
+    /**
+     * Reads TCP_INFO from a socket.
+     *
+     * @param socket_fd Connected TCP socket
+     * @param sample Output sample (elapsed_ms is left untouched)
+     * @return true if TCP_INFO could be read
+     */
+    static bool read(int socket_fd, Sample& sample) noexcept;
+
+    /**
+     * Prints the end-of-test state and the range seen across samples.
+     *
+     * @param samples Periodic samples
+     * @param final_sample End-of-test sample
+     */
+    static void print_summary(const std::vector<Sample>& samples,
+                              const Sample& final_sample);
+
+    /**
+     * Writes every field of a sample as one object.
+     *
+     * @param sample Sample to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object (ignored in arrays)
+     */
+    static void write_sample(const Sample& sample, ResultWriter& writer,
+                             const std::string& name = "");
+
+private:
+    double interval_ms_;
+    double next_sample_ms_;
+    Timer timer_;
+    std::vector<Sample> samples_;
+    Sample final_sample_;
+};
+
+#endif // TCP_INFO_SAMPLER_H
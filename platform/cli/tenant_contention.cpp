@@ -0,0 +1,516 @@
+/**
+ * tenant_contention.cpp - Multi-process noisy-neighbor benchmark implementation
+ */
+
+#include "tenant_contention.h"
+#include "benchmark_runner.h"
+#include "process_priority.h"
+#include "result_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::size_t NAME_BYTES = 64;
+    constexpr std::size_t UNIT_BYTES = 16;
+    constexpr std::size_t ERROR_BYTES = 256;
+    constexpr int SOLO = 0;
+    constexpr int CONTENDED = 1;
+
+    /**
+     * Primary metric of one benchmark in both phases. Plain data: it lives
+     * in memory shared between the forked tenants and the parent.
+     */
+    struct SharedMetric {
+        char benchmark[NAME_BYTES];
+        char metric[NAME_BYTES];
+        char unit[UNIT_BYTES];
+        int higher_is_better;
+        int valid[2];                   // Indexed by SOLO / CONTENDED
+        double value[2];
+    };
+
+    struct SharedTenant {
+        int finished;
+        std::size_t metric_count;
+        SharedMetric metrics[TenantContention::MAX_BENCHMARKS];
+        char error[ERROR_BYTES];
+    };
+
+#ifdef __linux__
+    struct SharedState {
+        pthread_barrier_t barrier;
+        SharedTenant tenants[TenantContention::MAX_TENANTS];
+    };
+#endif
+
+    void copy_string(char* destination, std::size_t size, const std::string& source) {
+        std::size_t length = std::min(source.size(), size - 1);
+        std::memcpy(destination, source.data(), length);
+        destination[length] = '\0';
+    }
+
+    /**
+     * Runs one tenant's mix and stores its primary metrics for a phase.
+     * Returns false (with slot.error set) when the tenant cannot go on.
+     */
+    bool run_phase(const BenchmarkRegistry& registry, const BenchmarkRunner::Config& runner_config,
+                   SharedTenant& slot, int phase) {
+        BenchmarkRunner runner;
+        std::string error_message;
+        std::vector<BenchmarkRunner::Run> runs = runner.run(registry, runner_config, error_message);
+        if (!error_message.empty()) {
+            copy_string(slot.error, ERROR_BYTES, error_message);
+            return false;
+        }
+        for (const BenchmarkRunner::Run& run : runs) {
+            if (!run.benchmark_successful) {
+                copy_string(slot.error, ERROR_BYTES, run.benchmark_name + ": " + run.error_message);
+                return false;
+            }
+            SharedMetric* metric = nullptr;
+            for (std::size_t i = 0; i < slot.metric_count; ++i) {
+                if (run.benchmark_name == slot.metrics[i].benchmark) {
+                    metric = &slot.metrics[i];
+                }
+            }
+            if (metric == nullptr) {
+                if (slot.metric_count == TenantContention::MAX_BENCHMARKS) {
+                    continue;
+                }
+                metric = &slot.metrics[slot.metric_count++];
+                copy_string(metric->benchmark, NAME_BYTES, run.benchmark_name);
+            }
+            for (const BenchmarkRunner::MetricSummary& summary : run.summaries) {
+                if (summary.name == run.primary_metric) {
+                    copy_string(metric->metric, NAME_BYTES, summary.name);
+                    copy_string(metric->unit, UNIT_BYTES, summary.unit);
+                    metric->higher_is_better = summary.higher_is_better ? 1 : 0;
+                    metric->value[phase] = summary.mean;
+                    metric->valid[phase] = 1;
+                }
+            }
+        }
+        return true;
+    }
+
+#ifdef __linux__
+    /**
+     * Body of a forked tenant. Every tenant passes every barrier, even
+     * after a failure, so the others are never left waiting.
+     */
+    void run_tenant(const BenchmarkRegistry& registry, const TenantContention::Config& config,
+                    const BenchmarkParameters& overrides, std::size_t index, SharedState* shared) {
+        SharedTenant& slot = shared->tenants[index];
+        const TenantContention::Tenant& tenant = config.tenants[index];
+
+        // Runner progress from several processes would interleave
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            close(null_fd);
+        }
+
+        bool ready = true;
+        ProcessPriority priority;
+        if (!tenant.cpus.empty()) {
+            ProcessPriority::Placement placement;
+            placement.cpus = tenant.cpus;
+            ProcessPriority::PlacementResults placed = priority.apply_placement(placement, CpuTopology::current());
+            if (placed.result != ProcessPriority::Result::Success) {
+                copy_string(slot.error, ERROR_BYTES, "CPU placement failed: " + placed.error_message);
+                ready = false;
+            }
+        }
+
+        BenchmarkRunner::Config runner_config;
+        runner_config.selection = tenant.selection;
+        runner_config.repetitions = config.repetitions;
+        runner_config.overrides = overrides;
+
+        // Solo: round t starts tenant t; the next round's barrier waits for it
+        if (config.solo_phase) {
+            for (std::size_t round = 0; round < config.tenants.size(); ++round) {
+                pthread_barrier_wait(&shared->barrier);
+                if (round == index && ready) {
+                    ready = run_phase(registry, runner_config, slot, SOLO);
+                }
+            }
+        }
+        if (config.contended_phase) {
+            pthread_barrier_wait(&shared->barrier);
+            if (ready) {
+                ready = run_phase(registry, runner_config, slot, CONTENDED);
+            }
+        }
+        slot.finished = ready ? 1 : 0;
+    }
+#endif
+
+    void aggregate(TenantContention::Results& results) {
+        for (const TenantContention::TenantResults& tenant : results.tenants) {
+            for (const TenantContention::TenantMetric& metric : tenant.metrics) {
+                auto total = std::find_if(results.totals.begin(), results.totals.end(),
+                                          [&metric](const TenantContention::TotalMetric& candidate) {
+                                              return candidate.benchmark == metric.benchmark &&
+                                                     candidate.metric == metric.metric;
+                                          });
+                if (total == results.totals.end()) {
+                    results.totals.push_back({metric.benchmark, metric.metric, metric.unit,
+                                              metric.higher_is_better, 0, 0.0, 0.0, 0.0});
+                    total = results.totals.end() - 1;
+                }
+                ++total->tenants;
+                total->solo += metric.solo;
+                total->contended += metric.contended;
+            }
+        }
+        for (TenantContention::TotalMetric& total : results.totals) {
+            // Throughput-like metrics add up across tenants; latencies average
+            if (!total.higher_is_better) {
+                total.solo /= static_cast<double>(total.tenants);
+                total.contended /= static_cast<double>(total.tenants);
+            }
+            total.degradation_percent = TenantContention::degradation(total.solo, total.contended,
+                                                                      total.higher_is_better);
+        }
+    }
+
+    /**
+     * Returns the cores restricted to the allowed CPUs, dropping cores
+     * with none left (a cpuset or taskset may exclude whole cores).
+     */
+    std::vector<CpuTopology::Core> usable_cores(const CpuTopology& topology, const std::vector<int>& allowed_cpus) {
+        std::vector<CpuTopology::Core> cores;
+        for (CpuTopology::Core core : topology.cores()) {
+            if (!allowed_cpus.empty()) {
+                core.cpus.erase(std::remove_if(core.cpus.begin(), core.cpus.end(), [&](int cpu) {
+                    return !std::binary_search(allowed_cpus.begin(), allowed_cpus.end(), cpu);
+                }), core.cpus.end());
+            }
+            if (!core.cpus.empty()) {
+                cores.push_back(core);
+            }
+        }
+        return cores;
+    }
+}
+
+std::vector<TenantContention::Tenant> TenantContention::assign_tenants(
+    std::size_t count,
+    const std::vector<std::string>& mixes,
+    const CpuTopology& topology,
+    const std::vector<int>& allowed_cpus
+) {
+    std::vector<Tenant> tenants;
+    std::vector<CpuTopology::Core> cores = usable_cores(topology, allowed_cpus);
+    std::size_t cores_per_tenant = (count > 0) ? std::max<std::size_t>(1, cores.size() / count) : 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        Tenant tenant;
+        tenant.name = "tenant" + std::to_string(i);
+        tenant.selection = mixes.empty() ? "memory" : mixes[i % mixes.size()];
+        for (std::size_t j = 0; j < cores_per_tenant && !cores.empty(); ++j) {
+            const CpuTopology::Core& core = cores[(i * cores_per_tenant + j) % cores.size()];
+            tenant.cpus.insert(tenant.cpus.end(), core.cpus.begin(), core.cpus.end());
+        }
+        std::sort(tenant.cpus.begin(), tenant.cpus.end());
+        tenant.cpus.erase(std::unique(tenant.cpus.begin(), tenant.cpus.end()), tenant.cpus.end());
+        tenants.push_back(tenant);
+    }
+    return tenants;
+}
+
+std::size_t TenantContention::allowed_cores(const CpuTopology& topology, const std::vector<int>& allowed_cpus) {
+    return usable_cores(topology, allowed_cpus).size();
+}
+
+TenantContention::Results TenantContention::run(const BenchmarkRegistry& registry, const Config& config) {
+    Results results{};
+    results.benchmark_successful = false;
+
+    if (config.tenants.empty() || config.tenants.size() > MAX_TENANTS) {
+        results.error_message = "Tenant count must be between 1 and " + std::to_string(MAX_TENANTS);
+        return results;
+    }
+    // Each tenant gets the overrides for its own benchmarks; every override
+    // must apply to at least one tenant
+    std::vector<BenchmarkParameters> tenant_overrides;
+    BenchmarkParameters used_overrides;
+    for (const Tenant& tenant : config.tenants) {
+        std::vector<std::string> unmatched;
+        std::vector<std::string> names = registry.match(tenant.selection, unmatched);
+        if (!unmatched.empty() || names.empty()) {
+            results.error_message = "No registered benchmark matches: " +
+                                    (unmatched.empty() ? tenant.selection : unmatched.front());
+            return results;
+        }
+        if (names.size() > MAX_BENCHMARKS) {
+            results.error_message = "A tenant mix can have at most " + std::to_string(MAX_BENCHMARKS) +
+                                    " benchmarks: " + tenant.selection;
+            return results;
+        }
+        tenant_overrides.push_back(applicable_overrides(registry, names, config.overrides));
+        used_overrides.insert(tenant_overrides.back().begin(), tenant_overrides.back().end());
+    }
+    for (const auto& override_value : config.overrides) {
+        if (used_overrides.count(override_value.first) == 0) {
+            results.error_message = "Unknown parameter for the tenant mixes: " + override_value.first;
+            return results;
+        }
+    }
+
+#ifdef __linux__
+    void* memory = mmap(nullptr, sizeof(SharedState), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        results.error_message = std::string("Cannot map shared memory: ") + std::strerror(errno);
+        return results;
+    }
+    SharedState* shared = static_cast<SharedState*>(memory);     // Zero-filled by mmap
+
+    pthread_barrierattr_t attributes;
+    pthread_barrierattr_init(&attributes);
+    pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    int barrier_error = pthread_barrier_init(&shared->barrier, &attributes,
+                                             static_cast<unsigned>(config.tenants.size()));
+    pthread_barrierattr_destroy(&attributes);
+    if (barrier_error != 0) {
+        munmap(memory, sizeof(SharedState));
+        results.error_message = std::string("Cannot create the tenant barrier: ") + std::strerror(barrier_error);
+        return results;
+    }
+
+    // Buffered output would otherwise be written once per process
+    std::cout << std::flush;
+    std::fflush(nullptr);
+
+    std::vector<pid_t> pids;
+    for (std::size_t i = 0; i < config.tenants.size(); ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            run_tenant(registry, config, tenant_overrides[i], i, shared);
+            std::cout << std::flush;
+            _exit(EXIT_SUCCESS);
+        }
+        if (pid < 0) {
+            results.error_message = std::string("Cannot fork tenant: ") + std::strerror(errno);
+            break;
+        }
+        pids.push_back(pid);
+    }
+
+    // A tenant that dies would leave the others waiting at the barrier
+    std::size_t running = pids.size();
+    if (!results.error_message.empty()) {
+        for (pid_t pid : pids) {
+            kill(pid, SIGKILL);
+        }
+    }
+    while (running > 0) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        auto tenant = std::find(pids.begin(), pids.end(), pid);
+        if (tenant == pids.end()) {
+            continue;
+        }
+        --running;
+        bool clean = WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+        if (!clean && results.error_message.empty()) {
+            std::size_t index = static_cast<std::size_t>(tenant - pids.begin());
+            results.error_message = config.tenants[index].name +
+                                    (WIFSIGNALED(status) ? " terminated by signal " + std::to_string(WTERMSIG(status))
+                                                         : " exited with an error");
+            for (pid_t other : pids) {
+                if (other != pid) {
+                    kill(other, SIGKILL);
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < config.tenants.size(); ++i) {
+        const SharedTenant& slot = shared->tenants[i];
+        TenantResults tenant{};
+        tenant.name = config.tenants[i].name;
+        tenant.selection = config.tenants[i].selection;
+        tenant.cpus = config.tenants[i].cpus;
+        tenant.error_message = slot.error;
+        tenant.benchmark_successful = (slot.finished == 1) && tenant.error_message.empty();
+        if (!tenant.benchmark_successful && tenant.error_message.empty()) {
+            tenant.error_message = "Tenant did not finish";
+        }
+        for (std::size_t j = 0; j < slot.metric_count && j < MAX_BENCHMARKS; ++j) {
+            const SharedMetric& shared_metric = slot.metrics[j];
+            if ((config.solo_phase && shared_metric.valid[SOLO] == 0) ||
+                (config.contended_phase && shared_metric.valid[CONTENDED] == 0)) {
+                continue;
+            }
+            TenantMetric metric{};
+            metric.benchmark = shared_metric.benchmark;
+            metric.metric = shared_metric.metric;
+            metric.unit = shared_metric.unit;
+            metric.higher_is_better = shared_metric.higher_is_better != 0;
+            metric.solo = shared_metric.value[SOLO];
+            metric.contended = shared_metric.value[CONTENDED];
+            if (config.solo_phase && config.contended_phase) {
+                metric.degradation_percent = degradation(metric.solo, metric.contended, metric.higher_is_better);
+            }
+            tenant.metrics.push_back(metric);
+        }
+        results.tenants.push_back(tenant);
+    }
+
+    pthread_barrier_destroy(&shared->barrier);
+    munmap(memory, sizeof(SharedState));
+
+    aggregate(results);
+    results.benchmark_successful = results.error_message.empty() &&
+        std::all_of(results.tenants.begin(), results.tenants.end(),
+                    [](const TenantResults& tenant) { return tenant.benchmark_successful; });
+    if (!results.benchmark_successful && results.error_message.empty()) {
+        results.error_message = "One or more tenants failed";
+    }
+#else
+    (void)registry;
+    results.error_message = "Tenant contention mode is only supported on Linux";
+#endif
+    return results;
+}
+
+BenchmarkParameters TenantContention::applicable_overrides(const BenchmarkRegistry& registry,
+                                                           const std::vector<std::string>& names,
+                                                           const BenchmarkParameters& overrides) {
+    BenchmarkParameters applicable;
+    for (const auto& override_value : overrides) {
+        for (const std::string& name : names) {
+            for (const BenchmarkParameter& parameter : registry.find(name)->parameters) {
+                if (override_value.first == parameter.name ||
+                    override_value.first == name + "." + parameter.name) {
+                    applicable.insert(override_value);
+                }
+            }
+        }
+    }
+    return applicable;
+}
+
+std::string TenantContention::format_cpus(const std::vector<int>& cpus) {
+    return cpus.empty() ? "any CPU" : "CPUs " + CpuTopology::format_cpulist(cpus);
+}
+
+double TenantContention::degradation(double solo, double contended, bool higher_is_better) noexcept {
+    if (solo == 0.0) {
+        return 0.0;
+    }
+    double change = (contended - solo) / solo * 100.0;
+    return higher_is_better ? -change : change;
+}
+
+void TenantContention::print_results(const Results& results) {
+    std::cout << "\n";
+    std::cout << "========================================\n";
+    std::cout << "  Tenant Contention Results\n";
+    std::cout << "========================================\n";
+    std::cout << "\n";
+
+    auto print_row = [](const std::string& benchmark, const std::string& metric, double solo,
+                        double contended, const std::string& unit, double degradation_percent) {
+        std::cout << "  " << std::left << std::setw(25) << (benchmark + ":") << metric << " "
+                  << std::fixed << std::setprecision(2) << solo << " -> " << contended << " " << unit
+                  << " (" << std::showpos << std::setprecision(1) << degradation_percent << std::noshowpos
+                  << "% degradation)\n";
+    };
+
+    for (const TenantResults& tenant : results.tenants) {
+        std::cout << tenant.name << " (" << tenant.selection << ") on " << format_cpus(tenant.cpus) << ":\n";
+        if (!tenant.benchmark_successful) {
+            std::cout << "  Error: " << tenant.error_message << "\n";
+        }
+        for (const TenantMetric& metric : tenant.metrics) {
+            print_row(metric.benchmark, metric.metric, metric.solo, metric.contended,
+                      metric.unit, metric.degradation_percent);
+        }
+        std::cout << "\n";
+    }
+
+    if (!results.totals.empty()) {
+        std::cout << "Total (solo -> contended; sum of higher-is-better metrics, mean of others):\n";
+        for (const TotalMetric& total : results.totals) {
+            print_row(total.benchmark, total.metric, total.solo, total.contended,
+                      total.unit, total.degradation_percent);
+        }
+        std::cout << "\n";
+    }
+
+    if (!results.benchmark_successful) {
+        std::cout << "Error: " << results.error_message << "\n\n";
+    }
+}
+
+void TenantContention::write_results(const Results& results, ResultWriter& writer, const std::string& name) {
+    writer.begin_object(name);
+    writer.begin_array("tenants");
+    for (const TenantResults& tenant : results.tenants) {
+        writer.begin_object();
+        writer.field("name", tenant.name);
+        writer.field("selection", tenant.selection);
+        writer.field("cpus", CpuTopology::format_cpulist(tenant.cpus));
+        writer.begin_array("metrics");
+        for (const TenantMetric& metric : tenant.metrics) {
+            writer.begin_object();
+            writer.field("benchmark", metric.benchmark);
+            writer.field("metric", metric.metric);
+            writer.field("unit", metric.unit);
+            writer.field("higher_is_better", metric.higher_is_better);
+            writer.field("solo", metric.solo);
+            writer.field("contended", metric.contended);
+            writer.field("degradation_percent", metric.degradation_percent);
+            writer.end_object();
+        }
+        writer.end_array();
+        writer.field("benchmark_successful", tenant.benchmark_successful);
+        if (!tenant.benchmark_successful) {
+            writer.field("error_message", tenant.error_message);
+        }
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.begin_array("totals");
+    for (const TotalMetric& total : results.totals) {
+        writer.begin_object();
+        writer.field("benchmark", total.benchmark);
+        writer.field("metric", total.metric);
+        writer.field("unit", total.unit);
+        writer.field("higher_is_better", total.higher_is_better);
+        writer.field("tenants", total.tenants);
+        writer.field("solo", total.solo);
+        writer.field("contended", total.contended);
+        writer.field("degradation_percent", total.degradation_percent);
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.field("benchmark_successful", results.benchmark_successful);
+    if (!results.benchmark_successful) {
+        writer.field("error_message", results.error_message);
+    }
+    writer.end_object();
+}
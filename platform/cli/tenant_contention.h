@@ -0,0 +1,193 @@
+/**
+ * tenant_contention.h - Multi-process noisy-neighbor benchmark (Linux)
+ *
+ * Forks one process per tenant, each running a mix of registered
+ * benchmarks on its own cores, to show how co-located services slow each
+ * other down through shared caches, memory bandwidth and the kernel.
+ */
+
+#ifndef TENANT_CONTENTION_H
+#define TENANT_CONTENTION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "benchmark_registry.h"
+#include "cpu_topology.h"
+
+class ResultWriter;
+
+/**
+ * Tenant Contention Module
+ *
+ * Every tenant is a forked process pinned to its cpuset (the first CPU
+ * measures, the rest take worker threads, as with --cpus). The processes
+ * meet at a process-shared barrier in anonymous shared memory and run two
+ * phases:
+ *   solo       each tenant's mix alone, one tenant after another
+ *   contended  every tenant's mix at the same time
+ * Either phase can be switched off in Config when the other one is
+ * measured elsewhere (InterferenceMatrix takes baselines only once).
+ * Each tenant stores the mean primary metric of every benchmark per phase
+ * in its shared slot; the parent aggregates them into per-tenant
+ * degradation and totals (sum of higher-is-better metrics such as
+ * throughput, mean of the others).
+ *
+ * Example usage:
+ *   TenantContention::Config config;
+ *   config.tenants = TenantContention::assign_tenants(4, {"memory", "cpu"}, CpuTopology::current(),
+ *                                                     ProcessPriority::allowed_cpus());
+ *   TenantContention::Results results = TenantContention::run(registry, config);
+ *   TenantContention::print_results(results);
+ */
+class TenantContention {
+public:
+    static constexpr std::size_t MAX_TENANTS = 64;
+    static constexpr std::size_t MAX_BENCHMARKS = 16;     // Per tenant mix
+
+    /**
+     * One tenant process.
+     */
+    struct Tenant {
+        std::string name;                   // "tenant0", ...
+        std::string selection;              // Registry patterns, e.g. "memory,cpu"
+        std::vector<int> cpus;              // Empty = not pinned
+    };
+
+    /**
+     * Contention run configuration.
+     */
+    struct Config {
+        std::vector<Tenant> tenants;
+        std::size_t repetitions = 3;        // Measured runs per benchmark and phase
+        BenchmarkParameters overrides;      // As BenchmarkRunner::Config::overrides
+        bool solo_phase = true;             // Skipped when baselines are measured elsewhere
+        bool contended_phase = true;
+    };
+
+    /**
+     * One benchmark of one tenant in both phases.
+     */
+    struct TenantMetric {
+        std::string benchmark;
+        std::string metric;                 // Primary metric of the benchmark
+        std::string unit;
+        bool higher_is_better;
+        double solo;                        // Mean over repetitions, tenant alone (0 = phase skipped)
+        double contended;                   // Mean over repetitions, all tenants running (0 = skipped)
+        double degradation_percent;         // Positive = worse under contention (0 without both phases)
+    };
+
+    /**
+     * Results of one tenant.
+     */
+    struct TenantResults {
+        std::string name;
+        std::string selection;
+        std::vector<int> cpus;
+        std::vector<TenantMetric> metrics;
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * One metric aggregated over the tenants that ran it.
+     */
+    struct TotalMetric {
+        std::string benchmark;
+        std::string metric;
+        std::string unit;
+        bool higher_is_better;
+        std::size_t tenants;
+        double solo;                        // Sum (higher is better) or mean
+        double contended;
+        double degradation_percent;
+    };
+
+    /**
+     * Per-tenant and total results.
+     */
+    struct Results {
+        std::vector<TenantResults> tenants;
+        std::vector<TotalMetric> totals;
+        bool benchmark_successful;
+        std::string error_message;
+    };
+
+    /**
+     * Builds count tenants with the mixes assigned round-robin and the
+     * allowed cores split into contiguous, equally sized groups (tenants
+     * share cores when there are more tenants than cores; see
+     * allowed_cores()).
+     *
+     * @param count Number of tenants
+     * @param mixes Registry selections, e.g. {"memory", "cpu"}
+     * @param topology Host topology (empty = tenants are not pinned)
+     * @param allowed_cpus CPUs the process may run on (empty = all)
+     * @return Tenant list
+     */
+    static std::vector<Tenant> assign_tenants(std::size_t count, const std::vector<std::string>& mixes,
+                                              const CpuTopology& topology, const std::vector<int>& allowed_cpus);
+
+    /**
+     * Counts the cores with at least one allowed CPU.
+     *
+     * @param topology Host topology
+     * @param allowed_cpus CPUs the process may run on (empty = all)
+     * @return Cores assign_tenants() distributes
+     */
+    static std::size_t allowed_cores(const CpuTopology& topology, const std::vector<int>& allowed_cpus);
+
+    /**
+     * Forks the tenants, runs both phases and collects the results.
+     * Tenant output (runner progress) is discarded.
+     *
+     * @param registry Registry the selections refer to
+     * @param config Tenants, repetitions and overrides
+     * @return Aggregated results (error_message set when the run could not start)
+     */
+    static Results run(const BenchmarkRegistry& registry, const Config& config);
+
+    /**
+     * Prints one table per tenant and the totals.
+     *
+     * @param results Results to print
+     */
+    static void print_results(const Results& results);
+
+    /**
+     * Writes tenants and totals as one object.
+     *
+     * @param results Results to write
+     * @param writer Destination JSON/CSV writer
+     * @param name Object name in the enclosing object
+     */
+    static void write_results(const Results& results, ResultWriter& writer,
+                              const std::string& name = "tenants");
+
+    /**
+     * Returns the overrides that name a parameter of one of the benchmarks,
+     * as NAME or BENCHMARK.NAME (the runner rejects the others).
+     *
+     * @param registry Registry the names refer to
+     * @param names Registered benchmark names
+     * @param overrides Overrides to filter
+     * @return Applicable subset of overrides
+     */
+    static BenchmarkParameters applicable_overrides(const BenchmarkRegistry& registry,
+                                                    const std::vector<std::string>& names,
+                                                    const BenchmarkParameters& overrides);
+
+    /**
+     * Formats a tenant's cpuset for tables, e.g. "CPUs 0-3" or "any CPU".
+     */
+    static std::string format_cpus(const std::vector<int>& cpus);
+
+    /**
+     * Computes the degradation of contended against solo in percent,
+     * positive when the metric got worse.
+     */
+    static double degradation(double solo, double contended, bool higher_is_better) noexcept;
+};
+
+#endif // TENANT_CONTENTION_H
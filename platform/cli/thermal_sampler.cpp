@@ -0,0 +1,92 @@
+/**
+ * thermal_sampler.cpp - CPU frequency and thermal throttling sampling implementation
+ */
+
+#include "thermal_sampler.h"
+#include "sysfs_util.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+    bool readable(const std::string& path) {
+        std::ifstream file(path);
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Reads the first number of a file; false if it cannot be read.
+     */
+    bool read_number(const std::string& path, double& value) {
+        std::ifstream file(path);
+        return static_cast<bool>(file >> value);
+    }
+}
+
+ThermalSampler::ThermalSampler() {
+    std::vector<double> packages_seen;
+    for (int cpu_number : SysfsUtil::numbered_entries("/sys/devices/system/cpu/", "cpu")) {
+        const std::string cpu = "/sys/devices/system/cpu/cpu" + std::to_string(cpu_number);
+        if (readable(cpu + "/cpufreq/scaling_cur_freq")) {
+            frequency_paths_.push_back(cpu + "/cpufreq/scaling_cur_freq");
+        }
+        if (readable(cpu + "/thermal_throttle/core_throttle_count")) {
+            core_throttle_paths_.push_back(cpu + "/thermal_throttle/core_throttle_count");
+        }
+        // Every CPU of a package reports the same package counter: keep one per package
+        double package = -1.0;
+        read_number(cpu + "/topology/physical_package_id", package);
+        if (readable(cpu + "/thermal_throttle/package_throttle_count") &&
+            std::find(packages_seen.begin(), packages_seen.end(), package) == packages_seen.end()) {
+            packages_seen.push_back(package);
+            package_throttle_paths_.push_back(cpu + "/thermal_throttle/package_throttle_count");
+        }
+    }
+    for (int zone_number : SysfsUtil::numbered_entries("/sys/class/thermal/", "thermal_zone")) {
+        const std::string zone = "/sys/class/thermal/thermal_zone" + std::to_string(zone_number);
+        if (readable(zone + "/temp")) {
+            temperature_paths_.push_back(zone + "/temp");
+        }
+    }
+}
+
+bool ThermalSampler::available() const noexcept {
+    return !frequency_paths_.empty() || !package_throttle_paths_.empty() ||
+           !core_throttle_paths_.empty() || !temperature_paths_.empty();
+}
+
+DriftAnalysis::Condition ThermalSampler::sample() const {
+    DriftAnalysis::Condition condition{};
+    condition.valid = available();
+    double value = 0.0;
+
+    std::size_t frequency_count = 0;
+    for (const std::string& path : frequency_paths_) {
+        if (read_number(path, value)) {
+            condition.frequency_mhz += value / 1000.0;     // kHz
+            frequency_count++;
+        }
+    }
+    if (frequency_count > 0) {
+        condition.frequency_mhz /= static_cast<double>(frequency_count);
+    }
+
+    for (const std::string& path : package_throttle_paths_) {
+        if (read_number(path, value)) {
+            condition.package_throttle_count += static_cast<std::uint64_t>(value);
+        }
+    }
+    for (const std::string& path : core_throttle_paths_) {
+        if (read_number(path, value)) {
+            condition.core_throttle_count += static_cast<std::uint64_t>(value);
+        }
+    }
+
+    for (const std::string& path : temperature_paths_) {
+        // Millidegrees; some zones report errors or bogus negative values
+        if (read_number(path, value) && value > 0.0) {
+            condition.temperature_celsius = std::max(condition.temperature_celsius, value / 1000.0);
+        }
+    }
+    return condition;
+}
@@ -0,0 +1,56 @@
+/**
+ * thermal_sampler.h - CPU frequency and thermal throttling sampling (Linux)
+ *
+ * Supplies DriftAnalysis with the host state between continuous runs so
+ * throughput shifts can be attributed to throttling or clock changes.
+ */
+
+#ifndef THERMAL_SAMPLER_H
+#define THERMAL_SAMPLER_H
+
+#include <string>
+#include <vector>
+#include "drift_analysis.h"
+
+/**
+ * Thermal Sampler
+ *
+ * The sysfs files to read are located once at construction; each sample()
+ * then reads:
+ *   - cpu*\/cpufreq/scaling_cur_freq (averaged over CPUs)
+ *   - cpu*\/thermal_throttle/package_throttle_count (summed over packages)
+ *   - cpu*\/thermal_throttle/core_throttle_count (summed)
+ *   - /sys/class/thermal/thermal_zone*\/temp (hottest zone)
+ * Samples are invalid when none of these exist (e.g. most virtual machines).
+ *
+ * Example usage:
+ *   ThermalSampler sampler;
+ *   benchmark.set_condition_sampler([&sampler]() { return sampler.sample(); });
+ */
+class ThermalSampler {
+public:
+    /**
+     * Locates the frequency, throttle and temperature files.
+     */
+    ThermalSampler();
+
+    /**
+     * Returns true if at least one source was found.
+     */
+    bool available() const noexcept;
+
+    /**
+     * Reads the current host state.
+     *
+     * @return Condition (valid == false when no source is available)
+     */
+    DriftAnalysis::Condition sample() const;
+
+private:
+    std::vector<std::string> frequency_paths_;
+    std::vector<std::string> package_throttle_paths_;
+    std::vector<std::string> core_throttle_paths_;
+    std::vector<std::string> temperature_paths_;
+};
+
+#endif // THERMAL_SAMPLER_H
@@ -0,0 +1,72 @@
+/**
+ * topology_discovery.cpp - CPU topology discovery implementation
+ */
+
+#include "topology_discovery.h"
+#include "sysfs_util.h"
+#include <cstdlib>
+#include <map>
+
+namespace {
+    using SysfsUtil::numbered_entries;
+    using SysfsUtil::read_line;
+
+    const std::string CPU_ROOT = "/sys/devices/system/cpu/";
+    const std::string NODE_ROOT = "/sys/devices/system/node/";
+
+    /**
+     * Parses a sysfs cache size such as "48K" or "32M".
+     */
+    std::size_t parse_cache_size(const std::string& size) {
+        std::size_t bytes = std::strtoull(size.c_str(), nullptr, 10);
+        if (!size.empty() && size.back() == 'K') {
+            bytes *= 1024;
+        } else if (!size.empty() && size.back() == 'M') {
+            bytes *= 1024 * 1024;
+        }
+        return bytes;
+    }
+}
+
+CpuTopology TopologyDiscovery::discover() {
+    CpuTopology topology;
+
+    std::map<int, int> cpu_nodes;
+    for (int node : numbered_entries(NODE_ROOT, "node")) {
+        for (int cpu : CpuTopology::parse_cpulist(read_line(NODE_ROOT + "node" + std::to_string(node) + "/cpulist"))) {
+            cpu_nodes[cpu] = node;
+        }
+    }
+
+    for (int cpu : numbered_entries(CPU_ROOT, "cpu")) {
+        const std::string cpu_directory = CPU_ROOT + "cpu" + std::to_string(cpu) + "/";
+        std::string package = read_line(cpu_directory + "topology/physical_package_id");
+        std::string core_id = read_line(cpu_directory + "topology/core_id");
+        if (package.empty() || core_id.empty()) {
+            continue;       // Offline
+        }
+        auto node = cpu_nodes.find(cpu);
+        topology.add_cpu(cpu, std::atoi(package.c_str()), std::atoi(core_id.c_str()),
+                         node != cpu_nodes.end() ? node->second : 0);
+
+        const std::string cache_root = cpu_directory + "cache/";
+        for (int index : numbered_entries(cache_root, "index")) {
+            const std::string directory = cache_root + "index" + std::to_string(index) + "/";
+            std::string size = read_line(directory + "size");
+            if (size.empty()) {
+                continue;
+            }
+            CpuTopology::Cache cache{};
+            cache.level = std::atoi(read_line(directory + "level").c_str());
+            cache.type = read_line(directory + "type");
+            cache.size_bytes = parse_cache_size(size);
+            cache.line_bytes = std::strtoull(read_line(directory + "coherency_line_size").c_str(), nullptr, 10);
+            cache.cpus = CpuTopology::parse_cpulist(read_line(directory + "shared_cpu_list"));
+            if (cache.cpus.empty()) {
+                cache.cpus.push_back(cpu);
+            }
+            topology.add_cache(cache);
+        }
+    }
+    return topology;
+}
@@ -0,0 +1,36 @@
+/**
+ * topology_discovery.h - CPU topology discovery from sysfs (Linux)
+ *
+ * Builds the CpuTopology that benchmarks use for cache-relative buffer
+ * sizes and thread placement.
+ */
+
+#ifndef TOPOLOGY_DISCOVERY_H
+#define TOPOLOGY_DISCOVERY_H
+
+#include "cpu_topology.h"
+
+/**
+ * Topology Discovery
+ *
+ * Reads, for every cpuN under /sys/devices/system/cpu:
+ *   - topology/physical_package_id and topology/core_id (SMT siblings)
+ *   - cache/index*\/{level,type,size,coherency_line_size,shared_cpu_list}
+ * and /sys/devices/system/node/node*\/cpulist for NUMA placement. Offline
+ * CPUs lack a topology directory and are skipped. Returns an empty
+ * topology on other platforms.
+ *
+ * Example usage:
+ *   CpuTopology::set_current(TopologyDiscovery::discover());
+ */
+class TopologyDiscovery {
+public:
+    /**
+     * Reads the host topology.
+     *
+     * @return Topology (empty when sysfs is unavailable)
+     */
+    static CpuTopology discover();
+};
+
+#endif // TOPOLOGY_DISCOVERY_H